@@ -195,6 +195,27 @@ namespace rascal {
         py::call_guard<py::gil_scoped_release>());
   }
 
+  //! register the streaming estimate of the optimal radial basis
+  template <class ManagerCollection>
+  void bind_radial_basis_covariance(py::module & mod,
+                                    py::module & /*m_internal*/) {
+    py::class_<RadialBasisCovariance> covariance(mod, "RadialBasisCovariance");
+    covariance.def(py::init<size_t, size_t>(), py::arg("max_radial"),
+                   py::arg("max_angular"));
+    covariance.def(
+        "accumulate",
+        &RadialBasisCovariance::template accumulate<ManagerCollection>,
+        py::call_guard<py::gil_scoped_release>(),
+        R"(Compute the spherical expansion of the structures with the
+              calculator and add their environments to the covariance.)");
+    covariance.def("get_n_environments",
+                   &RadialBasisCovariance::get_n_environments);
+    covariance.def("get_covariances", &RadialBasisCovariance::get_covariances);
+    covariance.def("get_projection_matrices",
+                   &RadialBasisCovariance::get_projection_matrices,
+                   py::arg("n_components"));
+  }
+
   /**
    * Function to bind the representation managers to python
    *
@@ -243,5 +264,7 @@ namespace rascal {
         mod, m_internal);
     bind_compute_numerical_kernel_gradients<
         SparseKernel, Calc1_t, ManagerCollection_2_t, SparsePoints_1_t>(mod);
+
+    bind_radial_basis_covariance<ManagerCollection_2_t>(mod, m_internal);
   }
 }  // namespace rascal
@@ -36,6 +36,7 @@
 #include "rascal/models/sparse_kernel_predict.hh"
 #include "rascal/models/sparse_kernels.hh"
 #include "rascal/models/sparse_points.hh"
+#include "rascal/representations/optimal_radial_basis.hh"
 
 namespace rascal {
   void add_models(py::module &, py::module &);
@@ -149,6 +149,8 @@ namespace rascal {
     auto base = py::class_<CalculatorBase>(m_internal, "CalculatorBase");
     base.def_readwrite("name", &CalculatorBase::name);
     base.def_readonly("default_prefix", &CalculatorBase::default_prefix);
+    base.def_property("n_threads", &CalculatorBase::get_n_threads,
+                      &CalculatorBase::set_n_threads);
     /*-------------------- rep-bind-start --------------------*/
     // Defines a particular structure manager type
     using TypeHolder_t =
@@ -186,6 +188,14 @@ namespace rascal {
         add_representation_calculator<Calc4_t>(mod, m_internal);
     bind_compute_function_helper<ManagerList_1_t>(rep_lambda_soap);
     bind_get_num_coefficients_function_helper<ManagerList_1_t>(rep_lambda_soap);
+
+    using Calc5_t = CalculatorKspaceSphericalExpansion;
+    auto rep_kspace_spherical_expansion =
+        add_representation_calculator<Calc5_t>(mod, m_internal);
+    bind_compute_function_helper<ManagerList_1_t>(
+        rep_kspace_spherical_expansion);
+    bind_get_num_coefficients_function_helper<ManagerList_1_t>(
+        rep_kspace_spherical_expansion);
   }
 
 }  // namespace rascal
@@ -31,6 +31,7 @@
 #include "bind_py_structure_manager.hh"
 
 #include "rascal/representations/calculator_base.hh"
+#include "rascal/representations/calculator_kspace_spherical_expansion.hh"
 #include "rascal/representations/calculator_sorted_coulomb.hh"
 #include "rascal/representations/calculator_spherical_covariants.hh"
 #include "rascal/representations/calculator_spherical_expansion.hh"
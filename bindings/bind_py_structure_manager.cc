@@ -779,6 +779,158 @@ namespace rascal {
         R"(Get the dense feature matrix associated with the calculator and
         the collection of structures (managers) using the list of keys
         provided. Only applicable when Calculator uses BlockSparseProperty.)");
+    manager_collection.def(
+        "get_features_gradient_block_sparse",
+        [](ManagerCollection_t & managers, const Calculator & calculator,
+           py::list & all_keys_l) {
+          using Manager_t = typename ManagerCollection_t::Manager_t;
+          using Prop_t =
+              typename Calculator::template PropertyGradient_t<Manager_t>;
+          using Keys_t = typename Prop_t::Keys_t;
+          using ManagerPtr_t = std::shared_ptr<Manager_t>;
+          Keys_t all_keys;
+          if (all_keys_l.size() > 0) {
+            for (py::handle key_l : all_keys_l) {
+              auto key = py::cast<std::vector<int>>(key_l);
+              all_keys.insert(key);
+            }
+          } else {
+            // the keys of the gradients are among the keys of the features
+            for (auto key_l : managers.get_keys(calculator)) {
+              all_keys.insert(key_l);
+            }
+          }
+
+          auto property_name{managers.get_calculator_name(calculator, true)};
+
+          py::list blocks_list{};
+          for (auto & manager : managers) {
+            const auto & property =
+                *manager->template get_property<Prop_t>(property_name);
+            const py::ssize_t inner_size{property.get_nb_comp() / ThreeD};
+            Eigen::VectorXi block_columns{}, block_row_pointers{};
+            property.get_block_sparse_gradient_structure(
+                all_keys, block_columns, block_row_pointers);
+            const py::ssize_t n_blocks{block_columns.size()};
+            // the blocks are the storage of the property, which is kept
+            // alive with its manager as long as the array is
+            py::capsule owner(new ManagerPtr_t(manager), [](void * ptr) {
+              delete reinterpret_cast<ManagerPtr_t *>(ptr);
+            });
+            constexpr py::ssize_t item_size{sizeof(double)};
+            py::array_t<double> blocks(
+                {n_blocks, static_cast<py::ssize_t>(ThreeD), inner_size},
+                {ThreeD * inner_size * item_size, inner_size * item_size,
+                 item_size},
+                property.get_raw_data().data(), owner);
+            blocks_list.append(py::make_tuple(blocks, block_columns,
+                                              block_row_pointers));
+          }
+          py::list keys_list{};
+          for (const auto & key : all_keys) {
+            keys_list.append(py::cast(key));
+          }
+          return py::make_tuple(keys_list, blocks_list);
+        },
+        R"(Get the gradients of the representation associated with the
+        calculator in a block sparse row (BSR) format. Returns the keys
+        used as block columns (the list of keys provided or the keys of the
+        managers if empty) and one tuple
+        (blocks, block_columns, block_row_pointers) per structure. The blocks
+        [n_blocks, 3, n_features_by_key] share the memory of the gradients
+        (no copy), block_columns gives the position of the key of each block
+        in the keys and block_row_pointers the first block of each pair.
+        Only applicable when Calculator uses BlockSparseProperty.)");
+    manager_collection.def(
+        "get_features_block_sparse",
+        [](ManagerCollection_t & managers, const Calculator & calculator,
+           py::list & all_keys_l) {
+          using Manager_t = typename ManagerCollection_t::Manager_t;
+          using Prop_t = typename Calculator::template Property_t<Manager_t>;
+          using Keys_t = typename Prop_t::Keys_t;
+          using ManagerPtr_t = std::shared_ptr<Manager_t>;
+          Keys_t all_keys;
+          if (all_keys_l.size() > 0) {
+            for (py::handle key_l : all_keys_l) {
+              auto key = py::cast<std::vector<int>>(key_l);
+              all_keys.insert(key);
+            }
+          } else {
+            for (auto key_l : managers.get_keys(calculator)) {
+              all_keys.insert(key_l);
+            }
+          }
+
+          auto property_name{managers.get_calculator_name(calculator, false)};
+
+          py::list blocks_list{};
+          for (auto & manager : managers) {
+            const auto & property =
+                *manager->template get_property<Prop_t>(property_name);
+            const py::ssize_t inner_size{property.get_nb_comp()};
+            Eigen::VectorXi block_columns{}, block_row_pointers{};
+            property.get_block_sparse_structure(all_keys, block_columns,
+                                                block_row_pointers);
+            const py::ssize_t n_blocks{block_columns.size()};
+            // the blocks are the storage of the property, which is kept
+            // alive with its manager as long as the array is
+            py::capsule owner(new ManagerPtr_t(manager), [](void * ptr) {
+              delete reinterpret_cast<ManagerPtr_t *>(ptr);
+            });
+            constexpr py::ssize_t item_size{sizeof(double)};
+            py::array_t<double> blocks({n_blocks, inner_size},
+                                       {inner_size * item_size, item_size},
+                                       property.get_raw_data().data(), owner);
+            // the calculator owns these values, they are only exposed
+            blocks.attr("setflags")(py::arg("write") = false);
+            blocks_list.append(py::make_tuple(blocks, block_columns,
+                                              block_row_pointers));
+          }
+          py::list keys_list{};
+          for (const auto & key : all_keys) {
+            keys_list.append(py::cast(key));
+          }
+          return py::make_tuple(keys_list, blocks_list);
+        },
+        R"(Get read-only views of the features associated with the calculator
+        in a block sparse row (BSR) format. Returns the keys used as block
+        columns (the list of keys provided or the keys of the managers if
+        empty) and one tuple (blocks, block_columns, block_row_pointers) per
+        structure. The blocks [n_blocks, n_features_by_key] share the memory
+        of the features (no copy), block_columns gives the position of the
+        key of each block in the keys and block_row_pointers the first block
+        of each center. Only applicable when Calculator uses
+        BlockSparseProperty.)");
+    manager_collection.def(
+        "fill_features",
+        [](ManagerCollection_t & managers, const Calculator & calculator,
+           py::list & all_keys_l, Eigen::Ref<math::Matrix_t> features,
+           int n_threads) {
+          using Manager_t = typename ManagerCollection_t::Manager_t;
+          using Prop_t = typename Calculator::template Property_t<Manager_t>;
+          using Keys_t = typename Prop_t::Keys_t;
+          Keys_t all_keys;
+          if (all_keys_l.size() > 0) {
+            for (py::handle key_l : all_keys_l) {
+              auto key = py::cast<std::vector<int>>(key_l);
+              all_keys.insert(key);
+            }
+          } else {
+            for (auto key_l : managers.get_keys(calculator)) {
+              all_keys.insert(key_l);
+            }
+          }
+          py::gil_scoped_release release{};
+          managers.fill_features(calculator, features, all_keys, n_threads);
+        },
+        py::arg("calculator"), py::arg("keys"),
+        py::arg("features").noconvert(), py::arg("n_threads") = 1,
+        R"(Fill features, a preallocated C-contiguous float64 array of shape
+        (n_centers, n_features), with the features associated with the
+        calculator and the collection of structures (managers) using the list
+        of keys provided (or the keys of the managers if empty). The
+        structures are split among n_threads threads (0 uses the default of
+        OpenMP). Only applicable when Calculator uses BlockSparseProperty.)");
     manager_collection.def(
         "get_representation_info",
         [](ManagerCollection_t & managers) {
@@ -903,6 +1055,8 @@ namespace rascal {
                                ManagerCollection_t>(manager_collection);
     bind_feature_matrix_getter<CalculatorSphericalCovariants,
                                ManagerCollection_t>(manager_collection);
+    bind_feature_matrix_getter<CalculatorKspaceSphericalExpansion,
+                               ManagerCollection_t>(manager_collection);
     // bind some special getters
     bind_sparse_feature_matrix_getter<CalculatorSphericalExpansion,
                                       ManagerCollection_t>(manager_collection);
@@ -910,6 +1064,8 @@ namespace rascal {
                                       ManagerCollection_t>(manager_collection);
     bind_sparse_feature_matrix_getter<CalculatorSphericalCovariants,
                                       ManagerCollection_t>(manager_collection);
+    bind_sparse_feature_matrix_getter<CalculatorKspaceSphericalExpansion,
+                                      ManagerCollection_t>(manager_collection);
 
     constexpr static bool HasDistances{Manager_t::traits::HasDistances};
     constexpr static bool HasDirectionVectors{
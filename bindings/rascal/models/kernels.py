@@ -183,9 +183,20 @@ class Kernel(BaseIO):
 
 
 def compute_numerical_kernel_gradients(
-    kernel, calculator, managers, sparse_points, h_disp, compute_neg_stress=True
+    kernel,
+    calculator,
+    managers,
+    sparse_points,
+    h_disp,
+    compute_neg_stress=True,
+    local=False,
 ):
-    """This function is used for testing the numerical kernel gradient"""
+    """This function is used for testing the numerical kernel gradient
+
+    With local=True the displaced structures are computed in parallel with
+    the threads of the calculator and only the centers within the cutoff of
+    the displaced atom are recomputed.
+    """
     return _compute_numerical_kernel_gradients(
         kernel._kernel,
         calculator._representation,
@@ -193,4 +204,5 @@ def compute_numerical_kernel_gradients(
         sparse_points._sparse_points,
         h_disp,
         compute_neg_stress,
+        local,
     )
@@ -424,6 +424,38 @@ class KRR(BaseIO):
     def get_representation_calculator(self):
         return self.kernel._rep
 
+    def get_sparse_gpr_model(self):
+        """Serialize the model in the format read by the C++
+        SparseGPRPredictor, e.g. by the LAMMPS pair style (see
+        interfaces/lammps/README.rst)
+
+        Returns
+        -------
+        dict that can be written with rascal.utils.io.dump_json
+        """
+        if (
+            self.kernel.name != "GAP"
+            or "Sparse" not in self.kernel.kernel_type
+            or self.target_type != "Structure"
+        ):
+            raise ValueError(
+                "Only sparse GAP models of structure properties can be exported"
+            )
+        self_contributions = dict()
+        if self.self_contributions is not None:
+            self_contributions = {
+                str(int(sp)): float(energy)
+                for sp, energy in self.self_contributions.items()
+            }
+        return dict(
+            representation=self.kernel._rep.hypers,
+            sparse_points=self.X_train._sparse_points.to_dict(),
+            weights=[float(w) for w in self.weights],
+            zeta=int(self.kernel._kwargs["zeta"]),
+            self_contributions=self_contributions,
+            units=self.units.copy(),
+        )
+
 
 def _get_kernel_strides(frames):
     """Get strides for total-energy/gradient kernels of the given structures
@@ -3,6 +3,7 @@ from functools import reduce
 from operator import and_
 
 import numpy as np
+from scipy import sparse
 
 from ase.geometry import wrap_positions
 from ase import Atoms
@@ -114,7 +115,7 @@ class AtomsList(object):
         )
         return new_atom_list
 
-    def get_features(self, calculator, species=None):
+    def get_features(self, calculator, species=None, out=None, n_threads=1):
         """
         Parameters
         -------
@@ -123,11 +124,28 @@ class AtomsList(object):
         species :  list of atomic number to use for building the dense feature
         matrix computed with calculators of name Spherical*
 
+        out : ndarray of size (n_atoms, n_features), optional
+            C-contiguous float64 array that is filled in place instead of
+            allocating a new matrix. Only applicable to calculators of name
+            Spherical*.
+
+        n_threads : int
+            number of threads used to fill out, 0 uses the default of OpenMP
+
         Returns
         -------
         represenation_matrix : ndarray
             returns the representation bound to the calculator as dense matrix.
         """
+        if out is not None:
+            if species is None:
+                keys_list = []
+            else:
+                keys_list = calculator.get_keys(species)
+            self.managers.fill_features(
+                calculator._representation, keys_list, out, n_threads
+            )
+            return out
 
         if species is None:
             X = self.managers.get_features(calculator._representation)
@@ -137,6 +155,46 @@ class AtomsList(object):
 
         return X
 
+    def get_features_views(self, calculator, species=None):
+        """
+        Parameters
+        -------
+        calculator : one of the representation calculators named Spherical*
+
+        species :  list of atomic number to use for building the feature
+        matrices
+
+        Returns
+        -------
+        X_views : list of scipy.sparse.bsr_matrix of size (n_atom, n_features)
+            one matrix per structure in the block sparse row format with
+            blocks of size (1, n_features / n_keys). The blocks are read-only
+            views of the features computed by the calculator (no copy) and
+            only the keys present in the environment of each center are
+            stored. The matrices are valid as long as the features are not
+            recomputed.
+        """
+        if species is None:
+            keys_list = []
+        else:
+            keys_list = calculator.get_keys(species)
+        keys, blocks_by_structure = self.managers.get_features_block_sparse(
+            calculator._representation, keys_list
+        )
+
+        X_views = []
+        for blocks, columns, row_pointers in blocks_by_structure:
+            inner_size = blocks.shape[1]
+            X_views.append(
+                sparse.bsr_matrix(
+                    (blocks.reshape((-1, 1, inner_size)), columns, row_pointers),
+                    shape=(len(row_pointers) - 1, len(keys) * inner_size),
+                    blocksize=(1, inner_size),
+                    copy=False,
+                )
+            )
+        return X_views
+
     def get_features_gradient(self, calculator, species=None):
         """
         Parameters
@@ -165,6 +223,53 @@ class AtomsList(object):
 
         return X
 
+    def get_features_gradient_sparse(self, calculator, species=None):
+        """
+        Parameters
+        -------
+        calculator : Calculator (an object owning a _representation object)
+
+        species :  list of atomic number to use for building the feature
+        matrix computed with calculators of name Spherical*
+
+        Returns
+        -------
+        dX_dr : scipy.sparse.bsr_matrix of size (3*(n_neighbor+n_atom), n_features)
+            same matrix as `get_features_gradient` in the block sparse row
+            format with blocks of size (3, n_features / n_keys). Only the
+            blocks of the keys present in the environment of each pair are
+            stored. With a single structure the blocks share their memory with
+            the gradients computed by the calculator, otherwise they are
+            concatenated.
+        """
+        if species is None:
+            keys_list = []
+        else:
+            keys_list = calculator.get_keys(species)
+        keys, blocks_by_structure = self.managers.get_features_gradient_block_sparse(
+            calculator._representation, keys_list
+        )
+
+        inner_size = blocks_by_structure[0][0].shape[2]
+        if len(blocks_by_structure) == 1:
+            data, indices, indptr = blocks_by_structure[0]
+        else:
+            data = np.concatenate([blocks for blocks, _, _ in blocks_by_structure])
+            indices = np.concatenate([columns for _, columns, _ in blocks_by_structure])
+            indptr = [np.zeros(1, dtype=indices.dtype)]
+            n_blocks = 0
+            for _, _, row_pointers in blocks_by_structure:
+                indptr.append(row_pointers[1:] + n_blocks)
+                n_blocks += row_pointers[-1]
+            indptr = np.concatenate(indptr)
+        n_rows = 3 * (len(indptr) - 1)
+        return sparse.bsr_matrix(
+            (data, indices, indptr),
+            shape=(n_rows, len(keys) * inner_size),
+            blocksize=(3, inner_size),
+            copy=False,
+        )
+
     def get_features_by_species(self, calculator):
         """
         Parameters
@@ -15,6 +15,7 @@ _representations_list = [
     "sphericalexpansion",
     "sphericalinvariants",
     "sphericalcovariants",
+    "kspacesphericalexpansion",
 ]
 _representations = {}
 for k, v in representation_calculators.__dict__.items():
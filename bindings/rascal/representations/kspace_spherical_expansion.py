@@ -0,0 +1,186 @@
+from .base import CalculatorFactory
+from ..neighbourlist import AtomsList
+from ..utils import BaseIO
+
+
+class KspaceSphericalExpansion(BaseIO):
+    """
+    Computes the spherical expansion of the long range potential generated by
+    the smeared atomic densities of each species (LODE) [lode]
+
+    The potential is computed in reciprocal space from the structure factors
+    of the periodic structure, so that its cost scales like the number of
+    atoms times the number of k-vectors instead of the number of pairs of
+    atoms. Only fully periodic structures are supported.
+
+    Attributes
+    ----------
+    interaction_cutoff : float
+        Extent of the GTO radial basis, as in SphericalExpansion. It is also
+        the cutoff of the neighbour list built by transform().
+
+    max_radial : int
+        Number of radial basis functions
+
+    max_angular : int
+        Highest angular momentum number (l) in the expansion
+
+    gaussian_sigma_type : str
+        How the Gaussian atom sigmas (smearing widths) are allowed to
+        vary. Only fixed smearing width ('Constant') are implemented.
+
+    gaussian_sigma_constant : float
+        Specifies the atomic Gaussian widths, in the case where they're
+        fixed.
+
+    k_cutoff : float, default None
+        Radius of the sphere of k-vectors used to compute the potential.
+        Defaults to pi / gaussian_sigma_constant.
+
+    radial_basis :  string
+        Specifies the type of radial basis R_n to be computed. Only "GTO" is
+        implemented.
+
+    Methods
+    -------
+    transform(frames)
+        Compute the representation for a list of ase.Atoms object.
+
+
+    .. [lode] Grisafi, A., & Ceriotti, M. (2019). Incorporating long-range
+        physics in atomic-scale machine learning. The Journal of Chemical
+        Physics, 151(20), 204105. https://doi.org/10.1063/1.5128375
+
+    """
+
+    def __init__(
+        self,
+        interaction_cutoff,
+        max_radial,
+        max_angular,
+        gaussian_sigma_type="Constant",
+        gaussian_sigma_constant=0.3,
+        k_cutoff=None,
+        radial_basis="GTO",
+    ):
+        """Construct a KspaceSphericalExpansion representation
+
+        Required arguments are all the hyperparameters named in the
+        class documentation
+        """
+        self.name = "kspacesphericalexpansion"
+        self.hypers = dict()
+        self.update_hyperparameters(
+            max_radial=max_radial,
+            max_angular=max_angular,
+        )
+
+        cutoff_function = dict(cutoff=dict(value=interaction_cutoff, unit="AA"))
+        gaussian_density = dict(
+            type=gaussian_sigma_type,
+            gaussian_sigma=dict(value=gaussian_sigma_constant, unit="AA"),
+        )
+        radial_contribution = dict(type=radial_basis)
+
+        self.update_hyperparameters(
+            cutoff_function=cutoff_function,
+            gaussian_density=gaussian_density,
+            radial_contribution=radial_contribution,
+        )
+        if k_cutoff is not None:
+            self.update_hyperparameters(
+                k_cutoff=dict(value=k_cutoff, unit="AA^-1"),
+            )
+
+        self.nl_options = [
+            dict(name="centers", args=dict()),
+            dict(name="neighbourlist", args=dict(cutoff=interaction_cutoff)),
+            dict(name="centercontribution", args=dict()),
+            dict(name="strict", args=dict(cutoff=interaction_cutoff)),
+        ]
+
+        self.rep_options = dict(name=self.name, args=[self.hypers])
+
+        self._representation = CalculatorFactory(self.rep_options)
+
+    def update_hyperparameters(self, **hypers):
+        """Store the given dict of hyperparameters
+
+        Also updates the internal json-like representation
+
+        """
+        allowed_keys = {
+            "max_radial",
+            "max_angular",
+            "cutoff_function",
+            "gaussian_density",
+            "radial_contribution",
+            "k_cutoff",
+        }
+        hypers_clean = {key: hypers[key] for key in hypers if key in allowed_keys}
+        self.hypers.update(hypers_clean)
+        return
+
+    def transform(self, frames):
+        """Compute the representation.
+
+        Parameters
+        ----------
+        frames : list(ase.Atoms) or AtomsList
+            List of atomic structures.
+
+        Returns
+        -------
+           AtomsList : Object containing the representation
+
+        """
+        if not isinstance(frames, AtomsList):
+            frames = AtomsList(frames, self.nl_options)
+
+        self._representation.compute(frames.managers)
+        return frames
+
+    def get_num_coefficients(self, n_species=1):
+        """Return the number of coefficients in the spherical expansion
+
+        (this is the descriptor size per atomic centre)
+
+        """
+        return self._representation.get_num_coefficients(n_species)
+
+    def get_keys(self, species):
+        """
+        return the proper list of keys used to build the representation
+        """
+        keys = []
+        for sp in species:
+            keys.append([sp])
+        return keys
+
+    def _get_init_params(self):
+        gaussian_density = self.hypers["gaussian_density"]
+        cutoff_function = self.hypers["cutoff_function"]
+        radial_contribution = self.hypers["radial_contribution"]
+        k_cutoff = self.hypers.get("k_cutoff")
+
+        init_params = dict(
+            interaction_cutoff=cutoff_function["cutoff"]["value"],
+            max_radial=self.hypers["max_radial"],
+            max_angular=self.hypers["max_angular"],
+            gaussian_sigma_type=gaussian_density["type"],
+            gaussian_sigma_constant=gaussian_density["gaussian_sigma"]["value"],
+            k_cutoff=None if k_cutoff is None else k_cutoff["value"],
+            radial_basis=radial_contribution["type"],
+        )
+        return init_params
+
+    def _set_data(self, data):
+        super()._set_data(data)
+        self._representation = self._representation.from_dict(
+            data["cpp_representation"]
+        )
+
+    def _get_data(self):
+        data = super()._get_data()
+        data.update(cpp_representation=self._representation.to_dict())
+        return data
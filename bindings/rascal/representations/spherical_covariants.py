@@ -93,6 +93,10 @@ class SphericalCovariants(BaseIO):
     covariant_lambda : int
         Order of the lambda spectrum.
 
+    compute_gradients : bool
+        control the computation of the representation's gradients w.r.t. atomic
+        positions.
+
     cutoff_function_parameters : dict
         Additional parameters for the cutoff function.
         if cutoff_function_type == 'RadialScaling' then it should have the form
@@ -114,6 +118,12 @@ class SphericalCovariants(BaseIO):
             accuracy : float
                 accuracy of the cubic spline
 
+            fold_cutoff_function : bool, default False
+                tabulate the cutoff function together with the radial basis
+                so that a single spline lookup gives their product (and its
+                derivative). Not available with RadialDimReduction or for a
+                RadialScaling with a zero rate, which diverges at r = 0.
+
         RadialDimReduction: Projection matrices to optimize radial basis,
                             requires Spline to be set
 
@@ -161,6 +171,7 @@ class SphericalCovariants(BaseIO):
         soap_type="LambdaSpectrum",
         inversion_symmetry=True,
         covariant_lambda=0,
+        compute_gradients=False,
         cutoff_function_parameters=dict(),
     ):
         """Construct a SphericalExpansion representation
@@ -177,6 +188,7 @@ class SphericalCovariants(BaseIO):
             normalize=normalize,
             inversion_symmetry=inversion_symmetry,
             covariant_lambda=covariant_lambda,
+            compute_gradients=compute_gradients,
         )
 
         self.cutoff_function_parameters = deepcopy(cutoff_function_parameters)
@@ -240,6 +252,7 @@ class SphericalCovariants(BaseIO):
             "gaussian_density",
             "radial_contribution",
             "cutoff_function_parameters",
+            "compute_gradients",
         }
         hypers_clean = {key: hypers[key] for key in hypers if key in allowed_keys}
         self.hypers.update(hypers_clean)
@@ -368,6 +381,7 @@ class SphericalCovariants(BaseIO):
             gaussian_sigma_type=gaussian_density["type"],
             gaussian_sigma_constant=gaussian_density["gaussian_sigma"]["value"],
             lam=self.hypers["covariant_lambda"],
+            compute_gradients=self.hypers["compute_gradients"],
             cutoff_function_type=cutoff_function["type"],
             radial_basis=radial_contribution["type"],
             optimization=radial_contribution["optimization"],
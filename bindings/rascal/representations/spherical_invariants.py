@@ -117,6 +117,12 @@ class SphericalInvariants(BaseIO):
             accuracy : float
                 accuracy of the cubic spline
 
+            fold_cutoff_function : bool, default False
+                tabulate the cutoff function together with the radial basis
+                so that a single spline lookup gives their product (and its
+                derivative). Not available with RadialDimReduction or for a
+                RadialScaling with a zero rate, which diverges at r = 0.
+
         RadialDimReduction: Projection matrices to optimize radial basis,
                             requires Spline to be set
 
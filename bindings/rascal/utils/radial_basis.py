@@ -5,6 +5,8 @@ A collection of utility functions to manipulate the radial basis.
 from scipy.special import legendre, gamma
 from copy import deepcopy
 import numpy as np
+from ..lib._rascal.models import RadialBasisCovariance
+from ..neighbourlist import AtomsList
 from ..representations.spherical_expansion import SphericalExpansion
 
 
@@ -383,27 +385,22 @@ def get_optimal_radial_basis_hypers(hypers, frames, expanded_max_radial=-1):
 
     spex = SphericalExpansion(**spherical_expansion_hypers)
 
-    # computes density expansion coefficients and covariance (incrementally if needed)
+    # accumulates the covariance of the density expansion coefficients block
+    # by block, the coefficients of a block are dropped with its managers
     if not type(frames[0]) is list:
         frames = [frames]
-    feats = spex.transform(frames[0]).get_features_by_species(spex)
-    cov = get_radial_basis_covariance(spex, feats)
-    nframes = len(frames[0])
-
-    for fr in frames[1:]:
-        feats = spex.transform(fr).get_features_by_species(spex)
-        icov = get_radial_basis_covariance(spex, feats)
-        # bit perverse: both cov and icov are normalized, so we need to
-        # un-normalize before accumulating
-        for s in cov.keys():
-            cov[s] = (cov[s] * nframes + icov[s] * len(fr)) / (nframes + len(fr))
-        nframes += len(fr)
-
-    # principal components from the covariance
-    p_val, p_vec = get_radial_basis_pca(cov)
-
-    # converts to the format suitable for hypers
-    p_mat = get_radial_basis_projections(p_vec, hypers["max_radial"])
+    covariance = RadialBasisCovariance(expanded_max_radial, hypers["max_angular"])
+    for fr in frames:
+        managers = AtomsList(fr, spex.nl_options).managers
+        covariance.accumulate(spex._representation, managers)
+
+    # principal components of the covariance, formatted for the hypers
+    p_mat = {
+        species: [projection.tolist() for projection in projections]
+        for species, projections in covariance.get_projection_matrices(
+            hypers["max_radial"]
+        ).items()
+    }
 
     # assemble the updated hypers
     optimal_hypers = deepcopy(hypers)
@@ -0,0 +1,263 @@
+/**
+ * @file   interfaces/lammps/pair_rascal.cpp
+ *
+ * @author agent <agent@local>
+ *
+ * @date   17 October 2026
+ *
+ * @brief LAMMPS pair style evaluating a SOAP-GAP sparse GPR model of librascal
+ *
+ * Copyright  2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "pair_rascal.h"
+
+#include "atom.h"
+#include "error.h"
+#include "force.h"
+#include "memory.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+#include "update.h"
+
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/utils/json_io.hh"
+
+#include <cstring>
+#include <exception>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+PairRascal::PairRascal(LAMMPS * lmp) : Pair(lmp) {
+  this->single_enable = 0;
+  this->restartinfo = 0;
+  this->one_coeff = 1;
+  this->manybody_flag = 1;
+}
+
+/* ---------------------------------------------------------------------- */
+PairRascal::~PairRascal() {
+  if (this->allocated) {
+    this->memory->destroy(this->setflag);
+    this->memory->destroy(this->cutsq);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+void PairRascal::compute(int eflag, int vflag) {
+  this->ev_init(eflag, vflag);
+
+  double ** x{this->atom->x};
+  double ** f{this->atom->f};
+  const int * type{this->atom->type};
+  const int nlocal{this->atom->nlocal};
+  const int nall{nlocal + this->atom->nghost};
+
+  const int inum{this->list->inum};
+  const int * ilist{this->list->ilist};
+  const int * numneigh{this->list->numneigh};
+  int ** firstneigh{this->list->firstneigh};
+  if (inum != nlocal) {
+    this->error->all(FLERR, "Pair style rascal needs all the local atoms "
+                            "in the neighbour list");
+  }
+
+  // the manager indexes the neighbour list with the local atom index and the
+  // ghost atoms follow the local atoms
+  this->ilist_buffer.resize(nlocal);
+  this->numneigh_buffer.resize(nlocal);
+  this->firstneigh_buffer.resize(nlocal);
+  int n_neighbours{0};
+  for (int ii{0}; ii < inum; ++ii) {
+    n_neighbours += numneigh[ilist[ii]];
+  }
+  this->neighbours_buffer.resize(n_neighbours);
+  int offset{0};
+  for (int ii{0}; ii < inum; ++ii) {
+    const int i{ilist[ii]};
+    this->ilist_buffer[i] = i;
+    this->numneigh_buffer[i] = numneigh[i];
+    this->firstneigh_buffer[i] = &this->neighbours_buffer[offset];
+    for (int jj{0}; jj < numneigh[i]; ++jj) {
+      this->neighbours_buffer[offset] = firstneigh[i][jj] & NEIGHMASK;
+      ++offset;
+    }
+  }
+  this->atomic_numbers.resize(nall);
+  for (int i{0}; i < nall; ++i) {
+    this->atomic_numbers[i] = this->type_to_atomic_number[type[i]];
+  }
+
+  // the virial of each pair is W_ij = r_ji \otimes dE_i/dr_j, it is split
+  // between i and j for the virial per atom
+  auto tally_virial = [this](const int i, const int j, const double * r_ji,
+                             const double * g_ij) {
+    const double w_ij[6]{r_ji[0] * g_ij[0], r_ji[1] * g_ij[1],
+                         r_ji[2] * g_ij[2], r_ji[0] * g_ij[1],
+                         r_ji[0] * g_ij[2], r_ji[1] * g_ij[2]};
+    for (int k{0}; k < 6; ++k) {
+      if (this->vflag_global and not this->vflag_fdotr) {
+        this->virial[k] += w_ij[k];
+      }
+      if (this->vflag_atom) {
+        this->vatom[i][k] += 0.5 * w_ij[k];
+        this->vatom[j][k] += 0.5 * w_ij[k];
+      }
+    }
+  };
+
+  try {
+    this->manager->update(nlocal, nall, this->ilist_buffer.data(),
+                          this->numneigh_buffer.data(),
+                          this->firstneigh_buffer.data(), x, f,
+                          this->atomic_numbers.data(), nullptr, nullptr);
+    this->predictor->predict_contributions(
+        this->manager,
+        [this](auto & center, double energy) {
+          if (this->eflag_global) {
+            this->eng_vdwl += energy;
+          }
+          if (this->eflag_atom) {
+            this->eatom[center.get_atom_tag()] += energy;
+          }
+        },
+        [this, x, f, &tally_virial](auto & center,
+                                    const auto & pair_gradients) {
+          const int i{center.get_atom_tag()};
+          int i_neigh{0};
+          for (auto neigh : center.pairs_with_self_pair()) {
+            const int j{neigh.get_atom_j().get_atom_tag()};
+            double g_ij[3];
+            double r_ji[3];
+            for (int k{0}; k < 3; ++k) {
+              g_ij[k] = pair_gradients(i_neigh, k);
+              r_ji[k] = x[i][k] - x[j][k];
+              f[j][k] -= g_ij[k];
+            }
+            if (this->vflag_either) {
+              tally_virial(i, j, r_ji, g_ij);
+            }
+            ++i_neigh;
+          }
+        });
+  } catch (const std::exception & e) {
+    this->error->one(FLERR, e.what());
+  }
+
+  if (this->vflag_fdotr) {
+    this->virial_fdotr_compute();
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+void PairRascal::allocate() {
+  this->allocated = 1;
+  const int n{this->atom->ntypes};
+  this->memory->create(this->setflag, n + 1, n + 1, "pair:setflag");
+  this->memory->create(this->cutsq, n + 1, n + 1, "pair:cutsq");
+  for (int i{1}; i <= n; ++i) {
+    for (int j{i}; j <= n; ++j) {
+      this->setflag[i][j] = 0;
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+void PairRascal::settings(int narg, char ** arg) {
+  if (narg > 1) {
+    this->error->all(FLERR, "Illegal pair_style rascal command");
+  }
+  if (narg == 0 or std::strcmp(arg[0], "forward") == 0) {
+    this->gradient_mode = Predictor_t::GradientMode::Forward;
+  } else if (std::strcmp(arg[0], "adjoint") == 0) {
+    this->gradient_mode = Predictor_t::GradientMode::Adjoint;
+  } else {
+    this->error->all(FLERR, "Pair style rascal only accepts the keywords "
+                            "forward and adjoint");
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+void PairRascal::coeff(int narg, char ** arg) {
+  const int ntypes{this->atom->ntypes};
+  if (narg != 3 + ntypes) {
+    this->error->all(FLERR, "Incorrect args for pair coefficients, expected "
+                            "* * model.json followed by the atomic number "
+                            "of each atom type");
+  }
+  if (std::strcmp(arg[0], "*") != 0 or std::strcmp(arg[1], "*") != 0) {
+    this->error->all(FLERR, "Incorrect args for pair coefficients");
+  }
+  if (not this->allocated) {
+    this->allocate();
+  }
+
+  this->type_to_atomic_number.assign(ntypes + 1, 0);
+  for (int i{1}; i <= ntypes; ++i) {
+    this->type_to_atomic_number[i] =
+        utils::inumeric(FLERR, arg[2 + i], false, this->lmp);
+  }
+
+  try {
+    json model = rascal::json_io::load(arg[2]);
+    this->cutoff = model.at("representation")
+                       .at("cutoff_function")
+                       .at("cutoff")
+                       .at("value")
+                       .get<double>();
+    this->predictor = std::make_unique<Predictor_t>(
+        Predictor_t::from_json(model, this->gradient_mode));
+  } catch (const std::exception & e) {
+    this->error->all(FLERR, "Could not load the rascal model {}: {}", arg[2],
+                     e.what());
+  }
+  // the neighbour list of lammps has the skin, AdaptorStrict removes the
+  // neighbours beyond the cutoff of the model
+  auto manager_root{rascal::make_structure_manager<ManagerRoot_t>()};
+  auto manager_center{
+      rascal::make_adapted_manager<rascal::AdaptorCenterContribution>(
+          manager_root)};
+  this->manager = rascal::make_adapted_manager<rascal::AdaptorStrict>(
+      manager_center, this->cutoff);
+
+  for (int i{1}; i <= ntypes; ++i) {
+    for (int j{i}; j <= ntypes; ++j) {
+      this->setflag[i][j] = 1;
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+void PairRascal::init_style() {
+  if (this->force->newton_pair == 0) {
+    this->error->all(FLERR, "Pair style rascal requires newton pair on");
+  }
+  if (std::strcmp(this->update->unit_style, "metal") != 0) {
+    this->error->all(FLERR, "Pair style rascal requires metal units, i.e. "
+                            "the eV and AA of the model");
+  }
+  this->neighbor->add_request(this, NeighConst::REQ_FULL);
+}
+
+/* ---------------------------------------------------------------------- */
+double PairRascal::init_one(int i, int j) {
+  if (this->setflag[i][j] == 0) {
+    this->error->all(FLERR, "All pair coeffs are not set");
+  }
+  return this->cutoff;
+}
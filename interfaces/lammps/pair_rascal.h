@@ -0,0 +1,102 @@
+/**
+ * @file   interfaces/lammps/pair_rascal.h
+ *
+ * @author agent <agent@local>
+ *
+ * @date   17 October 2026
+ *
+ * @brief LAMMPS pair style evaluating a SOAP-GAP sparse GPR model of librascal
+ *
+ * Copyright  2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef INTERFACES_LAMMPS_PAIR_RASCAL_H_
+#define INTERFACES_LAMMPS_PAIR_RASCAL_H_
+
+#include "pair.h"
+
+#include "rascal/models/sparse_kernel_predict.hh"
+#include "rascal/representations/calculator_spherical_invariants.hh"
+#include "rascal/structure_managers/adaptor_center_contribution.hh"
+#include "rascal/structure_managers/adaptor_strict.hh"
+#include "rascal/structure_managers/structure_manager_lammps.hh"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+  /**
+   * pair_style rascal [forward|adjoint]
+   * pair_coeff * * model.json Z_1 ... Z_ntypes
+   *
+   * Evaluates the energy, the forces and the virial of a sparse GPR model
+   * exported with rascal.models.KRR.get_sparse_gpr_model(). The atomic
+   * number of each lammps atom type is given in pair_coeff. The keyword of
+   * pair_style selects how the forces are computed, see
+   * SparseGPRPredictor::GradientMode.
+   *
+   * The atomic environments are many body so the style asks for a full
+   * neighbour list: the neighbours of a local atom include all the ghost
+   * atoms within the cutoff and the forces on the ghost atoms are sent back
+   * to the process owning them by the reverse communication of lammps,
+   * hence newton pair has to be on.
+   */
+  class PairRascal : public Pair {
+   public:
+    using ManagerRoot_t = rascal::StructureManagerLammpsFull;
+    using Manager_t = rascal::AdaptorStrict<
+        rascal::AdaptorCenterContribution<ManagerRoot_t>>;
+    using Calculator_t = rascal::CalculatorSphericalInvariants;
+    using Predictor_t = rascal::SparseGPRPredictor<Calculator_t>;
+
+    explicit PairRascal(class LAMMPS *);
+    ~PairRascal() override;
+
+    void compute(int, int) override;
+    void settings(int, char **) override;
+    void coeff(int, char **) override;
+    void init_style() override;
+    double init_one(int, int) override;
+
+   protected:
+    void allocate();
+
+    Predictor_t::GradientMode gradient_mode{Predictor_t::GradientMode::Forward};
+    std::unique_ptr<Predictor_t> predictor{};
+    std::shared_ptr<Manager_t> manager{};
+    //! cutoff of the representation
+    double cutoff{0.};
+    //! atomic number of each lammps atom type, 1-based like the types
+    std::vector<int> type_to_atomic_number{};
+
+    /**
+     * the neighbour list of lammps is copied without the special bonds bits
+     * and indexed by the local atom index
+     */
+    std::vector<int> ilist_buffer{};
+    std::vector<int> numneigh_buffer{};
+    std::vector<int> neighbours_buffer{};
+    std::vector<int *> firstneigh_buffer{};
+    //! atomic numbers of the local and ghost atoms
+    std::vector<int> atomic_numbers{};
+  };
+
+}  // namespace LAMMPS_NS
+
+#endif  // INTERFACES_LAMMPS_PAIR_RASCAL_H_
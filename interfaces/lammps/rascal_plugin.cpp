@@ -0,0 +1,48 @@
+/**
+ * @file   interfaces/lammps/rascal_plugin.cpp
+ *
+ * @author agent <agent@local>
+ *
+ * @date   17 October 2026
+ *
+ * @brief Registers pair_style rascal when the plugin is loaded by lammps
+ *
+ * Copyright  2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "lammpsplugin.h"
+#include "version.h"
+
+#include "pair_rascal.h"
+
+using namespace LAMMPS_NS;
+
+static Pair * rascal_creator(LAMMPS * lmp) { return new PairRascal(lmp); }
+
+extern "C" void lammpsplugin_init(void * lmp, void * handle, void * regfunc) {
+  auto register_plugin{reinterpret_cast<lammpsplugin_regfunc>(regfunc)};
+  lammpsplugin_t plugin{};
+  plugin.version = LAMMPS_VERSION;
+  plugin.style = "pair";
+  plugin.name = "rascal";
+  plugin.info = "librascal sparse GPR models of the SOAP";
+  plugin.author = "librascal developers";
+  plugin.creator.v1 =
+      reinterpret_cast<lammpsplugin_factory1 *>(&rascal_creator);
+  plugin.handle = handle;
+  (*register_plugin)(&plugin, lmp);
+}
@@ -26,6 +26,9 @@
 
 #include "benchmark_interpolator.hh"
 
+#include <algorithm>
+#include <chrono>
+
 namespace rascal {
   /**
    * To compare the benchmark results with the chrono library, these benchmarks
@@ -134,6 +137,50 @@ namespace rascal {
          {"grid_size", grid_size}});
   }
 
+  /**
+   * Benchmark for RadialContribution with the interpolator evaluated on a
+   * batch of pairs into a preallocated matrix, as done for the neighbours of
+   * a center. The time per (pair x nl) entry is reported in ns_per_pair_nl.
+   */
+  template <class BFixture>
+  void bm_radial_contr_intp_batch(benchmark::State & state, BFixture & fix,
+                                  bool single_precision) {
+    fix.setup(state);
+    fix.intp->set_single_precision_table(single_precision);
+    const int matrix_size{fix.intp->get_matrix_size()};
+    const Vector_t distances{fix.ref_points.head(fix.nb_iterations)};
+    Matrix_t values(distances.size(), matrix_size);
+    double elapsed_ns{0.};
+    for (auto _ : state) {
+      auto start = std::chrono::high_resolution_clock::now();
+      fix.intp->interpolate_to_matrix(distances, values);
+      benchmark::DoNotOptimize(values.data());
+      benchmark::ClobberMemory();
+      auto finish = std::chrono::high_resolution_clock::now();
+      elapsed_ns +=
+          std::chrono::duration<double, std::nano>(finish - start).count();
+    }
+    state.SetComplexityN(fix.nb_iterations);
+    // deviation from the double precision table
+    fix.intp->set_single_precision_table(false);
+    Matrix_t reference_values(distances.size(), matrix_size);
+    fix.intp->interpolate_to_matrix(distances, reference_values);
+    const double max_table_error{
+        (values - reference_values).array().abs().maxCoeff()};
+
+    state.counters.insert(
+        {{"nb_iterations", fix.nb_iterations},
+         {"max_radial", fix.max_radial},
+         {"max_angular", fix.max_angular},
+         {"log(error_bound)", fix.log_error_bound},
+         {"log(max_table_error)",
+          std::log10(std::max(max_table_error, 1e-300))},
+         {"grid_size", fix.intp->get_grid_size()},
+         {"ns_per_pair_nl",
+          elapsed_ns / (static_cast<double>(state.iterations()) *
+                        distances.size() * matrix_size)}});
+  }
+
   // Benchmark for SphericalExpansion with or without the interpolator
   template <class BFixture>
   void bm_spherical(benchmark::State & state, BFixture & fix) {
@@ -171,6 +218,21 @@ namespace rascal {
       ->Apply(all_combinations_of_arguments<RadialContributionDataset>)
       ->Complexity();
 
+  /**
+   * Batched RadialContribution for the matrix interpolator with the double
+   * and the single precision coefficient tables
+   */
+  auto intp_mat_batch_fix{
+      InterpolatorMatrixBFixture<RadialContributionBatchDataset>()};
+  BENCHMARK_CAPTURE(bm_radial_contr_intp_batch, double_table,
+                    intp_mat_batch_fix, false)
+      ->Apply(all_combinations_of_arguments<RadialContributionBatchDataset>)
+      ->Complexity();
+  BENCHMARK_CAPTURE(bm_radial_contr_intp_batch, single_table,
+                    intp_mat_batch_fix, true)
+      ->Apply(all_combinations_of_arguments<RadialContributionBatchDataset>)
+      ->Complexity();
+
   /**
    * Spherical Expansion without gradient benchmarks
    */
@@ -189,6 +189,26 @@ namespace rascal {
     }
   };
 
+  /**
+   * RadialContributionBatchDataset, the interpolator is evaluated on batches
+   * of nbs_iterations pair distances with the sizes of production hypers
+   */
+  struct RadialContributionBatchDataset : public BaseInterpolatorDataset {
+    using SupportedFunc = typename BaseInterpolatorDataset::SupportedFunc;
+    static const json data() {
+      static const json data = {
+          {"nbs_iterations", {1e2, 1e3}},
+          {"ranges", {std::make_pair(0, 5)}},
+          {"log_error_bounds", {-8, -10}},
+          {"func_names", {SupportedVecFunc::RadialContribution}},
+          {"radial_angular",
+           {std::make_pair(6, 6), std::make_pair(8, 6),
+            std::make_pair(12, 9)}},
+          {"random", {true}}};
+      return data;
+    }
+  };
+
   struct Hyp1f1Dataset : public BaseInterpolatorDataset {
     using SupportedFunc = typename BaseInterpolatorDataset::SupportedFunc;
     static const json data() {
@@ -0,0 +1,228 @@
+/**
+ * @file  performance/benchmarks/benchmark_sparse_gpr_predictor.cc
+ *
+ * @author agent <agent@local>
+ *
+ * @date   17 October 2026
+ *
+ * @brief benchmarks of the energy, forces and virial prediction of a sparse
+ *        GPR model on a box of liquid water, i.e. the cost of one MD step
+ *
+ * Copyright  2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "benchmarks.hh"
+
+#include "rascal/models/sparse_kernel_predict.hh"
+#include "rascal/models/sparse_points.hh"
+#include "rascal/representations/calculator_spherical_invariants.hh"
+#include "rascal/structure_managers/adaptor_center_contribution.hh"
+#include "rascal/structure_managers/adaptor_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_strict.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/structure_managers/structure_manager_centers.hh"
+
+#include <cmath>
+#include <random>
+
+namespace rascal {
+
+  /**
+   * Periodic box of liquid water, n_side^3 randomly oriented molecules on a
+   * cubic lattice at the density of 1 g/cm^3, with a sparse GPR model whose
+   * sparse points are taken from the box. The default gives 1029 atoms.
+   */
+  class WaterBoxBFixture {
+   public:
+    using Calculator_t = CalculatorSphericalInvariants;
+    using Manager_t = AdaptorStrict<AdaptorCenterContribution<
+        AdaptorNeighbourList<StructureManagerCenters>>>;
+    using SparsePoints_t = SparsePointsBlockSparse<Calculator_t>;
+
+    explicit WaterBoxBFixture(const int n_side = 7) {
+      // volume of one molecule at 1 g/cm^3 in AA^3
+      const double lattice_constant{std::cbrt(29.915)};
+      const double oh_distance{0.9572};
+      const double hoh_angle{104.52 * math::PI / 180.};
+      const int n_atoms{3 * n_side * n_side * n_side};
+      std::mt19937 generator{0};
+      std::normal_distribution<double> normal{0., 1.};
+      auto random_direction = [&generator, &normal]() {
+        Eigen::Vector3d direction{normal(generator), normal(generator),
+                                  normal(generator)};
+        return Eigen::Vector3d(direction.normalized());
+      };
+
+      Eigen::Matrix<double, 3, Eigen::Dynamic> positions(3, n_atoms);
+      Eigen::VectorXi atom_types(n_atoms);
+      int i_atom{0};
+      for (int i_x{0}; i_x < n_side; ++i_x) {
+        for (int i_y{0}; i_y < n_side; ++i_y) {
+          for (int i_z{0}; i_z < n_side; ++i_z) {
+            Eigen::Vector3d r_o{Eigen::Vector3d(i_x, i_y, i_z) *
+                                lattice_constant};
+            Eigen::Vector3d u{random_direction()};
+            Eigen::Vector3d v{random_direction()};
+            v = (v - v.dot(u) * u).normalized();
+            positions.col(i_atom) = r_o;
+            positions.col(i_atom + 1) = r_o + oh_distance * u;
+            positions.col(i_atom + 2) =
+                r_o + oh_distance * (std::cos(hoh_angle) * u +
+                                     std::sin(hoh_angle) * v);
+            atom_types.segment(i_atom, 3) << 8, 1, 1;
+            i_atom += 3;
+          }
+        }
+      }
+      this->box_length = n_side * lattice_constant;
+      this->wrap(positions);
+      Eigen::Matrix3d cell{Eigen::Matrix3d::Identity() * this->box_length};
+      this->structure.set_structure(positions, atom_types, cell,
+                                    Eigen::Vector3i::Ones());
+
+      json fc_hypers{{"type", "ShiftedCosine"},
+                     {"cutoff", {{"value", this->cutoff}, {"unit", "AA"}}},
+                     {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}};
+      json sigma_hypers{{"type", "Constant"},
+                        {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}};
+      this->hypers = {{"max_radial", 4},
+                      {"max_angular", 3},
+                      {"soap_type", "PowerSpectrum"},
+                      {"normalize", true},
+                      {"compute_gradients", false},
+                      {"cutoff_function", fc_hypers},
+                      {"gaussian_density", sigma_hypers},
+                      {"radial_contribution",
+                       {{"type", "GTO"},
+                        {"optimization",
+                         {{"type", "Spline"}, {"accuracy", 1e-8}}}}}};
+
+      // every n_stride-th molecule gives one O and one H sparse point
+      auto manager{this->make_manager()};
+      Calculator_t calculator{this->hypers};
+      calculator.compute(manager);
+      std::vector<int> selected_ids{};
+      const int n_stride{3};
+      for (int i_molecule{0}; i_molecule < n_atoms / 3;
+           i_molecule += n_stride) {
+        selected_ids.push_back(3 * i_molecule);
+        selected_ids.push_back(3 * i_molecule + 1);
+      }
+      this->sparse_points.push_back(calculator, manager, selected_ids);
+      this->weights = math::Vector_t::Random(this->sparse_points.size());
+      this->n_pairs = manager->get_nb_clusters(2);
+    }
+
+    //! wrap positions inside the cell
+    void wrap(Eigen::Ref<Eigen::Matrix<double, 3, Eigen::Dynamic>> positions)
+        const {
+      positions = positions.unaryExpr([this](double x) {
+        return x - this->box_length * std::floor(x / this->box_length);
+      });
+    }
+
+    std::shared_ptr<Manager_t> make_manager() const {
+      json adaptors{};
+      adaptors.emplace_back(
+          json{{"name", "AdaptorNeighbourList"},
+               {"initialization_arguments", {{"cutoff", this->cutoff}}}});
+      adaptors.emplace_back(json{{"name", "AdaptorCenterContribution"},
+                                 {"initialization_arguments", {}}});
+      adaptors.emplace_back(
+          json{{"name", "AdaptorStrict"},
+               {"initialization_arguments", {{"cutoff", this->cutoff}}}});
+      auto manager = make_structure_manager_stack<
+          StructureManagerCenters, AdaptorNeighbourList,
+          AdaptorCenterContribution, AdaptorStrict>(json{}, adaptors);
+      manager->update(this->structure);
+      return manager;
+    }
+
+    double cutoff{4.};
+    double box_length{0.};
+    AtomicStructure<3> structure{};
+    json hypers{};
+    SparsePoints_t sparse_points{};
+    math::Vector_t weights{};
+    size_t zeta{2};
+    size_t n_pairs{0};
+  };
+
+  //! the water box is shared by all the benchmarks
+  const WaterBoxBFixture & get_water_box() {
+    static const WaterBoxBFixture fix{};
+    return fix;
+  }
+
+  /**
+   * One MD step of the predictor: the positions are updated, the neighbour
+   * list and the representation recomputed and the energy, the forces and
+   * the virial predicted. Only the rattling of the positions is not timed.
+   * The forces are computed with GradientMode::Adjoint if state.range(0).
+   */
+  template <typename Precision>
+  void bm_sparse_gpr_predict(benchmark::State & state) {
+    using Predictor_t =
+        SparseGPRPredictor<WaterBoxBFixture::Calculator_t, Precision>;
+    using SparsePoints_t = typename Predictor_t::SparsePoints_t;
+    using GradientMode = typename Predictor_t::GradientMode;
+    const auto & fix{get_water_box()};
+
+    Predictor_t predictor{
+        fix.hypers,
+        SparsePoints_t{fix.sparse_points},
+        fix.weights,
+        fix.zeta,
+        {{1, -0.5}, {8, -1.}},
+        state.range(0) ? GradientMode::Adjoint : GradientMode::Forward};
+    auto manager{fix.make_manager()};
+    AtomicStructure<3> structure{fix.structure};
+    const auto n_atoms{structure.positions.cols()};
+    std::mt19937 generator{0};
+    std::uniform_real_distribution<double> rattle{-0.01, 0.01};
+    for (auto _ : state) {
+      state.PauseTiming();
+      structure.positions = fix.structure.positions.unaryExpr(
+          [&rattle, &generator](double x) { return x + rattle(generator); });
+      fix.wrap(structure.positions);
+      state.ResumeTiming();
+      manager->update(structure);
+      auto prediction{predictor.predict(manager)};
+      benchmark::DoNotOptimize(prediction.forces.data());
+    }
+    state.counters.insert(
+        {{"nb_atoms", n_atoms},
+         {"nb_pairs", fix.n_pairs},
+         {"nb_sparse_points", fix.sparse_points.size()},
+         {"atoms_per_second",
+          benchmark::Counter(n_atoms,
+                             benchmark::Counter::kIsIterationInvariantRate)}});
+  }
+
+  BENCHMARK_TEMPLATE(bm_sparse_gpr_predict, double)
+      ->ArgName("adjoint")
+      ->Arg(0)
+      ->Arg(1)
+      ->Unit(benchmark::kMillisecond);
+  BENCHMARK_TEMPLATE(bm_sparse_gpr_predict, float)
+      ->ArgName("adjoint")
+      ->Arg(0)
+      ->Unit(benchmark::kMillisecond);
+
+}  // namespace rascal
+
+BENCHMARK_MAIN();
@@ -0,0 +1,130 @@
+/**
+ * @file   performance/profiles/profile_neighbour_list.cc
+ *
+ * @author agent <agent@local>
+ *
+ * @date   16 October 2026
+ *
+ * @brief Compare the cost of rebuilding the neighbour list at every step of a
+ * perturbed trajectory with the cost of reusing it thanks to a Verlet skin
+ *
+ * Copyright  2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "rascal/structure_managers/adaptor_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_strict.hh"
+#include "rascal/structure_managers/atomic_structure.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/structure_managers/structure_manager_centers.hh"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// using namespace std;
+using namespace rascal;  // NOLINT
+
+constexpr size_t N_STEPS{200};
+
+/**
+ * random displacement of every atom, the displacements that would bring an
+ * atom out of the cell are skipped since wrapping it back would trigger a
+ * rebuild of the neighbour list
+ */
+void perturb(AtomicStructure<3> & structure, double amplitude,
+             std::mt19937 & generator) {
+  std::uniform_real_distribution<double> distribution(-amplitude, amplitude);
+  Eigen::Matrix3d cell_inv{structure.cell.inverse()};
+  for (size_t i_atom{0}; i_atom < structure.get_number_of_atoms(); ++i_atom) {
+    Eigen::Vector3d disp{distribution(generator), distribution(generator),
+                         distribution(generator)};
+    Eigen::Vector3d scaled{cell_inv *
+                           (structure.positions.col(i_atom) + disp)};
+    if ((scaled.array() > 0.).all() and (scaled.array() < 1.).all()) {
+      structure.displace_position(i_atom, disp);
+    }
+  }
+}
+
+int main(int argc, char * argv[]) {
+  if (argc < 2) {
+    std::cerr << "Must provide atomic structure json filename as argument";
+    std::cerr << std::endl;
+    return -1;
+  }
+
+  std::string filename{argv[1]};
+
+  double cutoff{5.};
+  // typical displacement of an atom during one MD step
+  double amplitude{0.01};
+  std::vector<double> skins{0., 0.3, 0.5, 1.};
+
+  AtomicStructure<3> initial_structure{};
+  initial_structure.set_structure(filename);
+
+  std::cout << "structure filename: " << filename << std::endl;
+  std::cout << "number of atoms: " << initial_structure.get_number_of_atoms()
+            << std::endl;
+
+  double elapsed_no_skin{0.};
+  for (auto && skin : skins) {
+    json structure{{"filename", filename}};
+    json adaptors;
+    json ad1{{"name", "AdaptorNeighbourList"},
+             {"initialization_arguments", {{"cutoff", cutoff}, {"skin", skin}}}};
+    json ad2{{"name", "AdaptorStrict"},
+             {"initialization_arguments", {{"cutoff", cutoff}}}};
+    adaptors.emplace_back(ad1);
+    adaptors.emplace_back(ad2);
+    auto manager =
+        make_structure_manager_stack<StructureManagerCenters,
+                                     AdaptorNeighbourList, AdaptorStrict>(
+            structure, adaptors);
+
+    // same trajectory for every skin
+    std::mt19937 generator{10};
+    AtomicStructure<3> ast{initial_structure};
+    std::vector<AtomicStructure<3>> trajectory{};
+    for (size_t i_step{0}; i_step < N_STEPS; i_step++) {
+      perturb(ast, amplitude, generator);
+      trajectory.push_back(ast);
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    // This is the part that should get profiled
+    for (auto && frame : trajectory) {
+      manager->update(frame);
+    }
+    auto finish = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = finish - start;
+
+    auto n_update{extract_underlying_manager<1>(manager)->get_n_update()};
+    if (skin == 0.) {
+      elapsed_no_skin = elapsed.count();
+    }
+    std::cout << "skin " << skin << " rebuilds: " << n_update - 1 << "/"
+              << N_STEPS << " elapsed: " << elapsed.count() / N_STEPS
+              << " seconds per step";
+    if (elapsed_no_skin > 0.) {
+      std::cout << " speedup: " << elapsed_no_skin / elapsed.count();
+    }
+    std::cout << std::endl;
+  }
+}
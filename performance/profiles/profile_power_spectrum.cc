@@ -0,0 +1,136 @@
+/**
+ * @file   performance/profiles/profile_power_spectrum.cc
+ *
+ * @author agent <agent@local>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  Compare the Loop and GEMM products of the PowerSpectrum
+ *
+ * Copyright © 2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "rascal/representations/calculator_spherical_expansion.hh"
+#include "rascal/representations/calculator_spherical_invariants.hh"
+#include "rascal/structure_managers/adaptor_center_contribution.hh"
+#include "rascal/structure_managers/adaptor_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_strict.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/structure_managers/structure_manager_centers.hh"
+#include "rascal/utils/basic_types.hh"
+#include "rascal/utils/utils.hh"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace rascal;  // NOLINT
+
+const int N_ITERATIONS = 5;
+
+/**
+ * Average time of N_ITERATIONS computations of the representation
+ */
+template <class Calculator, class Manager>
+double time_compute(Calculator & calculator, Manager & manager) {
+  // warm up the calculator, e.g. the splines of the radial integral
+  calculator.compute(manager);
+  auto start = std::chrono::high_resolution_clock::now();
+  for (size_t looper{0}; looper < N_ITERATIONS; looper++) {
+    calculator.compute(manager);
+  }
+  auto finish = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double> elapsed = finish - start;
+  return elapsed.count() / N_ITERATIONS;
+}
+
+int main(int argc, char * argv[]) {
+  if (argc < 2) {
+    std::cerr << "Must provide atomic structure json filename as argument";
+    std::cerr << std::endl;
+    return -1;
+  }
+
+  std::string filename{argv[1]};
+
+  double cutoff{5.};
+  json fc_hypers{{"type", "ShiftedCosine"},
+                 {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+                 {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}};
+  json sigma_hypers{{"type", "Constant"},
+                    {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}};
+
+  json structure{{"filename", filename}};
+  json adaptors;
+  json ad1{{"name", "AdaptorNeighbourList"},
+           {"initialization_arguments", {{"cutoff", cutoff}}}};
+  json ad1b{{"name", "AdaptorCenterContribution"},
+            {"initialization_arguments", {}}};
+  json ad2{{"name", "AdaptorStrict"},
+           {"initialization_arguments", {{"cutoff", cutoff}}}};
+  adaptors.emplace_back(ad1);
+  adaptors.emplace_back(ad1b);
+  adaptors.emplace_back(ad2);
+  auto manager =
+      make_structure_manager_stack<StructureManagerCenters,
+                                   AdaptorNeighbourList,
+                                   AdaptorCenterContribution, AdaptorStrict>(
+          structure, adaptors);
+
+  std::cout << "structure filename: " << filename << std::endl;
+
+  // (max_radial, max_angular)
+  std::vector<std::pair<int, int>> basis_sizes{{4, 3}, {6, 4}, {8, 6},
+                                               {10, 8}, {12, 9}};
+
+  for (bool compute_gradients : {false, true}) {
+    for (const auto & basis_size : basis_sizes) {
+      json hypers{{"max_radial", basis_size.first},
+                  {"max_angular", basis_size.second},
+                  {"soap_type", "PowerSpectrum"},
+                  {"normalize", true},
+                  {"compute_gradients", compute_gradients}};
+      hypers["cutoff_function"] = fc_hypers;
+      hypers["gaussian_density"] = sigma_hypers;
+      hypers["radial_contribution"] = {{"type", "GTO"}};
+
+      // the PowerSpectrum also computes the expansion so its cost is
+      // removed to compare the products only
+      CalculatorSphericalExpansion expansion{hypers};
+      double elapsed_expansion{time_compute(expansion, manager)};
+
+      hypers["powerspectrum_product"] = "Loop";
+      CalculatorSphericalInvariants soap_loop{hypers};
+      double elapsed_loop{time_compute(soap_loop, manager) -
+                          elapsed_expansion};
+
+      hypers["powerspectrum_product"] = "GEMM";
+      CalculatorSphericalInvariants soap_gemm{hypers};
+      double elapsed_gemm{time_compute(soap_gemm, manager) -
+                          elapsed_expansion};
+
+      std::cout << "max_radial " << basis_size.first << " max_angular "
+                << basis_size.second << " gradients " << compute_gradients
+                << " | expansion: " << elapsed_expansion
+                << " s, Loop product: " << elapsed_loop
+                << " s, GEMM product: " << elapsed_gemm
+                << " s, speedup: " << elapsed_loop / elapsed_gemm << std::endl;
+    }
+  }
+}
@@ -0,0 +1,185 @@
+/**
+ * @file   performance/profiles/profile_sparse_kernel.cc
+ *
+ * @author agent <agent@local>
+ *
+ * @date   17 October 2026
+ *
+ * @brief  Profile the construction of K_{NM} of the GAP sparse kernel by
+ *         batches of centers against the center by center construction
+ *
+ * Copyright © 2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "rascal/models/sparse_kernels.hh"
+#include "rascal/models/sparse_points.hh"
+#include "rascal/representations/calculator_spherical_invariants.hh"
+#include "rascal/structure_managers/adaptor_center_contribution.hh"
+#include "rascal/structure_managers/adaptor_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_strict.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/structure_managers/structure_manager_centers.hh"
+#include "rascal/structure_managers/structure_manager_collection.hh"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace rascal;  // NOLINT
+
+const int N_ITERATIONS = 20;
+
+using ManagerTypeHolder_t =
+    StructureManagerTypeHolder<StructureManagerCenters, AdaptorNeighbourList,
+                               AdaptorCenterContribution, AdaptorStrict>;
+using ManagerTypeList_t = typename ManagerTypeHolder_t::type_list;
+using Manager_t = typename ManagerTypeHolder_t::type;
+using ManagerCollection_t =
+    typename TypeHolderInjector<ManagerCollection, ManagerTypeList_t>::type;
+using Representation_t = CalculatorSphericalInvariants;
+using Property_t = typename Representation_t::template Property_t<Manager_t>;
+using SparsePoints_t = SparsePointsBlockSparse<Representation_t>;
+
+/**
+ * K_{NM} built like before the batching, one matrix-vector product per
+ * center and key
+ */
+math::Matrix_t compute_kernel_by_center(ManagerCollection_t & collection,
+                                        SparsePoints_t & sparse_points,
+                                        const std::string & representation_name,
+                                        const size_t zeta,
+                                        const bool is_structure_target) {
+  size_t n_rows{collection.size()};
+  if (not is_structure_target) {
+    n_rows = 0;
+    for (auto & manager : collection) {
+      n_rows += manager->size();
+    }
+  }
+  math::Matrix_t KNM(n_rows, sparse_points.size());
+  KNM.setZero();
+  size_t i_row{0};
+  for (auto & manager : collection) {
+    auto && prop{
+        *manager->template get_property<Property_t>(representation_name, true)};
+    for (auto center : manager) {
+      KNM.row(i_row) += internal::pow_zeta(sparse_points.dot(
+                                               center.get_atom_type(),
+                                               prop[center]),
+                                           zeta)
+                            .transpose();
+      if (not is_structure_target) {
+        ++i_row;
+      }
+    }
+    if (is_structure_target) {
+      ++i_row;
+    }
+  }
+  return KNM;
+}
+
+int main() {
+  std::string filename{"../reference_data/inputs/small_molecules-20.json"};
+  double cutoff{3.5};
+  const size_t zeta{2};
+
+  json hypers{{"max_radial", 8},
+              {"max_angular", 6},
+              {"compute_gradients", false},
+              {"soap_type", "PowerSpectrum"},
+              {"normalize", true},
+              {"expansion_by_species_method", "user defined"},
+              {"global_species", {1, 6, 7, 8}}};
+
+  json fc_hypers{{"type", "ShiftedCosine"},
+                 {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+                 {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}};
+  json sigma_hypers{{"type", "Constant"},
+                    {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}};
+
+  hypers["cutoff_function"] = fc_hypers;
+  hypers["gaussian_density"] = sigma_hypers;
+  hypers["radial_contribution"] = {{"type", "GTO"}};
+
+  json adaptors;
+  json ad1{{"name", "AdaptorNeighbourList"},
+           {"initialization_arguments", {{"cutoff", cutoff}, {"skin", 0.}}}};
+  json ad1b{{"name", "AdaptorCenterContribution"},
+            {"initialization_arguments", {}}};
+  json ad2{{"name", "AdaptorStrict"},
+           {"initialization_arguments", {{"cutoff", cutoff}}}};
+  adaptors.emplace_back(ad1);
+  adaptors.emplace_back(ad1b);
+  adaptors.emplace_back(ad2);
+
+  ManagerCollection_t collection{adaptors};
+  collection.add_structures(filename, 0, 20);
+
+  Representation_t soap{hypers};
+  soap.compute(collection);
+
+  // every other center is a sparse point
+  std::vector<std::vector<int>> selected_ids{};
+  for (auto & manager : collection) {
+    selected_ids.emplace_back();
+    for (int i_center{0}; i_center < static_cast<int>(manager->size());
+         i_center += 2) {
+      selected_ids.back().push_back(i_center);
+    }
+  }
+  SparsePoints_t sparse_points{};
+  sparse_points.push_back(soap, collection, selected_ids);
+
+  std::cout << "structure filename: " << filename << std::endl;
+  std::cout << "number of sparse points: " << sparse_points.size()
+            << std::endl;
+
+  for (const std::string target_type : {"Structure", "Atom"}) {
+    json kernel_hypers{
+        {"zeta", zeta}, {"target_type", target_type}, {"name", "GAP"}};
+    SparseKernel kernel{kernel_hypers};
+    const bool is_structure_target{target_type == "Structure"};
+
+    std::chrono::duration<double> elapsed{};
+    auto start = std::chrono::high_resolution_clock::now();
+    math::Matrix_t KNM_ref{};
+    for (size_t looper{0}; looper < N_ITERATIONS; looper++) {
+      KNM_ref = compute_kernel_by_center(collection, sparse_points,
+                                         soap.get_name(), zeta,
+                                         is_structure_target);
+    }
+    auto finish = std::chrono::high_resolution_clock::now();
+    elapsed = finish - start;
+    std::cout << target_type << " K_NM center by center"
+              << " elapsed: " << elapsed.count() / N_ITERATIONS << " seconds"
+              << std::endl;
+
+    start = std::chrono::high_resolution_clock::now();
+    math::Matrix_t KNM{};
+    for (size_t looper{0}; looper < N_ITERATIONS; looper++) {
+      KNM = kernel.compute(soap, collection, sparse_points);
+    }
+    finish = std::chrono::high_resolution_clock::now();
+    elapsed = finish - start;
+    std::cout << target_type << " K_NM by batches of centers"
+              << " elapsed: " << elapsed.count() / N_ITERATIONS << " seconds"
+              << " (max abs. diff: "
+              << (KNM - KNM_ref).array().abs().maxCoeff() << ")" << std::endl;
+  }
+}
@@ -34,6 +34,7 @@
 #include "rascal/structure_managers/make_structure_manager.hh"
 #include "rascal/structure_managers/structure_manager_centers.hh"
 #include "rascal/utils/basic_types.hh"
+#include "rascal/utils/threading.hh"
 #include "rascal/utils/utils.hh"
 
 #include <chrono>
@@ -175,4 +176,29 @@ int main(int argc, char * argv[]) {
   }
   // TODO(max) print out analogous gradient components, for now see
   // spherical_expansion_example
+
+  // Strong scaling of the spherical expansion over the centers
+  if (internal::has_openmp()) {
+    std::chrono::duration<double> elapsed_serial{};
+    for (int n_threads{1}; n_threads <= internal::get_max_threads();
+         n_threads *= 2) {
+      CalculatorSphericalExpansion expansion{hypers};
+      expansion.set_n_threads(n_threads);
+      start = std::chrono::high_resolution_clock::now();
+      for (size_t looper{0}; looper < N_ITERATIONS; looper++) {
+        expansion.compute(manager);
+      }
+      finish = std::chrono::high_resolution_clock::now();
+      std::chrono::duration<double> elapsed_threads = finish - start;
+      if (n_threads == 1) {
+        elapsed_serial = elapsed_threads;
+      }
+      std::cout << "Compute spherical expansion with gradients on "
+                << n_threads << " threads elapsed: "
+                << elapsed_threads.count() / N_ITERATIONS
+                << " seconds, speedup: "
+                << elapsed_serial.count() / elapsed_threads.count()
+                << std::endl;
+    }
+  }
 }
@@ -54,6 +54,7 @@ void ModifiedSphericalBessel::precompute(
 
   // precompute for downward recursion
   this->igammas.resize(2);
+  this->hyp1f1s.clear();
   int ii{0};
   for (int order{this->order_max - 2}; order < this->order_max; ++order) {
     this->hyp1f1s.emplace_back(static_cast<double>(order + 1),
@@ -121,6 +121,9 @@ namespace rascal {
        */
       ArrayConstRef_t get_gradients() { return this->bessel_gradients; }
 
+      //! whether calc() also computes the gradients, see precompute()
+      bool has_gradients() const { return this->compute_gradients; }
+
      private:
       /**
        * Compute the MBSFs times two exponentials that complete the square
@@ -0,0 +1,126 @@
+/**
+ * @file   clebsch_gordan.cc
+ *
+ * @author agent <agent@local>
+ *
+ * @date   17 October 2026
+ *
+ * @brief Clebsch-Gordan coefficients acting on the coefficients of the real
+ *        spherical harmonics
+ *
+ * Copyright © 2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "rascal/math/clebsch_gordan.hh"
+
+#include <wigxjpf.h>
+
+using namespace rascal::math;  // NOLINT
+
+std::vector<std::pair<int, std::complex<double>>>
+rascal::math::real_to_complex_harmonics(int l, int m) {
+  using complex = std::complex<double>;
+  const int lm{l + m};
+  if (m > 0) {
+    const double sign{m % 2 == 0 ? 1. : -1.};
+    return {{lm, complex{sign * INV_SQRT_TWO, 0.}},
+            {lm - 2 * m, complex{0., sign * INV_SQRT_TWO}}};
+  } else if (m == 0) {
+    return {{lm, complex{1., 0.}}};
+  }
+  return {{lm - 2 * m, complex{INV_SQRT_TWO, 0.}},
+          {lm, complex{0., -INV_SQRT_TWO}}};
+}
+
+ClebschGordanReal::ClebschGordanReal(size_t max_angular)
+    : max_angular{max_angular} {
+  using complex = std::complex<double>;
+  const int l_max{static_cast<int>(max_angular)};
+  this->couplings.resize((max_angular + 1) * (max_angular + 1) *
+                         (2 * max_angular + 1));
+
+  wig_table_init(2 * 2 * (l_max + 1), 3);
+  wig_temp_init(2 * 2 * (l_max + 1));
+  // complex coefficients transformed to the real basis, dense for a given
+  // (l1, l2, L)
+  std::vector<complex> real_couplings{};
+  for (int l1{0}; l1 < l_max + 1; ++l1) {
+    for (int l2{0}; l2 < l_max + 1; ++l2) {
+      for (int L{std::abs(l1 - l2)}; L < l1 + l2 + 1; ++L) {
+        const int n_m1{2 * l1 + 1}, n_m2{2 * l2 + 1}, n_M{2 * L + 1};
+        real_couplings.assign(n_m1 * n_m2 * n_M, complex{0., 0.});
+        for (int m1{-l1}; m1 < l1 + 1; ++m1) {
+          for (int m2{-l2}; m2 < l2 + 1; ++m2) {
+            const int M{m1 + m2};
+            if (std::abs(M) > L) {
+              continue;
+            }
+            // <l1 m1; l2 m2 | L M> from the Wigner 3j symbol
+            const double sign{(l1 - l2 + M) % 2 == 0 ? 1. : -1.};
+            const double cg{sign * std::sqrt(2. * L + 1.) *
+                            wig3jj(2 * l1, 2 * l2, 2 * L, 2 * m1, 2 * m2,
+                                   -2 * M)};
+            // real to complex on l1 and l2 and complex to real on L
+            for (const auto & r1 : real_to_complex_harmonics(l1, m1)) {
+              for (const auto & r2 : real_to_complex_harmonics(l2, m2)) {
+                for (const auto & rL : real_to_complex_harmonics(L, M)) {
+                  real_couplings[(r1.first * n_m2 + r2.first) * n_M +
+                                 rL.first] +=
+                      cg * r1.second * r2.second * std::conj(rL.second);
+                }
+              }
+            }
+          }
+        }
+
+        auto & couplings_l{this->couplings[this->get_index(l1, l2, L)]};
+        const bool is_real{(l1 + l2 + L) % 2 == 0};
+        for (int M{0}; M < n_M; ++M) {
+          for (int m1{0}; m1 < n_m1; ++m1) {
+            for (int m2{0}; m2 < n_m2; ++m2) {
+              const complex & coupling{
+                  real_couplings[(m1 * n_m2 + m2) * n_M + M]};
+              const double value{is_real ? coupling.real() : coupling.imag()};
+              if (std::abs(value) > 1e-15) {
+                couplings_l.push_back({m1, m2, M, value});
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+  wig_temp_free();
+  wig_table_free();
+}
+
+Matrix_t ClebschGordanReal::combine(const Eigen::Ref<const Matrix_t> & rho1,
+                                    const Eigen::Ref<const Matrix_t> & rho2,
+                                    size_t L) const {
+  if (rho1.rows() != rho2.rows()) {
+    throw std::runtime_error(
+        "Cannot combine coefficients with different number of rows.");
+  }
+  const size_t l1{static_cast<size_t>(rho1.cols() - 1) / 2};
+  const size_t l2{static_cast<size_t>(rho2.cols() - 1) / 2};
+  Matrix_t rho{Matrix_t::Zero(rho1.rows(), 2 * L + 1)};
+  for (const auto & coupling : this->get_couplings(l1, l2, L)) {
+    rho.col(coupling.M) += coupling.value * rho1.col(coupling.m1).cwiseProduct(
+                                                rho2.col(coupling.m2));
+  }
+  return rho;
+}
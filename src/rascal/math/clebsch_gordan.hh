@@ -0,0 +1,116 @@
+/**
+ * @file   rascal/math/clebsch_gordan.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   17 October 2026
+ *
+ * @brief Clebsch-Gordan coefficients acting on the coefficients of the real
+ *        spherical harmonics
+ *
+ * Copyright © 2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_MATH_CLEBSCH_GORDAN_HH_
+#define SRC_RASCAL_MATH_CLEBSCH_GORDAN_HH_
+
+#include "rascal/math/utils.hh"
+
+#include <complex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace rascal {
+  namespace math {
+    /**
+     * Coefficients of the real spherical harmonics of degree l making up the
+     * coefficient of order m of the complex spherical harmonics, i.e.
+     * c_{m} = sum_k weight_k r_{k} following the definition of the real
+     * spherical harmonics of src/rascal/math/spherical_harmonics.hh
+     *
+     * @return (index m' + l of the real coefficient, weight) pairs
+     */
+    std::vector<std::pair<int, std::complex<double>>>
+    real_to_complex_harmonics(int l, int m);
+
+    /**
+     * Clebsch-Gordan coefficients <l1 m1; l2 m2 | L M> transformed to act on
+     * coefficients of the real spherical harmonics and to give real
+     * coefficients, like the ClebschGordanReal class of
+     * bindings/rascal/utils/cg_utils.py.
+     *
+     * The coefficients are stored sparsely, only the non zero (m1, m2, M)
+     * couplings of each (l1, l2, L) are kept.
+     */
+    class ClebschGordanReal {
+     public:
+      //! non zero coefficient, the orders go from 0 to 2l (i.e. m + l)
+      struct Coupling {
+        int m1;
+        int m2;
+        int M;
+        double value;
+      };
+
+      /**
+       * Precompute the coefficients for l1, l2 <= max_angular and every L
+       * allowed by the triangle rule.
+       */
+      explicit ClebschGordanReal(size_t max_angular);
+
+      size_t get_max_angular() const { return this->max_angular; }
+
+      /**
+       * @return the couplings of (l1, l2, L) sorted by M, m1 and m2, empty
+       * when L does not satisfy the triangle rule
+       */
+      const std::vector<Coupling> & get_couplings(size_t l1, size_t l2,
+                                                  size_t L) const {
+        return this->couplings[this->get_index(l1, l2, L)];
+      }
+
+      /**
+       * Combine rows of coefficients of degree l1 [n, 2 l1 + 1] and l2
+       * [n, 2 l2 + 1] into coefficients of degree L [n, 2 L + 1].
+       */
+      Matrix_t combine(const Eigen::Ref<const Matrix_t> & rho1,
+                       const Eigen::Ref<const Matrix_t> & rho2,
+                       size_t L) const;
+
+     protected:
+      size_t get_index(size_t l1, size_t l2, size_t L) const {
+        if (l1 > this->max_angular or l2 > this->max_angular or
+            L > 2 * this->max_angular) {
+          throw std::out_of_range(
+              "The Clebsch-Gordan coefficients of l1 or l2 > max_angular "
+              "have not been precomputed.");
+        }
+        return (l1 * (this->max_angular + 1) + l2) *
+                   (2 * this->max_angular + 1) +
+               L;
+      }
+
+      size_t max_angular;
+      //! couplings by (l1, l2, L)
+      std::vector<std::vector<Coupling>> couplings{};
+    };
+
+  }  // namespace math
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_MATH_CLEBSCH_GORDAN_HH_
@@ -32,7 +32,7 @@ using namespace rascal::math;  // NOLINT
 bool rascal::math::is_grid_uniform(const Vector_Ref & grid) {
   // checks if the grid is in ascending order
   for (int i = 0; i < grid.size() - 2; i++) {
-    if (grid(i + 1) > grid(i)) {
+    if (grid(i + 1) < grid(i)) {
       return false;
     }
   }
@@ -173,37 +173,63 @@ void CubicSplineVectorUniformInterpolation::compute_second_derivative(
   this->second_derivative_h_sq_6 = y2 * this->h_sq_6;
 }
 
-Vector_t CubicSplineVectorUniformInterpolation::interpolate_for_one_point(
-    const Vector_Ref & xx, const Matrix_Ref & yy, int j1, double x) const {
-  int klo{j1};
-  int khi{j1 + 1};
-  // Bad xa input to routine splint
-  assert(h > DBL_FTOL);
-  double a{(xx(khi) - x) / this->h};
-  // Because we can assume a+b=1, we simplify the calculation of b
-  double b{1 - a};
-  return (a * (yy.row(klo).array() +
-               (a * a - 1) * this->second_derivative_h_sq_6.row(klo).array()) +
-          b * (yy.row(khi).array() +
-               (b * b - 1) * this->second_derivative_h_sq_6.row(khi).array()))
-      .matrix();
+void CubicSplineVectorUniformInterpolation::compute_coefficients(
+    const Matrix_Ref & yv) {
+  const Eigen::Index n_intervals{yv.rows() - 1};
+  const Eigen::Index size{yv.cols()};
+  const Eigen::Index padding{16};
+  this->padded_size = ((size + padding - 1) / padding) * padding;
+  // the padding stays zero
+  this->coefficients =
+      CoefficientTable_t<double>::Zero(n_intervals, 4 * this->padded_size);
+  const auto & s{this->second_derivative_h_sq_6};
+  const double h_inv{1. / this->h};
+  for (Eigen::Index j{0}; j < n_intervals; j++) {
+    auto row{this->coefficients.row(j)};
+    // expansion of the "Numerical Recipes" form around x_j
+    row.segment(0, size) = yv.row(j);
+    row.segment(this->padded_size, size) =
+        (yv.row(j + 1) - yv.row(j) - 2 * s.row(j) - s.row(j + 1)) * h_inv;
+    row.segment(2 * this->padded_size, size) = 3 * s.row(j) * h_inv * h_inv;
+    row.segment(3 * this->padded_size, size) =
+        (s.row(j + 1) - s.row(j)) * h_inv * h_inv * h_inv;
+  }
+  this->update_single_precision_coefficients();
 }
 
-Vector_t
-CubicSplineVectorUniformInterpolation::interpolate_derivative_for_one_point(
-    const Vector_Ref & xx, const Matrix_Ref & yy, int j1, double x) const {
-  int klo{j1};
-  int khi{j1 + 1};
-  // Bad xa input to routine splint
-  assert(h > DBL_FTOL);
-  double a{(xx(khi) - x) / this->h};
-  // Because we can assume a+b=1, we simplify the calculation of b
-  double b{1 - a};
-  return ((yy.row(khi).array() - yy.row(klo).array() -
-           (3 * a * a - 1) * this->second_derivative_h_sq_6.row(klo).array() +
-           (3 * b * b - 1) * this->second_derivative_h_sq_6.row(khi).array()) /
-          this->h)
-      .matrix();
+void CubicSplineVectorUniformInterpolation::
+    update_single_precision_coefficients() {
+  if (this->single_precision) {
+    this->coefficients_single = this->coefficients.cast<float>();
+  } else {
+    this->coefficients_single.resize(0, 0);
+  }
+}
+
+void CubicSplineVectorUniformInterpolation::interpolate_for_one_point(
+    const Vector_Ref & xx, const Matrix_Ref &, int j1, double x,
+    Eigen::Ref<Vector_t> result) const {
+  const double t{x - xx(j1)};
+  if (this->single_precision) {
+    this->evaluate_polynomials(this->coefficients_single.row(j1).data(), t,
+                               result);
+  } else {
+    this->evaluate_polynomials(this->coefficients.row(j1).data(), t, result);
+  }
+}
+
+void CubicSplineVectorUniformInterpolation::
+    interpolate_derivative_for_one_point(const Vector_Ref & xx,
+                                         const Matrix_Ref &, int j1, double x,
+                                         Eigen::Ref<Vector_t> result) const {
+  const double t{x - xx(j1)};
+  if (this->single_precision) {
+    this->evaluate_polynomials_derivative(
+        this->coefficients_single.row(j1).data(), t, result);
+  } else {
+    this->evaluate_polynomials_derivative(this->coefficients.row(j1).data(),
+                                          t, result);
+  }
 }
 
 /*****************************************************************************/
@@ -357,6 +357,14 @@ namespace rascal {
      * y:[x1,x2]->ℝ^n and optimized for uniform grids. The private functions are
      * kept as close as possible to the reference.
      *
+     * For the evaluation the spline is converted into the coefficients of one
+     * cubic polynomial per grid interval and output, stored interval-major:
+     * the coefficients needed to evaluate all the n outputs on an interval
+     * are contiguous, padded and aligned, so that an evaluation streams over
+     * a few cache lines with vectorized Horner steps. The table can also be
+     * kept in single precision, which halves its memory footprint at the
+     * cost of a relative accuracy of about 1e-7.
+     *
      * [1] Press, William H., et al. Numerical recipes 3rd edition: The art of
      * scientific computing. Cambridge university press, 2007.
      */
@@ -370,18 +378,48 @@ namespace rascal {
         this->h = grid(1) - grid(0);
         this->h_sq_6 = this->h * this->h / 6.0;
         this->compute_second_derivative(evaluated_grid);
+        this->compute_coefficients(evaluated_grid);
         this->initialized = true;
       }
 
+      /**
+       * Switches the table of polynomial coefficients used for the
+       * evaluation between double and single precision. The evaluation
+       * results are always given in double precision.
+       */
+      void set_single_precision(bool single_precision) {
+        this->single_precision = single_precision;
+        this->update_single_precision_coefficients();
+      }
+
+      bool is_single_precision() const { return this->single_precision; }
+
       /**
        * @pre interpolation method is initialized
        */
       Vector_t interpolate(const Vector_Ref & grid,
                            const Matrix_Ref & evaluated_grid, double x,
                            int nearest_grid_index_to_x) const {
+        Vector_t result(evaluated_grid.cols());
+        this->interpolate(grid, evaluated_grid, x, nearest_grid_index_to_x,
+                          result);
+        return result;
+      }
+
+      /**
+       * Writes the interpolation of x into result, which must have as many
+       * entries as evaluated_grid has columns, e.g. a row of a preallocated
+       * matrix.
+       *
+       * @pre interpolation method is initialized
+       */
+      void interpolate(const Vector_Ref & grid,
+                       const Matrix_Ref & evaluated_grid, double x,
+                       int nearest_grid_index_to_x,
+                       Eigen::Ref<Vector_t> result) const {
         assert(this->initialized);
-        return this->interpolate_for_one_point(grid, evaluated_grid,
-                                               nearest_grid_index_to_x, x);
+        this->interpolate_for_one_point(grid, evaluated_grid,
+                                        nearest_grid_index_to_x, x, result);
       }
 
       /**
@@ -391,21 +429,90 @@ namespace rascal {
                                       const Matrix_Ref & evaluated_grid,
                                       double x,
                                       int nearest_grid_index_to_x) const {
+        Vector_t result(evaluated_grid.cols());
+        this->interpolate_derivative(grid, evaluated_grid, x,
+                                     nearest_grid_index_to_x, result);
+        return result;
+      }
+
+      /**
+       * Writes the interpolation of the derivative at x into result, which
+       * must have as many entries as evaluated_grid has columns.
+       *
+       * @pre interpolation method is initialized
+       */
+      void interpolate_derivative(const Vector_Ref & grid,
+                                  const Matrix_Ref & evaluated_grid, double x,
+                                  int nearest_grid_index_to_x,
+                                  Eigen::Ref<Vector_t> result) const {
         assert(this->initialized);
-        return this->interpolate_derivative_for_one_point(
-            grid, evaluated_grid, nearest_grid_index_to_x, x);
+        this->interpolate_derivative_for_one_point(
+            grid, evaluated_grid, nearest_grid_index_to_x, x, result);
       }
 
      private:
+      template <typename Scalar>
+      using CoefficientTable_t = Eigen::Matrix<Scalar, Eigen::Dynamic,
+                                               Eigen::Dynamic, Eigen::RowMajor>;
+
+      template <typename Scalar>
+      using CoefficientMap_t =
+          Eigen::Map<const Eigen::Array<Scalar, Eigen::Dynamic, 1>,
+                     Eigen::AlignedMax>;
+
       void compute_second_derivative(const Matrix_Ref & yv);
 
-      Vector_t interpolate_for_one_point(const Vector_Ref & xx,
-                                         const Matrix_Ref & yy, int j1,
-                                         double x) const;
+      void compute_coefficients(const Matrix_Ref & yv);
+
+      void update_single_precision_coefficients();
+
+      void interpolate_for_one_point(const Vector_Ref & xx,
+                                     const Matrix_Ref & yy, int j1, double x,
+                                     Eigen::Ref<Vector_t> result) const;
+
+      void interpolate_derivative_for_one_point(
+          const Vector_Ref & xx, const Matrix_Ref & yy, int j1, double x,
+          Eigen::Ref<Vector_t> result) const;
+
+      /**
+       * Evaluates the polynomials of one interval at t = x - x_j with
+       * Horner's scheme
+       *
+       * @param coefficients row j of the coefficient table
+       */
+      template <typename Scalar>
+      void evaluate_polynomials(const Scalar * coefficients, double t,
+                                Eigen::Ref<Vector_t> result) const {
+        const Eigen::Index size{result.size()};
+        const Scalar ts{static_cast<Scalar>(t)};
+        CoefficientMap_t<Scalar> c0{coefficients, size};
+        CoefficientMap_t<Scalar> c1{coefficients + this->padded_size, size};
+        CoefficientMap_t<Scalar> c2{coefficients + 2 * this->padded_size,
+                                    size};
+        CoefficientMap_t<Scalar> c3{coefficients + 3 * this->padded_size,
+                                    size};
+        result.array() =
+            (c0 + ts * (c1 + ts * (c2 + ts * c3))).template cast<double>();
+      }
 
-      Vector_t interpolate_derivative_for_one_point(const Vector_Ref & xx,
-                                                    const Matrix_Ref & yy,
-                                                    int j1, double x) const;
+      /**
+       * Evaluates the derivative of the polynomials of one interval at
+       * t = x - x_j with Horner's scheme
+       */
+      template <typename Scalar>
+      void evaluate_polynomials_derivative(const Scalar * coefficients,
+                                           double t,
+                                           Eigen::Ref<Vector_t> result) const {
+        const Eigen::Index size{result.size()};
+        const Scalar ts{static_cast<Scalar>(t)};
+        CoefficientMap_t<Scalar> c1{coefficients + this->padded_size, size};
+        CoefficientMap_t<Scalar> c2{coefficients + 2 * this->padded_size,
+                                    size};
+        CoefficientMap_t<Scalar> c3{coefficients + 3 * this->padded_size,
+                                    size};
+        result.array() = (c1 + ts * (Scalar(2) * c2 + Scalar(3) * ts * c3))
+                             .template cast<double>();
+      }
 
       bool initialized{false};
       // The gap between two grid points
@@ -414,6 +521,22 @@ namespace rascal {
       double h_sq_6{0};
       // second_derivative*h*h/6
       Matrix_t second_derivative_h_sq_6{};
+      /**
+       * Row j holds the coefficients c_0, c_1, c_2, c_3 of the polynomials
+       * sum_k c_k (x - x_j)^k interpolating the n outputs on [x_j, x_{j+1}],
+       * one block of padded_size entries per c_k, so shape
+       * (grid_size - 1, 4 * padded_size)
+       */
+      CoefficientTable_t<double> coefficients{};
+      // coefficients rounded to single precision, only set if used
+      CoefficientTable_t<float> coefficients_single{};
+      /**
+       * n rounded up to a multiple of 16, so that each block of the table
+       * keeps the (at most 64 bytes) alignment of the allocation in both
+       * precisions
+       */
+      Eigen::Index padded_size{0};
+      bool single_precision{false};
     };
 
     enum class ErrorMetric_t { Absolute, Relative, AbsoluteRelative };
@@ -1144,12 +1267,33 @@ namespace rascal {
        * @return intp(x) in the vector shape (rows*cols)
        */
       inline Matrix_t interpolate_to_vector(const Vector_Ref & points) {
-        Matrix_t interpolated_points =
-            Matrix_t::Zero(points.size(), this->matrix_size);
+        Matrix_t interpolated_points(points.size(), this->matrix_size);
+        this->interpolate_to_matrix(points, interpolated_points);
+        return interpolated_points;
+      }
+
+      /**
+       * Interpolates each x in points into the rows of a preallocated
+       * matrix, no memory is allocated.
+       *
+       * @param output of shape (points.size(), rows*cols), its row i is set
+       * to intp(points(i)) in the vector shape
+       *
+       * @pre each x in points is in range [x1,x2]
+       */
+      inline void interpolate_to_matrix(const Vector_Ref & points,
+                                        Eigen::Ref<Matrix_t> output) {
+        assert(output.rows() == points.size());
+        assert(output.cols() == this->matrix_size);
         for (int i{0}; i < points.size(); i++) {
-          interpolated_points.row(i) = this->interpolate_to_vector(points(i));
+          const double x{points(i)};
+          assert(x >= this->x1 && x <= this->x2);
+          int nearest_grid_index_to_x{
+              this->search_method.search(x, this->grid)};
+          this->intp_method.interpolate(this->grid, this->evaluated_grid, x,
+                                        nearest_grid_index_to_x,
+                                        output.row(i));
         }
-        return interpolated_points;
       }
 
       /**
@@ -1171,13 +1315,32 @@ namespace rascal {
        */
       inline Matrix_t
       interpolate_to_vector_derivative(const Vector_Ref & points) {
-        Matrix_t interpolated_points =
-            Matrix_t::Zero(points.size(), this->matrix_size);
+        Matrix_t interpolated_points(points.size(), this->matrix_size);
+        this->interpolate_to_matrix_derivative(points, interpolated_points);
+        return interpolated_points;
+      }
+
+      /**
+       * Interpolates the derivative of each x in points into the rows of a
+       * preallocated matrix of shape (points.size(), rows*cols), no memory
+       * is allocated.
+       *
+       * @pre each x in points is in range [x1,x2]
+       */
+      inline void
+      interpolate_to_matrix_derivative(const Vector_Ref & points,
+                                       Eigen::Ref<Matrix_t> output) {
+        assert(output.rows() == points.size());
+        assert(output.cols() == this->matrix_size);
         for (int i{0}; i < points.size(); i++) {
-          interpolated_points.row(i) =
-              this->interpolate_to_vector_derivative(points(i));
+          const double x{points(i)};
+          assert(x >= this->x1 && x <= this->x2);
+          int nearest_grid_index_to_x{
+              this->search_method.search(x, this->grid)};
+          this->intp_method.interpolate_derivative(
+              this->grid, this->evaluated_grid, x, nearest_grid_index_to_x,
+              output.row(i));
         }
-        return interpolated_points;
       }
 
       /**
@@ -1200,6 +1363,20 @@ namespace rascal {
 
       int get_matrix_size() { return this->matrix_size; }
 
+      /**
+       * Evaluates the spline from a single precision copy of its polynomial
+       * coefficients, halving the memory traffic of the interpolation. The
+       * grid is not refined again, so the error bound is only fulfilled up
+       * to a relative error of about 1e-7 of the interpolated values.
+       */
+      void set_single_precision_table(bool single_precision) {
+        this->intp_method.set_single_precision(single_precision);
+      }
+
+      bool is_single_precision_table() const {
+        return this->intp_method.is_single_precision();
+      }
+
       /**
        * @param x
        * @return evaluation of f on x, f(x)
@@ -91,6 +91,11 @@ void SphericalHarmonics::precompute(size_t max_angular,
     this->phi_derivative_factors = Vector_t::Zero(this->max_angular);
     this->derivatives_precomputed = true;
   }
+  // the batch storage depends on max_angular
+  this->n_batch = 0;
+  this->batch_assoc_legendre_polynom.resize(0, 0);
+  this->harmonics_batch.resize(0, 0);
+  this->harmonics_derivatives_batch.resize(0, 0);
 }
 
 void SphericalHarmonics::compute_assoc_legendre_polynom(double cos_theta) {
@@ -376,3 +381,263 @@ void SphericalHarmonics::compute_spherical_harmonics_derivatives(
     l_block_index += (2 * angular_l + 1);
   }  // for (l in [0, lmax])
 }
+
+void SphericalHarmonics::reserve_batch(Eigen::Index n_directions,
+                                       bool calculate_derivatives) {
+  const Eigen::Index n_harmonics{static_cast<Eigen::Index>(
+      (this->max_angular + 1) * (this->max_angular + 1))};
+  if (this->harmonics_batch.rows() < n_directions or
+      this->harmonics_batch.cols() != n_harmonics) {
+    const Eigen::Index n_rows{
+        std::max(n_directions, this->harmonics_batch.rows())};
+    const Eigen::Index n_m{static_cast<Eigen::Index>(this->max_angular + 1)};
+    this->batch_cos_theta.resize(n_rows);
+    this->batch_sin_theta.resize(n_rows);
+    this->batch_cos_phi.resize(n_rows);
+    this->batch_sin_phi.resize(n_rows);
+    this->batch_work.resize(n_rows);
+    this->batch_legendre_polynom_differences.resize(n_rows);
+    this->batch_phi_derivative_factors.resize(n_rows);
+    // the P_l^{l+1} columns are never written and have to stay zero
+    this->batch_assoc_legendre_polynom =
+        Eigen::ArrayXXd::Zero(n_rows, n_m * (n_m + 1));
+    this->batch_cos_m_phi.resize(n_rows, n_m);
+    this->batch_sin_m_phi.resize(n_rows, n_m);
+    this->harmonics_batch.resize(n_rows, n_harmonics);
+    this->harmonics_derivatives_batch.resize(0, 0);
+  }
+  if (calculate_derivatives and
+      this->harmonics_derivatives_batch.rows() < this->harmonics_batch.rows()) {
+    // x, y and z components
+    this->harmonics_derivatives_batch.resize(this->harmonics_batch.rows(),
+                                             3 * n_harmonics);
+  }
+  this->n_batch = n_directions;
+}
+
+void SphericalHarmonics::calc_batch(const MatrixX3_Ref & directions,
+                                    bool calculate_derivatives,
+                                    bool conjugate) {
+  if (calculate_derivatives and not this->derivatives_precomputed) {
+    std::stringstream err_str{};
+    err_str << "Resources for computation of dervatives have not been "
+               "initialized. Please set calculate_derivatives flag on "
+               "construction of the SphericalHarmonics object or during "
+               "precomputation.";
+    throw std::runtime_error(err_str.str());
+  }
+  const Eigen::Index n_directions{directions.rows()};
+  this->reserve_batch(n_directions, calculate_derivatives);
+
+  auto x{directions.col(0).array()};
+  auto y{directions.col(1).array()};
+  auto z{directions.col(2).array()};
+  auto cos_theta{this->batch_cos_theta.head(n_directions)};
+  auto sin_theta{this->batch_sin_theta.head(n_directions)};
+  auto cos_phi{this->batch_cos_phi.head(n_directions)};
+  auto sin_phi{this->batch_sin_phi.head(n_directions)};
+  // inverse norm of the directions that are not normalized, 1 otherwise
+  auto inv_norm{this->batch_work.head(n_directions)};
+
+  inv_norm = x * x + y * y + z * z;
+  if (((inv_norm - 1.0).abs() > math::DBL_FTOL).any()) {
+    std::cerr << "Warning: SphericalHarmonics::calc_batch()";
+    std::cerr << ": Direction vector unnormalized, normalizing it now";
+    std::cerr << std::endl;
+    inv_norm = ((inv_norm - 1.0).abs() > math::DBL_FTOL)
+                   .select(inv_norm.sqrt().inverse(), 1.0);
+  } else {
+    inv_norm.setOnes();
+  }
+
+  // The cosine against the z-axis is just the z-component of the
+  // direction vector
+  cos_theta = z * inv_norm;
+  // sin_theta is used as sqrt(x^2 + y^2) until the cos/sin(phi) are known
+  sin_theta = ((x * inv_norm).square() + (y * inv_norm).square()).sqrt();
+  // For a vector along the z-axis, define phi=0
+  cos_phi = (sin_theta >= math::DBL_FTOL).select(x * inv_norm / sin_theta, 1.0);
+  sin_phi = (sin_theta >= math::DBL_FTOL).select(y * inv_norm / sin_theta, 0.0);
+  if (conjugate) {
+    // if we require the complex conjugate of Y^m_l,
+    // simply evaluates Ylm(theta,-phi) (cosine doesn't change)
+    sin_phi *= -1;
+  }
+
+  this->compute_assoc_legendre_polynom_batch();
+  this->compute_cos_sin_angle_multiples_batch();
+  this->compute_spherical_harmonics_batch();
+  if (calculate_derivatives) {
+    this->compute_spherical_harmonics_derivatives_batch();
+  }
+}
+
+void SphericalHarmonics::compute_assoc_legendre_polynom_batch() {
+  const Eigen::Index n_directions{this->n_batch};
+  const double SQRT_INV_2PI = std::sqrt(0.5 / PI);
+  auto && cos_theta{this->batch_cos_theta.head(n_directions)};
+  auto && alps{this->batch_assoc_legendre_polynom};
+  auto alp = [this, &alps, n_directions](size_t angular_l, size_t m_count) {
+    return alps.col(this->get_batch_alp_index(angular_l, m_count))
+        .head(n_directions);
+  };
+  // here sin(theta) = sqrt(1 - cos^2(theta)) as in the single direction case
+  auto l_accum{this->batch_work.head(n_directions)};
+  l_accum = SQRT_INV_2PI;
+  alp(0, 0) = SQRT_INV_2PI;
+  if (this->max_angular > 0) {
+    alp(1, 0) = cos_theta * SQRT_THREE * SQRT_INV_2PI;
+    l_accum = l_accum * -std::sqrt(3.0 / 2.0) *
+              (1.0 - cos_theta.square()).sqrt();
+    alp(1, 1) = l_accum;
+  }
+  for (size_t angular_l{2}; angular_l < this->max_angular + 1; angular_l++) {
+    // for l > 1 : Use the recurrence relation, one m at a time for all the
+    // directions
+    for (size_t m_count{0}; m_count < angular_l - 1; m_count++) {
+      alp(angular_l, m_count) =
+          (cos_theta * alp(angular_l - 1, m_count) +
+           this->coeff_b(angular_l, m_count) * alp(angular_l - 2, m_count)) *
+          this->coeff_a(angular_l, m_count);
+    }
+    alp(angular_l, angular_l - 1) =
+        l_accum * cos_theta * this->angular_coeffs1(angular_l);
+    l_accum = l_accum * (1.0 - cos_theta.square()).sqrt() *
+              this->angular_coeffs2(angular_l);
+    alp(angular_l, angular_l) = l_accum;
+  }
+}
+
+void SphericalHarmonics::compute_cos_sin_angle_multiples_batch() {
+  const Eigen::Index n_directions{this->n_batch};
+  auto && cos_phi{this->batch_cos_phi.head(n_directions)};
+  auto && sin_phi{this->batch_sin_phi.head(n_directions)};
+  auto && cos_m_phi{this->batch_cos_m_phi};
+  auto && sin_m_phi{this->batch_sin_m_phi};
+  // same modified iteration as compute_cos_sin_angle_multiples()
+  for (size_t m_count{0}; m_count < this->max_angular + 1; m_count++) {
+    if (m_count == 0) {
+      cos_m_phi.col(m_count).head(n_directions) = 1.0;
+      sin_m_phi.col(m_count).head(n_directions) = 0.0;
+    } else if (m_count == 1) {
+      cos_m_phi.col(m_count).head(n_directions) = -cos_phi;
+      sin_m_phi.col(m_count).head(n_directions) = -sin_phi;
+    } else {
+      cos_m_phi.col(m_count).head(n_directions) =
+          -2.0 * cos_phi * cos_m_phi.col(m_count - 1).head(n_directions) -
+          cos_m_phi.col(m_count - 2).head(n_directions);
+      sin_m_phi.col(m_count).head(n_directions) =
+          -2.0 * cos_phi * sin_m_phi.col(m_count - 1).head(n_directions) -
+          sin_m_phi.col(m_count - 2).head(n_directions);
+    }
+  }
+}
+
+void SphericalHarmonics::compute_spherical_harmonics_batch() {
+  const Eigen::Index n_directions{this->n_batch};
+  auto && alps{this->batch_assoc_legendre_polynom};
+  auto && harmonics{this->harmonics_batch};
+  size_t lm_base{0};  // starting point for storage
+  for (size_t angular_l{0}; angular_l < this->max_angular + 1; angular_l++) {
+    const size_t lm_zero{lm_base + angular_l};
+    harmonics.col(lm_zero).head(n_directions).array() =
+        alps.col(this->get_batch_alp_index(angular_l, 0)).head(n_directions) *
+        INV_SQRT_TWO;
+    for (size_t m_count{1}; m_count < angular_l + 1; m_count++) {
+      auto && alp{alps.col(this->get_batch_alp_index(angular_l, m_count))
+                      .head(n_directions)};
+      harmonics.col(lm_zero + m_count).head(n_directions).array() =
+          alp * this->batch_cos_m_phi.col(m_count).head(n_directions);
+      harmonics.col(lm_zero - m_count).head(n_directions).array() =
+          alp * this->batch_sin_m_phi.col(m_count).head(n_directions);
+    }
+    lm_base += 2 * angular_l + 1;
+  }  // for (l in [0, lmax])
+}
+
+void SphericalHarmonics::compute_spherical_harmonics_derivatives_batch() {
+  const Eigen::Index n_directions{this->n_batch};
+  const Eigen::Index n_harmonics{this->harmonics_batch.cols()};
+  auto && alps{this->batch_assoc_legendre_polynom};
+  auto alp = [this, &alps, n_directions](size_t angular_l, size_t m_count) {
+    return alps.col(this->get_batch_alp_index(angular_l, m_count))
+        .head(n_directions);
+  };
+  // column of the derivatives of Y_l^m along cartesian_idx
+  auto derivative = [this, n_directions, n_harmonics](int cartesian_idx,
+                                                      size_t lm) {
+    return this->harmonics_derivatives_batch
+        .col(cartesian_idx * n_harmonics + lm)
+        .head(n_directions)
+        .array();
+  };
+  auto && cos_theta{this->batch_cos_theta.head(n_directions)};
+  // sqrt(x^2 + y^2), see compute_spherical_harmonics_derivatives()
+  auto && sin_theta{this->batch_sin_theta.head(n_directions)};
+  auto && cos_phi{this->batch_cos_phi.head(n_directions)};
+  auto && sin_phi{this->batch_sin_phi.head(n_directions)};
+  auto && legendre_polynom_difference{
+      this->batch_legendre_polynom_differences.head(n_directions)};
+  auto && phi_derivative_factor{
+      this->batch_phi_derivative_factors.head(n_directions)};
+
+  // angular_l = 0
+  for (int cartesian_idx{0}; cartesian_idx < 3; ++cartesian_idx) {
+    derivative(cartesian_idx, 0).setZero();
+  }
+
+  // angular_l > 0
+  size_t l_block_index{1};
+  for (size_t angular_l{1}; angular_l < this->max_angular + 1; angular_l++) {
+    const size_t lm_zero{l_block_index + angular_l};
+    auto && alp_l1{alp(angular_l, 1)};
+    const double plm_factor_0{this->plm_factors(angular_l, 0)};
+    // d/dx, d/dy, d/dz of the m = 0 component
+    derivative(0, lm_zero) =
+        cos_theta * cos_phi * plm_factor_0 * INV_SQRT_TWO * alp_l1;
+    derivative(1, lm_zero) =
+        cos_theta * sin_phi * plm_factor_0 * INV_SQRT_TWO * alp_l1;
+    derivative(2, lm_zero) =
+        -1.0 * sin_theta * plm_factor_0 * INV_SQRT_TWO * alp_l1;
+
+    for (size_t m_count{1}; m_count < angular_l + 1; m_count++) {
+      const double plm_factor_1{this->plm_factors(angular_l, m_count - 1)};
+      const double plm_factor_2{this->plm_factors(angular_l, m_count)};
+      auto && alp_m0{alp(angular_l, m_count - 1)};
+      auto && alp_m2{alp(angular_l, m_count + 1)};
+      auto && cos_m_phi{this->batch_cos_m_phi.col(m_count).head(n_directions)};
+      auto && sin_m_phi{this->batch_sin_m_phi.col(m_count).head(n_directions)};
+      legendre_polynom_difference =
+          plm_factor_1 * alp_m0 - plm_factor_2 * alp_m2;
+      // singularity at the poles is avoided by switching to the expression
+      // used near the equator
+      phi_derivative_factor =
+          (sin_theta > 0.1)
+              .select(static_cast<double>(m_count) / sin_theta *
+                          alp(angular_l, m_count),
+                      -0.5 / cos_theta *
+                          (plm_factor_1 * alp_m0 + plm_factor_2 * alp_m2));
+
+      // d/dx
+      derivative(0, lm_zero + m_count) =
+          sin_phi * phi_derivative_factor * sin_m_phi +
+          -0.5 * cos_theta * cos_phi * cos_m_phi * legendre_polynom_difference;
+      derivative(0, lm_zero - m_count) =
+          -1.0 * sin_phi * phi_derivative_factor * cos_m_phi +
+          -0.5 * cos_theta * cos_phi * sin_m_phi * legendre_polynom_difference;
+      // d/dy
+      derivative(1, lm_zero + m_count) =
+          -1.0 * cos_phi * phi_derivative_factor * sin_m_phi +
+          -0.5 * cos_theta * sin_phi * cos_m_phi * legendre_polynom_difference;
+      derivative(1, lm_zero - m_count) =
+          cos_phi * phi_derivative_factor * cos_m_phi +
+          -0.5 * cos_theta * sin_phi * sin_m_phi * legendre_polynom_difference;
+      // d/dz
+      derivative(2, lm_zero + m_count) =
+          0.5 * sin_theta * cos_m_phi * legendre_polynom_difference;
+      derivative(2, lm_zero - m_count) =
+          0.5 * sin_theta * sin_m_phi * legendre_polynom_difference;
+    }
+    l_block_index += (2 * angular_l + 1);
+  }  // for (l in [0, lmax])
+}
@@ -31,6 +31,8 @@
 
 #include "rascal/math/utils.hh"
 
+#include <algorithm>
+
 namespace rascal {
   namespace math {
     /**
@@ -148,6 +150,63 @@ namespace rascal {
         this->calc(direction, this->calculate_derivatives, conjugate);
       }
 
+      /**
+       * Compute the spherical harmonics (and optionally their derivatives) of
+       * a batch of direction vectors at once.
+       *
+       * The recurrences are run on structure-of-arrays storage, i.e. for all
+       * the directions at once for each (l, m), so that the inner operations
+       * are contiguous and can be vectorized. The results are identical to
+       * calling calc() on each direction and are retrieved with
+       * get_harmonics_batch() and get_harmonics_derivatives_batch().
+       *
+       * @param directions  N x 3 array of unit vectors, one per row
+       *
+       * @param calculate_derivatives       Compute the gradients too?
+       * @param conjugate                   Compute \f$(Y^m_l)^*\f$?
+       *
+       * @warning Prints warning and normalizes the directions that are not
+       *          already normalized.
+       */
+      void calc_batch(const MatrixX3_Ref & directions,
+                      bool calculate_derivatives, bool conjugate = false);
+
+      /**
+       * Same as calc_batch(), but using the internal default to decide
+       * whether to compute derivatives.
+       */
+      void calc_batch(const MatrixX3_Ref & directions,
+                      bool conjugate = false) {
+        this->calc_batch(directions, this->calculate_derivatives, conjugate);
+      }
+
+      /**
+       * Access the spherical harmonics computed by calc_batch().
+       *
+       * @return  N x \f$(\ell_\text{max}+1)^2\f$ (column-major) matrix, the
+       *          row is the index of the direction and the column collects
+       *          the \f$\ell\f$ and \f$m\f$ quantum numbers in the compact
+       *          format of get_harmonics().
+       */
+      Eigen::Ref<const Eigen::MatrixXd> get_harmonics_batch() const {
+        return this->harmonics_batch.topRows(this->n_batch);
+      }
+
+      /**
+       * Access the Cartesian gradients computed by calc_batch().
+       *
+       * @return  N x 3 \f$(\ell_\text{max}+1)^2\f$ (column-major) matrix,
+       *          the row is the index of the direction and the columns hold
+       *          the x, y and z gradient components one after the other, each
+       *          in the compact format of get_harmonics().
+       */
+      Eigen::Ref<const Eigen::MatrixXd>
+      get_harmonics_derivatives_batch() const {
+        // empty if the derivatives have never been computed
+        return this->harmonics_derivatives_batch.topRows(std::min(
+            this->n_batch, this->harmonics_derivatives_batch.rows()));
+      }
+
       const Matrix_Ref get_assoc_legendre_polynom() {
         // Since for calculation purposes assoc_legendre_polynom has one column
         // more than it would have in standard libaries, we return only the
@@ -268,6 +327,40 @@ namespace rascal {
                                                    double sin_phi,
                                                    double cos_phi);
 
+      /**
+       * Make sure the batch storage can hold n_directions directions. The
+       * storage only grows so that the successive calls to calc_batch() do not
+       * reallocate.
+       */
+      void reserve_batch(Eigen::Index n_directions,
+                         bool calculate_derivatives);
+
+      //! column of the batch storage of \f$P_\ell^{m}\f$
+      Eigen::Index get_batch_alp_index(size_t angular_l,
+                                       size_t m_count) const {
+        return angular_l * (this->max_angular + 2) + m_count;
+      }
+
+      /**
+       * Batch version of compute_assoc_legendre_polynom(), the polynomials
+       * (including the zero \f$P_\ell^{\ell+1}\f$) are stored column-wise
+       * in batch_assoc_legendre_polynom, see get_batch_alp_index().
+       */
+      void compute_assoc_legendre_polynom_batch();
+
+      /**
+       * Batch version of compute_cos_sin_angle_multiples(), the m-th column
+       * of batch_cos_m_phi (batch_sin_m_phi) holds \f$(-1)^m\cos(m\phi)\f$
+       * (\f$(-1)^m\sin(m\phi)\f$).
+       */
+      void compute_cos_sin_angle_multiples_batch();
+
+      //! Batch version of compute_spherical_harmonics()
+      void compute_spherical_harmonics_batch();
+
+      //! Batch version of compute_spherical_harmonics_derivatives()
+      void compute_spherical_harmonics_derivatives_batch();
+
       const MatrixX2_Ref get_cos_sin_m_phi() {
         return MatrixX2_Ref(this->cos_sin_m_phi);
       }
@@ -287,6 +380,21 @@ namespace rascal {
       Matrix_t plm_factors{};
       Vector_t legendre_polynom_differences{};
       Vector_t phi_derivative_factors{};
+      // batch related member variables, only the first n_batch rows are
+      // used, see reserve_batch()
+      Eigen::Index n_batch{0};
+      Eigen::ArrayXd batch_cos_theta{};
+      Eigen::ArrayXd batch_sin_theta{};
+      Eigen::ArrayXd batch_cos_phi{};
+      Eigen::ArrayXd batch_sin_phi{};
+      Eigen::ArrayXd batch_work{};
+      Eigen::ArrayXd batch_legendre_polynom_differences{};
+      Eigen::ArrayXd batch_phi_derivative_factors{};
+      Eigen::ArrayXXd batch_assoc_legendre_polynom{};
+      Eigen::ArrayXXd batch_cos_m_phi{};
+      Eigen::ArrayXXd batch_sin_m_phi{};
+      Eigen::MatrixXd harmonics_batch{};
+      Eigen::MatrixXd harmonics_derivatives_batch{};
     };
 
   }  // namespace math
@@ -70,10 +70,12 @@ namespace rascal {
     using Matrix_t =
         Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
     using MatrixX2_t = Eigen::Matrix<double, Eigen::Dynamic, 2>;
+    using MatrixX3_t = Eigen::Matrix<double, Eigen::Dynamic, 3>;
     using Vector_t = Eigen::Matrix<double, 1, Eigen::Dynamic>;
 
     using Matrix_Ref = typename Eigen::Ref<const Matrix_t>;
     using MatrixX2_Ref = typename Eigen::Ref<const MatrixX2_t>;
+    using MatrixX3_Ref = typename Eigen::Ref<const MatrixX3_t>;
     using Vector_Ref = typename Eigen::Ref<const Vector_t>;
 
     /**
@@ -33,8 +33,98 @@
 #include "rascal/structure_managers/atomic_structure.hh"
 #include "rascal/structure_managers/make_structure_manager.hh"
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 namespace rascal {
 
+  namespace internal {
+    /**
+     * Mask of the atoms of structure that are within cutoff of i_atom or of
+     * one of its periodic images, i.e. the centers whose environment can
+     * change when i_atom is displaced.
+     */
+    inline AtomicStructure<ThreeD>::ArrayB_t
+    get_atoms_within_cutoff(const AtomicStructure<ThreeD> & structure,
+                            const size_t i_atom, const double cutoff) {
+      using Vector_t = Eigen::Vector3d;
+      const size_t n_atoms{structure.get_number_of_atoms()};
+      AtomicStructure<ThreeD>::ArrayB_t is_within(n_atoms);
+      const Vector_t position{structure.positions.col(i_atom)};
+      if (not structure.pbc.any()) {
+        for (size_t j_atom{0}; j_atom < n_atoms; ++j_atom) {
+          is_within(j_atom) =
+              (structure.positions.col(j_atom) - position).norm() <= cutoff;
+        }
+        return is_within;
+      }
+      // a sphere of radius cutoff spans cutoff * |row of cell^-1| in the
+      // scaled coordinates
+      const Eigen::Matrix3d cell_inverse{structure.cell.inverse()};
+      Eigen::Array3i n_images{};
+      for (int i_dim{0}; i_dim < ThreeD; ++i_dim) {
+        n_images(i_dim) =
+            structure.pbc(i_dim)
+                ? static_cast<int>(
+                      std::ceil(cutoff * cell_inverse.row(i_dim).norm()))
+                : 0;
+      }
+      for (size_t j_atom{0}; j_atom < n_atoms; ++j_atom) {
+        Vector_t scaled{cell_inverse *
+                        (structure.positions.col(j_atom) - position)};
+        for (int i_dim{0}; i_dim < ThreeD; ++i_dim) {
+          if (structure.pbc(i_dim)) {
+            scaled(i_dim) -= std::round(scaled(i_dim));
+          }
+        }
+        bool within{false};
+        for (int n_x{-n_images(0)}; n_x <= n_images(0); ++n_x) {
+          for (int n_y{-n_images(1)}; n_y <= n_images(1); ++n_y) {
+            for (int n_z{-n_images(2)}; n_z <= n_images(2); ++n_z) {
+              const Vector_t image{scaled + Vector_t(n_x, n_y, n_z)};
+              within = within or (structure.cell * image).norm() <= cutoff;
+            }
+          }
+        }
+        is_within(j_atom) = within;
+      }
+      return is_within;
+    }
+
+    /**
+     * Kernel between the sparse points and each of structures, summed over
+     * the centers of the structure. The structures are computed on new
+     * stacks of managers built like the ones of managers, in parallel with
+     * the threads of calculator.
+     */
+    template <class KernelImpl, class Calculator, class Managers,
+              class SparsePoints>
+    math::Matrix_t compute_kernel_of_structures(
+        KernelImpl & kernel, Calculator & calculator, const Managers & managers,
+        const SparsePoints & sparse_points,
+        const std::vector<AtomicStructure<ThreeD>> & structures) {
+      Managers copies{managers.get_adaptors_parameters()};
+      copies.add_structures(structures);
+      calculator.compute(copies);
+      math::Matrix_t KNM_copies{
+          kernel.compute(calculator, copies, sparse_points)};
+      if (kernel.target_type == TargetType::Structure) {
+        return KNM_copies;
+      }
+      math::Matrix_t KNM{structures.size(), sparse_points.size()};
+      Eigen::Index i_row{0}, i_structure{0};
+      for (const auto & copy : copies) {
+        const auto n_centers{static_cast<Eigen::Index>(copy->size())};
+        KNM.row(i_structure) =
+            KNM_copies.middleRows(i_row, n_centers).colwise().sum();
+        i_row += n_centers;
+        ++i_structure;
+      }
+      return KNM;
+    }
+  }  // namespace internal
+
   /*
    * displacement of strain tensor in alpha beta spatial dimensions
    * where alpha and beta can be one of the integers {0, 1, 2}
@@ -48,9 +138,9 @@ namespace rascal {
       const int & beta_spatial_dim, const double & h_disp) {
     // get a copy of the atomic_structure object
     auto manager_root = extract_underlying_manager<0>(manager);
-    json structure_copy = manager_root->get_atomic_structure();
-    auto atomic_structure =
-        structure_copy.template get<AtomicStructure<ThreeD>>();
+    const AtomicStructure<ThreeD> structure_copy{
+        manager_root->get_atomic_structure()};
+    AtomicStructure<ThreeD> atomic_structure{structure_copy};
     atomic_structure.displace_strain_tensor(alpha_spatial_dim, beta_spatial_dim,
                                             h_disp);
     // make sure all atoms are in the unit cell
@@ -60,7 +150,7 @@ namespace rascal {
     managers.emplace_back(manager);
     math::Matrix_t KNM = kernel.compute(calculator, managers, sparse_points);
     // reset neighborlist to the original structure
-    manager->update(structure_copy.template get<AtomicStructure<ThreeD>>());
+    manager->update(structure_copy);
     return KNM;
   }
 
@@ -81,9 +171,9 @@ namespace rascal {
       const Eigen::MatrixBase<Derived> & disp) {
     // get a copy of the atomic_structure object
     auto manager_root = extract_underlying_manager<0>(manager);
-    json structure_copy = manager_root->get_atomic_structure();
-    auto atomic_structure =
-        structure_copy.template get<AtomicStructure<ThreeD>>();
+    const AtomicStructure<ThreeD> structure_copy{
+        manager_root->get_atomic_structure()};
+    AtomicStructure<ThreeD> atomic_structure{structure_copy};
     atomic_structure.displace_position(i_atom, disp);
     // make sure all atoms are in the unit cell
     atomic_structure.wrap();
@@ -93,7 +183,7 @@ namespace rascal {
     managers.emplace_back(manager);
     math::Matrix_t KNM = kernel.compute(calculator, managers, sparse_points);
     // reset neighborlist to the original structure
-    manager->update(structure_copy.template get<AtomicStructure<ThreeD>>());
+    manager->update(structure_copy);
     return KNM;
   }
 
@@ -170,13 +260,82 @@ namespace rascal {
     }
 
     auto manager_root = extract_underlying_manager<0>(manager);
-    json structure_copy = manager_root->get_atomic_structure();
-    auto atomic_structure =
-        structure_copy.template get<AtomicStructure<ThreeD>>();
+    AtomicStructure<ThreeD> atomic_structure{
+        manager_root->get_atomic_structure()};
     KNM /= -atomic_structure.get_volume();
     return KNM;
   }
 
+  /**
+   * Same as compute_numerical_kernel_gradient() but the displaced
+   * structures are computed on new stacks of managers, built like the ones
+   * of managers, by chunks of structures computed in parallel with the
+   * threads of calculator (see CalculatorBase::set_n_threads()).
+   *
+   * Only the centers within the cutoff of the displaced atom are kept in the
+   * displaced structures since the kernel of the other centers cancels out
+   * in the finite difference. With a half neighbour list all the atoms have
+   * to be centers so all of them are recomputed.
+   *
+   * @param managers the collection manager belongs to
+   * @see compute_numerical_kernel_gradients
+   */
+  template <class KernelImpl, class Calculator, class Managers,
+            class SparsePoints>
+  math::Matrix_t compute_numerical_kernel_gradient_local(
+      KernelImpl & kernel, Calculator & calculator, const Managers & managers,
+      const typename Managers::ManagerPtr_t & manager,
+      const SparsePoints & sparse_points, const double & h_disp) {
+    using Manager_t = typename Managers::Manager_t;
+    constexpr bool IsHalfNL{Manager_t::traits::NeighbourListType ==
+                            AdaptorTraits::NeighbourListType::half};
+    auto manager_root = extract_underlying_manager<0>(manager);
+    const auto & structure{manager_root->get_atomic_structure()};
+    // an atom further than the cutoff can come within it when displaced
+    const double cutoff{manager->get_cutoff() + h_disp};
+    const size_t n_atoms{manager->size()};
+    // one atom per thread, i.e. 6 displaced structures per thread
+    const size_t chunk_size{static_cast<size_t>(calculator.get_n_threads())};
+
+    math::Matrix_t KNM{n_atoms * ThreeD, sparse_points.size()};
+    std::vector<AtomicStructure<ThreeD>> structures{};
+    for (size_t i_begin{0}; i_begin < n_atoms; i_begin += chunk_size) {
+      const size_t i_end{std::min(i_begin + chunk_size, n_atoms)};
+      structures.clear();
+      for (size_t i_atom{i_begin}; i_atom < i_end; ++i_atom) {
+        AtomicStructure<ThreeD> displaced{structure};
+        if (not IsHalfNL) {
+          displaced.center_atoms_mask =
+              displaced.center_atoms_mask and
+              internal::get_atoms_within_cutoff(structure, i_atom, cutoff);
+        }
+        for (int i_der{0}; i_der < ThreeD; ++i_der) {
+          // use centered finite difference to estimate gradient
+          for (const double & sign : {1., -1.}) {
+            structures.push_back(displaced);
+            structures.back().displace_position(
+                i_atom, sign * h_disp * Eigen::Vector3d::Unit(i_der));
+            // make sure all atoms are in the unit cell
+            structures.back().wrap();
+          }
+        }
+      }
+      math::Matrix_t KNM_displaced{internal::compute_kernel_of_structures(
+          kernel, calculator, managers, sparse_points, structures)};
+      for (size_t i_atom{i_begin}; i_atom < i_end; ++i_atom) {
+        for (int i_der{0}; i_der < ThreeD; ++i_der) {
+          const auto i_row{
+              static_cast<Eigen::Index>(2 * ((i_atom - i_begin) * ThreeD +
+                                             static_cast<size_t>(i_der)))};
+          KNM.row(i_atom * ThreeD + i_der) =
+              (KNM_displaced.row(i_row) - KNM_displaced.row(i_row + 1)) /
+              (2 * h_disp);
+        }
+      }
+    }
+    return KNM;
+  }
+
   /**
    * Compute finite-difference gradient of the kernel of a sparse GPR model
    * w.r.t. atomic positions for a collection of atomic structures
@@ -187,6 +346,11 @@ namespace rascal {
    * @param managers a collection of structure managers
    * @param sparse_points basis points used in the sparse GPR model
    * @param h_disp displacement used for the centered finite difference
+   * @param compute_stress also compute the kernel of the negative stress
+   * @param local compute the displaced structures in parallel and only for
+   *        the centers within the cutoff of the displaced atom, see
+   *        compute_numerical_kernel_gradient_local(). It needs the adaptor
+   *        parameters of the collection.
    *
    */
   template <class KernelImpl, class Calculator, class Managers,
@@ -194,7 +358,7 @@ namespace rascal {
   math::Matrix_t compute_numerical_kernel_gradients(
       KernelImpl & kernel, Calculator & calculator, Managers & managers,
       const SparsePoints & sparse_points, double h_disp = 1e-5,
-      const bool compute_stress = false) {
+      const bool compute_stress = false, const bool local = false) {
     size_t n_centers{0};
     for (const auto & manager : managers) {
       n_centers += manager->size() * ThreeD;
@@ -207,9 +371,15 @@ namespace rascal {
     KNM.setZero();
     size_t i_centers{0};
     for (const auto & manager : managers) {
-      KNM.block(i_centers, 0, manager->size() * ThreeD, n_sparse_points) =
-          compute_numerical_kernel_gradient(kernel, calculator, manager,
-                                            sparse_points, h_disp);
+      if (local) {
+        KNM.block(i_centers, 0, manager->size() * ThreeD, n_sparse_points) =
+            compute_numerical_kernel_gradient_local(
+                kernel, calculator, managers, manager, sparse_points, h_disp);
+      } else {
+        KNM.block(i_centers, 0, manager->size() * ThreeD, n_sparse_points) =
+            compute_numerical_kernel_gradient(kernel, calculator, manager,
+                                              sparse_points, h_disp);
+      }
       i_centers += manager->size() * ThreeD;
     }
 
@@ -30,12 +30,216 @@
 #include "rascal/math/utils.hh"
 #include "rascal/models/kernels.hh"
 #include "rascal/models/sparse_kernels.hh"
+#include "rascal/models/sparse_points.hh"
 #include "rascal/structure_managers/property_block_sparse.hh"
 #include "rascal/structure_managers/structure_manager_collection.hh"
 #include "rascal/utils/json_io.hh"
 
+#include <array>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
 namespace rascal {
 
+  namespace internal {
+    /**
+     * Preallocated scratch memory of a SOAP-GAP prediction, reused between
+     * the centers so that the gradient pass does not allocate anything per
+     * center.
+     *
+     * For a center of species a_sp and representation X_i, compute() fills
+     *  - kernel_row: the row of K_{NM}, X_i \dot T_n,
+     *  - weights_scaled: \alpha_n^{scaled} = z \alpha_n (X_i \dot T_n)^{z-1},
+     *  - the scaled sparse point \sum_n \alpha_n^{scaled} T_n, stored in one
+     *    contiguous buffer per species with the blocks of all the keys of
+     *    the sparse points of that species one after the other.
+     *
+     * The keys shared with the representation of a structure and their
+     * position in the buffers are set once per structure with set_keys().
+     */
+    template <class SparsePoints>
+    class GAPScaledSparsePoints {
+     public:
+      using Precision_t = typename SparsePoints::Precision_t;
+      using Key_t = typename SparsePoints::Key_t;
+      using Keys_t = typename SparsePoints::Keys_t;
+      using RowVector_t = typename SparsePoints::RowVector_t;
+      using ColVector_t = typename SparsePoints::ColVector_t;
+      using Vector_t = Eigen::Matrix<Precision_t, Eigen::Dynamic, 1>;
+      //! key and position of its block in the scaled sparse point
+      using KeyBlocks_t = std::vector<std::pair<Key_t, Eigen::Index>>;
+
+      explicit GAPScaledSparsePoints(const SparsePoints & sparse_points)
+          : inner_size{static_cast<Eigen::Index>(sparse_points.inner_size)},
+            kernel_row(sparse_points.size()),
+            kernel_row_pow(sparse_points.size()),
+            weights_scaled(sparse_points.size()) {
+        for (const int & sp : sparse_points.species()) {
+          this->values[sp] = RowVector_t::Zero(
+              sparse_points.keys_sp.at(sp).size() * this->inner_size);
+          this->key_blocks[sp].reserve(sparse_points.keys_sp.at(sp).size());
+        }
+      }
+
+      /**
+       * Select the keys of the sparse points that are also in rep_keys, the
+       * keys of the representation of the current structure
+       */
+      void set_keys(const SparsePoints & sparse_points,
+                    const Keys_t & rep_keys) {
+        for (auto & sp_key_blocks : this->key_blocks) {
+          const auto & keys_by_sp{
+              sparse_points.keys_sp.at(sp_key_blocks.first)};
+          auto & key_blocks_by_sp{sp_key_blocks.second};
+          key_blocks_by_sp.clear();
+          Eigen::Index i_col{0};
+          for (const Key_t & key : keys_by_sp) {
+            if (rep_keys.count(key)) {
+              key_blocks_by_sp.emplace_back(key, i_col);
+            }
+            i_col += this->inner_size;
+          }
+        }
+      }
+
+      /**
+       * Compute the scaled sparse point of a center of species a_sp, which
+       * has to be in the sparse points, with the representation X_i
+       *
+       * @return the contribution of the center to the energy,
+       *          \sum_n \alpha_n (X_i \dot T_n)^z
+       */
+      template <class Representation>
+      double compute(const SparsePoints & sparse_points,
+                     const math::Vector_t & weights, const size_t zeta,
+                     const int a_sp, Representation & representation) {
+        // (X_i \dot T_n)^{z-1} is shared by the energy and the gradients
+        sparse_points.dot_into(a_sp, representation, this->kernel_row);
+        this->kernel_row_pow = this->kernel_row.unaryExpr(
+            [zeta](double v) { return math::pow(v, zeta - 1); });
+        this->weights_scaled =
+            zeta *
+            (weights.array() * this->kernel_row_pow.transpose().array())
+                .matrix();
+        sparse_points.dot_into(a_sp, this->weights_scaled,
+                               this->values.at(a_sp));
+        return (weights.array() * this->kernel_row.transpose().array() *
+                this->kernel_row_pow.transpose().array())
+            .sum();
+      }
+
+      //! make room for the pair gradients of a center with n_neigh pairs
+      void reserve_neighbours(const Eigen::Index n_neigh) {
+        if (this->pair_gradients.rows() < n_neigh) {
+          this->pair_gradients.resize(n_neigh, ThreeD);
+          this->fij.resize(n_neigh);
+        }
+      }
+
+      //! block of the scaled sparse point of species sp starting at i_col
+      Eigen::Map<const RowVector_t> get_block(const int sp,
+                                              const Eigen::Index i_col) const {
+        return Eigen::Map<const RowVector_t>(
+            this->values.at(sp).data() + i_col, this->inner_size);
+      }
+
+      //! size of one block of features of a key
+      Eigen::Index inner_size{0};
+      //! scaled sparse point by central species
+      std::map<int, RowVector_t> values{};
+      //! keys shared with the representation by central species
+      std::map<int, KeyBlocks_t> key_blocks{};
+      ColVector_t kernel_row{};
+      ColVector_t kernel_row_pow{};
+      math::Vector_t weights_scaled{};
+      //! partial gradients of the pairs of a center [n_neigh, 3]
+      math::Matrix_t pair_gradients{};
+      //! contraction of one key of the gradients of a center [n_neigh]
+      Vector_t fij{};
+    };
+
+    /**
+     * Contract the sparse points scaled by the weights of a SOAP-GAP model
+     * of the central species of center, i.e. \sum_n \alpha_n^{scaled} T_n
+     * computed with GAPScaledSparsePoints::compute(), with the gradients of
+     * the representation of center w.r.t. the positions of its neighbours
+     * (including itself). The partial gradient of each pair is handed to
+     * accumulate(neigh, i_neigh, i_der, value) where i_neigh is the index of
+     * the pair within the pairs of center.
+     *
+     * When the keys of the gradients are uniform the contraction is done
+     * block by key on the raw gradient data, starting at row i_row which is
+     * moved past the pairs of center.
+     */
+    template <class SparsePoints, class PropertyGradient, class Center,
+              class Accumulator>
+    void contract_gap_pair_gradients(
+        GAPScaledSparsePoints<SparsePoints> & sparse_point_scaled,
+        PropertyGradient & prop_grad, Center & center,
+        const bool do_block_by_key_dot, size_t & i_row,
+        Accumulator && accumulate) {
+      using Precision_t = typename SparsePoints::Precision_t;
+      const int a_sp{center.get_atom_type()};
+      const Eigen::Index inner_size{sparse_point_scaled.inner_size};
+      const auto & key_blocks{sparse_point_scaled.key_blocks.at(a_sp)};
+      const Eigen::Index n_neigh{
+          static_cast<Eigen::Index>(center.pairs_with_self_pair().size())};
+      if (do_block_by_key_dot) {
+        auto rep_grads = prop_grad.get_raw_data_view();
+        sparse_point_scaled.reserve_neighbours(n_neigh);
+        auto fij_block = sparse_point_scaled.fij.head(n_neigh);
+
+        for (const auto & key_block : key_blocks) {
+          auto spts{sparse_point_scaled.get_block(a_sp, key_block.second)};
+          int col_st{prop_grad.get_gradient_col_by_key(key_block.first)};
+          for (int i_der{0}; i_der < ThreeD; i_der++) {
+            fij_block.noalias() =
+                rep_grads.block(i_row, col_st + i_der * inner_size, n_neigh,
+                                inner_size) *
+                spts.transpose();
+
+            int i_row_{0};
+            for (auto neigh : center.pairs_with_self_pair()) {
+              accumulate(neigh, i_row_, i_der,
+                         static_cast<double>(fij_block(i_row_)));
+              i_row_++;
+            }  // neigh
+          }    // i_der
+        }      // key
+        i_row += n_neigh;
+      } else {
+        int i_neigh{0};
+        for (auto neigh : center.pairs_with_self_pair()) {
+          auto && prop_grad_by_neigh{prop_grad[neigh]};
+          for (const auto & key_block : key_blocks) {
+            if (not prop_grad_by_neigh.count(key_block.first)) {
+              continue;
+            }
+            // the gradient directions are the outermost index
+            auto rep_grad_flat_by_key{
+                prop_grad_by_neigh.flat(key_block.first)};
+            using RepPrecision_t =
+                typename decltype(rep_grad_flat_by_key)::Scalar;
+            using RepGrad_t = Eigen::Matrix<RepPrecision_t, ThreeD,
+                                            Eigen::Dynamic, Eigen::RowMajor>;
+            Eigen::Map<const RepGrad_t> rep_grad_by_key(
+                rep_grad_flat_by_key.data(), ThreeD, inner_size);
+            auto spts{sparse_point_scaled.get_block(a_sp, key_block.second)};
+            for (int i_der{0}; i_der < ThreeD; i_der++) {
+              accumulate(neigh, i_neigh, i_der,
+                         static_cast<double>(spts.dot(
+                             rep_grad_by_key.row(i_der)
+                                 .template cast<Precision_t>())));
+            }
+          }
+          i_neigh++;
+        }
+      }
+    }
+  }  // namespace internal
+
   /**
    * Compute the partial gradients of a structure w.r.t atomic positions
    * using the SOAP-GAP model (see
@@ -76,36 +280,13 @@ namespace rascal {
                                 const std::string & representation_grad_name,
                                 const std::string & pair_grad_atom_i_r_j_name) {
     using Manager_t = typename StructureManager::element_type;
-    using Keys_t = typename SparsePoints::Keys_t;
-    using Key_t = typename SparsePoints::Key_t;
 
     auto && prop{
         *manager->template get_property<Property_t>(representation_name, true)};
     auto && prop_grad{*manager->template get_property<PropertyGradient_t>(
         representation_grad_name, true)};
 
-    const int inner_size{prop.get_nb_comp()};
-
-    bool do_block_by_key_dot{false};
-    if (prop_grad.are_keys_uniform()) {
-      do_block_by_key_dot = true;
-    }
-
-    std::set<int> unique_species{};
-    for (auto center : manager) {
-      unique_species.insert(center.get_atom_type());
-    }
-
-    // find shared central atom species
-    std::set<int> species_intersect{
-        internal::set_intersection(unique_species, sparse_points.species())};
-
-    Keys_t rep_keys{prop_grad.get_keys()};
-    std::map<int, Keys_t> keys_intersect{};
-    for (const int & sp : species_intersect) {
-      keys_intersect[sp] =
-          internal::set_intersection(rep_keys, sparse_points.keys_sp.at(sp));
-    }
+    const bool do_block_by_key_dot{prop_grad.are_keys_uniform()};
 
     // attach partial gradients array to manager
     auto && pair_grad_atom_i_r_j{
@@ -120,61 +301,41 @@ namespace rascal {
     pair_grad_atom_i_r_j.resize();
     pair_grad_atom_i_r_j.setZero();
 
-    if (species_intersect.empty()) {
+    const auto & species = sparse_points.species();
+    if (species.empty()) {
       return;
     }
 
-    math::Vector_t weights_scaled(weights.size());
+    // scratch memory shared by all the centers
+    internal::GAPScaledSparsePoints<SparsePoints> sparse_point_scaled{
+        sparse_points};
+    sparse_point_scaled.set_keys(sparse_points, prop_grad.get_keys());
+
     size_t i_row{0};
     for (auto center : manager) {
       const int a_sp{center.get_atom_type()};
+      if (species.count(a_sp) == 0) {
+        // no sparse point of this species, the gradients of the center
+        // still have to be skipped
+        if (do_block_by_key_dot) {
+          i_row += center.pairs_with_self_pair().size();
+        }
+        continue;
+      }
       // compute contraction of the model weights with the gradient of the
       // kernel with respect to the representation in 2 steps
       // 1. \alpha_n^{scaled} = \alpha_n * [z* (X_j \dot T_n)^{z-1}]
-      weights_scaled =
-          (weights.array() *
-           (zeta *
-            internal::pow_zeta(sparse_points.dot(a_sp, prop[center]), zeta - 1))
-               .transpose()
-               .array())
-              .matrix();
       // 2. \sum_n \alpha_n^{scaled} T_n
-      SparsePoints sparse_point_scaled{sparse_points.dot(a_sp, weights_scaled)};
-      const size_t n_neigh{center.pairs_with_self_pair().size()};
+      sparse_point_scaled.compute(sparse_points, weights, zeta, a_sp,
+                                  prop[center]);
       // contract weights&kernel_grad with the gradient of the representation
       // w.r.t. atoms positions, namely sparse_point_scaled \dot dX_i/dr_j
-      if (do_block_by_key_dot) {
-        auto rep_grads = prop_grad.get_raw_data_view();
-        const auto & values_by_sp = sparse_point_scaled.values.at(a_sp);
-
-        for (const Key_t & key : keys_intersect.at(a_sp)) {
-          const auto & values_by_sp_key = values_by_sp.at(key);
-          auto spts = Eigen::Map<const math::Vector_t>(
-              values_by_sp_key.data(), static_cast<Eigen::Index>(inner_size));
-
-          math::Vector_t fij_block(n_neigh);
-
-          int col_st{prop_grad.get_gradient_col_by_key(key)};
-          for (int i_der{0}; i_der < ThreeD; i_der++) {
-            fij_block = (rep_grads.block(i_row, col_st + i_der * inner_size,
-                                         n_neigh, inner_size) *
-                         spts.transpose())
-                            .transpose();
-
-            int i_row_{0};
-            for (auto neigh : center.pairs_with_self_pair()) {
-              pair_grad_atom_i_r_j[neigh](i_der) += fij_block(i_row_);
-              i_row_++;
-            }  // neigh
-          }    // i_der
-        }      // key
-        i_row += n_neigh;
-      } else {
-        for (auto neigh : center.pairs_with_self_pair()) {
-          pair_grad_atom_i_r_j[neigh] =
-              sparse_point_scaled.dot_derivative(a_sp, prop_grad[neigh]);
-        }
-      }
+      internal::contract_gap_pair_gradients(
+          sparse_point_scaled, prop_grad, center, do_block_by_key_dot, i_row,
+          [&pair_grad_atom_i_r_j](auto & neigh, int /*i_neigh*/, int i_der,
+                                  double fij) {
+            pair_grad_atom_i_r_j[neigh](i_der) += fij;
+          });
     }  // center
     pair_grad_atom_i_r_j.set_updated_status(true);
   }
@@ -209,9 +370,9 @@ namespace rascal {
                                               SparsePoints & sparse_points,
                                               math::Vector_t & weights) {
     using Manager_t = typename StructureManagers::Manager_t;
-    using Property_t = typename Calculator::template Property_t<Manager_t>;
+    using Property_t = typename SparsePoints::template Property_t<Manager_t>;
     using PropertyGradient_t =
-        typename Calculator::template PropertyGradient_t<Manager_t>;
+        typename SparsePoints::template PropertyGradient_t<Manager_t>;
     auto && representation_name{calculator.get_name()};
     const auto representation_grad_name{calculator.get_gradient_name()};
     size_t n_centers{0};
@@ -294,9 +455,9 @@ namespace rascal {
                                                SparsePoints & sparse_points,
                                                math::Vector_t & weights) {
     using Manager_t = typename StructureManagers::Manager_t;
-    using Property_t = typename Calculator::template Property_t<Manager_t>;
+    using Property_t = typename SparsePoints::template Property_t<Manager_t>;
     using PropertyGradient_t =
-        typename Calculator::template PropertyGradient_t<Manager_t>;
+        typename SparsePoints::template PropertyGradient_t<Manager_t>;
     auto && representation_name{calculator.get_name()};
     const auto representation_grad_name{calculator.get_gradient_name()};
     size_t n_centers{0};
@@ -374,5 +535,383 @@ namespace rascal {
     }  // manager
     return neg_stress_name;
   }
+
+  /**
+   * Predictions of a sparse GPR model for one structure.
+   *
+   * The virial and stress follow the conventions of the python KRR model and
+   * use the Voigt order xx, yy, zz, yz, xz, xy.
+   */
+  struct SparseGPRPrediction {
+    using Voigt_t = Eigen::Matrix<double, 6, 1>;
+    //! energy of the structure, including the self contributions
+    double energy{0.};
+    //! forces on the atoms [N_{atoms}, 3]
+    math::Matrix_t forces{};
+    //! virial, -\sum_{ij} r_{ji} \otimes dE_i/dr_j
+    Voigt_t virial{Voigt_t::Zero()};
+    //! virial divided by the cell volume, zero for non periodic structures
+    Voigt_t stress{Voigt_t::Zero()};
+  };
+
+  /**
+   * Energy, forces and virial predictor of a SOAP-GAP sparse GPR model,
+   * meant to be called once per step by MD drivers.
+   *
+   * The model is evaluated in a single pass over the centers: the row of
+   * K_{NM} of a center, (X_i \dot T_n)^{z-1}, gives both its contribution
+   * to the energy and the scaling of the weights needed for the gradients
+   * (see compute_partial_gradients_gap), so the gradients of the kernel are
+   * never formed and the forces and the virial are accumulated from the
+   * same partial gradients.
+   *
+   * With GradientMode::Adjoint the gradients of the representation are not
+   * computed either: dE/dX_i = \sum_n \alpha_n^{scaled} T_n is
+   * back-propagated through the representation and contracted with the
+   * gradients of the expansion one pair at a time (see
+   * CalculatorSphericalInvariants::contract_gradients), so the memory does
+   * not grow with the number of pairs times the number of features. It is
+   * only implemented for the PowerSpectrum.
+   *
+   * @tparam Calculator type of the representation of the model, it has to
+   *          provide the gradients of the representation
+   * @tparam Precision precision used to store the representation and the
+   *          sparse points, with float the representation is still
+   *          expanded in double precision and the energy, forces and virial
+   *          are accumulated in double precision
+   */
+  template <class Calculator, typename Precision = double>
+  class SparseGPRPredictor {
+   public:
+    using Hypers_t = typename Calculator::Hypers_t;
+    using SparsePoints_t = SparsePointsBlockSparse<Calculator, Precision>;
+    using Keys_t = typename SparsePoints_t::Keys_t;
+    //! map atomic number to the baseline of the energy, e.g. isolated atoms
+    using SelfContributions_t = std::map<int, double>;
+
+    //! how the forces and the virial are computed, see the class description
+    enum class GradientMode {
+      //! contract the stored gradients of the representation
+      Forward,
+      //! back-propagate dE/dX_i without storing any gradient
+      Adjoint
+    };
+
+    /**
+     * @param calculator_hypers hypers of the representation, the gradients
+     *          are always computed
+     * @param sparse_points sparse points of the model
+     * @param weights regression weights of the model, one per sparse point
+     * @param zeta exponent of the GAP kernel
+     * @param self_contributions baseline of the energy per atomic number
+     * @param gradient_mode how the forces and the virial are computed
+     */
+    SparseGPRPredictor(
+        const Hypers_t & calculator_hypers,
+        const SparsePoints_t & sparse_points, const math::Vector_t & weights,
+        const size_t zeta,
+        const SelfContributions_t & self_contributions = SelfContributions_t{},
+        const GradientMode gradient_mode = GradientMode::Forward)
+        : calculator{make_calculator_hypers(calculator_hypers, gradient_mode)},
+          sparse_points{sparse_points}, weights{weights}, zeta{zeta},
+          self_contributions{self_contributions}, gradient_mode{gradient_mode},
+          sparse_point_scaled{this->sparse_points} {
+      if (static_cast<size_t>(this->weights.size()) !=
+          this->sparse_points.size()) {
+        std::stringstream err_str{};
+        err_str << "The number of weights " << this->weights.size()
+                << " does not match the number of sparse points "
+                << this->sparse_points.size();
+        throw std::runtime_error(err_str.str());
+      }
+      if (this->zeta < 1) {
+        throw std::runtime_error("zeta should be a positive integer");
+      }
+    }
+
+    //! Copy constructor
+    SparseGPRPredictor(const SparseGPRPredictor & other) = delete;
+
+    //! Move constructor
+    SparseGPRPredictor(SparseGPRPredictor && other) = default;
+
+    //! Destructor
+    ~SparseGPRPredictor() = default;
+
+    //! Copy assignment operator
+    SparseGPRPredictor & operator=(const SparseGPRPredictor & other) = delete;
+
+    //! Move assignment operator
+    SparseGPRPredictor & operator=(SparseGPRPredictor && other) = delete;
+
+    /**
+     * Build a predictor from a serialized model, i.e. a json object with
+     * the fields
+     *   "representation": hypers of the representation
+     *   "sparse_points": the sparse points, see to_json(SparsePoints)
+     *   "weights": regression weights
+     *   "zeta": exponent of the GAP kernel
+     *   "self_contributions": (optional) baseline of the energy per atomic
+     *                         number, e.g. {"1": -0.5, "8": -1.0}
+     */
+    static SparseGPRPredictor
+    from_json(const json & model,
+              const GradientMode gradient_mode = GradientMode::Forward) {
+      auto sparse_points{model.at("sparse_points").get<SparsePoints_t>()};
+      auto weights_vec{model.at("weights").get<std::vector<double>>()};
+      math::Vector_t weights{Eigen::Map<math::Vector_t>(
+          weights_vec.data(), static_cast<Eigen::Index>(weights_vec.size()))};
+      SelfContributions_t self_contributions{};
+      if (model.count("self_contributions")) {
+        for (const auto & el : model.at("self_contributions").items()) {
+          self_contributions[std::stoi(el.key())] = el.value().get<double>();
+        }
+      }
+      return SparseGPRPredictor{model.at("representation").get<Hypers_t>(),
+                                sparse_points,
+                                weights,
+                                model.at("zeta").get<size_t>(),
+                                self_contributions,
+                                gradient_mode};
+    }
+
+    /**
+     * Compute the representation of manager and predict its energy, forces
+     * and virial.
+     *
+     * @param manager shared pointer to a structure manager with a full
+     *          neighbour list
+     */
+    template <class StructureManager>
+    SparseGPRPrediction predict(StructureManager & manager) {
+      SparseGPRPrediction prediction{};
+      prediction.forces = math::Matrix_t::Zero(manager->size(), ThreeD);
+      this->predict_contributions(
+          manager,
+          [&prediction](auto & /*center*/, double energy) {
+            prediction.energy += energy;
+          },
+          [this, &prediction](auto & center, const auto & pair_gradients) {
+            this->accumulate_pair_gradients(center, pair_gradients,
+                                            prediction);
+          });
+      this->set_stress(manager, prediction);
+      return prediction;
+    }
+
+    /**
+     * Compute the representation of manager and hand the contributions of
+     * each center to the callbacks, e.g. for a MD code that owns the forces
+     * and the virial and whose neighbours can be ghost atoms.
+     *
+     * @param manager shared pointer to a structure manager with a full
+     *          neighbour list
+     * @param energy_callback called as energy_callback(center, E_i) with
+     *          the energy of the center, baseline included
+     * @param pair_gradients_callback called as
+     *          pair_gradients_callback(center, pair_gradients) with the
+     *          partial gradients dE_i/dr_j, one row per pair of
+     *          center.pairs_with_self_pair(). It might not be called for
+     *          the centers without sparse points of their species.
+     */
+    template <class StructureManager, class EnergyCallback,
+              class PairGradientsCallback>
+    void
+    predict_contributions(StructureManager & manager,
+                          EnergyCallback && energy_callback,
+                          PairGradientsCallback && pair_gradients_callback) {
+      if (this->gradient_mode == GradientMode::Adjoint) {
+        this->predict_contributions_adjoint(manager, energy_callback,
+                                            pair_gradients_callback);
+        return;
+      }
+      using Manager_t = typename StructureManager::element_type;
+      using Property_t =
+          typename SparsePoints_t::template Property_t<Manager_t>;
+      using PropertyGradient_t =
+          typename SparsePoints_t::template PropertyGradient_t<Manager_t>;
+
+      this->calculator.compute(manager);
+      auto && prop{*manager->template get_property<Property_t>(
+          this->calculator.get_name(), true)};
+      auto && prop_grad{*manager->template get_property<PropertyGradient_t>(
+          this->calculator.get_gradient_name(), true)};
+
+      const bool do_block_by_key_dot{prop_grad.are_keys_uniform()};
+      const auto & species = this->sparse_points.species();
+      auto & sparse_point_scaled = this->sparse_point_scaled;
+      sparse_point_scaled.set_keys(this->sparse_points, prop_grad.get_keys());
+
+      size_t i_row{0};
+      for (auto center : manager) {
+        const int a_sp{center.get_atom_type()};
+        const Eigen::Index n_neigh{
+            static_cast<Eigen::Index>(center.pairs_with_self_pair().size())};
+        if (species.count(a_sp) == 0) {
+          energy_callback(center, this->get_self_contribution(a_sp));
+          // no sparse point of this species, the gradients of the center
+          // still have to be skipped
+          if (do_block_by_key_dot) {
+            i_row += n_neigh;
+          }
+          continue;
+        }
+        energy_callback(center, this->get_self_contribution(a_sp) +
+                                    sparse_point_scaled.compute(
+                                        this->sparse_points, this->weights,
+                                        this->zeta, a_sp, prop[center]));
+
+        sparse_point_scaled.reserve_neighbours(n_neigh);
+        auto pair_gradients =
+            sparse_point_scaled.pair_gradients.topRows(n_neigh);
+        pair_gradients.setZero();
+        internal::contract_gap_pair_gradients(
+            sparse_point_scaled, prop_grad, center, do_block_by_key_dot, i_row,
+            [&pair_gradients](auto & /*neigh*/, int i_neigh, int i_der,
+                              double fij) {
+              pair_gradients(i_neigh, i_der) += fij;
+            });
+        pair_gradients_callback(center, pair_gradients);
+      }  // center
+    }
+
+    //! calculator used to compute the representation
+    Calculator & get_calculator() { return this->calculator; }
+
+    const SparsePoints_t & get_sparse_points() const {
+      return this->sparse_points;
+    }
+
+    const math::Vector_t & get_weights() const { return this->weights; }
+
+    size_t get_zeta() const { return this->zeta; }
+
+    GradientMode get_gradient_mode() const { return this->gradient_mode; }
+
+   protected:
+    /**
+     * predict_contributions() with GradientMode::Adjoint, the sparse points
+     * scaled by the weights give dE/dX_i which is handed to the calculator
+     * to be back-propagated
+     */
+    template <class StructureManager, class EnergyCallback,
+              class PairGradientsCallback>
+    void predict_contributions_adjoint(
+        StructureManager & manager, EnergyCallback & energy_callback,
+        PairGradientsCallback & pair_gradients_callback) {
+      using Manager_t = typename StructureManager::element_type;
+      using Property_t =
+          typename SparsePoints_t::template Property_t<Manager_t>;
+
+      this->calculator.compute(manager);
+      auto && prop{*manager->template get_property<Property_t>(
+          this->calculator.get_name(), true)};
+
+      const auto & species = this->sparse_points.species();
+      auto & sparse_point_scaled = this->sparse_point_scaled;
+      sparse_point_scaled.set_keys(this->sparse_points, prop.get_keys());
+      const Eigen::Index inner_size{sparse_point_scaled.inner_size};
+
+      this->calculator.contract_gradients(
+          manager,
+          [&](auto & center, auto & soap_vector_adjoint) {
+            const int a_sp{center.get_atom_type()};
+            if (species.count(a_sp) == 0) {
+              energy_callback(center, this->get_self_contribution(a_sp));
+              return;
+            }
+            // dE/dX_i = \sum_n \alpha_n^{scaled} T_n
+            energy_callback(center, this->get_self_contribution(a_sp) +
+                                        sparse_point_scaled.compute(
+                                            this->sparse_points, this->weights,
+                                            this->zeta, a_sp, prop[center]));
+            for (const auto & key_block :
+                 sparse_point_scaled.key_blocks.at(a_sp)) {
+              if (soap_vector_adjoint.count(key_block.first) == 0) {
+                continue;
+              }
+              Eigen::Map<math::Vector_t>(
+                  soap_vector_adjoint[key_block.first].data(), inner_size) =
+                  sparse_point_scaled.get_block(a_sp, key_block.second)
+                      .transpose()
+                      .template cast<double>();
+            }
+          },
+          pair_gradients_callback);
+    }
+
+    //! baseline of the energy of an atom of type a_sp
+    double get_self_contribution(const int a_sp) const {
+      auto it{this->self_contributions.find(a_sp)};
+      return it == this->self_contributions.end() ? 0. : it->second;
+    }
+
+    /**
+     * Add the partial gradients dE_i/dr_j of the pairs of center, in the
+     * order of center.pairs_with_self_pair(), to the forces and the virial
+     */
+    template <class Center, class PairGradients>
+    void accumulate_pair_gradients(Center & center,
+                                   const PairGradients & pair_gradients,
+                                   SparseGPRPrediction & prediction) const {
+      // the off diagonal terms of the virial are filled like in
+      // compute_sparse_kernel_neg_stress, i.e. xz, xy and yz are
+      // computed together with the z, x and y derivatives
+      const std::array<std::array<int, 2>, ThreeD> voigt_id_to_spatial_dim = {
+          {{{4, 2}}, {{5, 0}}, {{3, 1}}}};
+      Eigen::Vector3d r_i = center.get_position();
+      int i_neigh{0};
+      for (auto neigh : center.pairs_with_self_pair()) {
+        const auto atom_j_tag{neigh.get_atom_j().get_atom_tag()};
+        prediction.forces.row(atom_j_tag) -= pair_gradients.row(i_neigh);
+        Eigen::Vector3d r_ji = r_i - neigh.get_position();
+        for (int i_der{0}; i_der < ThreeD; i_der++) {
+          const auto & voigt = voigt_id_to_spatial_dim[i_der];
+          prediction.virial(i_der) -=
+              r_ji(i_der) * pair_gradients(i_neigh, i_der);
+          prediction.virial(voigt[0]) -=
+              r_ji(voigt[1]) * pair_gradients(i_neigh, i_der);
+        }
+        i_neigh++;
+      }
+    }
+
+    //! stress of periodic structures
+    template <class StructureManager>
+    void set_stress(StructureManager & manager,
+                    SparseGPRPrediction & prediction) const {
+      auto manager_root = extract_underlying_manager<0>(manager);
+      auto atomic_structure{manager_root->get_atomic_structure()};
+      if (atomic_structure.pbc.any()) {
+        prediction.stress = prediction.virial / atomic_structure.get_volume();
+      }
+    }
+
+    /**
+     * the forward mode needs the gradients of the representation, which is
+     * stored with the precision of the sparse points
+     */
+    static Hypers_t make_calculator_hypers(const Hypers_t & hypers,
+                                           const GradientMode gradient_mode) {
+      Hypers_t calculator_hypers = hypers;
+      calculator_hypers["compute_gradients"] =
+          gradient_mode == GradientMode::Forward;
+      if (not std::is_same<Precision, double>::value) {
+        calculator_hypers["single_precision"] = true;
+      }
+      return calculator_hypers;
+    }
+
+    Calculator calculator;
+    SparsePoints_t sparse_points;
+    //! regression weights, one per sparse point
+    math::Vector_t weights;
+    size_t zeta;
+    SelfContributions_t self_contributions;
+    GradientMode gradient_mode;
+
+    //! scratch memory reused between the centers and the calls
+    internal::GAPScaledSparsePoints<SparsePoints_t> sparse_point_scaled;
+  };
 }  // namespace rascal
 #endif  // SRC_RASCAL_MODELS_SPARSE_KERNEL_PREDICT_HH_
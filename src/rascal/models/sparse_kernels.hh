@@ -109,19 +109,16 @@ namespace rascal {
                              const std::string & representation_name) {
         math::Matrix_t KNM(managers.size(), sparse_points.size());
         KNM.setZero();
-        size_t ii_A{0};
-        for (auto & manager : managers) {
-          auto && propA{*manager->template get_property<Property_t>(
-              representation_name, true)};
-          for (auto center : manager) {
-            int sp = center.get_atom_type();
-            // only the pseudo points of species sp contribute
-            KNM.row(ii_A) +=
-                pow_zeta(sparse_points.dot(sp, propA[center]), this->zeta)
-                    .transpose();
-          }
-          ++ii_A;
-        }
+        this->template compute_by_batch<Property_t>(
+            managers, sparse_points, representation_name,
+            [&KNM](const auto & KNM_batch, const int offset,
+                   const std::vector<size_t> & /*centers*/,
+                   const std::vector<size_t> & structures) {
+              for (size_t i_row{0}; i_row < structures.size(); ++i_row) {
+                KNM.block(structures[i_row], offset, 1, KNM_batch.cols()) +=
+                    KNM_batch.row(i_row);
+              }
+            });
         return KNM;
       }
 
@@ -173,19 +170,146 @@ namespace rascal {
         }
         size_t nb_sparse_points{sparse_points.size()};
         math::Matrix_t KNM(n_centersA, nb_sparse_points);
-        size_t ii_A{0};
+        KNM.setZero();
+        this->template compute_by_batch<Property_t>(
+            managers, sparse_points, representation_name,
+            [&KNM](const auto & KNM_batch, const int offset,
+                   const std::vector<size_t> & centers,
+                   const std::vector<size_t> & /*structures*/) {
+              for (size_t i_row{0}; i_row < centers.size(); ++i_row) {
+                KNM.block(centers[i_row], offset, 1, KNM_batch.cols()) =
+                    KNM_batch.row(i_row);
+              }
+            });
+        return KNM;
+      }
+
+      //! maximum number of centers of a species computed together
+      constexpr static const size_t BatchSize{128};
+
+      /**
+       * Compute the kernel between the centers of managers and the sparse
+       * points by batches of centers of the same species.
+       *
+       * For each key, the features of the centers of a batch are gathered
+       * in a contiguous panel that is multiplied with the block of the
+       * sparse points of the same species and key in one matrix-matrix
+       * product, instead of one matrix-vector product per center and key.
+       *
+       * Each batch is handed to
+       * consume(KNM_batch, offset, centers, structures) where KNM_batch is
+       * the kernel between the centers of the batch and the sparse points of
+       * their species, which start at column offset in K_{NM}, and centers
+       * and structures are the indices (over all managers) of the center
+       * and of the structure of each row. Centers whose species has no
+       * sparse point are skipped since their kernel is zero.
+       */
+      template <class Property_t, class StructureManagers, class SparsePoints,
+                class Consumer>
+      void compute_by_batch(const StructureManagers & managers,
+                            const SparsePoints & sparse_points,
+                            const std::string & representation_name,
+                            Consumer && consume) const {
+        using Key_t = typename SparsePoints::Key_t;
+        // the panels are products of blocks stored with the precision of
+        // the sparse points and the representation
+        using Block_t = typename SparsePoints::Block_t;
+        const auto inner_size{
+            static_cast<Eigen::Index>(sparse_points.inner_size)};
+
+        //! centers of one species waiting to be computed
+        struct Batch {
+          //! features of the centers by key [n_rows, inner_size]
+          std::map<Key_t, Block_t> panels{};
+          //! row in the batch of each row of the panels
+          std::map<Key_t, std::vector<int>> panel_rows{};
+          std::vector<size_t> centers{};
+          std::vector<size_t> structures{};
+          math::Matrix_t KNM{};
+        };
+        std::map<int, Batch> batches{};
+        for (const int & sp : sparse_points.species()) {
+          auto & batch = batches[sp];
+          for (const Key_t & key : sparse_points.keys_sp.at(sp)) {
+            batch.panels[key].resize(BatchSize, inner_size);
+            batch.panel_rows[key].reserve(BatchSize);
+          }
+          batch.centers.reserve(BatchSize);
+          batch.structures.reserve(BatchSize);
+          batch.KNM.resize(BatchSize, sparse_points.size_by_species(sp));
+        }
+        const auto offsets{sparse_points.get_offsets()};
+        Block_t KNM_key{};
+
+        auto compute_batch = [&](const int sp, Batch & batch) {
+          const auto n_rows{static_cast<Eigen::Index>(batch.centers.size())};
+          const auto & values_by_sp = sparse_points.values.at(sp);
+          const auto & indices_by_sp = sparse_points.indices.at(sp);
+          batch.KNM.setZero();
+          for (auto & key_rows : batch.panel_rows) {
+            auto & rows = key_rows.second;
+            if (rows.empty()) {
+              continue;
+            }
+            const Key_t & key{key_rows.first};
+            const auto & indices_by_sp_key = indices_by_sp.at(key);
+            auto mat = Eigen::Map<const Block_t>(
+                values_by_sp.at(key).data(),
+                static_cast<Eigen::Index>(indices_by_sp_key.size()),
+                inner_size);
+            const auto n_key_rows{static_cast<Eigen::Index>(rows.size())};
+            KNM_key.noalias() =
+                batch.panels.at(key).topRows(n_key_rows) * mat.transpose();
+            for (Eigen::Index i_row{0}; i_row < n_key_rows; ++i_row) {
+              for (Eigen::Index i_col{0}; i_col < KNM_key.cols(); ++i_col) {
+                batch.KNM(rows[i_row], indices_by_sp_key[i_col]) +=
+                    KNM_key(i_row, i_col);
+              }
+            }
+            rows.clear();
+          }
+          batch.KNM = pow_zeta(std::move(batch.KNM), this->zeta);
+          consume(batch.KNM.topRows(n_rows), offsets.at(sp), batch.centers,
+                  batch.structures);
+          batch.centers.clear();
+          batch.structures.clear();
+        };
+
+        size_t i_center{0};
+        size_t i_structure{0};
         for (auto & manager : managers) {
           auto && propA{*manager->template get_property<Property_t>(
               representation_name, true)};
           for (auto center : manager) {
-            int sp = center.get_atom_type();
-            KNM.row(ii_A) =
-                pow_zeta(sparse_points.dot(sp, propA[center]), this->zeta)
-                    .transpose();
-            ii_A++;
+            const int sp{center.get_atom_type()};
+            auto batch_it = batches.find(sp);
+            if (batch_it != batches.end()) {
+              auto & batch = batch_it->second;
+              const int i_row{static_cast<int>(batch.centers.size())};
+              auto && rep = propA[center];
+              for (auto & key_rows : batch.panel_rows) {
+                const Key_t & key{key_rows.first};
+                if (rep.count(key)) {
+                  auto & rows = key_rows.second;
+                  batch.panels.at(key).row(rows.size()) = rep.flat(key);
+                  rows.push_back(i_row);
+                }
+              }
+              batch.centers.push_back(i_center);
+              batch.structures.push_back(i_structure);
+              if (batch.centers.size() == BatchSize) {
+                compute_batch(sp, batch);
+              }
+            }
+            ++i_center;
+          }
+          ++i_structure;
+        }
+        for (auto & sp_batch : batches) {
+          if (not sp_batch.second.centers.empty()) {
+            compute_batch(sp_batch.first, sp_batch.second);
           }
         }
-        return KNM;
       }
 
       /**
@@ -267,6 +391,7 @@ namespace rascal {
         using Manager_t = typename StructureManagers::Manager_t;
         using Keys_t = typename SparsePoints::Keys_t;
         using Key_t = typename SparsePoints::Key_t;
+        using Block_t = typename SparsePoints::Block_t;
         // the nb of rows of the kernel matrix consist of:
         // - 3*nb_centers rows for each center for each spatial_dim
         // - 6 rows at the end for the stress tensor in voigt notation if
@@ -375,7 +500,7 @@ namespace rascal {
               for (const Key_t & key : keys_intersect.at(a_species)) {
                 const auto & indices_by_sp_key = indices_by_sp.at(key);
                 const auto & values_by_sp_key = values_by_sp.at(key);
-                auto sparse_points_block = Eigen::Map<const math::Matrix_t>(
+                auto sparse_points_block = Eigen::Map<const Block_t>(
                     values_by_sp_key.data(),
                     static_cast<Eigen::Index>(indices_by_sp_key.size()),
                     static_cast<Eigen::Index>(block_size));
@@ -399,11 +524,12 @@ namespace rascal {
                      idx_spatial_dim++) {
                   // dX/dr * T
                   KNM_der_block =
-                      repr_grads.block(idx_row,
-                                       block_start_col_idx +
-                                           idx_spatial_dim * block_size,
-                                       nb_rows, block_size) *
-                      sparse_points_block.transpose();
+                      (repr_grads.block(idx_row,
+                                        block_start_col_idx +
+                                            idx_spatial_dim * block_size,
+                                        nb_rows, block_size) *
+                       sparse_points_block.transpose())
+                          .template cast<double>();
                   // * zeta * (X * T)**(zeta-1)
                   if (zeta > 1) {
                     KNM_der_block *=
@@ -578,7 +704,8 @@ namespace rascal {
                            const SparsePoints & sparse_points) {
       using ManagerPtr_t = typename StructureManagers::value_type;
       using Manager_t = typename ManagerPtr_t::element_type;
-      using Property_t = typename Calculator::template Property_t<Manager_t>;
+      using Property_t =
+          typename SparsePoints::template Property_t<Manager_t>;
       auto && representation_name{calculator.get_name()};
       using internal::TargetType;
 
@@ -697,9 +824,10 @@ namespace rascal {
                                       const bool compute_neg_stress) {
       using ManagerPtr_t = typename StructureManagers::value_type;
       using Manager_t = typename ManagerPtr_t::element_type;
-      using Property_t = typename Calculator::template Property_t<Manager_t>;
+      using Property_t =
+          typename SparsePoints::template Property_t<Manager_t>;
       using PropertyGradient_t =
-          typename Calculator::template PropertyGradient_t<Manager_t>;
+          typename SparsePoints::template PropertyGradient_t<Manager_t>;
       if (not calculator.does_gradients()) {
         throw std::runtime_error(
             "This representation does not compute gradients.");
@@ -33,6 +33,10 @@
 #include "rascal/structure_managers/structure_manager_collection.hh"
 #include "rascal/utils/json_io.hh"
 
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+
 namespace rascal {
 
   /**
@@ -44,22 +48,31 @@ namespace rascal {
    * Pseudo points are useful to build sparse kernel models such as Subset of
    * Regressors. This class is tailored for building property models that
    * depend on the type of the central atom.
+   *
+   * The pseudo points are stored with Precision, i.e. float to halve their
+   * memory footprint, and the kernels built from them are in double
+   * precision. The representations they are compared with are expected to
+   * be stored with the same Precision.
    */
-  template <class Calculator>
+  template <class Calculator, typename Precision = double>
   class SparsePointsBlockSparse {
    public:
+    using Precision_t = Precision;
     using Key_t = typename CalculatorBase::Key_t;
     using Keys_t = std::set<Key_t>;
-    using Data_t = std::map<int, std::map<Key_t, std::vector<double>>>;
+    using Data_t = std::map<int, std::map<Key_t, std::vector<Precision_t>>>;
     using Indices_t = std::map<int, std::map<Key_t, std::vector<size_t>>>;
     using Counters_t = std::map<int, size_t>;
+    //! block of features of the pseudo points of one [sp][key]
+    using Block_t = Eigen::Matrix<Precision_t, Eigen::Dynamic, Eigen::Dynamic,
+                                  Eigen::RowMajor>;
 
     template <class StructureManager>
-    using Property_t =
-        typename Calculator::template Property_t<StructureManager>;
+    using Property_t = typename Calculator::template Property_t<
+        StructureManager>::template WithPrecision_t<Precision_t>;
     template <class StructureManager>
-    using PropertyGradient_t =
-        typename Calculator::template PropertyGradient_t<StructureManager>;
+    using PropertyGradient_t = typename Calculator::template PropertyGradient_t<
+        StructureManager>::template WithPrecision_t<Precision_t>;
 
     /**
      * Container for the actual data. By construction it gathers pseudo points
@@ -101,7 +114,36 @@ namespace rascal {
     //! Move constructor
     SparsePointsBlockSparse(SparsePointsBlockSparse && other) = default;
 
-    bool operator==(const SparsePointsBlockSparse<Calculator> & other) const {
+    //! Convert pseudo points stored with another precision
+    template <typename OtherPrecision>
+    explicit SparsePointsBlockSparse(
+        const SparsePointsBlockSparse<Calculator, OtherPrecision> & other)
+        : indices{other.indices}, counters{other.counters},
+          inner_size{other.inner_size}, center_species{other.center_species},
+          keys{other.keys}, keys_sp{other.keys_sp} {
+      for (const auto & values_by_sp : other.values) {
+        for (const auto & values_by_sp_key : values_by_sp.second) {
+          this->values[values_by_sp.first][values_by_sp_key.first].assign(
+              values_by_sp_key.second.begin(), values_by_sp_key.second.end());
+        }
+      }
+    }
+
+    /**
+     * Name of the type used to check the serialized objects. The double
+     * precision one is kept to the name it had before Precision was added.
+     */
+    static std::string get_type_name() {
+      std::string name{"rascal::SparsePointsBlockSparse<"};
+      name += internal::type_name_demangled(typeid(Calculator).name());
+      if (not std::is_same<Precision_t, double>::value) {
+        name += ", ";
+        name += internal::type_name_demangled(typeid(Precision_t).name());
+      }
+      return name + ">";
+    }
+
+    bool operator==(const SparsePointsBlockSparse & other) const {
       if ((values == other.values) and (indices == other.indices) and  // NOLINT
           (counters == other.counters) and                             // NOLINT
           (inner_size == other.inner_size) and                         // NOLINT
@@ -147,17 +189,16 @@ namespace rascal {
       const auto & indices_by_sp = this->indices.at(sp);
       for (const Key_t & key : this->keys_sp.at(sp)) {
         const auto & indices_by_sp_key = indices_by_sp.at(key);
-        auto mat = Eigen::Map<const math::Matrix_t>(
+        auto mat = Eigen::Map<const Block_t>(
             values_by_sp.at(key).data(),
             static_cast<Eigen::Index>(indices_by_sp_key.size()),
             static_cast<Eigen::Index>(this->inner_size));
         // the following does the same as:
         // auto KMM_by_key = (mat * mat.transpose()).eval();
-        math::Matrix_t KMM_by_key(indices_by_sp_key.size(),
-                                  indices_by_sp_key.size());
-        KMM_by_key =
-            KMM_by_key.setZero().selfadjointView<Eigen::Upper>().rankUpdate(
-                mat);
+        Block_t KMM_by_key(indices_by_sp_key.size(), indices_by_sp_key.size());
+        KMM_by_key = KMM_by_key.setZero()
+                         .template selfadjointView<Eigen::Upper>()
+                         .rankUpdate(mat);
         for (int i_row{0}; i_row < KMM_by_key.rows(); i_row++) {
           for (int i_col{0}; i_col < KMM_by_key.cols(); i_col++) {
             KMM_by_sp(indices_by_sp_key[i_row], indices_by_sp_key[i_col]) +=
@@ -180,42 +221,43 @@ namespace rascal {
     dot(const int & sp,
         internal::InternallySortedKeyMap<Key_t, Val> & representation) const {
       ColVector_t KNM_row(this->size());
+      this->dot_into(sp, representation, KNM_row);
+      return KNM_row;
+    }
+
+    /**
+     * Same as dot(sp, representation) but the row of K_{NM} is written in
+     * the preallocated KNM_row of size M.
+     */
+    template <class Val>
+    void dot_into(const int & sp,
+                  internal::InternallySortedKeyMap<Key_t, Val> & representation,
+                  ColVector_t & KNM_row) const {
+      assert(static_cast<size_t>(KNM_row.size()) == this->size());
       KNM_row.setZero();
       if (this->center_species.count(sp) == 0) {
         // the type of the central atom is not in the pseudo points
-        return KNM_row;
+        return;
       }
 
       const auto & values_by_sp = this->values.at(sp);
       const auto & indices_by_sp = this->indices.at(sp);
+      const int offset{this->get_offset(sp)};
 
-      int offset{0};
-      for (const int & csp : this->center_species) {
-        if (csp == sp) {
-          break;
-        } else {
-          offset += this->counters.at(csp);
-        }
-      }
-
-      Keys_t keys_intersect{internal::set_intersection(
-          representation.get_keys(), this->keys_sp.at(sp))};
-
-      for (const Key_t & key : keys_intersect) {
+      for (const Key_t & key : this->keys_sp.at(sp)) {
         if (representation.count(key)) {
           auto rep_flat_by_key{representation.flat(key)};
           const auto & indices_by_sp_key = indices_by_sp.at(key);
-          auto mat = Eigen::Map<const math::Matrix_t>(
+          auto mat = Eigen::Map<const Block_t>(
               values_by_sp.at(key).data(),
               static_cast<Eigen::Index>(indices_by_sp_key.size()),
               static_cast<Eigen::Index>(this->inner_size));
-          auto KNM_row_key = (mat * rep_flat_by_key.transpose()).eval();
-          for (int i_row{0}; i_row < KNM_row_key.size(); i_row++) {
-            KNM_row(offset + indices_by_sp_key[i_row]) += KNM_row_key(i_row);
+          for (int i_row{0}; i_row < mat.rows(); i_row++) {
+            KNM_row(offset + indices_by_sp_key[i_row]) += mat.row(i_row).dot(
+                rep_flat_by_key.template cast<Precision_t>());
           }
         }
       }
-      return KNM_row;
     }
 
     /**
@@ -225,8 +267,7 @@ namespace rascal {
      * sp.
      * @return a sparse point with one row
      */
-    SparsePointsBlockSparse<Calculator> dot(const int & sp,
-                                            math::Vector_t & vec) const {
+    SparsePointsBlockSparse dot(const int & sp, math::Vector_t & vec) const {
       const auto & values_by_sp = this->values.at(sp);
       const auto & indices_by_sp = this->indices.at(sp);
       int n_feature{
@@ -258,18 +299,53 @@ namespace rascal {
         for (size_t i_col{0}; i_col < indices_by_sp_key.size(); i_col++) {
           vec_subset(i_col) = vec(offset + indices_by_sp_key[i_col]);
         }
-        auto mat = Eigen::Map<const math::Matrix_t>(
+        auto mat = Eigen::Map<const Block_t>(
             values_by_sp.at(key).data(),
             static_cast<Eigen::Index>(indices_by_sp_key.size()),
             static_cast<Eigen::Index>(this->inner_size));
 
-        res_map_by_key = vec_subset * mat;
+        res_map_by_key = (vec_subset.template cast<Precision_t>() * mat)
+                             .template cast<double>();
       }
 
       out.push_back(res_map, sp);
       return out;
     }
 
+    using RowVector_t = Eigen::Matrix<Precision_t, 1, Eigen::Dynamic>;
+    /**
+     * Same as dot(sp, vec) without building a new SparsePointsBlockSparse:
+     * the features of \sum_n vec_n T_n are written in the preallocated out
+     * of size keys_sp.at(sp).size() * inner_size, one block of inner_size
+     * after the other in the order of keys_sp.at(sp).
+     */
+    void dot_into(const int & sp, const math::Vector_t & vec,
+                  RowVector_t & out) const {
+      assert(static_cast<size_t>(out.size()) ==
+             this->keys_sp.at(sp).size() * this->inner_size);
+      const auto & values_by_sp = this->values.at(sp);
+      const auto & indices_by_sp = this->indices.at(sp);
+      const int offset{this->get_offset(sp)};
+      const Eigen::Index inner_size{
+          static_cast<Eigen::Index>(this->inner_size)};
+
+      Eigen::Index i_col{0};
+      for (const Key_t & key : this->keys_sp.at(sp)) {
+        const auto & indices_by_sp_key = indices_by_sp.at(key);
+        auto mat = Eigen::Map<const Block_t>(
+            values_by_sp.at(key).data(),
+            static_cast<Eigen::Index>(indices_by_sp_key.size()), inner_size);
+        auto out_by_key = out.segment(i_col, inner_size);
+        out_by_key.setZero();
+        for (int i_row{0}; i_row < mat.rows(); i_row++) {
+          out_by_key += static_cast<Precision_t>(
+                            vec(offset + indices_by_sp_key[i_row])) *
+                        mat.row(i_row);
+        }
+        i_col += inner_size;
+      }
+    }
+
     using ColVectorDer_t =
         Eigen::Matrix<double, Eigen::Dynamic, ThreeD, Eigen::ColMajor>;
     /**
@@ -306,15 +382,16 @@ namespace rascal {
         // get the representation gradient features and shape it
         // assumes the gradient directions are the outermost index
         auto rep_grad_flat_by_key{representation_grad.flat(key)};
-        Eigen::Map<const Eigen::Matrix<double, ThreeD, Eigen::Dynamic,
-                                       Eigen::RowMajor>>
-            rep_grad_by_key(rep_grad_flat_by_key.data(), ThreeD,
-                            this->inner_size);
+        using RepPrecision_t = typename decltype(rep_grad_flat_by_key)::Scalar;
+        using RepGrad_t = Eigen::Matrix<RepPrecision_t, ThreeD, Eigen::Dynamic,
+                                        Eigen::RowMajor>;
+        Eigen::Map<const RepGrad_t> rep_grad_by_key(
+            rep_grad_flat_by_key.data(), ThreeD, this->inner_size);
         assert(rep_grad_flat_by_key.size() ==
                static_cast<int>(ThreeD * this->inner_size));
         const auto & indices_by_sp_key = indices_by_sp.at(key);
         // get the block of pseudo points features
-        auto mat = Eigen::Map<const math::Matrix_t>(
+        auto mat = Eigen::Map<const Block_t>(
             values_by_sp.at(key).data(),
             static_cast<Eigen::Index>(indices_by_sp_key.size()),
             static_cast<Eigen::Index>(this->inner_size));
@@ -323,7 +400,9 @@ namespace rascal {
         // compute the product between pseudo points and representation
         // gradient block
         ColVectorDer_t KNM_row_key(indices_by_sp_key.size(), ThreeD);
-        KNM_row_key = (mat * rep_grad_by_key.transpose());
+        KNM_row_key =
+            (mat * rep_grad_by_key.transpose().template cast<Precision_t>())
+                .template cast<double>();
         // dispatach kernel partial elements to the proper pseudo points
         // indices
         for (int i_dim{0}; i_dim < ThreeD; i_dim++) {
@@ -336,6 +415,18 @@ namespace rascal {
       return KNM_row;
     }
 
+    //! offset of the sparse points of species sp along the M direction
+    int get_offset(const int & sp) const {
+      int offset{0};
+      for (const int & csp : this->center_species) {
+        if (csp == sp) {
+          break;
+        }
+        offset += this->counters.at(csp);
+      }
+      return offset;
+    }
+
     //! get offsets alongs the sparse points direction
     std::map<int, int> get_offsets() const {
       int offset{0};
@@ -397,7 +488,8 @@ namespace rascal {
         auto & values_by_sp_key = values_by_sp[key];
         auto pseudo_point_by_key = pseudo_point.flat(key);
         for (int ii{0}; ii < pseudo_point_by_key.size(); ++ii) {
-          values_by_sp_key.push_back(pseudo_point_by_key[ii]);
+          values_by_sp_key.push_back(
+              static_cast<Precision_t>(pseudo_point_by_key[ii]));
         }
         indices_by_sp[key].push_back(counters_by_sp);
         if (this->inner_size == 0) {
@@ -429,13 +521,14 @@ namespace rascal {
         size_t i_col{0};
         for (const auto & key : this->keys) {
           if (values_by_sp.count(key)) {
-            Eigen::Map<const math::Matrix_t> block{
+            Eigen::Map<const Block_t> block{
                 values_by_sp.at(key).data(),
                 static_cast<Eigen::Index>(indices_by_sp.at(key).size()),
                 static_cast<Eigen::Index>(this->inner_size)};
             for (size_t ii{0}; ii < indices_by_sp.at(key).size(); ii++) {
               mat.block(i_row + indices_by_sp.at(key)[ii], i_col, 1,
-                        this->inner_size) = block.row(ii);
+                        this->inner_size) =
+                  block.row(ii).template cast<double>();
             }
           }
           i_col += this->inner_size;
@@ -451,11 +544,11 @@ namespace rascal {
    * is an overload of the function defined in the header class
    * json.hpp.
    */
-  template <class Calculator>
-  void to_json(json & j,
-               const SparsePointsBlockSparse<Calculator> & sparse_points) {
-    j["name"] = internal::type_name_demangled(
-        typeid(SparsePointsBlockSparse<Calculator>).name());
+  template <class Calculator, typename Precision>
+  void to_json(
+      json & j,
+      const SparsePointsBlockSparse<Calculator, Precision> & sparse_points) {
+    j["name"] = SparsePointsBlockSparse<Calculator, Precision>::get_type_name();
     j["values"] = sparse_points.values;
     j["indices"] = sparse_points.indices;
     j["counters"] = sparse_points.counters;
@@ -470,16 +563,17 @@ namespace rascal {
    * the data into standard types. Overload of the function defined in
    * json.hpp class header.
    */
-  template <class Calculator>
-  void from_json(const json & j,
-                 SparsePointsBlockSparse<Calculator> & sparse_points) {
-    using Data_t = typename SparsePointsBlockSparse<Calculator>::Data_t;
-    using Indices_t = typename SparsePointsBlockSparse<Calculator>::Indices_t;
-    using Counters_t = typename SparsePointsBlockSparse<Calculator>::Counters_t;
-    using Key_t = typename SparsePointsBlockSparse<Calculator>::Key_t;
-
-    std::string name{internal::type_name_demangled(
-        typeid(SparsePointsBlockSparse<Calculator>).name())};
+  template <class Calculator, typename Precision>
+  void
+  from_json(const json & j,
+            SparsePointsBlockSparse<Calculator, Precision> & sparse_points) {
+    using SparsePoints_t = SparsePointsBlockSparse<Calculator, Precision>;
+    using Data_t = typename SparsePoints_t::Data_t;
+    using Indices_t = typename SparsePoints_t::Indices_t;
+    using Counters_t = typename SparsePoints_t::Counters_t;
+    using Key_t = typename SparsePoints_t::Key_t;
+
+    std::string name{SparsePoints_t::get_type_name()};
     if (name != j.at("name").get<std::string>()) {
       std::stringstream err_str{};
       err_str << "The saved object name does not match the asked type: '"
@@ -30,11 +30,14 @@
 #include "rascal/structure_managers/property_block_sparse.hh"
 #include "rascal/structure_managers/structure_manager_base.hh"
 #include "rascal/utils/json_io.hh"
+#include "rascal/utils/threading.hh"
 
 #include <Eigen/Dense>
 
 #include <iostream>
+#include <iterator>
 #include <set>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -61,7 +64,8 @@ namespace rascal {
     CalculatorBase(CalculatorBase && other) noexcept
         : name{std::move(other.name)}, default_prefix{std::move(
                                            other.default_prefix)},
-          hypers{}, options{std::move(other.options)} {
+          hypers{}, options{std::move(other.options)},
+          n_threads{other.n_threads} {
       this->hypers = std::move(other.hypers);
     }
 
@@ -110,6 +114,44 @@ namespace rascal {
       }
     }
 
+    /**
+     * Set the number of threads used to compute the representation.
+     * 1 (default) keeps the computation serial and 0 uses the default of the
+     * OpenMP runtime (e.g. OMP_NUM_THREADS). It has no effect when the
+     * library is compiled without OpenMP support.
+     *
+     * A collection of structures is split among the threads one structure at
+     * a time, otherwise the centers of the structure are.
+     */
+    virtual void set_n_threads(int n_threads) {
+      if (n_threads < 0) {
+        throw std::invalid_argument("n_threads should be >= 0");
+      }
+      this->n_threads = n_threads;
+    }
+
+    //! number of threads that will actually be used by the calculator
+    int get_n_threads() const {
+      return internal::get_n_threads(this->n_threads);
+    }
+
+    /**
+     * Number of threads to use to loop over a collection of structures.
+     * It is 1 when there are fewer structures than threads since the threads
+     * are then better used on the centers of each structure.
+     */
+    template <class StructureManagers>
+    int get_n_threads_for_structures(const StructureManagers & managers) const {
+      const int n_threads{this->get_n_threads()};
+      const auto n_structures{
+          std::distance(std::begin(managers), std::end(managers))};
+      if (n_threads > 1 and n_structures >= n_threads and
+          not internal::in_parallel()) {
+        return n_threads;
+      }
+      return 1;
+    }
+
     /**
      * Returns if the calculator is able to compute gradients of the
      * representation w.r.t. atomic positions. Default implementation returns
@@ -141,6 +183,10 @@ namespace rascal {
     //! stores the hyperparameters that change
     //! the behaviour of the representation
     std::map<std::string, std::string> options{};
+
+   protected:
+    //! number of threads requested for the computation, see set_n_threads()
+    int n_threads{1};
   };
 
 }  // namespace rascal
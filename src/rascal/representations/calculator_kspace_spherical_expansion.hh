@@ -0,0 +1,585 @@
+/**
+ * @file   rascal/representations/calculator_kspace_spherical_expansion.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   17 October 2026
+ *
+ * @brief  Compute the spherical expansion of the long range potential of the
+ *         smeared atomic densities in reciprocal space
+ *
+ * Copyright  2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_REPRESENTATIONS_CALCULATOR_KSPACE_SPHERICAL_EXPANSION_HH_
+#define SRC_RASCAL_REPRESENTATIONS_CALCULATOR_KSPACE_SPHERICAL_EXPANSION_HH_
+
+#include "rascal/math/kvec_generator.hh"
+#include "rascal/math/spherical_harmonics.hh"
+#include "rascal/math/utils.hh"
+#include "rascal/representations/calculator_base.hh"
+#include "rascal/representations/calculator_spherical_expansion.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/structure_managers/property_block_sparse.hh"
+#include "rascal/structure_managers/structure_manager.hh"
+#include "rascal/utils/threading.hh"
+
+#include <Eigen/Dense>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace rascal {
+
+  namespace internal {
+    /**
+     * Compute e^{-x} 1F1(a; b; x) for x >= 0 from the power series of
+     * 1F1 summed in the log domain, so that neither the terms nor e^{-x}
+     * overflow for the large x of the short wavelengths. The series
+     * terminates when a is a negative integer.
+     */
+    inline double scaled_hyp1f1_series(double a, double b, double x) {
+      constexpr double Tolerance{1e-15};
+      const int max_terms{static_cast<int>(2 * x) + 200};
+      double sum{0.};
+      // log of the absolute value of the term times e^{-x}
+      double log_term{-x};
+      double sign{1.};
+      for (int j{0}; j < max_terms; ++j) {
+        const double term{sign * std::exp(log_term)};
+        sum += term;
+        const double ratio{(a + j) * x / ((b + j) * (j + 1))};
+        if (ratio == 0.) {
+          break;
+        }
+        if (j > x and std::abs(term) < Tolerance * std::abs(sum)) {
+          break;
+        }
+        if (ratio < 0.) {
+          sign = -sign;
+        }
+        log_term += std::log(std::abs(ratio));
+      }
+      return sum;
+    }
+
+    /**
+     * Fourier-Bessel transform of the (non normalized) GTO radial basis
+     * functions r^n e^{-b_n r^2} of the spherical expansion
+     *
+     * \f{equation}{
+     *   J_{nl}(k) = \int_0^\infty r^{2+n} e^{-b_n r^2} j_l(k r) dr
+     *    = \frac{\sqrt{\pi} k^l \Gamma(A)}{2^{l+2} b_n^A \Gamma(B)}
+     *      e^{-x} {}_1F_1(B - A; B; x),
+     * \f}
+     *
+     * with \f$A = (n + l + 3) / 2\f$, \f$B = l + 3 / 2\f$ and
+     * \f$x = k^2 / 4 b_n\f$, where the Kummer transformation of
+     * \f${}_1F_1(A; B; -x)\f$ avoids the cancellations of the alternating
+     * series at large x and \f$B - A = (l - n) / 2\f$.
+     */
+    class KspaceRadialIntegralGTO {
+     public:
+      using Matrix_t = math::Matrix_t;
+
+      void precompute(size_t max_radial, size_t max_angular,
+                      const Eigen::Ref<const Eigen::VectorXd> & fac_b) {
+        using math::PI;
+        this->max_radial = max_radial;
+        this->max_angular = max_angular;
+        this->fac_b = fac_b;
+        this->prefactors.resize(max_radial, max_angular + 1);
+        for (size_t n{0}; n < max_radial; ++n) {
+          for (size_t l{0}; l < max_angular + 1; ++l) {
+            const double A{0.5 * (n + l + 3.)};
+            const double B{l + 1.5};
+            this->prefactors(n, l) =
+                std::exp(0.5 * std::log(PI) + std::lgamma(A) - std::lgamma(B) -
+                         (l + 2.) * std::log(2.) - A * std::log(fac_b(n)));
+          }
+        }
+      }
+
+      /**
+       * Compute J_{nl}(k) for all n and l
+       *
+       * @param values of shape (max_radial, max_angular + 1)
+       */
+      void calc(double k, Matrix_t & values) const {
+        values.resize(this->max_radial, this->max_angular + 1);
+        for (size_t n{0}; n < this->max_radial; ++n) {
+          const double x{0.25 * k * k / this->fac_b(n)};
+          double k_l{1.};
+          for (size_t l{0}; l < this->max_angular + 1; ++l) {
+            const double a{0.5 * (static_cast<double>(l) - n)};
+            values(n, l) = this->prefactors(n, l) * k_l *
+                           scaled_hyp1f1_series(a, l + 1.5, x);
+            k_l *= k;
+          }
+        }
+      }
+
+     protected:
+      size_t max_radial{0};
+      size_t max_angular{0};
+      Eigen::VectorXd fac_b{};
+      Matrix_t prefactors{};
+    };
+  }  // namespace internal
+
+  /**
+   * Long range (LODE) counterpart of the spherical expansion: the expansion
+   * on the GTO radial basis and the real spherical harmonics of the
+   * potential generated by the Gaussian densities of the atoms of each
+   * species around every center,
+   *
+   * \f{equation}{
+   *   c^{ia}_{nlm} = \int d\mathbf{r} R_n(r) Y_l^m(\hat{\mathbf{r}})
+   *     V^a(\mathbf{r}_i + \mathbf{r}),
+   * \f}
+   *
+   * where \f$V^a\f$ solves the Poisson equation for the smeared density
+   * of the atoms of species a and of the periodic images.
+   *
+   * The potential is computed in reciprocal space from the structure
+   * factors \f$F_a(\mathbf{k}) = \sum_{j \in a} e^{i\mathbf{k}\cdot
+   * \mathbf{r}_j}\f$ on the k-vectors of math::Kvectors, so that the cost
+   * scales like the number of atoms times the number of k-vectors and the
+   * memory is linear in both, instead of going through all the pairs of
+   * atoms of AdaptorKspace. The k = 0 term is left out, which corresponds
+   * to a neutralizing background. Only fully periodic structures are
+   * supported and gradients are not implemented.
+   *
+   * The hyperparameters follow the ones of the spherical expansion:
+   * max_radial, max_angular, gaussian_density (only 'Constant'),
+   * radial_contribution (only 'GTO') and cutoff_function, whose cutoff
+   * only sets the extent of the radial basis. The optional k_cutoff sets
+   * the radius of the sphere of k-vectors, pi / sigma by default.
+   */
+  class CalculatorKspaceSphericalExpansion : public CalculatorBase {
+   public:
+    using Parent = CalculatorBase;
+    using Hypers_t = typename Parent::Hypers_t;
+    using Key_t = typename Parent::Key_t;
+
+    template <class StructureManager>
+    using Property_t = BlockSparseProperty<double, 1, StructureManager, Key_t>;
+    template <class StructureManager>
+    using PropertyGradient_t =
+        BlockSparseProperty<double, 2, StructureManager, Key_t>;
+
+    template <class StructureManager>
+    using Dense_t = typename Property_t<StructureManager>::Dense_t;
+    template <class StructureManager>
+    using Data_t = typename Property_t<StructureManager>::Data_t;
+
+    explicit CalculatorKspaceSphericalExpansion(const Hypers_t & hyper)
+        : CalculatorBase{} {
+      this->set_default_prefix("kspace_spherical_expansion_");
+      this->set_hyperparameters(hyper);
+      this->hypers = hyper;
+    }
+
+    //! Copy constructor
+    CalculatorKspaceSphericalExpansion(
+        const CalculatorKspaceSphericalExpansion & other) = delete;
+
+    //! Move constructor
+    CalculatorKspaceSphericalExpansion(
+        CalculatorKspaceSphericalExpansion && other) = default;
+
+    //! Destructor
+    virtual ~CalculatorKspaceSphericalExpansion() = default;
+
+    //! Copy assignment operator
+    CalculatorKspaceSphericalExpansion &
+    operator=(const CalculatorKspaceSphericalExpansion & other) = delete;
+
+    //! Move assignment operator
+    CalculatorKspaceSphericalExpansion &
+    operator=(CalculatorKspaceSphericalExpansion && other) = default;
+
+    bool operator==(const CalculatorKspaceSphericalExpansion & other) const {
+      return (this->max_radial == other.max_radial and
+              this->max_angular == other.max_angular and
+              this->gaussian_sigma == other.gaussian_sigma and
+              this->interaction_cutoff == other.interaction_cutoff and
+              this->k_cutoff == other.k_cutoff);
+    }
+
+    void set_hyperparameters(const Hypers_t & hypers) override {
+      using math::PI;
+      this->max_radial = hypers.at("max_radial").get<size_t>();
+      this->max_angular = hypers.at("max_angular").get<size_t>();
+
+      if (hypers.count("compute_gradients") and
+          hypers.at("compute_gradients").get<bool>()) {
+        throw std::logic_error("The gradients of the k-space spherical "
+                               "expansion are not implemented.");
+      }
+
+      auto smearing_hypers = hypers.at("gaussian_density").get<json>();
+      auto smearing_type = smearing_hypers.at("type").get<std::string>();
+      if (smearing_type != "Constant") {
+        throw std::logic_error(
+            "Requested Gaussian sigma type \'" + smearing_type +
+            "\' has not been implemented.  Must be one of" + ": \'Constant\'.");
+      }
+      this->gaussian_sigma =
+          smearing_hypers.at("gaussian_sigma").at("value").get<double>();
+
+      auto radial_contribution_hypers =
+          hypers.at("radial_contribution").get<json>();
+      auto radial_contribution_type =
+          radial_contribution_hypers.at("type").get<std::string>();
+      if (radial_contribution_type != "GTO") {
+        throw std::logic_error("Requested Radial contribution type \'" +
+                               radial_contribution_type +
+                               "\' has not been implemented.  Must be one of" +
+                               ": \'GTO\'.");
+      }
+
+      auto fc_hypers = hypers.at("cutoff_function").get<json>();
+      this->interaction_cutoff =
+          fc_hypers.at("cutoff").at("value").get<double>();
+
+      if (hypers.count("k_cutoff")) {
+        this->k_cutoff = hypers.at("k_cutoff").at("value").get<double>();
+      } else {
+        this->k_cutoff = PI / this->gaussian_sigma;
+      }
+
+      // the GTO basis is the one of the spherical expansion
+      internal::RadialContribution<internal::RadialBasisType::GTO>
+          radial_contribution{hypers};
+      radial_contribution.precompute();
+      this->radial_ortho_matrix =
+          radial_contribution.get_radial_orthonormalization_matrix();
+      this->radial_integral.precompute(this->max_radial, this->max_angular,
+                                       radial_contribution.fac_b);
+
+      this->parity_offsets.clear();
+      this->n_lm_by_parity = {0, 0};
+      for (size_t l{0}; l < this->max_angular + 1; ++l) {
+        this->parity_offsets.push_back(this->n_lm_by_parity[l % 2]);
+        this->n_lm_by_parity[l % 2] += static_cast<int>(2 * l + 1);
+      }
+
+      this->set_name(hypers);
+    }
+
+    /**
+     * Compute representation for a given structure manager.
+     *
+     * @tparam StructureManager a (single or collection)
+     * of structure manager(s) (in an iterator) held in shared_ptr
+     */
+    template <class StructureManager>
+    void compute(StructureManager & managers) {
+      this->compute_loop(managers);
+    }
+
+    /**
+     * loop over a collection of manangers if it is an iterator.
+     * Or just call compute_impl
+     */
+    template <
+        class StructureManager,
+        std::enable_if_t<internal::is_proper_iterator<StructureManager>::value,
+                         int> = 0>
+    void compute_loop(StructureManager & managers) {
+      const int n_threads{this->get_n_threads_for_structures(managers)};
+      if (n_threads > 1) {
+        internal::parallel_for_each(
+            managers, n_threads,
+            [this](auto & manager) { this->compute_impl(manager); });
+        return;
+      }
+      for (auto & manager : managers) {
+        this->compute_impl(manager);
+      }
+    }
+
+    //! single manager case
+    template <class StructureManager,
+              std::enable_if_t<
+                  not(internal::is_proper_iterator<StructureManager>::value),
+                  int> = 0>
+    void compute_loop(StructureManager & manager) {
+      this->compute_impl(manager);
+    }
+
+    template <class StructureManager>
+    void compute_impl(std::shared_ptr<StructureManager> manager);
+
+    int get_num_coefficients(int n_species) const {
+      return static_cast<int>(n_species * this->max_radial *
+                              (this->max_angular + 1) *
+                              (this->max_angular + 1));
+    }
+
+    /**
+     * Expansion of the long range potential of a unit charge in the
+     * orthonormal radial basis and the real spherical harmonics for each of
+     * the k-vectors, split by the parity of l, so that the contribution of a
+     * k-vector to c^{ia} is Re(e^{i k r_i} F_a(k)^*) Z_0(k) for even l and
+     * Im(e^{i k r_i} F_a(k)^*) Z_1(k) for odd l.
+     *
+     * The columns of Z_p are ordered by n and then by the (l, m) of parity
+     * p, see parity_offsets.
+     */
+    std::array<math::Matrix_t, 2>
+    compute_kspace_projections(const Eigen::Ref<const math::Matrix_t> & kvecs,
+                               const Eigen::Ref<const math::Vector_t> & knorms,
+                               double volume) const;
+
+   protected:
+    size_t max_radial{};
+    size_t max_angular{};
+    double gaussian_sigma{};
+    double interaction_cutoff{};
+    double k_cutoff{};
+
+    //! offset of the l channels among the (l, m) of the same parity
+    std::vector<int> parity_offsets{};
+    //! number of (l, m) of even and odd l
+    std::array<int, 2> n_lm_by_parity{};
+
+    //! orthonormalization of the GTO basis of the spherical expansion
+    math::Matrix_t radial_ortho_matrix{};
+    internal::KspaceRadialIntegralGTO radial_integral{};
+  };
+
+  inline std::array<math::Matrix_t, 2>
+  CalculatorKspaceSphericalExpansion::compute_kspace_projections(
+      const Eigen::Ref<const math::Matrix_t> & kvecs,
+      const Eigen::Ref<const math::Vector_t> & knorms, double volume) const {
+    using math::PI;
+    const int n_k{static_cast<int>(knorms.size())};
+    const int n_max{static_cast<int>(this->max_radial)};
+    const int l_max{static_cast<int>(this->max_angular)};
+
+    const math::MatrixX3_t directions{
+        (knorms.cwiseInverse().asDiagonal() * kvecs).eval()};
+    math::SphericalHarmonics harmonics_calculator{};
+    harmonics_calculator.precompute(this->max_angular);
+    harmonics_calculator.calc_batch(directions, false, false);
+    const auto harmonics{harmonics_calculator.get_harmonics_batch()};
+
+    std::array<math::Matrix_t, 2> projections{};
+    for (int parity{0}; parity < 2; ++parity) {
+      projections[parity].resize(n_k,
+                                 n_max * this->n_lm_by_parity[parity]);
+    }
+    math::Matrix_t radial_integral_values(n_max, l_max + 1);
+    math::Matrix_t radial_values(n_max, l_max + 1);
+    for (int i_k{0}; i_k < n_k; ++i_k) {
+      const double k{knorms(i_k)};
+      // 4 pi / V e^{-sigma^2 k^2 / 2} / k^2 is the Fourier component of the
+      // potential of a Gaussian of unit charge, the second 4 pi comes from
+      // the plane wave expansion of e^{i k r} and the factor 2 from the
+      // -k vector that is not listed
+      const double sigma_k{this->gaussian_sigma * k};
+      const double green{32. * PI * PI / volume *
+                         std::exp(-0.5 * sigma_k * sigma_k) / (k * k)};
+      this->radial_integral.calc(k, radial_integral_values);
+      radial_values.noalias() =
+          this->radial_ortho_matrix.transpose() * radial_integral_values;
+      for (int l{0}; l < l_max + 1; ++l) {
+        // i^l selects the real or the imaginary part of the structure factor
+        const int parity{l % 2};
+        const double sign{((l + parity) / 2) % 2 == 0 ? green : -green};
+        const int n_lm_parity{this->n_lm_by_parity[parity]};
+        for (int n{0}; n < n_max; ++n) {
+          projections[parity]
+              .row(i_k)
+              .segment(n * n_lm_parity + this->parity_offsets[l], 2 * l + 1) =
+              sign * radial_values(n, l) *
+              harmonics.row(i_k).segment(l * l, 2 * l + 1);
+        }
+      }
+    }
+    return projections;
+  }
+
+  template <class StructureManager>
+  void CalculatorKspaceSphericalExpansion::compute_impl(
+      std::shared_ptr<StructureManager> manager) {
+    using Prop_t = Property_t<StructureManager>;
+    using math::Matrix_t;
+
+    constexpr bool ExcludeGhosts{true};
+    auto && expansions_coefficients{*manager->template get_property<Prop_t>(
+        this->get_name(), true, true, ExcludeGhosts)};
+
+    // if the representation has already been computed for the current
+    // structure then do nothing
+    if (expansions_coefficients.is_updated()) {
+      return;
+    }
+
+    auto manager_root{extract_underlying_manager<0>(manager)};
+    const auto pbc{manager_root->get_periodic_boundary_conditions()};
+    if (not pbc.all()) {
+      std::stringstream err_str{};
+      err_str << "The k-space spherical expansion requires a structure that "
+              << "is periodic in the three directions, pbc: ["
+              << pbc.transpose() << "].";
+      throw std::runtime_error(err_str.str());
+    }
+    const Eigen::Matrix3d cell{manager_root->get_cell()};
+    const auto positions{manager_root->get_positions()};
+    const auto atom_types{manager_root->get_atom_types()};
+    const int n_atoms{static_cast<int>(atom_types.size())};
+
+    // the species of the structure are the keys of every center
+    std::map<int, int> species_index{};
+    std::set<Key_t> keys{};
+    for (int i_atom{0}; i_atom < n_atoms; ++i_atom) {
+      species_index.emplace(atom_types(i_atom), 0);
+    }
+    int n_species{0};
+    for (auto & species : species_index) {
+      species.second = n_species++;
+      keys.insert({species.first});
+    }
+
+    // the lattice vectors are the columns of the cell
+    math::Kvectors kvectors{this->k_cutoff, cell.transpose(), false, false};
+    const int n_k{static_cast<int>(kvectors.get_numvectors())};
+    const Matrix_t kvecs{kvectors.get_kvectors()};
+
+    const int n_max{static_cast<int>(this->max_radial)};
+    const int l_max{static_cast<int>(this->max_angular)};
+    const int n_lm{(l_max + 1) * (l_max + 1)};
+
+    expansions_coefficients.clear();
+    expansions_coefficients.set_shape(n_max, n_lm);
+    expansions_coefficients.resize(keys);
+    expansions_coefficients.setZero();
+
+    const int n_centers{static_cast<int>(manager->size())};
+    if (n_k == 0 or n_centers == 0) {
+      return;
+    }
+
+    const auto projections{this->compute_kspace_projections(
+        kvecs, kvectors.get_kvector_norms(), std::abs(cell.determinant()))};
+
+    // real and imaginary parts of the structure factors of each species
+    Eigen::MatrixXd factors_re{Eigen::MatrixXd::Zero(n_k, n_species)};
+    Eigen::MatrixXd factors_im{Eigen::MatrixXd::Zero(n_k, n_species)};
+    Eigen::ArrayXd phases(n_k);
+    for (int i_atom{0}; i_atom < n_atoms; ++i_atom) {
+      const int i_species{species_index[atom_types(i_atom)]};
+      phases = (kvecs * positions.col(i_atom)).array();
+      factors_re.col(i_species).array() += phases.cos();
+      factors_im.col(i_species).array() += phases.sin();
+    }
+
+    // number of centers whose coefficients are computed together
+    constexpr int CenterBatchSize{128};
+    // Re and Im of e^{i k r_i} F_a(k)^* for a batch of centers and the
+    // corresponding coefficients of even and odd l
+    std::array<Matrix_t, 2> center_factors{};
+    std::array<Matrix_t, 2> batch_coefficients{};
+    for (int parity{0}; parity < 2; ++parity) {
+      center_factors[parity].resize(CenterBatchSize, n_k);
+      batch_coefficients[parity].resize(
+          CenterBatchSize, n_max * this->n_lm_by_parity[parity]);
+    }
+    Eigen::Matrix3Xd center_positions(ThreeD, CenterBatchSize);
+    Eigen::ArrayXXd center_cos(n_k, CenterBatchSize);
+    Eigen::ArrayXXd center_sin(n_k, CenterBatchSize);
+    for (int i_begin{0}; i_begin < n_centers; i_begin += CenterBatchSize) {
+      const int n_batch{std::min(CenterBatchSize, n_centers - i_begin)};
+      for (int i_batch{0}; i_batch < n_batch; ++i_batch) {
+        // the cluster ref refers to the iterator so it has to be kept alive
+        auto center_it{manager->get_iterator_at(i_begin + i_batch)};
+        auto center{*center_it};
+        center_positions.col(i_batch) = center.get_position();
+      }
+      const Eigen::ArrayXXd center_phases{
+          (kvecs * center_positions.leftCols(n_batch)).array()};
+      center_cos.leftCols(n_batch) = center_phases.cos();
+      center_sin.leftCols(n_batch) = center_phases.sin();
+
+      for (const auto & species : species_index) {
+        const int i_species{species.second};
+        const auto factor_re{factors_re.col(i_species).array()};
+        const auto factor_im{factors_im.col(i_species).array()};
+        for (int i_batch{0}; i_batch < n_batch; ++i_batch) {
+          const auto cos_i{center_cos.col(i_batch)};
+          const auto sin_i{center_sin.col(i_batch)};
+          center_factors[0].row(i_batch) =
+              (cos_i * factor_re + sin_i * factor_im).matrix().transpose();
+          center_factors[1].row(i_batch) =
+              (sin_i * factor_re - cos_i * factor_im).matrix().transpose();
+        }
+        for (int parity{0}; parity < 2; ++parity) {
+          batch_coefficients[parity].topRows(n_batch).noalias() =
+              center_factors[parity].topRows(n_batch) * projections[parity];
+        }
+
+        const Key_t key{species.first};
+        for (int i_batch{0}; i_batch < n_batch; ++i_batch) {
+          auto center_it{manager->get_iterator_at(i_begin + i_batch)};
+          auto center{*center_it};
+          auto && coefficients{expansions_coefficients[center][key]};
+          for (int l{0}; l < l_max + 1; ++l) {
+            const int parity{l % 2};
+            const int n_lm_parity{this->n_lm_by_parity[parity]};
+            for (int n{0}; n < n_max; ++n) {
+              coefficients.row(n).segment(l * l, 2 * l + 1) =
+                  batch_coefficients[parity].row(i_batch).segment(
+                      n * n_lm_parity + this->parity_offsets[l], 2 * l + 1);
+            }
+          }
+        }
+      }
+    }
+  }
+
+}  // namespace rascal
+
+namespace nlohmann {
+  /**
+   * Special specialization of the json serialization for non default
+   * constructible type.
+   */
+  template <>
+  struct adl_serializer<rascal::CalculatorKspaceSphericalExpansion> {
+    static rascal::CalculatorKspaceSphericalExpansion
+    from_json(const json & j) {
+      return rascal::CalculatorKspaceSphericalExpansion{j};
+    }
+
+    static void to_json(json & j,
+                        const rascal::CalculatorKspaceSphericalExpansion & t) {
+      j = t.hypers;
+    }
+  };
+}  // namespace nlohmann
+
+#endif  // SRC_RASCAL_REPRESENTATIONS_CALCULATOR_KSPACE_SPHERICAL_EXPANSION_HH_
@@ -30,6 +30,7 @@
 #include "rascal/representations/calculator_base.hh"
 #include "rascal/structure_managers/property.hh"
 #include "rascal/structure_managers/structure_manager.hh"
+#include "rascal/utils/threading.hh"
 #include "rascal/utils/utils.hh"
 
 #include <math.h>
@@ -256,6 +257,32 @@ namespace rascal {
       }
     }
 
+    /**
+     * The central cutoff and the size of the calculator are adapted to each
+     * structure in compute_impl(). To compute a collection concurrently they
+     * are set once for all the structures beforehand, which is only possible
+     * if they share the same cutoff.
+     *
+     * @return true if the collection can be computed concurrently
+     */
+    template <class StructureManagers>
+    bool prepare_parallel_loop(StructureManagers & managers) {
+      auto it_manager{std::begin(managers)};
+      const double cutoff{(*it_manager)->get_cutoff()};
+      for (auto & manager : managers) {
+        if (manager->get_cutoff() != cutoff) {
+          return false;
+        }
+      }
+      if (cutoff != this->central_cutoff) {
+        this->update_central_cutoff(cutoff);
+      }
+      for (auto & manager : managers) {
+        this->check_size_compatibility(manager);
+      }
+      return true;
+    }
+
     /* -------------------- rep-interface-end -------------------- */
 
     /* -------------------- compute-loop-begin -------------------- */
@@ -266,6 +293,14 @@ namespace rascal {
         std::enable_if_t<internal::is_proper_iterator<StructureManager>::value,
                          int> = 0>
     void compute_loop(StructureManager & managers) {
+      const int n_threads{this->get_n_threads_for_structures(managers)};
+      if (n_threads > 1 and this->prepare_parallel_loop(managers)) {
+        internal::parallel_for_each(
+            managers, n_threads, [this](auto & manager) {
+              this->template compute_impl<AlgorithmType>(manager);
+            });
+        return;
+      }
       for (auto & manager : managers) {
         this->compute_impl<AlgorithmType>(manager);
       }
@@ -432,7 +467,9 @@ namespace rascal {
     // TODO(felix) use the commented code bellow. needs changes in the tests
     // because it actually runs cases where
     // this->central_cutoff > manager->get_cutoff() is true.
-    this->update_central_cutoff(manager->get_cutoff());
+    if (manager->get_cutoff() != this->central_cutoff) {
+      this->update_central_cutoff(manager->get_cutoff());
+    }
     // if (this->central_cutoff > manager->get_cutoff()) {
     //   std::string error{R"(The hypers cutoff and the managers cutoff are not
     //   compatible: )"}; error += std::to_string(this->central_cutoff) +
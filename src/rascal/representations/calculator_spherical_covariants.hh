@@ -30,6 +30,7 @@
 #ifndef SRC_RASCAL_REPRESENTATIONS_CALCULATOR_SPHERICAL_COVARIANTS_HH_
 #define SRC_RASCAL_REPRESENTATIONS_CALCULATOR_SPHERICAL_COVARIANTS_HH_
 
+#include "rascal/math/clebsch_gordan.hh"
 #include "rascal/math/utils.hh"
 #include "rascal/representations/calculator_base.hh"
 #include "rascal/representations/calculator_spherical_expansion.hh"
@@ -37,14 +38,17 @@
 #include "rascal/structure_managers/property.hh"
 #include "rascal/structure_managers/property_block_sparse.hh"
 #include "rascal/structure_managers/structure_manager.hh"
+#include "rascal/utils/threading.hh"
 #include "rascal/utils/utils.hh"
 
 #include <Eigen/Dense>
 #include <Eigen/Eigenvalues>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <exception>
+#include <map>
 #include <vector>
 
 namespace rascal {
@@ -52,51 +56,62 @@ namespace rascal {
   namespace internal {
     enum class SphericalCovariantsType { LambdaSpectrum };
 
-    inline Eigen::ArrayXd precompute_wigner_3js(size_t max_angular,
-                                                bool inversion_symmetry,
-                                                size_t lambda) {
-      Eigen::ArrayXd wigner_3js{};
-      // get the number of non zero elements in the w3j
-      // Use the well-known selection rules for the Wigner 3j symbols
-      int n_elements{0};
-      size_t l3{lambda};
-      for (size_t l1{0}; l1 < max_angular + 1; ++l1) {
-        for (size_t l2{0}; l2 < max_angular + 1; ++l2) {
-          // Triangle rule
-          if (l1 < static_cast<size_t>(std::abs<int>(l2 - l3)) ||
-              l1 > l2 + l3) {
-            continue;
-          }
-          if (inversion_symmetry) {
-            if ((l1 + l2 + l3) % 2 == 1) {
-              continue;
-            }
-          }
-          for (size_t m1{0}; m1 < 2 * l1 + 1; m1++) {
-            int m1s{static_cast<int>(m1 - l1)};
-            for (size_t m2{0}; m2 < 2 * l2 + 1; m2++) {
-              int m2s{static_cast<int>(m2 - l2)};
-              for (size_t m3{0}; m3 < 2 * l3 + 1; m3++) {
-                int m3s{static_cast<int>(m3 - l3)};
-                // Selection rule for m
-                if ((m1s + m2s + m3s != 0) && (m1s + m2s - m3s != 0)) {
-                  continue;
-                }
-                ++n_elements;
-              }
-            }
-          }
-        }
+    /**
+     * Non zero couplings of the LambdaSpectrum, i.e. the coefficients w such
+     * that the column of the (l1, l2, M) component of the LambdaSpectrum of
+     * (n1, n2) is the sum of w c^{1}_{n1 lm1} c^{2}_{n2 lm2} over the
+     * couplings with this column.
+     *
+     * The couplings are sorted by (column, lm1, lm2) so that the ones
+     * sharing (column, lm1) are consecutive.
+     */
+    struct LambdaSpectrumCouplings {
+      std::vector<int> column{};
+      //! index l^2 + l + m of the two real expansion coefficients
+      std::vector<int> lm1{};
+      std::vector<int> lm2{};
+      std::vector<double> values{};
+      //! number of (l1, l2) channels
+      size_t n_channels{0};
+
+      size_t size() const { return this->values.size(); }
+
+      bool operator==(const LambdaSpectrumCouplings & other) const {
+        return this->column == other.column and this->lm1 == other.lm1 and
+               this->lm2 == other.lm2 and this->values == other.values and
+               this->n_channels == other.n_channels;
       }
+    };
 
-      wigner_3js.resize(n_elements);
-      n_elements = 0;
-      wig_table_init(2 * (max_angular + 1), 3);
-      wig_temp_init(2 * (max_angular + 1));
-      for (size_t l1{0}; l1 < max_angular + 1; ++l1) {
-        for (size_t l2{0}; l2 < max_angular + 1; ++l2) {
-          if ((l1 < static_cast<size_t>(std::abs<int>(l2 - l3))) ||
-              (l1 > l2 + l3)) {
+    /**
+     * Couplings of the LambdaSpectrum from the Clebsch-Gordan coefficients of
+     * the real spherical harmonics. The columns of the (l1, l2) channels
+     * follow the order of l1 and l2 and the channels are restricted to even
+     * l1 + l2 + lambda with inversion_symmetry.
+     *
+     * The LambdaSpectrum keeps its original definition in terms of Wigner 3j
+     * symbols, which differs from the Clebsch-Gordan coupling by a factor
+     * of (-1)^(l1 + l2) / sqrt(2 lambda + 1) and by the sign of the M < 0
+     * components.
+     */
+    inline LambdaSpectrumCouplings
+    precompute_lambda_spectrum_couplings(size_t max_angular,
+                                         bool inversion_symmetry,
+                                         size_t lambda) {
+      LambdaSpectrumCouplings couplings{};
+      if (lambda > 2 * max_angular) {
+        return couplings;
+      }
+      const math::ClebschGordanReal clebsch_gordan{max_angular};
+      const int l3{static_cast<int>(lambda)};
+      const int l_max{static_cast<int>(max_angular)};
+      const double normalization{1. / std::sqrt(2. * l3 + 1.)};
+      // (column, lm1, lm2) -> coupling
+      std::map<std::array<int, 3>, double> couplings_by_index{};
+      int i_channel{0};
+      for (int l1{0}; l1 < l_max + 1; ++l1) {
+        for (int l2{0}; l2 < l_max + 1; ++l2) {
+          if ((l1 < std::abs(l2 - l3)) || (l1 > l2 + l3)) {
             continue;
           }
           if (inversion_symmetry) {
@@ -104,51 +119,27 @@ namespace rascal {
               continue;
             }
           }
-
-          // NB: the order of this loop MATTERS because it mirrors the
-          // order of evaluation of the covariants further down
-          for (size_t m3{0}; m3 < 2 * l3 + 1; m3++) {
-            int m3s{static_cast<int>(m3 - l3)};
-            for (size_t m1{0}; m1 < 2 * l1 + 1; m1++) {
-              int m1s{static_cast<int>(m1 - l1)};
-              for (size_t m2{0}; m2 < 2 * l2 + 1; m2++) {
-                int m2s{static_cast<int>(m2 - l2)};
-                if ((m1s + m2s + m3s != 0) && (m1s + m2s - m3s != 0)) {
-                  continue;
-                }
-                double w3j1{
-                    wig3jj(2 * l1, 2 * l2, 2 * l3, 2 * m1s, 2 * m2s, 2 * m3s)};
-                double w3j2{
-                    wig3jj(2 * l1, 2 * l2, 2 * l3, 2 * m1s, 2 * m2s, -2 * m3s)};
-                if (m3s > 0) {
-                  wigner_3js(n_elements) =
-                      (w3j2 + math::pow(-1, m3s) * w3j1) * math::INV_SQRT_TWO;
-                } else if (m3s < 0) {
-                  wigner_3js(n_elements) =
-                      ((w3j1 - math::pow(-1, m3s) * w3j2)) * math::INV_SQRT_TWO;
-                } else if (m3s == 0) {
-                  wigner_3js(n_elements) = w3j1;
-                }
-                // change to the following for agreement with SOAPFAST
-                // (different definition of the real spherical harmonics)
-                /*
-                if (m3s > 0) { wigner_3js.push_back((w3j1 + pow(-1,
-                m3s)*w3j2)/sqrt(2.0)); } else if (m3s == 0) {
-                wigner_3js.push_back(w3j1); } else if (m3s < 0) {
-                wigner_3js.push_back(((w3j2 - pow(-1,
-                m3s)*w3j1))/sqrt(2.0));
-                }
-                */
-                ++n_elements;
-              }
-            }
+          const double sign{(l1 + l2) % 2 == 0 ? 1. : -1.};
+          for (const auto & coupling :
+               clebsch_gordan.get_couplings(l1, l2, l3)) {
+            const double sign_M{coupling.M < l3 ? -1. : 1.};
+            couplings_by_index[{i_channel * (2 * l3 + 1) + coupling.M,
+                                l1 * l1 + coupling.m1,
+                                l2 * l2 + coupling.m2}] =
+                sign * sign_M * normalization * coupling.value;
           }
+          ++i_channel;
         }
       }
-      wig_temp_free();
-      wig_table_free();
 
-      return wigner_3js;
+      couplings.n_channels = static_cast<size_t>(i_channel);
+      for (const auto & coupling : couplings_by_index) {
+        couplings.column.push_back(coupling.first[0]);
+        couplings.lm1.push_back(coupling.first[1]);
+        couplings.lm2.push_back(coupling.first[2]);
+        couplings.values.push_back(coupling.second);
+      }
+      return couplings;
     }
 
   }  // namespace internal
@@ -190,10 +181,12 @@ namespace rascal {
                                                 other.max_radial)},
           max_angular{std::move(other.max_angular)}, rep_expansion{std::move(
                                                          other.rep_expansion)},
-          type{std::move(other.type)}, wigner_3js{std::move(other.wigner_3js)},
+          type{std::move(other.type)}, lambda_spectrum_couplings{std::move(
+                                           other.lambda_spectrum_couplings)},
           inversion_symmetry{std::move(other.inversion_symmetry)},
-          lambda{std::move(other.lambda)}, normalize{
-                                               std::move(other.normalize)} {}
+          lambda{std::move(other.lambda)}, normalize{std::move(
+                                               other.normalize)},
+          compute_gradients{std::move(other.compute_gradients)} {}
 
     //! Destructor
     virtual ~CalculatorSphericalCovariants() = default;
@@ -211,10 +204,12 @@ namespace rascal {
               this->max_angular == other.max_angular and
               this->rep_expansion == other.rep_expansion and
               this->type == other.type and
-              (this->wigner_3js.array() == other.wigner_3js.array()).all() and
+              this->lambda_spectrum_couplings ==
+                  other.lambda_spectrum_couplings and
               this->inversion_symmetry == other.inversion_symmetry and
               this->lambda == other.lambda and
-              this->normalize == other.normalize);
+              this->normalize == other.normalize and
+              this->compute_gradients == other.compute_gradients);
     }
 
     void set_hyperparameters(const Hypers_t & hypers) override {
@@ -225,11 +220,17 @@ namespace rascal {
       this->lambda = hypers.at("covariant_lambda").get<size_t>();
       this->inversion_symmetry = hypers.at("inversion_symmetry").get<bool>();
       this->normalize = hypers.at("normalize").get<bool>();
+      if (hypers.find("compute_gradients") != hypers.end()) {
+        this->compute_gradients = hypers.at("compute_gradients").get<bool>();
+      } else {
+        this->compute_gradients = false;
+      }
 
       if (soap_type == "LambdaSpectrum") {
         this->type = SphericalCovariantsType::LambdaSpectrum;
-        this->wigner_3js = internal::precompute_wigner_3js(
-            this->max_angular, this->inversion_symmetry, this->lambda);
+        this->lambda_spectrum_couplings =
+            internal::precompute_lambda_spectrum_couplings(
+                this->max_angular, this->inversion_symmetry, this->lambda);
 
       } else {
         throw std::logic_error("Requested Spherical Covariants type '" +
@@ -241,6 +242,17 @@ namespace rascal {
       this->set_name(hypers);
     }
 
+    bool does_gradients() const override { return this->compute_gradients; }
+
+    /**
+     * Set the number of threads of this calculator and of the underlying
+     * spherical expansion.
+     */
+    void set_n_threads(int n_threads) override {
+      CalculatorBase::set_n_threads(n_threads);
+      this->rep_expansion.set_n_threads(n_threads);
+    }
+
     /**
      * Compute representation for a given structure manager.
      *
@@ -262,6 +274,17 @@ namespace rascal {
         std::enable_if_t<internal::is_proper_iterator<StructureManager>::value,
                          int> = 0>
     void compute_loop(StructureManager & managers) {
+      const int n_threads{this->get_n_threads_for_structures(managers)};
+      if (n_threads > 1) {
+        // the expansions are computed beforehand so that the expansion
+        // calculator is only read from within the parallel region
+        this->rep_expansion.compute(managers);
+        internal::parallel_for_each(
+            managers, n_threads, [this](auto & manager) {
+              this->template compute_impl<Type>(manager);
+            });
+        return;
+      }
       for (auto & manager : managers) {
         this->compute_impl<Type>(manager);
       }
@@ -284,9 +307,11 @@ namespace rascal {
         class StructureManager>
     void compute_impl(std::shared_ptr<StructureManager> manager);
 
-    template <class Invariants, class ExpansionCoeff, class StructureManager>
+    template <class Invariants, class InvariantsDerivative,
+              class ExpansionCoeff, class StructureManager>
     void initialize_per_center_lambda_soap_vectors(
-        Invariants & soap_vector, ExpansionCoeff & expansions_coefficients,
+        Invariants & soap_vectors, InvariantsDerivative & soap_vector_gradients,
+        ExpansionCoeff & expansions_coefficients,
         std::shared_ptr<StructureManager> manager);
 
     int get_num_coefficients(int /*n_species*/) const {
@@ -297,18 +322,37 @@ namespace rascal {
     }
 
    protected:
+    template <class StructureManager>
+    using SpectrumNorm_t = Property<double, 1, StructureManager, 1>;
+
+    /**
+     * Add the LambdaSpectrum of coef1 and coef2, i.e. the coupling of
+     * c^{1}_{n1 lm1} c^{2}_{n2 lm2}, to lambda_spectrum. lambda_spectrum is
+     * column major so that the n2 components of a (n1, column) are
+     * contiguous.
+     *
+     * @param coef2_by_lm and coupled_coef2 are work spaces
+     */
+    template <class Coefficients1, class Coefficients2>
+    void add_lambda_spectrum(const Coefficients1 & coef1,
+                             const Coefficients2 & coef2,
+                             Eigen::MatrixXd & lambda_spectrum,
+                             Eigen::MatrixXd & coef2_by_lm,
+                             Eigen::VectorXd & coupled_coef2) const;
+
     size_t max_radial{};
     size_t max_angular{};
 
     CalculatorSphericalExpansion rep_expansion;
     internal::SphericalCovariantsType type{};
 
-    /// precomputed wigner symbols
-    Eigen::ArrayXd wigner_3js{};
+    /// precomputed couplings of the expansion coefficients
+    internal::LambdaSpectrumCouplings lambda_spectrum_couplings{};
 
     bool inversion_symmetry{false};
     size_t lambda{0};
     bool normalize{true};
+    bool compute_gradients{};
   };
 
   template <class StructureManager>
@@ -324,50 +368,33 @@ namespace rascal {
     }
   }
 
-  template <class Invariants, class ExpansionCoeff, class StructureManager>
+  template <class Invariants, class InvariantsDerivative, class ExpansionCoeff,
+            class StructureManager>
   void CalculatorSphericalCovariants::initialize_per_center_lambda_soap_vectors(
-      Invariants & soap_vectors, ExpansionCoeff & expansions_coefficients,
+      Invariants & soap_vectors, InvariantsDerivative & soap_vector_gradients,
+      ExpansionCoeff & expansions_coefficients,
       std::shared_ptr<StructureManager> manager) {
     using math::pow;
 
     size_t n_row{pow(this->max_radial, 2_size_t)};
     // number of combinations of l1 and l2 satisfying the triangle constraint
-    size_t n_col{0};
-    if (this->inversion_symmetry == false) {
-      n_col = static_cast<size_t>(
-          (2 + this->lambda - 3 * pow(this->lambda, 2_size_t) +
-           2 * this->max_angular + 4 * this->lambda * this->max_angular) /
-          2 * (2 * this->lambda + 1));
-    } else {
-      n_col =
-          static_cast<size_t>(
-              std::ceil(pow(this->max_angular + 1, 2_size_t) / 2.0) -
-              pow(1.0 + std::floor((this->lambda - 1) / 2.0), 2) -
-              std::floor(pow(this->max_angular + 1 - this->lambda, 2_size_t) /
-                         2.0) *
-                  (this->lambda % 2) -
-              (std::ceil(pow(this->max_angular + 1 - this->lambda, 2_size_t) /
-                         2.0) -
-               (this->max_angular - this->lambda + 1)) *
-                  (1.0 - this->lambda % 2)) *
-          (2 * this->lambda + 1);
-      if (this->lambda % 2 == 1) {
-        n_col = static_cast<size_t>(
-            0.5 *
-                (2 + this->lambda - 3 * pow(this->lambda, 2_size_t) +
-                 2 * this->max_angular + 4 * this->lambda * this->max_angular) *
-                (2 * this->lambda + 1) -
-            static_cast<int>(n_col));
-      }
-    }
+    size_t n_col{this->lambda_spectrum_couplings.n_channels *
+                 (2 * this->lambda + 1)};
 
     // clear the data container and resize it
     soap_vectors.clear();
     soap_vectors.set_shape(n_row, n_col);
+    soap_vector_gradients.clear();
+    if (this->compute_gradients) {
+      soap_vector_gradients.set_shape(ThreeD * n_row, n_col);
+    }
 
     std::vector<
         std::set<internal::SortedKey<Key_t>, internal::CompareSortedKeyLess>>
         keys_list{};
+    std::vector<
+        std::set<internal::SortedKey<Key_t>, internal::CompareSortedKeyLess>>
+        keys_list_grad{};
     // identify the species in each environment and initialize soap_vectors
     for (auto center : manager) {
       auto & coefficients{expansions_coefficients[center]};
@@ -388,9 +415,68 @@ namespace rascal {
         }
       }
       keys_list.emplace_back(pair_list);
+
+      if (this->compute_gradients) {
+        keys_list_grad.emplace_back(pair_list);
+        auto atom_i_tag = center.get_atom_tag();
+        // \grad_j p^{i ab} is zero when the species of j is neither a nor b
+        // unless j is a periodic image of i or the normalization mixes the
+        // components
+        for (auto neigh : center.pairs()) {
+          auto atom_j_tag = neigh.get_atom_j().get_atom_tag();
+          if (this->normalize or atom_j_tag == atom_i_tag) {
+            keys_list_grad.emplace_back(pair_list);
+            continue;
+          }
+          std::set<internal::SortedKey<Key_t>, internal::CompareSortedKeyLess>
+              grad_pair_list{};
+          pair_type[0] = neigh.get_atom_type();
+          for (const auto & el : coefficients) {
+            pair_type[1] = el.first[0];
+            grad_pair_list.insert({is_not_sorted, pair_type});
+          }
+          keys_list_grad.emplace_back(grad_pair_list);
+        }
+      }
     }
     soap_vectors.resize(keys_list);
     soap_vectors.setZero();
+    if (this->compute_gradients) {
+      soap_vector_gradients.resize(keys_list_grad);
+      soap_vector_gradients.setZero();
+    } else {
+      soap_vector_gradients.resize();
+    }
+  }
+
+  template <class Coefficients1, class Coefficients2>
+  void CalculatorSphericalCovariants::add_lambda_spectrum(
+      const Coefficients1 & coef1, const Coefficients2 & coef2,
+      Eigen::MatrixXd & lambda_spectrum, Eigen::MatrixXd & coef2_by_lm,
+      Eigen::VectorXd & coupled_coef2) const {
+    const auto & couplings{this->lambda_spectrum_couplings};
+    const int n_couplings{static_cast<int>(couplings.size())};
+    const int n_max{static_cast<int>(this->max_radial)};
+    coef2_by_lm = coef2;
+
+    int i_coupling{0};
+    while (i_coupling < n_couplings) {
+      const int column{couplings.column[i_coupling]};
+      const int lm1{couplings.lm1[i_coupling]};
+      coupled_coef2.setZero(n_max);
+      // the couplings sharing (column, lm1) are consecutive
+      for (; i_coupling < n_couplings and
+             couplings.column[i_coupling] == column and
+             couplings.lm1[i_coupling] == lm1;
+           ++i_coupling) {
+        coupled_coef2 += couplings.values[i_coupling] *
+                         coef2_by_lm.col(couplings.lm2[i_coupling]);
+      }
+      for (int n1{0}; n1 < n_max; ++n1) {
+        lambda_spectrum.col(column).segment(n1 * n_max, n_max) +=
+            coef1(n1, lm1) * coupled_coef2;
+      }
+    }
   }
 
   template <internal::SphericalCovariantsType Type,
@@ -401,10 +487,12 @@ namespace rascal {
       std::shared_ptr<StructureManager> manager) {
     using PropExp_t =
         typename CalculatorSphericalExpansion::Property_t<StructureManager>;
+    using PropGradExp_t =
+        typename CalculatorSphericalExpansion::PropertyGradient_t<
+            StructureManager>;
     using Prop_t = Property_t<StructureManager>;
+    using PropGrad_t = PropertyGradient_t<StructureManager>;
     using internal::SphericalCovariantsType;
-    using math::pow;
-    using complex = std::complex<double>;
 
     // Compute the spherical expansions of the current structure
     rep_expansion.compute(manager);
@@ -412,9 +500,17 @@ namespace rascal {
     auto && expansions_coefficients{*manager->template get_property<PropExp_t>(
         rep_expansion.get_name(), true, true, ExcludeGhosts)};
 
+    // No error if gradients not computed; just an empty array in that case
+    auto && expansions_coefficients_gradient{
+        *manager->template get_property<PropGradExp_t>(
+            rep_expansion.get_gradient_name(), true, true)};
+
     auto && soap_vectors{*manager->template get_property<Prop_t>(
         this->get_name(), true, true, ExcludeGhosts)};
 
+    auto && soap_vector_gradients{*manager->template get_property<PropGrad_t>(
+        this->get_gradient_name(), true, true)};
+
     // if the representation has already been computed for the current
     // structure then do nothing
     if (soap_vectors.is_updated()) {
@@ -422,7 +518,21 @@ namespace rascal {
     }
 
     this->initialize_per_center_lambda_soap_vectors(
-        soap_vectors, expansions_coefficients, manager);
+        soap_vectors, soap_vector_gradients, expansions_coefficients, manager);
+
+    // to store the norm of the soap vectors
+    SpectrumNorm_t<StructureManager> soap_vector_norm_inv{
+        *manager, "lambda spectrums inverse norms", true};
+    soap_vector_norm_inv.resize();
+
+    const size_t n_max{this->max_radial};
+    const size_t n_row{n_max * n_max};
+    const size_t n_col{this->lambda_spectrum_couplings.n_channels *
+                       (2 * this->lambda + 1)};
+    // LambdaSpectrum of a pair of species, see add_lambda_spectrum()
+    Eigen::MatrixXd lambda_spectrum{};
+    Eigen::MatrixXd coef2_by_lm{};
+    Eigen::VectorXd coupled_coef2{};
 
     Key_t p_type{0, 0};
     internal::SortedKey<Key_t> pair_type{p_type};
@@ -431,110 +541,20 @@ namespace rascal {
       auto & coefficients{expansions_coefficients[center]};
       auto & soap_vector{soap_vectors[center]};
 
+      // only the pairs of sorted species are stored
       for (const auto & el1 : coefficients) {
         pair_type[0] = el1.first[0];
-        auto & coef1{el1.second};
         for (const auto & el2 : coefficients) {
           pair_type[1] = el2.first[0];
-          auto & coef2{el2.second};
-
-          size_t & l3{this->lambda};
-          if (soap_vector.count(pair_type) == 1) {
-            auto && soap_vector_by_type{soap_vector[pair_type]};
-
-            size_t nn{0};
-            for (size_t n1{0}; n1 < this->max_radial; n1++) {
-              for (size_t n2{0}; n2 < this->max_radial; n2++) {
-                size_t l0{0};
-                int wigner_count{0};
-                for (size_t l1{0}; l1 < this->max_angular + 1; l1++) {
-                  for (size_t l2{0}; l2 < this->max_angular + 1; l2++) {
-                    if ((l1 < static_cast<size_t>(std::abs<int>(l2 - l3))) ||
-                        (l1 > l2 + l3)) {
-                      continue;
-                    }
-                    if (this->inversion_symmetry == true) {
-                      if ((l1 + l2 + l3) % 2 == 1) {
-                        continue;
-                      }
-                    }
-                    for (size_t m3{0}; m3 < 2 * l3 + 1; m3++) {
-                      int m3s{static_cast<int>(m3 - l3)};
-                      for (size_t m1{0}; m1 < 2 * l1 + 1; m1++) {
-                        int m1s{static_cast<int>(m1 - l1)};
-                        size_t lm1{pow(l1, 2_size_t) + m1};
-                        for (size_t m2{0}; m2 < 2 * l2 + 1; m2++) {
-                          int m2s{static_cast<int>(m2 - l2)};
-
-                          if ((m1s + m2s + m3s != 0) &&
-                              (m1s + m2s - m3s != 0)) {
-                            continue;
-                          }
-                          size_t lm2{pow(l2, 2_size_t) + m2};
-                          complex coef1c, coef2c;
-                          double w3j = this->wigner_3js[wigner_count];
-                          // usual formulae for converting from real to complex
-                          // These are the inverses of the formulae we used to
-                          // define the real spherical harmonics in
-                          // src/math/spherical_harmonics.hh
-                          if (m1s > 0) {
-                            coef1c = pow(-1.0, m1s) *
-                                     complex(coef1(n1, lm1),
-                                             coef1(n1, lm1 - 2 * m1s));
-                          } else if (m1s == 0) {
-                            coef1c =
-                                complex(coef1(n1, lm1), 0.0) * math::SQRT_TWO;
-                          } else if (m1s < 0) {
-                            coef1c = complex(coef1(n1, lm1 - 2 * m1s),
-                                             -coef1(n1, lm1));
-                          }
-                          if (m2s > 0) {
-                            coef2c = pow(-1.0, m2s) *
-                                     complex(coef2(n2, lm2),
-                                             coef2(n2, lm2 - 2 * m2s));
-                          } else if (m2s == 0) {
-                            coef2c =
-                                complex(coef2(n2, lm2), 0.0) * math::SQRT_TWO;
-                          } else if (m2s < 0) {
-                            coef2c = complex{coef2(n2, lm2 - 2 * m2s),
-                                             -coef2(n2, lm2)};
-                          }
-                          coef1c *= math::INV_SQRT_TWO;
-                          coef2c *= math::INV_SQRT_TWO;
-
-                          // combine the coefficients with Wigner 3j symbols
-                          // TODO(andrea, michael) avoid complex arithmetic
-                          complex i_unit{0.0, 1.0};
-                          if ((l1 + l2 + l3) % 2 == 0) {
-                            if (m3s < 0) {
-                              soap_vector_by_type(nn, l0) +=
-                                  w3j * (i_unit * coef1c * coef2c).real();
-                            } else {
-                              soap_vector_by_type(nn, l0) +=
-                                  w3j * (coef1c * coef2c).real();
-                            }
-                          } else if (this->inversion_symmetry == false) {
-                            if (m3s < 0) {
-                              soap_vector_by_type(nn, l0) +=
-                                  w3j * (i_unit * coef1c * coef2c).imag();
-                            } else {
-                              soap_vector_by_type(nn, l0) +=
-                                  w3j * (coef1c * coef2c).imag();
-                            }
-                          }
-                          wigner_count++;
-                        }  // m2
-                      }    // m1
-                      l0++;
-                    }  // m3
-                  }    // l2
-                }      // l1
-                nn++;
-              }  // n2
-            }    // n1
-          }      // if pair_type count
-        }        // coef1
-      }          // coef1
+          if (pair_type[0] > pair_type[1]) {
+            continue;
+          }
+          lambda_spectrum.setZero(n_row, n_col);
+          this->add_lambda_spectrum(el1.second, el2.second, lambda_spectrum,
+                                    coef2_by_lm, coupled_coef2);
+          soap_vector[pair_type] += lambda_spectrum;
+        }  // coef2
+      }    // coef1
 
       // the SQRT_TWO factor comes from the fact that
       // the upper diagonal of the species is not considered
@@ -542,10 +562,59 @@ namespace rascal {
 
       // normalize the soap vector
       if (this->normalize) {
-        soap_vector.normalize_and_get_norm();
+        double norm_inv{1. / soap_vector.normalize_and_get_norm()};
+        soap_vector_norm_inv[center] = norm_inv;
       }
-    }  // center
-  }    // compute_lambdaspectrum
+
+      if (this->compute_gradients) {
+        for (auto neigh : center.pairs_with_self_pair()) {
+          // \grad_k c^{i}
+          auto & grad_neigh_coefficients{
+              expansions_coefficients_gradient[neigh]};
+          // \grad_k p^{i}
+          auto & soap_neigh_gradient{soap_vector_gradients[neigh]};
+
+          // \grad_k p^{i ab} = p(\grad_k c^{i a}, c^{i b})
+          //                    + p(c^{i a}, \grad_k c^{i b})
+          for (const auto & grad_key : grad_neigh_coefficients.get_keys()) {
+            auto && grad_coef{grad_neigh_coefficients[grad_key]};
+            for (const auto & el : coefficients) {
+              const int species{el.first[0]};
+              for (size_t cartesian_idx{0}; cartesian_idx < ThreeD;
+                   ++cartesian_idx) {
+                const auto grad_coef_by_cart{
+                    grad_coef.middleRows(cartesian_idx * n_max, n_max)};
+                lambda_spectrum.setZero(n_row, n_col);
+                if (grad_key[0] <= species) {
+                  this->add_lambda_spectrum(grad_coef_by_cart, el.second,
+                                            lambda_spectrum, coef2_by_lm,
+                                            coupled_coef2);
+                }
+                if (species <= grad_key[0]) {
+                  this->add_lambda_spectrum(el.second, grad_coef_by_cart,
+                                            lambda_spectrum, coef2_by_lm,
+                                            coupled_coef2);
+                }
+                pair_type[0] = std::min(grad_key[0], species);
+                pair_type[1] = std::max(grad_key[0], species);
+                soap_neigh_gradient[pair_type].middleRows(
+                    cartesian_idx * n_row, n_row) += lambda_spectrum;
+              }  // cartesian_idx
+            }    // el
+          }      // grad_key
+
+          soap_neigh_gradient.multiply_off_diagonal_elements_by(
+              math::SQRT_TWO);
+        }  // neigh
+      }    // if compute_gradients
+    }      // center
+
+    if (this->normalize and this->compute_gradients) {
+      internal::update_gradients_for_normalization(
+          soap_vectors, soap_vector_gradients, manager, soap_vector_norm_inv,
+          n_row * n_col);
+    }
+  }  // compute_lambdaspectrum
 
 }  // namespace rascal
 
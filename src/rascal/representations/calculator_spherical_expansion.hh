@@ -41,6 +41,7 @@
 #include "rascal/structure_managers/make_structure_manager.hh"
 #include "rascal/structure_managers/property_block_sparse.hh"
 #include "rascal/structure_managers/structure_manager.hh"
+#include "rascal/utils/threading.hh"
 #include "rascal/utils/utils.hh"
 
 #include <Eigen/Dense>
@@ -50,6 +51,7 @@
 #include <array>
 #include <cmath>
 #include <exception>
+#include <functional>
 #include <memory>
 #include <sstream>
 #include <unordered_set>
@@ -290,6 +292,97 @@ namespace rascal {
                                  "implemented in a derived class");
         return Matrix_Ref(Matrix_t::Zero());
       }
+
+      /**
+       * Compute the neighbour contributions (and optionally their radial
+       * derivatives) of a batch of neighbours, e.g. all the neighbours of a
+       * center, at once.
+       *
+       * The results are written in preallocated buffers, see
+       * get_radial_integral_neighbour_batch() and
+       * get_radial_neighbour_derivative_batch().
+       *
+       * @param distances of the neighbours
+       * @param neighbour_types atomic type of each neighbour
+       * @param compute_derivatives also compute the radial derivatives
+       */
+      void compute_neighbour_contribution_batch(
+          const Vector_Ref & /*distances*/,
+          const std::vector<int> & /*neighbour_types*/,
+          bool /*compute_derivatives*/) {
+        throw std::runtime_error("This method is pure virtual and should be "
+                                 "implemented in a derived class");
+      }
+
+      /**
+       * Neighbour contributions of the last batch with shape
+       * (n_neighbours, max_radial * (max_angular + 1)). Row i is the
+       * max_radial x (max_angular + 1) contribution of neighbour i in
+       * row-major order.
+       */
+      Matrix_Ref get_radial_integral_neighbour_batch() const {
+        return Matrix_Ref(
+            this->radial_integral_neighbour_batch.topRows(this->n_batch));
+      }
+
+      //! Radial derivatives of the last batch, laid out like the integrals
+      Matrix_Ref get_radial_neighbour_derivative_batch() const {
+        return Matrix_Ref(this->radial_neighbour_derivative_batch.topRows(
+            std::min(this->n_batch,
+                     this->radial_neighbour_derivative_batch.rows())));
+      }
+
+      /**
+       * Whether the neighbour contributions (and their derivatives) already
+       * include the cutoff function, i.e. are f_c(r) R_nl(r), so that they
+       * must not be multiplied by f_c again.
+       */
+      bool includes_cutoff_function() const {
+        return this->cutoff_function_folded;
+      }
+
+     protected:
+      //! read the optional fold_cutoff_function flag of the Spline hypers
+      static bool
+      get_fold_cutoff_function(const Hypers_t & optimization_hypers) {
+        auto spline_hypers = optimization_hypers.at("Spline").get<json>();
+        return spline_hypers.count("fold_cutoff_function") and
+               spline_hypers.at("fold_cutoff_function").get<bool>();
+      }
+
+      /**
+       * Make room for the contributions of n_neighbours neighbours with
+       * n_components entries each. The buffers only ever grow so that
+       * batches of similar sizes do not allocate.
+       */
+      void reserve_batch(Eigen::Index n_neighbours, Eigen::Index n_components,
+                         bool compute_derivatives) {
+        this->n_batch = n_neighbours;
+        if (this->radial_integral_neighbour_batch.rows() < n_neighbours or
+            this->radial_integral_neighbour_batch.cols() != n_components) {
+          this->radial_integral_neighbour_batch.resize(
+              std::max(n_neighbours,
+                       this->radial_integral_neighbour_batch.rows()),
+              n_components);
+        }
+        if (compute_derivatives and
+            (this->radial_neighbour_derivative_batch.rows() < n_neighbours or
+             this->radial_neighbour_derivative_batch.cols() != n_components)) {
+          this->radial_neighbour_derivative_batch.resize(
+              std::max(n_neighbours,
+                       this->radial_neighbour_derivative_batch.rows()),
+              n_components);
+        }
+      }
+
+      //! number of neighbours in the last batch
+      Eigen::Index n_batch{0};
+      //! (n_neighbours, max_radial * (max_angular + 1))
+      Matrix_t radial_integral_neighbour_batch{};
+      //! (n_neighbours, max_radial * (max_angular + 1))
+      Matrix_t radial_neighbour_derivative_batch{};
+      //! the cutoff function is tabulated with the radial integrals
+      bool cutoff_function_folded{false};
     };
 
     template <RadialBasisType RBT>
@@ -389,7 +482,9 @@ namespace rascal {
         this->ortho_norm_matrix.resize(this->max_radial, this->max_radial);
         this->fac_b.resize(this->max_radial, 1);
         this->a_b_l_n.resize(this->max_radial, this->max_angular + 1);
+        this->a_b_l.resize(this->max_radial);
         this->distance_fac_a_l.resize(this->max_angular + 1);
+        this->l_over_distance.resize(this->max_angular + 1);
         this->radial_norm_factors.resize(this->max_radial, 1);
         this->radial_n_factors.resize(this->max_radial);
         this->radial_sigmas.resize(this->max_radial, 1);
@@ -516,6 +611,19 @@ namespace rascal {
 
       Matrix_Ref compute_neighbour_contribution(const double distance,
                                                 const double fac_a) {
+        return this->compute_neighbour_contribution(distance, fac_a,
+                                                    this->compute_gradients);
+      }
+
+      /**
+       * Same as above but the derivatives needed by
+       * compute_neighbour_derivative() are evaluated when
+       * compute_derivatives is true, independently of the compute_gradients
+       * hyper, e.g. for the adjoint of the expansion.
+       */
+      Matrix_Ref compute_neighbour_contribution(const double distance,
+                                                const double fac_a,
+                                                bool compute_derivatives) {
         using math::pow;
         using std::sqrt;
 
@@ -530,7 +638,8 @@ namespace rascal {
         }
 
         // computes (a+b_n)^{-0.5*(3+l+n)}
-        Eigen::ArrayXd a_b_l{Eigen::rsqrt(fac_a + this->fac_b.array())};
+        auto & a_b_l{this->a_b_l};
+        a_b_l = Eigen::rsqrt(fac_a + this->fac_b.array());
         for (size_t radial_n{0}; radial_n < this->max_radial; radial_n++) {
           this->a_b_l_n(radial_n, 0) = pow(a_b_l(radial_n), 3 + radial_n);
         }
@@ -544,7 +653,7 @@ namespace rascal {
         }
 
         this->hyp1f1_calculator.calc(distance, fac_a, this->fac_b,
-                                     this->compute_gradients);
+                                     compute_derivatives);
 
         this->radial_integral_neighbour =
             (this->a_b_l_n.array() *
@@ -561,12 +670,22 @@ namespace rascal {
       compute_neighbour_derivative(const double distance,
                                    const ClusterRefKey<Order, Layer> & /*pair*/,
                                    int /*neighbour_type*/) {
+        return this->compute_neighbour_derivative(distance);
+      }
+
+      /**
+       * Compute the radial derivative of the neighbour contribution at
+       * distance, compute_neighbour_contribution() must have been called
+       * with the same distance first.
+       */
+      Matrix_Ref compute_neighbour_derivative(const double distance) {
         using math::PI;
         using math::pow;
         using std::sqrt;
 
-        // start proportional_factors as the list of l from 0 to l_max
-        Vector_t proportional_factors =
+        // the list of l from 0 to l_max divided by the distance
+        auto & proportional_factors{this->l_over_distance};
+        proportional_factors =
             Vector_t::LinSpaced(this->max_angular + 1, 0, this->max_angular);
         proportional_factors /= distance;
 
@@ -616,6 +735,15 @@ namespace rascal {
         }  // for (neigh : center)
       }
 
+      /**
+       * Transpose of finalize_coefficients(): turn the adjoints dE/dc of the
+       * finalized coefficients into the adjoints of the raw ones
+       */
+      template <typename Coeffs>
+      void finalize_coefficients_adjoint(Coeffs & adjoints) const {
+        adjoints.lhs_dot(this->ortho_norm_matrix.transpose());
+      }
+
       /** Compute common prefactors for the radial Gaussian basis functions */
       void precompute_radial_sigmas() {
         using math::pow;
@@ -714,7 +842,11 @@ namespace rascal {
       // b_n = 1 / (2*\sigma_n^2)
       Vector_t fac_b{};
       Matrix_t a_b_l_n{};
+      //! (a+b_n)^{-1/2}
+      Eigen::ArrayXd a_b_l{};
       Vector_t distance_fac_a_l{};
+      //! l / r_{ij}, buffer of compute_neighbour_derivative
+      Vector_t l_over_distance{};
       //! constant factors of the GTO basis
       //! N_n=sqrt(2/\Gamma(n+3/2)) b_n^{3+2n}/4
       Vector_t radial_norm_factors{};
@@ -875,10 +1007,26 @@ namespace rascal {
 
       inline Matrix_Ref compute_neighbour_contribution(const double distance,
                                                        const double fac_a) {
+        return this->compute_neighbour_contribution(distance, fac_a,
+                                                    this->compute_gradients);
+      }
+
+      /**
+       * Same as above but the gradients of the Bessel functions are also
+       * computed when compute_derivatives is true, even if they were not
+       * requested by the compute_gradients hyper.
+       */
+      Matrix_Ref compute_neighbour_contribution(const double distance,
+                                                const double fac_a,
+                                                bool compute_derivatives) {
         using math::PI;
         using math::pow;
         using std::sqrt;
 
+        if (compute_derivatives and not this->bessel.has_gradients()) {
+          this->bessel.precompute(this->max_angular, this->legendre_points,
+                                  true);
+        }
         this->bessel.calc(distance, fac_a);
 
         this->radial_integral_neighbour =
@@ -891,9 +1039,17 @@ namespace rascal {
       //! Compute the radial derivative of the neighbour contribution
       template <size_t Order, size_t Layer>
       Matrix_Ref
-      compute_neighbour_derivative(const double /*distance*/,
+      compute_neighbour_derivative(const double distance,
                                    const ClusterRefKey<Order, Layer> & /*pair*/,
                                    int /*neighbour_type*/) {
+        return this->compute_neighbour_derivative(distance);
+      }
+
+      /**
+       * Compute the radial derivative of the neighbour contribution,
+       * compute_neighbour_contribution() must have been called first.
+       */
+      Matrix_Ref compute_neighbour_derivative(const double /*distance*/) {
         this->radial_neighbour_derivative =
             this->legendre_radial_factor.asDiagonal() *
             this->bessel.get_gradients().matrix();
@@ -912,6 +1068,9 @@ namespace rascal {
       void finalize_coefficients_der(Coeffs & /*coefficients_gradient*/,
                                      Center & /*center*/) const {}
 
+      template <typename Coeffs>
+      void finalize_coefficients_adjoint(Coeffs & /*adjoints*/) const {}
+
       math::ModifiedSphericalBessel bessel{};
 
       std::shared_ptr<AtomicSmearingSpecificationBase> atomic_smearing{};
@@ -953,6 +1112,7 @@ namespace rascal {
      public:
       using Parent = RadialContribution<RBT>;
       using Hypers_t = typename Parent::Hypers_t;
+      using Matrix_t = typename Parent::Matrix_t;
       using Matrix_Ref = typename Parent::Matrix_Ref;
       using Vector_Ref = typename Parent::Vector_Ref;
 
@@ -990,6 +1150,33 @@ namespace rascal {
                                                     neighbour_type);
       }
 
+      // The analytical contributions are computed one neighbour at a time
+      // and gathered in the batch buffers
+      void compute_neighbour_contribution_batch(
+          const Vector_Ref & distances,
+          const std::vector<int> & /*neighbour_types*/,
+          bool compute_derivatives) {
+        const Eigen::Index n_rows{static_cast<Eigen::Index>(this->max_radial)};
+        const Eigen::Index n_cols{
+            static_cast<Eigen::Index>(this->max_angular + 1)};
+        this->reserve_batch(distances.size(), n_rows * n_cols,
+                            compute_derivatives);
+        for (Eigen::Index i_neigh{0}; i_neigh < distances.size(); ++i_neigh) {
+          const double distance{distances(i_neigh)};
+          Eigen::Map<Matrix_t>(
+              this->radial_integral_neighbour_batch.row(i_neigh).data(),
+              n_rows, n_cols) =
+              Parent::compute_neighbour_contribution(distance, this->fac_a,
+                                                     compute_derivatives);
+          if (compute_derivatives) {
+            Eigen::Map<Matrix_t>(
+                this->radial_neighbour_derivative_batch.row(i_neigh).data(),
+                n_rows, n_cols) =
+                Parent::compute_neighbour_derivative(distance);
+          }
+        }
+      }
+
      protected:
       void precompute() override {
         Parent::precompute();
@@ -1014,6 +1201,9 @@ namespace rascal {
 
     /* For the a constant smearing type the "a" factor can be precomputed and
      * when using the spline has to be initialized and used.
+     * With the fold_cutoff_function option the splines tabulate
+     * f_c(r) R_nl(r) so that the cutoff function does not have to be
+     * evaluated and multiplied for each pair.
      */
     template <RadialBasisType RBT>
     struct RadialContributionHandler<RBT, AtomicSmearingType::Constant,
@@ -1056,7 +1246,8 @@ namespace rascal {
       Matrix_Ref compute_neighbour_contribution(
           const double distance, const ClusterRefKey<Order, Layer> & /*pair*/,
           int /*neighbour_type*/) {
-        this->radial_integral_neighbour = this->intp->interpolate(distance);
+        this->radial_integral_neighbour =
+            this->get_interpolator(distance).interpolate(distance);
         return Matrix_Ref(this->radial_integral_neighbour);
       }
 
@@ -1066,10 +1257,32 @@ namespace rascal {
                                    const ClusterRefKey<Order, Layer> & /*pair*/,
                                    int /*neighbour_type*/) {
         this->radial_neighbour_derivative =
-            this->intp->interpolate_derivative(distance);
+            this->get_interpolator(distance).interpolate_derivative(distance);
         return Matrix_Ref(this->radial_neighbour_derivative);
       }
 
+      // The spline writes its interpolations directly in the batch buffers
+      void compute_neighbour_contribution_batch(
+          const Vector_Ref & distances,
+          const std::vector<int> & /*neighbour_types*/,
+          bool compute_derivatives) {
+        this->reserve_batch(distances.size(), this->intp->get_matrix_size(),
+                            compute_derivatives);
+        if (this->intp_switching) {
+          this->compute_neighbour_contribution_batch_switching(
+              distances, compute_derivatives);
+          return;
+        }
+        this->intp->interpolate_to_matrix(
+            distances, this->radial_integral_neighbour_batch.topRows(
+                           this->n_batch));
+        if (compute_derivatives) {
+          this->intp->interpolate_to_matrix_derivative(
+              distances, this->radial_neighbour_derivative_batch.topRows(
+                             this->n_batch));
+        }
+      }
+
       /*
        * Overwriting the finalization function to empty one, since the
        * finalization happens now in the spline
@@ -1085,6 +1298,10 @@ namespace rascal {
       void finalize_coefficients_der(Coeffs & /*coefficients_gradient*/,
                                      Center & /*center*/) const {}
 
+      //! nothing to do since the finalization happens in the spline
+      template <typename Coeffs>
+      void finalize_coefficients_adjoint(Coeffs & /*adjoints*/) const {}
+
      protected:
       void precompute() override {
         Parent::precompute();
@@ -1114,23 +1331,158 @@ namespace rascal {
         // function
         double range_begin{math::SPHERICAL_BESSEL_FUNCTION_FTOL};
         double range_end{this->interaction_cutoff};
-        this->init_interpolator(range_begin, range_end, accuracy);
+        if (this->get_fold_cutoff_function(optimization_hypers)) {
+          this->init_folded_interpolators(hypers, range_begin, range_end,
+                                          accuracy);
+        } else {
+          this->init_interpolator(range_begin, range_end, accuracy);
+        }
       }
 
       void init_interpolator(const double range_begin, const double range_end,
                              const double accuracy) {
-        // "this" is passed by reference and is mutable
+        this->intp = this->make_interpolator(range_begin, range_end, accuracy);
+      }
+
+      /**
+       * Tabulate f_c(r) R_nl(r) instead of R_nl(r). The second derivative of
+       * the cosine switching function jumps at both ends of the switching
+       * region, which a cubic spline resolves poorly, so one spline is used
+       * inside and one across the switching region. They tabulate the
+       * smooth continuations of f_c a bit beyond the distances where they
+       * are used so that the natural boundary conditions of the splines do
+       * not spoil the accuracy either.
+       */
+      void init_folded_interpolators(const Hypers_t & hypers,
+                                     const double range_begin,
+                                     const double range_end,
+                                     const double accuracy) {
+        auto fc_hypers = hypers.at("cutoff_function").template get<json>();
+        const double cutoff{
+            fc_hypers.at("cutoff").at("value").template get<double>()};
+        const double smooth_width{
+            fc_hypers.at("smooth_width").at("value").template get<double>()};
+        auto radial_scaling{make_radial_scaling_function(fc_hypers)};
+        std::function<double(double)> switching{
+            [radial_scaling, cutoff, smooth_width](const double distance) {
+              return radial_scaling(distance) *
+                     switching_function_cosine_continued(distance, cutoff,
+                                                         smooth_width);
+            }};
+        this->cutoff_function_folded = true;
+        this->switching_begin = cutoff - smooth_width;
+        const double margin{0.5 * smooth_width};
+        if (smooth_width <= 0.) {
+          this->intp = this->make_interpolator(range_begin, range_end,
+                                               accuracy, radial_scaling);
+        } else if (this->switching_begin <= range_begin) {
+          this->intp = this->make_interpolator(range_begin, range_end + margin,
+                                               accuracy, switching);
+        } else {
+          this->intp = this->make_interpolator(
+              range_begin, this->switching_begin + margin, accuracy,
+              radial_scaling);
+          this->intp_switching = this->make_interpolator(
+              std::max(range_begin, this->switching_begin - margin),
+              range_end + margin, accuracy, switching);
+        }
+      }
+
+      /**
+       * Make the spline of the radial integrals, multiplied by factor(r)
+       * when it is given
+       */
+      std::unique_ptr<Spline_t> make_interpolator(
+          const double range_begin, const double range_end,
+          const double accuracy,
+          const std::function<double(double)> & factor = nullptr) {
+        // "this" is passed by reference and is mutable, the spline keeps
+        // func so factor is copied
         std::function<Matrix_t(double)> func{
-            [&](const double distance) mutable {
+            [this, factor](const double distance) mutable {
               Parent::compute_neighbour_contribution(distance, this->fac_a);
               Parent::finalize_radial_integral_neighbour();
+              if (factor) {
+                this->radial_integral_neighbour *= factor(distance);
+              }
               return this->radial_integral_neighbour;
             }};
         Matrix_t result = func(range_begin);
         int cols{static_cast<int>(result.cols())};
         int rows{static_cast<int>(result.rows())};
-        this->intp = std::make_unique<Spline_t>(func, range_begin, range_end,
-                                                accuracy, cols, rows);
+        return std::make_unique<Spline_t>(func, range_begin, range_end,
+                                          accuracy, cols, rows);
+      }
+
+      /**
+       * Batch of neighbours with the folded switching region: the
+       * neighbours are ordered by side of switching_begin so that each
+       * spline interpolates its neighbours in one call, and the rows are
+       * then put back in the order of the neighbours.
+       */
+      void compute_neighbour_contribution_batch_switching(
+          const Vector_Ref & distances, bool compute_derivatives) {
+        const Eigen::Index n_neighbours{distances.size()};
+        this->batch_order.clear();
+        for (Eigen::Index i_neigh{0}; i_neigh < n_neighbours; ++i_neigh) {
+          if (distances(i_neigh) < this->switching_begin) {
+            this->batch_order.push_back(i_neigh);
+          }
+        }
+        const Eigen::Index n_inner{
+            static_cast<Eigen::Index>(this->batch_order.size())};
+        for (Eigen::Index i_neigh{0}; i_neigh < n_neighbours; ++i_neigh) {
+          if (distances(i_neigh) >= this->switching_begin) {
+            this->batch_order.push_back(i_neigh);
+          }
+        }
+        const Eigen::Index n_switching{n_neighbours - n_inner};
+
+        if (this->batch_distances.size() < n_neighbours) {
+          this->batch_distances.resize(n_neighbours);
+        }
+        if (this->batch_values.rows() < n_neighbours or
+            this->batch_values.cols() != this->intp->get_matrix_size()) {
+          this->batch_values.resize(
+              std::max(n_neighbours, this->batch_values.rows()),
+              this->intp->get_matrix_size());
+        }
+        for (Eigen::Index i_row{0}; i_row < n_neighbours; ++i_row) {
+          this->batch_distances(i_row) = distances(this->batch_order[i_row]);
+        }
+        const auto inner_distances{this->batch_distances.head(n_inner)};
+        const auto switching_distances{
+            this->batch_distances.segment(n_inner, n_switching)};
+
+        this->intp->interpolate_to_matrix(inner_distances,
+                                          this->batch_values.topRows(n_inner));
+        this->intp_switching->interpolate_to_matrix(
+            switching_distances,
+            this->batch_values.middleRows(n_inner, n_switching));
+        for (Eigen::Index i_row{0}; i_row < n_neighbours; ++i_row) {
+          this->radial_integral_neighbour_batch.row(this->batch_order[i_row]) =
+              this->batch_values.row(i_row);
+        }
+        if (not compute_derivatives) {
+          return;
+        }
+        this->intp->interpolate_to_matrix_derivative(
+            inner_distances, this->batch_values.topRows(n_inner));
+        this->intp_switching->interpolate_to_matrix_derivative(
+            switching_distances,
+            this->batch_values.middleRows(n_inner, n_switching));
+        for (Eigen::Index i_row{0}; i_row < n_neighbours; ++i_row) {
+          this->radial_neighbour_derivative_batch.row(
+              this->batch_order[i_row]) = this->batch_values.row(i_row);
+        }
+      }
+
+      //! spline covering distance
+      Spline_t & get_interpolator(const double distance) {
+        if (this->intp_switching and distance >= this->switching_begin) {
+          return *this->intp_switching;
+        }
+        return *this->intp;
       }
 
       double get_interpolator_accuracy(const Hypers_t & optimization_hypers) {
@@ -1152,6 +1504,16 @@ namespace rascal {
 
       double fac_a{};
       std::unique_ptr<Spline_t> intp{};
+      //! spline of the switching region when the cutoff function is folded
+      std::unique_ptr<Spline_t> intp_switching{};
+      //! distance where the switching region starts
+      double switching_begin{};
+      //! neighbours of the batch ordered by spline, inner ones first
+      std::vector<Eigen::Index> batch_order{};
+      //! distances of the batch in the order of batch_order
+      typename Parent::Vector_t batch_distances{};
+      //! interpolations of the batch in the order of batch_order
+      Matrix_t batch_values{};
     };
 
     /*
@@ -1398,6 +1760,39 @@ namespace rascal {
         }
       }
 
+      // Each neighbour is interpolated with the spline of its species
+      void compute_neighbour_contribution_batch(
+          const Vector_Ref & distances,
+          const std::vector<int> & neighbour_types,
+          bool compute_derivatives) {
+        // the contributions are projected on n_components radial channels
+        this->reserve_batch(
+            distances.size(),
+            static_cast<Eigen::Index>(this->n_components *
+                                      (this->max_angular + 1)),
+            compute_derivatives);
+        for (Eigen::Index i_neigh{0}; i_neigh < distances.size(); ++i_neigh) {
+          const int neighbour_type{neighbour_types[i_neigh]};
+          auto intp_it{this->intps.find(neighbour_type)};
+          if (intp_it == this->intps.end()) {
+            std::stringstream err_str{};
+            err_str << "RadialDimReduction is missing projection matrices at "
+                       "least for species '"
+                    << neighbour_type << "'";
+            throw std::runtime_error(err_str.str());
+          }
+          intp_it->second->interpolate_to_matrix(
+              distances.segment(i_neigh, 1),
+              this->radial_integral_neighbour_batch.middleRows(i_neigh, 1));
+          if (compute_derivatives) {
+            intp_it->second->interpolate_to_matrix_derivative(
+                distances.segment(i_neigh, 1),
+                this->radial_neighbour_derivative_batch.middleRows(i_neigh,
+                                                                   1));
+          }
+        }
+      }
+
       /*
        * Overwriting the finalization function to empty one, since the
        * finalization happens now in the per neighbour computation
@@ -1413,6 +1808,10 @@ namespace rascal {
       void finalize_coefficients_der(Coeffs & /*coefficients_gradient*/,
                                      Center & /*center*/) const {}
 
+      //! nothing to do since the finalization happens in the spline
+      template <typename Coeffs>
+      void finalize_coefficients_adjoint(Coeffs & /*adjoints*/) const {}
+
      protected:
       Matrix_Ref compute_neighbour_contribution(const double distance,
                                                 int neighbour_type) {
@@ -1460,6 +1859,10 @@ namespace rascal {
         // function
         double range_begin{math::SPHERICAL_BESSEL_FUNCTION_FTOL};
         double range_end{this->interaction_cutoff};
+        if (this->get_fold_cutoff_function(optimization_hypers)) {
+          throw std::logic_error("fold_cutoff_function is not implemented "
+                                 "with RadialDimReduction");
+        }
         this->init_interpolator(range_begin, range_end, accuracy);
       }
 
@@ -1545,6 +1948,113 @@ namespace rascal {
         internal::RadialContributionHandler<RBT, AST, OT>>(radial_integral);
   }
 
+  namespace internal {
+    /**
+     * Scratch memory used to accumulate the expansion of a center and its
+     * gradients. It belongs to the calculator (one per thread) and never
+     * shrinks, so once the largest environment has been seen the neighbour
+     * loop does not allocate.
+     */
+    struct SphericalExpansionWorkspace {
+      using Matrix_t = math::Matrix_t;
+
+      //! Set the size of the per neighbour buffers
+      void resize(size_t max_radial, size_t max_angular) {
+        const auto n_radial{static_cast<Eigen::Index>(max_radial)};
+        const auto n_angular{static_cast<Eigen::Index>(max_angular + 1)};
+        this->c_ij_nlm.resize(n_radial, n_angular * n_angular);
+        this->pair_gradient_contribution_p1.resize(n_radial, n_angular);
+        this->harmonics_direction.resize(3, n_angular * n_angular);
+        this->harmonics_gradients_scaled.resize(3, n_angular * n_angular);
+        this->adjoint_radial.resize(2, n_angular * n_angular);
+      }
+
+      //! Make room for the data of n_neighbours neighbours
+      void reserve_neighbours(Eigen::Index n_neighbours) {
+        if (this->directions.rows() < n_neighbours) {
+          this->directions.resize(n_neighbours, 3);
+          this->distances.resize(n_neighbours);
+          this->neighbour_types.resize(n_neighbours);
+          this->pair_gradients.resize(n_neighbours + 1, 3);
+        }
+      }
+
+      //! c^{ij}_{nlm}
+      Matrix_t c_ij_nlm{};
+      //! d/dr_{ij} (c^{ij}_{nl} f_c(r_{ij})) when f_c is not in the spline
+      Matrix_t pair_gradient_contribution_p1{};
+      //! Y^m_l times each Cartesian component of the direction of r_{ij}
+      Matrix_t harmonics_direction{};
+      //! Cartesian components of \grad Y^m_l times f_c(r_{ij}) / r_{ij}
+      Matrix_t harmonics_gradients_scaled{};
+      //! directions of the neighbours of the current center
+      math::MatrixX3_t directions{};
+      //! distances of the neighbours of the current center
+      Eigen::VectorXd distances{};
+      //! atomic types of the neighbours of the current center
+      std::vector<int> neighbour_types{};
+      //! \sum_n dE/dc^{i}_{nlm} times the two radial factors of
+      //! \grad_j c^{ij}_{nlm}, see contract_gradients()
+      Matrix_t adjoint_radial{};
+      //! dE/dc^{i} contracted with \grad_j c^{i} for the current center
+      Matrix_t pair_gradients{};
+    };
+
+    /**
+     * Copy of the entries of a BlockSparseProperty taken before the property
+     * is resized for the current structure, so that the entries that are
+     * still valid can be put back instead of being recomputed.
+     */
+    template <class Property>
+    class BlockSparsePropertyBackup {
+     public:
+      using Data_t = typename Property::Data_t;
+
+      //! copy the data and the layout of all the entries of property
+      void save(const Property & property) {
+        this->values = property.get_raw_data();
+        this->offsets.clear();
+        this->sizes.clear();
+        this->key_hashes.clear();
+        for (size_t i_entry{0}; i_entry < property.size(); ++i_entry) {
+          const auto & entry{property[i_entry]};
+          this->offsets.push_back(entry.global_offset);
+          this->sizes.push_back(entry.size());
+          this->key_hashes.push_back(entry.get_key_hash());
+        }
+      }
+
+      /**
+       * Put back the saved data of the entry of cluster. Returns false and
+       * leaves property unchanged when the saved entry does not have the
+       * same keys as the current one.
+       */
+      template <class ClusterRef>
+      bool restore(Property & property, const ClusterRef & cluster) const {
+        const size_t i_entry{static_cast<size_t>(
+            cluster.get_cluster_index(property.get_property_layer()))};
+        if (i_entry >= this->offsets.size()) {
+          return false;
+        }
+        auto & entry{property[cluster]};
+        if (entry.size() != this->sizes[i_entry] or
+            entry.get_key_hash() != this->key_hashes[i_entry]) {
+          return false;
+        }
+        entry.get_full_vector() =
+            this->values.segment(this->offsets[i_entry], this->sizes[i_entry])
+                .matrix();
+        return true;
+      }
+
+     protected:
+      Data_t values{};
+      std::vector<size_t> offsets{};
+      std::vector<size_t> sizes{};
+      std::vector<size_t> key_hashes{};
+    };
+  }  // namespace internal
+
   /**
    * Handles the expansion of an environment in a spherical and radial basis.
    *
@@ -1572,10 +2082,33 @@ namespace rascal {
     using Dense_t = typename Property_t<StructureManager>::Dense_t;
     template <class StructureManager>
     using Data_t = typename Property_t<StructureManager>::Data_t;
+    /**
+     * State of the incremental update of each center: its number of
+     * neighbours and the update of the structure at which its expansion
+     * was computed
+     */
+    template <class StructureManager>
+    using IncrementalCenterState_t = Property<size_t, 1, StructureManager, 2>;
+    /**
+     * State of the incremental update of the structure: the update of the
+     * structure at which it was last computed and the number of centers
+     * that were recomputed then
+     */
+    template <class StructureManager>
+    using IncrementalState_t = Property<size_t, 0, StructureManager, 2>;
 
     template <class StructureManager, size_t Order>
     using ClusterRef_t = typename StructureManager::template ClusterRef<Order>;
 
+    template <internal::CutoffFunctionType FcType>
+    using CutoffFunctionPtr_t =
+        std::shared_ptr<internal::CutoffFunction<FcType>>;
+    template <internal::RadialBasisType RadialType,
+              internal::AtomicSmearingType SmearingType,
+              internal::OptimizationType OptType>
+    using RadialIntegralHandlerPtr_t = std::shared_ptr<
+        internal::RadialContributionHandler<RadialType, SmearingType, OptType>>;
+
     using Matrix_t = math::Matrix_t;
     using Vector_t = math::Vector_t;
     using Matrix_Ref = math::Matrix_Ref;
@@ -1611,6 +2144,16 @@ namespace rascal {
         this->compute_gradients = false;
       }
 
+      if (hypers.count("incremental")) {
+        this->incremental = hypers.at("incremental").get<bool>();
+      } else {
+        this->incremental = false;
+      }
+      if (this->incremental and this->compute_gradients) {
+        throw std::logic_error("The incremental update of the spherical "
+                               "expansion does not support gradients.");
+      }
+
       if (hypers.count("expansion_by_species_method")) {
         std::set<std::string> possible_expansion_by_species{
             {"environment wise", "user defined", "structure wise"}};
@@ -1648,8 +2191,8 @@ namespace rascal {
         this->global_species.clear();
       }
 
-      this->spherical_harmonics.precompute(this->max_angular,
-                                           this->compute_gradients);
+      // the derivatives are also needed by contract_gradients()
+      this->spherical_harmonics.precompute(this->max_angular, true);
 
       // create the class that will compute the radial terms of the
       // expansion. the atomic smearing is an integral part of the
@@ -1798,6 +2341,7 @@ namespace rascal {
           max_radial{std::move(other.max_radial)}, max_angular{std::move(
                                                        other.max_angular)},
           compute_gradients{std::move(other.compute_gradients)},
+          incremental{std::move(other.incremental)},
           expansion_by_species{std::move(other.expansion_by_species)},
           global_species{std::move(other.global_species)},
           atomic_smearing_type{std::move(other.atomic_smearing_type)},
@@ -1806,7 +2350,12 @@ namespace rascal {
           optimization_type{std::move(other.optimization_type)},
           cutoff_function{std::move(other.cutoff_function)},
           cutoff_function_type{std::move(other.cutoff_function_type)},
-          spherical_harmonics{std::move(other.spherical_harmonics)} {}
+          spherical_harmonics{std::move(other.spherical_harmonics)},
+          radial_integrals{std::move(other.radial_integrals)},
+          spherical_harmonics_per_thread{
+              std::move(other.spherical_harmonics_per_thread)},
+          workspace{std::move(other.workspace)},
+          workspaces_per_thread{std::move(other.workspaces_per_thread)} {}
 
     //! Destructor
     virtual ~CalculatorSphericalExpansion() = default;
@@ -1844,6 +2393,9 @@ namespace rascal {
     /**
      * loop over a collection of manangers if it is an iterator.
      * Or just call compute_impl() if it's a single manager (see below)
+     *
+     * The structures are distributed among the threads when there are
+     * enough of them, see get_n_threads_for_structures().
      */
     template <
         internal::CutoffFunctionType FcType,
@@ -1853,6 +2405,16 @@ namespace rascal {
         std::enable_if_t<internal::is_proper_iterator<StructureManager>::value,
                          int> = 0>
     void compute_loop(StructureManager & managers) {
+      const int n_threads{this->get_n_threads_for_structures(managers)};
+      if (n_threads > 1) {
+        this->set_up_thread_local_states(n_threads);
+        internal::parallel_for_each(
+            managers, n_threads, [this](auto & manager) {
+              this->template compute_impl<FcType, RadialType, SmearingType,
+                                          OptType>(manager);
+            });
+        return;
+      }
       for (auto & manager : managers) {
         this->compute_impl<FcType, RadialType, SmearingType, OptType>(manager);
       }
@@ -1877,7 +2439,118 @@ namespace rascal {
               internal::OptimizationType OptType, class StructureManager>
     void compute_impl(std::shared_ptr<StructureManager> manager);
 
+    /**
+     * Compute the spherical expansion of the centers of a single manager using
+     * get_n_threads() threads, see compute_center_expansion()
+     */
+    template <internal::CutoffFunctionType FcType,
+              internal::RadialBasisType RadialType,
+              internal::AtomicSmearingType SmearingType,
+              internal::OptimizationType OptType, class StructureManager>
+    void compute_centers_parallel(
+        std::shared_ptr<StructureManager> manager,
+        Property_t<StructureManager> & expansions_coefficients,
+        PropertyGradient_t<StructureManager> & expansions_coefficients_gradient,
+        const std::vector<bool> & is_center_outdated);
+
+    /**
+     * Backward-mode (adjoint) gradients of a function E of the expansion of
+     * the structure: the adjoints dE/dc^{i} are contracted with
+     * \grad_j c^{i}, which is computed on the fly one pair at a time and
+     * never stored, so the expansion does not need compute_gradients.
+     *
+     * accumulate(center, pair_gradients) is called once per center, where
+     * pair_gradients [N_{pairs}+1, 3] holds
+     *   \sum_{nlm} dE/dc^{i}_{nlm} \grad_j c^{i}_{nlm}
+     * in the order of center.pairs_with_self_pair(), i.e. the same partial
+     * gradients as the contraction of dE/dc^{i} with the gradients of the
+     * expansion.
+     *
+     * @param manager structure manager with a full neighbour list whose
+     *          expansion has been computed
+     * @param adjoints dE/dc^{i} of each center with the keys and the key ids
+     *          of the expansion coefficients, it is modified in place
+     * @throw runtime_error with a half neighbour list
+     */
+    template <class StructureManager, class Accumulator>
+    void contract_gradients(std::shared_ptr<StructureManager> manager,
+                            Property_t<StructureManager> & adjoints,
+                            Accumulator && accumulate);
+
+    //! tells if the expansion is updated incrementally
+    bool is_incremental() const { return this->incremental; }
+
+    /**
+     * Number of centers of manager whose expansion was recomputed the last
+     * time it was computed. All the centers are counted without the
+     * incremental hyper.
+     */
+    template <class StructureManager>
+    size_t
+    get_n_centers_recomputed(std::shared_ptr<StructureManager> manager) const {
+      if (not this->incremental) {
+        return manager->size();
+      }
+      auto && state{*manager->template get_property<
+          IncrementalState_t<StructureManager>>(
+          this->get_incremental_state_name(), true, true)};
+      state.resize();
+      return state(1);
+    }
+
+    //! name of the IncrementalState_t property of the structures
+    std::string get_incremental_state_name() const {
+      return this->get_name() + " incremental state";
+    }
+
+    //! name of the IncrementalCenterState_t property of the structures
+    std::string get_incremental_center_state_name() const {
+      return this->get_name() + " incremental center state";
+    }
+
    protected:
+    //! choose the RadialBasisType and AtomicSmearingType, see compute()
+    template <internal::CutoffFunctionType FcType, class StructureManager,
+              class Accumulator>
+    void contract_gradients_by_radial_contribution(
+        std::shared_ptr<StructureManager> manager,
+        Property_t<StructureManager> & adjoints, Accumulator & accumulate);
+
+    //! choose the OptimizationType, see compute()
+    template <internal::CutoffFunctionType FcType,
+              internal::RadialBasisType RadialType,
+              internal::AtomicSmearingType SmearingType, class StructureManager,
+              class Accumulator>
+    void contract_gradients_by_optimization(
+        std::shared_ptr<StructureManager> manager,
+        Property_t<StructureManager> & adjoints, Accumulator & accumulate);
+
+    //! see contract_gradients()
+    template <internal::CutoffFunctionType FcType,
+              internal::RadialBasisType RadialType,
+              internal::AtomicSmearingType SmearingType,
+              internal::OptimizationType OptType, class StructureManager,
+              class Accumulator>
+    void contract_gradients_impl(std::shared_ptr<StructureManager> manager,
+                                 Property_t<StructureManager> & adjoints,
+                                 Accumulator & accumulate);
+
+    /**
+     * Decide which centers of manager have to be recomputed: the ones that
+     * changed, that have a neighbour that changed or that lost a neighbour
+     * since the expansion was last computed (see
+     * StructureManagerCenters::get_atom_update_indices()). The expansion of
+     * the other centers is put back from previous_coefficients.
+     *
+     * @return is_center_outdated, indexed like the iteration over manager
+     */
+    template <class StructureManager>
+    std::vector<bool> update_incremental_state(
+        std::shared_ptr<StructureManager> manager,
+        const internal::BlockSparsePropertyBackup<
+            Property_t<StructureManager>> & previous_coefficients,
+        Property_t<StructureManager> & expansions_coefficients);
+
     //! cutoff radius r_c defining the size of the atom centered environment
     double interaction_cutoff{};
     //! size of the transition region r_t spanning [r_c-r_t, r_c] in which the
@@ -1896,6 +2569,11 @@ namespace rascal {
     //! controls the computation of the gradients of the expansion wrt. atomic
     //! positions
     bool compute_gradients{};
+    /**
+     * only recompute the centers whose environment changed since the last
+     * computation, see update_incremental_state()
+     */
+    bool incremental{};
     /**
      * defines the method to determine the set of species to use in the
      * expansion
@@ -1917,6 +2595,83 @@ namespace rascal {
 
     math::SphericalHarmonics spherical_harmonics{};
 
+    /**
+     * radial integral used by each thread, the first one is radial_integral.
+     * They hold the intermediate results of the neighbour contributions
+     * so they can't be shared between threads.
+     */
+    std::vector<std::shared_ptr<internal::RadialContributionBase>>
+        radial_integrals{};
+    //! spherical harmonics used by each thread
+    std::vector<math::SphericalHarmonics> spherical_harmonics_per_thread{};
+
+    //! scratch memory of the center loop
+    internal::SphericalExpansionWorkspace workspace{};
+    //! scratch memory used by each thread
+    std::vector<internal::SphericalExpansionWorkspace> workspaces_per_thread{};
+
+    //! make sure there are thread local states for n_threads threads
+    void set_up_thread_local_states(size_t n_threads) {
+      if (this->radial_integrals.empty()) {
+        this->radial_integrals.push_back(this->radial_integral);
+      }
+      while (this->radial_integrals.size() < n_threads) {
+        this->radial_integrals.push_back(
+            this->make_radial_integral(this->hypers));
+      }
+      if (this->spherical_harmonics_per_thread.size() < n_threads) {
+        this->spherical_harmonics_per_thread.resize(n_threads,
+                                                    this->spherical_harmonics);
+      }
+      if (this->workspaces_per_thread.size() < n_threads) {
+        this->workspaces_per_thread.resize(n_threads);
+      }
+    }
+
+    /**
+     * Adds (-1)^l times the l blocks of contribution to expansion, for each of
+     * the n_blocks blocks of max_radial rows (e.g. the Cartesian components
+     * of the gradients), i.e. c^{ji} from c^{ij} with a half neighbour list.
+     */
+    template <class Expansion, class Contribution>
+    void add_with_parity(Expansion && expansion,
+                         const Contribution & contribution,
+                         int n_blocks) const {
+      for (int i_block{0}; i_block < n_blocks; ++i_block) {
+        size_t l_block_idx{0};
+        double parity{1.};
+        for (size_t angular_l{0}; angular_l < this->max_angular + 1;
+             ++angular_l) {
+          size_t l_block_size{2 * angular_l + 1};
+          expansion.block(i_block * this->max_radial, l_block_idx,
+                          this->max_radial, l_block_size) +=
+              parity * contribution.block(i_block * this->max_radial,
+                                          l_block_idx, this->max_radial,
+                                          l_block_size);
+          l_block_idx += l_block_size;
+          parity *= -1.;
+        }
+      }
+    }
+
+    //! accumulate the contributions of the neighbours of center
+    template <internal::CutoffFunctionType FcType,
+              internal::RadialBasisType RadialType,
+              internal::AtomicSmearingType SmearingType,
+              internal::OptimizationType OptType, class StructureManager,
+              class Center>
+    void compute_center_expansion(
+        const std::shared_ptr<StructureManager> & manager, Center & center,
+        Property_t<StructureManager> & expansions_coefficients,
+        PropertyGradient_t<StructureManager> &
+            expansions_coefficients_gradient,
+        RadialIntegralHandlerPtr_t<RadialType, SmearingType, OptType> &
+            radial_integral,
+        CutoffFunctionPtr_t<FcType> & cutoff_function,
+        math::SphericalHarmonics & spherical_harmonics,
+        internal::SphericalExpansionWorkspace & workspace,
+        Data_t<StructureManager> * neighbours_coefficients = nullptr);
+
     /**
      * set up chemical keys of the expension so that only species appearing in
      * the environment are present and initialize coeffs to zero.
@@ -1969,21 +2724,29 @@ namespace rascal {
 
    private:
     void set_radial_integral(Hypers_t hypers) {
+      this->radial_integral = this->make_radial_integral(hypers);
+      // the thread local copies are outdated
+      this->radial_integrals.clear();
+      this->spherical_harmonics_per_thread.clear();
+    }
+
+    std::shared_ptr<internal::RadialContributionBase>
+    make_radial_integral(Hypers_t hypers) {
       using internal::AtomicSmearingType;
       using internal::RadialBasisType;
       switch (internal::combine_enums(this->radial_integral_type,
                                       this->atomic_smearing_type)) {
       case internal::combine_enums(RadialBasisType::GTO,
                                    AtomicSmearingType::Constant): {
-        this->set_radial_integral<RadialBasisType::GTO,
-                                  AtomicSmearingType::Constant>(hypers);
-        break;
+        return this->make_radial_integral<RadialBasisType::GTO,
+                                          AtomicSmearingType::Constant>(
+            hypers);
       }
       case internal::combine_enums(RadialBasisType::DVR,
                                    AtomicSmearingType::Constant): {
-        this->set_radial_integral<RadialBasisType::DVR,
-                                  AtomicSmearingType::Constant>(hypers);
-        break;
+        return this->make_radial_integral<RadialBasisType::DVR,
+                                          AtomicSmearingType::Constant>(
+            hypers);
       }
       default:
         std::basic_ostringstream<char> err_message;
@@ -2002,27 +2765,22 @@ namespace rascal {
 
     template <internal::RadialBasisType RadialType,
               internal::AtomicSmearingType AST>
-    void set_radial_integral(Hypers_t hypers) {
+    std::shared_ptr<internal::RadialContributionBase>
+    make_radial_integral(Hypers_t hypers) {
       using internal::OptimizationType;
       switch (this->optimization_type) {
       case (OptimizationType::None): {
-        auto rc_shared = std::make_shared<internal::RadialContributionHandler<
+        return std::make_shared<internal::RadialContributionHandler<
             RadialType, AST, OptimizationType::None>>(hypers);
-        this->radial_integral = rc_shared;
-        break;
       }
       case (OptimizationType::Spline): {
-        auto rc_shared = std::make_shared<internal::RadialContributionHandler<
+        return std::make_shared<internal::RadialContributionHandler<
             RadialType, AST, OptimizationType::Spline>>(hypers);
-        this->radial_integral = rc_shared;
-        break;
       }
       case (OptimizationType::RadialDimReductionSpline): {
-        auto rc_shared = std::make_shared<internal::RadialContributionHandler<
+        return std::make_shared<internal::RadialContributionHandler<
             RadialType, AST, OptimizationType::RadialDimReductionSpline>>(
             hypers);
-        this->radial_integral = rc_shared;
-        break;
       }
       default:
         std::basic_ostringstream<char> err_message;
@@ -2187,6 +2945,11 @@ namespace rascal {
       throw std::runtime_error(err_str.str());
     }
 
+    if (this->incremental and IsHalfNL) {
+      throw std::runtime_error("The incremental update of the spherical "
+                               "expansion requires a full neighbour list.");
+    }
+
     auto && expansions_coefficients{*manager->template get_property<Prop_t>(
         this->get_name(), true, true, ExcludeGhosts)};
 
@@ -2200,18 +2963,40 @@ namespace rascal {
       return;
     }
 
+    // the coefficients of the centers that did not change are kept aside
+    // before the property is resized for the current structure
+    internal::BlockSparsePropertyBackup<Prop_t> previous_coefficients{};
+    if (this->incremental) {
+      previous_coefficients.save(expansions_coefficients);
+    }
+
+    // when structures are computed concurrently (see compute_loop()) each
+    // thread uses its own radial integral and spherical harmonics
+    const size_t i_thread{
+        internal::in_parallel()
+            ? static_cast<size_t>(internal::get_thread_num())
+            : 0};
+    auto & spherical_harmonics{
+        i_thread == 0 ? this->spherical_harmonics
+                      : this->spherical_harmonics_per_thread.at(i_thread)};
+    auto & workspace{i_thread == 0 ? this->workspace
+                                   : this->workspaces_per_thread.at(i_thread)};
+
     // downcast cutoff and radial contributions so they are functional
     auto cutoff_function{
         downcast_cutoff_function<FcType>(this->cutoff_function)};
     auto radial_integral{
         downcast_radial_integral_handler<RadialType, SmearingType, OptType>(
-            this->radial_integral)};
+            i_thread == 0 ? this->radial_integral
+                          : this->radial_integrals.at(i_thread))};
     auto n_row{this->max_radial};
     // to store linearly all l,m components with
     // -l-1<=m<=l+1 needs (l+1)**2 elements
     auto n_col{(this->max_angular + 1) * (this->max_angular + 1)};
     expansions_coefficients.clear();
     expansions_coefficients.set_shape(n_row, n_col);
+    expansions_coefficients_gradient.set_key_interner(
+        expansions_coefficients.get_key_interner());
     if (compute_gradients) {
       expansions_coefficients_gradient.clear();
       // Row-major ordering, so the Cartesian (spatial) index varies slowest
@@ -2231,191 +3016,720 @@ namespace rascal {
       throw std::runtime_error("should not arrive here");
     }
 
-    // coeff C^{ij}_{nlm}
-    auto c_ij_nlm = math::Matrix_t(n_row, n_col);
+    // empty when all the centers have to be computed
+    std::vector<bool> is_center_outdated{};
+    if (this->incremental) {
+      is_center_outdated = this->update_incremental_state(
+          manager, previous_coefficients, expansions_coefficients);
+    }
+
+    // split the centers among threads unless the calculator is already used
+    // from within a parallel region, e.g. one thread per structure
+    if (this->get_n_threads() > 1 and not internal::in_parallel()) {
+      this->compute_centers_parallel<FcType, RadialType, SmearingType,
+                                     OptType>(
+          manager, expansions_coefficients, expansions_coefficients_gradient,
+          is_center_outdated);
+      return;
+    }
 
+    workspace.resize(this->max_radial, this->max_angular);
+
+    size_t i_center{0};
     for (auto center : manager) {
-      // c^{i}
-      auto & coefficients_center = expansions_coefficients[center];
-      // \grad_i c^{i}
-      auto & coefficients_center_gradient =
-          expansions_coefficients_gradient[center.get_atom_ii()];
-      auto atom_i_tag = center.get_atom_tag();
-      Key_t center_type{center.get_atom_type()};
+      const bool is_outdated{is_center_outdated.empty() or
+                             is_center_outdated[i_center]};
+      ++i_center;
+      if (not is_outdated) {
+        continue;
+      }
+      this->compute_center_expansion(
+          manager, center, expansions_coefficients,
+          expansions_coefficients_gradient, radial_integral, cutoff_function,
+          spherical_harmonics, workspace);
 
-      // Start the accumulation with the central atom contribution
-      coefficients_center[center_type].col(0) +=
-          radial_integral->template compute_center_contribution(
-              center, center.get_atom_type()) /
-          sqrt(4.0 * PI);
+      // Normalize and orthogonalize the radial coefficients
+      radial_integral->finalize_coefficients(expansions_coefficients[center]);
+      if (compute_gradients) {
+        radial_integral->template finalize_coefficients_der<ThreeD>(
+            expansions_coefficients_gradient, center);
+      }
+    }  // for (center : manager)
+  }    // compute()
 
-      for (auto neigh : center.pairs()) {
-        auto atom_j = neigh.get_atom_j();
-        const int atom_j_tag = atom_j.get_atom_tag();
-        const bool is_center_atom{manager->is_center_atom(neigh)};
-
-        const double & dist{manager->get_distance(neigh)};
-        const auto direction{manager->get_direction_vector(neigh)};
-        Key_t neigh_type{neigh.get_atom_type()};
-
-        // the typical definition of the expansion coefficients involves
-        // (Y^m_l)*, but we compute everything with actual _real_ harmonics,
-        // so we just compute the real-valued Y^m_l (conjugate=false)
-        this->spherical_harmonics.calc(direction, compute_gradients, false);
-        auto && harmonics{spherical_harmonics.get_harmonics()};
-        auto && harmonics_gradients{
-            spherical_harmonics.get_harmonics_derivatives()};
-        auto && neighbour_contribution =
-            radial_integral->template compute_neighbour_contribution(
-                dist, neigh, neigh.get_atom_type());
-        double f_c{cutoff_function->f_c(dist)};
-        auto coefficients_center_by_type{coefficients_center[neigh_type]};
-
-        // compute the coefficients
-        size_t l_block_idx{0};
-        for (size_t angular_l{0}; angular_l < this->max_angular + 1;
-             ++angular_l) {
-          size_t l_block_size{2 * angular_l + 1};
-          c_ij_nlm.block(0, l_block_idx, this->max_radial, l_block_size) =
-              neighbour_contribution.col(angular_l) *
-              harmonics.segment(l_block_idx, l_block_size);
-          l_block_idx += l_block_size;
-        }
+  /**
+   * Accumulate the contributions of the neighbours of center to its
+   * expansion (and gradients). The coefficients are not finalized.
+   *
+   * With a half neighbour list the pair ij also contributes to the expansion
+   * of j. These contributions are accumulated in neighbours_coefficients
+   * (laid out like the raw data of expansions_coefficients) when it is
+   * provided and the ones to the gradients of j are then left to the caller,
+   * so that several centers can be computed concurrently.
+   *
+   * All the intermediate results are stored in workspace, which has to be
+   * resized for the current hypers, and in the batch buffers of
+   * spherical_harmonics and radial_integral. None of them shrink so the
+   * neighbour loop does not allocate in the steady state.
+   */
+  template <internal::CutoffFunctionType FcType,
+            internal::RadialBasisType RadialType,
+            internal::AtomicSmearingType SmearingType,
+            internal::OptimizationType OptType, class StructureManager,
+            class Center>
+  void CalculatorSphericalExpansion::compute_center_expansion(
+      const std::shared_ptr<StructureManager> & manager, Center & center,
+      Property_t<StructureManager> & expansions_coefficients,
+      PropertyGradient_t<StructureManager> & expansions_coefficients_gradient,
+      RadialIntegralHandlerPtr_t<RadialType, SmearingType, OptType> &
+          radial_integral,
+      CutoffFunctionPtr_t<FcType> & cutoff_function,
+      math::SphericalHarmonics & spherical_harmonics,
+      internal::SphericalExpansionWorkspace & workspace,
+      Data_t<StructureManager> * neighbours_coefficients) {
+    constexpr static bool IsHalfNL{
+        StructureManager::traits::NeighbourListType ==
+        AdaptorTraits::NeighbourListType::half};
+    using math::PI;
+    const bool compute_gradients{this->compute_gradients};
+    const bool is_deferred{neighbours_coefficients != nullptr};
+
+    // c^{i}
+    auto & coefficients_center = expansions_coefficients[center];
+    // \grad_i c^{i}
+    auto & coefficients_center_gradient =
+        expansions_coefficients_gradient[center.get_atom_ii()];
+    auto atom_i_tag = center.get_atom_tag();
+    // the coefficients and their gradients share the ids of the species keys
+    const int center_type_id{
+        expansions_coefficients.find_key_id_by_element(center.get_atom_type())};
+
+    // Start the accumulation with the central atom contribution
+    coefficients_center.block_by_id(center_type_id).col(0) +=
+        radial_integral->template compute_center_contribution(
+            center, center.get_atom_type()) /
+        sqrt(4.0 * PI);
+
+    // gather the directions, distances and types of all the neighbours to
+    // compute their spherical harmonics and radial integrals at once
+    Eigen::Index n_neighbours{0};
+    for (auto neigh : center.pairs()) {
+      static_cast<void>(neigh);
+      ++n_neighbours;
+    }
+    workspace.reserve_neighbours(n_neighbours);
+    auto && directions{workspace.directions.topRows(n_neighbours)};
+    auto && distances{workspace.distances.head(n_neighbours)};
+    auto & neighbour_types{workspace.neighbour_types};
+    Eigen::Index i_neigh{0};
+    for (auto neigh : center.pairs()) {
+      directions.row(i_neigh) =
+          manager->get_direction_vector(neigh).transpose();
+      distances(i_neigh) = manager->get_distance(neigh);
+      neighbour_types[i_neigh] = neigh.get_atom_type();
+      ++i_neigh;
+    }
+    radial_integral->compute_neighbour_contribution_batch(
+        distances, neighbour_types, compute_gradients);
+    auto && radial_integral_batch{
+        radial_integral->get_radial_integral_neighbour_batch()};
+    auto && radial_derivative_batch{
+        radial_integral->get_radial_neighbour_derivative_batch()};
+    const Eigen::Index n_radial{static_cast<Eigen::Index>(this->max_radial)};
+    const Eigen::Index n_angular{
+        static_cast<Eigen::Index>(this->max_angular + 1)};
+    // the typical definition of the expansion coefficients involves
+    // (Y^m_l)*, but we compute everything with actual _real_ harmonics,
+    // so we just compute the real-valued Y^m_l (conjugate=false)
+    spherical_harmonics.calc_batch(directions, compute_gradients, false);
+    auto && harmonics_batch{spherical_harmonics.get_harmonics_batch()};
+    auto && harmonics_gradients_batch{
+        spherical_harmonics.get_harmonics_derivatives_batch()};
+    const Eigen::Index n_harmonics{harmonics_batch.cols()};
+    // with a spline the cutoff function can be tabulated together with the
+    // radial integrals, which then give f_c c^{ij} and its derivative
+    const bool is_cutoff_folded{radial_integral->includes_cutoff_function()};
+
+    // coeff C^{ij}_{nlm}
+    auto & c_ij_nlm{workspace.c_ij_nlm};
+    // d/dr_{ij} (c_{ij} f_c{r_{ij}})
+    auto & pair_gradient_contribution_p1{
+        workspace.pair_gradient_contribution_p1};
+    auto & harmonics_direction{workspace.harmonics_direction};
+    auto & harmonics_gradients_scaled{workspace.harmonics_gradients_scaled};
+
+    i_neigh = 0;
+    for (auto neigh : center.pairs()) {
+      auto atom_j = neigh.get_atom_j();
+      const int atom_j_tag = atom_j.get_atom_tag();
+      const bool is_center_atom{manager->is_center_atom(neigh)};
+
+      const double & dist{distances(i_neigh)};
+      const int neigh_type_id{expansions_coefficients.find_key_id_by_element(
+          neighbour_types[i_neigh])};
+
+      // Y^m_l of the neighbour
+      auto && harmonics{harmonics_batch.row(i_neigh)};
+      Eigen::Map<const Matrix_t> neighbour_contribution(
+          radial_integral_batch.row(i_neigh).data(), n_radial, n_angular);
+      const double f_c{is_cutoff_folded ? 1. : cutoff_function->f_c(dist)};
+      auto coefficients_center_by_type{
+          coefficients_center.block_by_id(neigh_type_id)};
+
+      // compute the coefficients
+      size_t l_block_idx{0};
+      for (size_t angular_l{0}; angular_l < this->max_angular + 1;
+           ++angular_l) {
+        size_t l_block_size{2 * angular_l + 1};
+        c_ij_nlm.block(0, l_block_idx, this->max_radial, l_block_size)
+            .noalias() = neighbour_contribution.col(angular_l) *
+                         harmonics.segment(l_block_idx, l_block_size);
+        l_block_idx += l_block_size;
+      }
+      if (not is_cutoff_folded) {
         c_ij_nlm *= f_c;
-        coefficients_center_by_type += c_ij_nlm;
+      }
+      coefficients_center_by_type += c_ij_nlm;
+
+      // half list branch for c^{ji} terms using
+      // c^{ij}_{nlm} = (-1)^l c^{ji}_{nlm}.
+      if (IsHalfNL) {
+        if (is_center_atom) {
+          auto & coefficients_neigh{expansions_coefficients[atom_j]};
+          if (not is_deferred) {
+            auto coefficients_neigh_by_type{
+                coefficients_neigh.block_by_id(center_type_id)};
+            this->add_with_parity(coefficients_neigh_by_type, c_ij_nlm, 1);
+          } else {
+            // c^{j} might be updated concurrently by another thread
+            auto position{
+                coefficients_neigh.get_location_by_id(center_type_id)};
+            Eigen::Map<Matrix_t> coefficients_neigh_by_type(
+                &(*neighbours_coefficients)(position), c_ij_nlm.rows(),
+                c_ij_nlm.cols());
+            this->add_with_parity(coefficients_neigh_by_type, c_ij_nlm, 1);
+          }
+        }
+      }
+
+      // compute the gradients of the coefficients with respect to
+      // atoms positions
+      // but only if the neighbour is _not_ an image of the center!
+      // (the periodic images move with the center, so their contribution to
+      // the center gradient is zero)
+      if (compute_gradients) {  // NOLINT
+        // \grad_j c^i
+        auto & coefficients_neigh_gradient =
+            expansions_coefficients_gradient[neigh];
+
+        Eigen::Map<const Matrix_t> neighbour_derivative(
+            radial_derivative_batch.row(i_neigh).data(), n_radial, n_angular);
+        // The type of the contribution c^{ij} to the coefficient c^{i}
+        // depends on the type of j (and it is the same for the gradients)
+        // In the following atom i is of type a and atom j is of type b
+
+        // grad_i c^{ib}
+        auto && gradient_center_by_type{
+            coefficients_center_gradient.block_by_id(neigh_type_id)};
+        // grad_j c^{ib}
+        auto && gradient_neigh_by_type{
+            coefficients_neigh_gradient.block_by_id(neigh_type_id)};
+
+        // d/dr_{ij} (c^{ij} f_c(r_{ij})), given by the spline when the
+        // cutoff function is folded in it
+        const double * radial_gradient_data{neighbour_derivative.data()};
+        if (not is_cutoff_folded) {
+          const double df_c{cutoff_function->df_c(dist)};
+          pair_gradient_contribution_p1.noalias() =
+              neighbour_derivative * f_c + neighbour_contribution * df_c;
+          radial_gradient_data = pair_gradient_contribution_p1.data();
+        }
+        Eigen::Map<const Matrix_t> radial_gradient(radial_gradient_data,
+                                                   n_radial, n_angular);
+        // the angular factors of both terms of grad_j c^{ij}, so that the
+        // products below only involve plain blocks and need no temporaries
+        for (int cartesian_idx{0}; cartesian_idx < ThreeD; ++cartesian_idx) {
+          harmonics_direction.row(cartesian_idx).noalias() =
+              harmonics * directions(i_neigh, cartesian_idx);
+          harmonics_gradients_scaled.row(cartesian_idx).noalias() =
+              harmonics_gradients_batch.block(
+                  i_neigh, cartesian_idx * n_harmonics, 1, n_harmonics) *
+              (f_c / dist);
+        }
 
-        // half list branch for c^{ji} terms using
-        // c^{ij}_{nlm} = (-1)^l c^{ji}_{nlm}.
-        if (IsHalfNL) {
+        // clang-format off
+        for (int cartesian_idx{0}; cartesian_idx < ThreeD;
+               ++cartesian_idx) {
+          l_block_idx = 0;
+          for (size_t angular_l{0}; angular_l < this->max_angular + 1;
+              ++angular_l) {
+            size_t l_block_size{2 * angular_l + 1};
+            // Each Cartesian gradient component occupies a contiguous block
+            // (row-major storage)
+            // grad_j c^{ib} =  grad_j c^{ijb}
+            auto pair_gradient_contribution{gradient_neigh_by_type.block(
+                cartesian_idx * max_radial, l_block_idx,
+                max_radial, l_block_size)};
+            pair_gradient_contribution.noalias() =
+              radial_gradient.col(angular_l)
+              * harmonics_direction.block(
+                  cartesian_idx, l_block_idx, 1, l_block_size);
+            pair_gradient_contribution.noalias() +=
+                neighbour_contribution.col(angular_l)
+                * harmonics_gradients_scaled.block(
+                    cartesian_idx, l_block_idx, 1, l_block_size);
+
+            // grad_i c^{ib} = - \sum_{j} grad_j c^{ijb}
+            if (atom_j_tag != atom_i_tag) {
+              gradient_center_by_type.block(
+                  cartesian_idx * max_radial, l_block_idx,
+                  max_radial, l_block_size) -= pair_gradient_contribution;
+            }
+            l_block_idx += l_block_size;
+            // clang-format on
+          }  // for (angular_l)
+        }    // for cartesian_idx
+
+        // half list branch for accumulating parts of grad_j c^{j} using
+        // grad_j c^{ji a} = (-1)^l grad_j c^{ij b}
+        if (IsHalfNL and not is_deferred) {
           if (is_center_atom) {
-            auto & coefficients_neigh{expansions_coefficients[atom_j]};
-            auto coefficients_neigh_by_type{coefficients_neigh[center_type]};
-            l_block_idx = 0;
-            double parity{1.};
-            for (size_t angular_l{0}; angular_l < this->max_angular + 1;
-                 ++angular_l) {
-              size_t l_block_size{2 * angular_l + 1};
-              coefficients_neigh_by_type.block(0, l_block_idx, this->max_radial,
-                                               l_block_size) +=
-                  parity * c_ij_nlm.block(0, l_block_idx, this->max_radial,
-                                          l_block_size);
-              l_block_idx += l_block_size;
-              parity *= -1.;
+            // grad_j c^{j}
+            auto & coefficients_neigh_center_gradient =
+                expansions_coefficients_gradient[neigh.get_atom_jj()];
+            // grad_j c^{j a}
+            auto gradient_neigh_center_by_type =
+                coefficients_neigh_center_gradient.block_by_id(center_type_id);
+            this->add_with_parity(gradient_neigh_center_by_type,
+                                  gradient_neigh_by_type, ThreeD);
+          }  // if (is_center_atom)
+        }    // if (IsHalfNL)
+      }      // if (compute_gradients)
+      ++i_neigh;
+    }  // for (neigh : center)
+  }
+
+  /**
+   * Compute the spherical expansion of the centers of manager concurrently.
+   *
+   * Each thread uses its own radial integral, spherical harmonics and
+   * workspace. With a half neighbour list, the contributions to the expansion
+   * of the neighbours are accumulated in one buffer per thread which are
+   * summed up in a fixed order, and the ones to their gradients are added
+   * serially, in the same order as in the serial case, once all the pair
+   * gradients are known. The coefficients are finalized at the end.
+   */
+  template <internal::CutoffFunctionType FcType,
+            internal::RadialBasisType RadialType,
+            internal::AtomicSmearingType SmearingType,
+            internal::OptimizationType OptType, class StructureManager>
+  void CalculatorSphericalExpansion::compute_centers_parallel(
+      std::shared_ptr<StructureManager> manager,
+      Property_t<StructureManager> & expansions_coefficients,
+      PropertyGradient_t<StructureManager> & expansions_coefficients_gradient,
+      const std::vector<bool> & is_center_outdated) {
+    constexpr static bool IsHalfNL{
+        StructureManager::traits::NeighbourListType ==
+        AdaptorTraits::NeighbourListType::half};
+    const bool compute_gradients{this->compute_gradients};
+    const int n_threads{this->get_n_threads()};
+    const int n_centers{static_cast<int>(manager->size())};
+
+    this->set_up_thread_local_states(n_threads);
+    auto cutoff_function{
+        downcast_cutoff_function<FcType>(this->cutoff_function)};
+
+    // c^{j} contributions of the half neighbour list, one buffer per thread
+    std::vector<Data_t<StructureManager>> neighbours_coefficients{};
+    if (IsHalfNL) {
+      neighbours_coefficients.resize(
+          n_threads, Data_t<StructureManager>::Zero(
+                         expansions_coefficients.get_raw_data().size()));
+    }
+
+#pragma omp parallel num_threads(n_threads)
+    {
+      const int i_thread{internal::get_thread_num()};
+      auto radial_integral{
+          downcast_radial_integral_handler<RadialType, SmearingType, OptType>(
+              this->radial_integrals[i_thread])};
+      auto & spherical_harmonics{
+          this->spherical_harmonics_per_thread[i_thread]};
+      auto & workspace{this->workspaces_per_thread[i_thread]};
+      workspace.resize(this->max_radial, this->max_angular);
+      Data_t<StructureManager> * neighbours_coefficients_thread{
+          IsHalfNL ? &neighbours_coefficients[i_thread] : nullptr};
+
+      auto compute_center = [&](int i_center) {
+        if (not is_center_outdated.empty() and
+            not is_center_outdated[i_center]) {
+          return;
+        }
+        // the cluster ref refers to the iterator so it has to be kept alive
+        auto center_it{manager->get_iterator_at(i_center)};
+        auto center{*center_it};
+        this->compute_center_expansion(
+            manager, center, expansions_coefficients,
+            expansions_coefficients_gradient, radial_integral, cutoff_function,
+            spherical_harmonics, workspace, neighbours_coefficients_thread);
+      };
+
+      if (IsHalfNL) {
+        // static schedule so that the content of the buffers does not depend
+        // on the run
+#pragma omp for schedule(static)
+        for (int i_center = 0; i_center < n_centers; ++i_center) {
+          compute_center(i_center);
+        }
+      } else {
+        // the number of neighbours can vary a lot from center to center
+#pragma omp for schedule(dynamic, 16)
+        for (int i_center = 0; i_center < n_centers; ++i_center) {
+          compute_center(i_center);
+        }
+      }
+    }  // omp parallel
+
+    if (IsHalfNL) {
+      auto & values{expansions_coefficients.get_raw_data()};
+      for (const auto & buffer : neighbours_coefficients) {
+        values += buffer;
+      }
+      // grad_j c^{ji a} = (-1)^l grad_j c^{ij b}, where grad_j c^{ij b} has
+      // been stored in the pair ij
+      if (compute_gradients) {
+        for (auto center : manager) {
+          const int center_type_id{
+              expansions_coefficients.find_key_id_by_element(
+                  center.get_atom_type())};
+          for (auto neigh : center.pairs()) {
+            if (manager->is_center_atom(neigh)) {
+              const int neigh_type_id{
+                  expansions_coefficients.find_key_id_by_element(
+                      neigh.get_atom_type())};
+              auto gradient_neigh_by_type{
+                  expansions_coefficients_gradient[neigh].block_by_id(
+                      neigh_type_id)};
+              auto gradient_neigh_center_by_type{
+                  expansions_coefficients_gradient[neigh.get_atom_jj()]
+                      .block_by_id(center_type_id)};
+              this->add_with_parity(gradient_neigh_center_by_type,
+                                    gradient_neigh_by_type, ThreeD);
             }
           }
         }
+      }
+    }
 
-        // compute the gradients of the coefficients with respect to
-        // atoms positions
-        // but only if the neighbour is _not_ an image of the center!
-        // (the periodic images move with the center, so their contribution to
-        // the center gradient is zero)
-        if (compute_gradients) {  // NOLINT
-          // \grad_j c^i
-          auto & coefficients_neigh_gradient =
-              expansions_coefficients_gradient[neigh];
-
-          auto && neighbour_derivative =
-              radial_integral->compute_neighbour_derivative(
-                  dist, neigh, neigh.get_atom_type());
-          double df_c{cutoff_function->df_c(dist)};
-          // The type of the contribution c^{ij} to the coefficient c^{i}
-          // depends on the type of j (and it is the same for the gradients)
-          // In the following atom i is of type a and atom j is of type b
-
-          // grad_i c^{ib}
-          auto && gradient_center_by_type{
-              coefficients_center_gradient[neigh_type]};
-          // grad_j c^{ib}
-          auto && gradient_neigh_by_type{
-              coefficients_neigh_gradient[neigh_type]};
-
-          // clang-format off
-          // d/dr_{ij} (c_{ij} f_c{r_{ij}})
-          Matrix_t pair_gradient_contribution_p1 =
-                ((neighbour_derivative * f_c)
-                 + (neighbour_contribution * df_c));
-          // grad_j c^{ij}
-          Matrix_t pair_gradient_contribution{this->max_radial,
-                                              this->max_angular + 1};
-          for (int cartesian_idx{0}; cartesian_idx < ThreeD;
-                 ++cartesian_idx) {
-            l_block_idx = 0;
-            for (size_t angular_l{0}; angular_l < this->max_angular + 1;
-                ++angular_l) {
-              size_t l_block_size{2 * angular_l + 1};
-              pair_gradient_contribution.resize(this->max_radial, l_block_size);
-              pair_gradient_contribution =
-                pair_gradient_contribution_p1.col(angular_l)
-                * harmonics.segment(l_block_idx, l_block_size)
-                * direction(cartesian_idx);
-              pair_gradient_contribution +=
-                  neighbour_contribution.col(angular_l)
-                  * harmonics_gradients.block(cartesian_idx, l_block_idx,
-                                              1, l_block_size)
-                  * f_c / dist;
-
-              // Each Cartesian gradient component occupies a contiguous block
-              // (row-major storage)
-              // grad_i c^{ib} = - \sum_{j} grad_j c^{ijb}
-              if (atom_j_tag != atom_i_tag) {
-                gradient_center_by_type.block(
-                    cartesian_idx * max_radial, l_block_idx,
-                    max_radial, l_block_size) -= pair_gradient_contribution;
-              }
-              // grad_j c^{ib} =  grad_j c^{ijb}
-              gradient_neigh_by_type.block(
-                  cartesian_idx * max_radial, l_block_idx,
-                  max_radial, l_block_size) = pair_gradient_contribution;
-              l_block_idx += l_block_size;
-              // clang-format on
-            }  // for (angular_l)
-          }    // for cartesian_idx
-
-          // half list branch for accumulating parts of grad_j c^{j} using
-          // grad_j c^{ji a} = (-1)^l grad_j c^{ij b}
-          if (IsHalfNL) {
-            if (is_center_atom) {
-              // grad_j c^{j}
-              auto & coefficients_neigh_center_gradient =
-                  expansions_coefficients_gradient[neigh.get_atom_jj()];
-              // grad_j c^{j a}
-              auto gradient_neigh_center_by_type =
-                  coefficients_neigh_center_gradient[center_type];
-
-              for (int cartesian_idx{0}; cartesian_idx < ThreeD;
-                   ++cartesian_idx) {
-                l_block_idx = 0;
-                double parity{1};
-                for (size_t angular_l{0}; angular_l < this->max_angular + 1;
-                     ++angular_l) {
-                  size_t l_block_size{2 * angular_l + 1};
-                  // clang-format off
-                  gradient_neigh_center_by_type.block(
-                      cartesian_idx * max_radial, l_block_idx,
-                      max_radial, l_block_size) += parity *
-                                  gradient_neigh_by_type.block(
-                                    cartesian_idx * max_radial, l_block_idx,
-                                    max_radial, l_block_size);
-
-                  l_block_idx += l_block_size;
-                  parity *= -1.;
-                  // clang-format on
-                }  // for (angular_l)
-              }    // for cartesian_idx
-            }      // if (is_center_atom)
-          }        // if (IsHalfNL)
-        }          // if (compute_gradients)
-      }            // for (neigh : center)
-
-      // Normalize and orthogonalize the radial coefficients
-      radial_integral->finalize_coefficients(coefficients_center);
+    // Normalize and orthogonalize the radial coefficients
+    auto radial_integral{
+        downcast_radial_integral_handler<RadialType, SmearingType, OptType>(
+            this->radial_integral)};
+#pragma omp parallel for num_threads(n_threads) schedule(static)
+    for (int i_center = 0; i_center < n_centers; ++i_center) {
+      if (not is_center_outdated.empty() and not is_center_outdated[i_center]) {
+        continue;
+      }
+      auto center_it{manager->get_iterator_at(i_center)};
+      auto center{*center_it};
+      radial_integral->finalize_coefficients(expansions_coefficients[center]);
       if (compute_gradients) {
         radial_integral->template finalize_coefficients_der<ThreeD>(
             expansions_coefficients_gradient, center);
       }
+    }
+  }
+
+  template <class StructureManager, class Accumulator>
+  void CalculatorSphericalExpansion::contract_gradients(
+      std::shared_ptr<StructureManager> manager,
+      Property_t<StructureManager> & adjoints, Accumulator && accumulate) {
+    using internal::CutoffFunctionType;
+    constexpr static bool IsHalfNL{
+        StructureManager::traits::NeighbourListType ==
+        AdaptorTraits::NeighbourListType::half};
+    if (IsHalfNL) {
+      throw std::runtime_error("The adjoint gradients of the spherical "
+                               "expansion require a full neighbour list.");
+    }
+    if (not manager->is_not_masked()) {
+      throw std::logic_error("Can't compute spherical expansion gradients with "
+                             "masked center atoms");
+    }
+
+    switch (this->cutoff_function_type) {
+    case CutoffFunctionType::ShiftedCosine:
+      this->contract_gradients_by_radial_contribution<
+          CutoffFunctionType::ShiftedCosine>(manager, adjoints, accumulate);
+      break;
+    case CutoffFunctionType::RadialScaling:
+      this->contract_gradients_by_radial_contribution<
+          CutoffFunctionType::RadialScaling>(manager, adjoints, accumulate);
+      break;
+    default:
+      std::basic_ostringstream<char> err_message;
+      err_message << "Invalid cutoff function type encountered ";
+      err_message << "(This is a bug.  Debug info for developers: ";
+      err_message << "cutoff_function_type == ";
+      err_message << static_cast<int>(this->cutoff_function_type);
+      err_message << ")" << std::endl;
+      throw std::logic_error(err_message.str());
+      break;
+    }
+  }
+
+  template <internal::CutoffFunctionType FcType, class StructureManager,
+            class Accumulator>
+  void CalculatorSphericalExpansion::contract_gradients_by_radial_contribution(
+      std::shared_ptr<StructureManager> manager,
+      Property_t<StructureManager> & adjoints, Accumulator & accumulate) {
+    using internal::AtomicSmearingType;
+    using internal::RadialBasisType;
+
+    switch (internal::combine_enums(this->radial_integral_type,
+                                    this->atomic_smearing_type)) {
+    case internal::combine_enums(RadialBasisType::GTO,
+                                 AtomicSmearingType::Constant): {
+      this->contract_gradients_by_optimization<FcType, RadialBasisType::GTO,
+                                               AtomicSmearingType::Constant>(
+          manager, adjoints, accumulate);
+      break;
+    }
+    case internal::combine_enums(RadialBasisType::DVR,
+                                 AtomicSmearingType::Constant): {
+      this->contract_gradients_by_optimization<FcType, RadialBasisType::DVR,
+                                               AtomicSmearingType::Constant>(
+          manager, adjoints, accumulate);
+      break;
+    }
+    default:
+      std::basic_ostringstream<char> err_message;
+      err_message << "Invalid combination of atomic smearing and radial basis ";
+      err_message << "type encountered (This is a bug.  Debug info for ";
+      err_message << "developers: "
+                  << "radial_integral_type == ";
+      err_message << static_cast<int>(this->radial_integral_type);
+      err_message << ", atomic_smearing_type == ";
+      err_message << static_cast<int>(this->atomic_smearing_type);
+      err_message << ")" << std::endl;
+      throw std::logic_error(err_message.str());
+    }
+  }
+
+  template <internal::CutoffFunctionType FcType,
+            internal::RadialBasisType RadialType,
+            internal::AtomicSmearingType SmearingType, class StructureManager,
+            class Accumulator>
+  void CalculatorSphericalExpansion::contract_gradients_by_optimization(
+      std::shared_ptr<StructureManager> manager,
+      Property_t<StructureManager> & adjoints, Accumulator & accumulate) {
+    using internal::OptimizationType;
+    switch (this->optimization_type) {
+    case (OptimizationType::None): {
+      this->contract_gradients_impl<FcType, RadialType, SmearingType,
+                                    OptimizationType::None>(manager, adjoints,
+                                                            accumulate);
+      break;
+    }
+    case (OptimizationType::Spline): {
+      this->contract_gradients_impl<FcType, RadialType, SmearingType,
+                                    OptimizationType::Spline>(
+          manager, adjoints, accumulate);
+      break;
+    }
+    case (OptimizationType::RadialDimReductionSpline): {
+      this->contract_gradients_impl<FcType, RadialType, SmearingType,
+                                    OptimizationType::RadialDimReductionSpline>(
+          manager, adjoints, accumulate);
+      break;
+    }
+    default:
+      std::basic_ostringstream<char> err_message;
+      err_message << "Invalid optimization type == ";
+      err_message << static_cast<int>(this->optimization_type);
+      err_message << "(C++ side)" << std::endl;
+      throw std::logic_error(err_message.str());
+    }
+  }
+
+  /**
+   * With \grad_j c^{ij}_{nlm} = d/dr_{ij} (c^{ij}_{nl} f_c) Y^m_l \hat{r}_{ij}
+   *                            + c^{ij}_{nl} f_c \grad Y^m_l / r_{ij},
+   * the contraction with dE/dc^{i} of one pair only needs the sums over n of
+   * the adjoints times the two radial factors, so it costs about as much as
+   * c^{ij} itself. The neighbour contributions are computed with the batch
+   * routines of compute_center_expansion().
+   */
+  template <internal::CutoffFunctionType FcType,
+            internal::RadialBasisType RadialType,
+            internal::AtomicSmearingType SmearingType,
+            internal::OptimizationType OptType, class StructureManager,
+            class Accumulator>
+  void CalculatorSphericalExpansion::contract_gradients_impl(
+      std::shared_ptr<StructureManager> manager,
+      Property_t<StructureManager> & adjoints, Accumulator & accumulate) {
+    auto cutoff_function{
+        downcast_cutoff_function<FcType>(this->cutoff_function)};
+    auto radial_integral{
+        downcast_radial_integral_handler<RadialType, SmearingType, OptType>(
+            this->radial_integral)};
+    auto & spherical_harmonics{this->spherical_harmonics};
+    auto & workspace{this->workspace};
+    workspace.resize(this->max_radial, this->max_angular);
+    const bool is_cutoff_folded{radial_integral->includes_cutoff_function()};
+    const Eigen::Index n_radial{static_cast<Eigen::Index>(this->max_radial)};
+    const Eigen::Index n_angular{
+        static_cast<Eigen::Index>(this->max_angular + 1)};
+    auto & adjoint_radial{workspace.adjoint_radial};
+
+    for (auto center : manager) {
+      auto & adjoints_center{adjoints[center]};
+      // adjoints of the coefficients before their finalization
+      radial_integral->finalize_coefficients_adjoint(adjoints_center);
+      const auto atom_i_tag{center.get_atom_tag()};
+
+      Eigen::Index n_neighbours{0};
+      for (auto neigh : center.pairs()) {
+        static_cast<void>(neigh);
+        ++n_neighbours;
+      }
+      workspace.reserve_neighbours(n_neighbours);
+      auto && directions{workspace.directions.topRows(n_neighbours)};
+      auto && distances{workspace.distances.head(n_neighbours)};
+      auto & neighbour_types{workspace.neighbour_types};
+      Eigen::Index i_neigh{0};
+      for (auto neigh : center.pairs()) {
+        directions.row(i_neigh) =
+            manager->get_direction_vector(neigh).transpose();
+        distances(i_neigh) = manager->get_distance(neigh);
+        neighbour_types[i_neigh] = neigh.get_atom_type();
+        ++i_neigh;
+      }
+      radial_integral->compute_neighbour_contribution_batch(
+          distances, neighbour_types, true);
+      auto && radial_integral_batch{
+          radial_integral->get_radial_integral_neighbour_batch()};
+      auto && radial_derivative_batch{
+          radial_integral->get_radial_neighbour_derivative_batch()};
+      spherical_harmonics.calc_batch(directions, true, false);
+      auto && harmonics_batch{spherical_harmonics.get_harmonics_batch()};
+      auto && harmonics_gradients_batch{
+          spherical_harmonics.get_harmonics_derivatives_batch()};
+      const Eigen::Index n_harmonics{harmonics_batch.cols()};
+
+      // the first row is the self pair, \grad_i c^{i} = - \sum_j \grad_j c^{ij}
+      auto && pair_gradients{
+          workspace.pair_gradients.topRows(n_neighbours + 1)};
+      pair_gradients.row(0).setZero();
+      i_neigh = 0;
+      for (auto neigh : center.pairs()) {
+        const double & dist{distances(i_neigh)};
+        // dE/dc^{ib}
+        const auto adjoint{adjoints_center.block_by_id(
+            adjoints.find_key_id_by_element(neighbour_types[i_neigh]))};
+        Eigen::Map<const Matrix_t> neighbour_contribution(
+            radial_integral_batch.row(i_neigh).data(), n_radial, n_angular);
+        Eigen::Map<const Matrix_t> neighbour_derivative(
+            radial_derivative_batch.row(i_neigh).data(), n_radial, n_angular);
+        const double f_c{is_cutoff_folded ? 1. : cutoff_function->f_c(dist)};
+        const double * radial_gradient_data{neighbour_derivative.data()};
+        if (not is_cutoff_folded) {
+          const double df_c{cutoff_function->df_c(dist)};
+          workspace.pair_gradient_contribution_p1.noalias() =
+              neighbour_derivative * f_c + neighbour_contribution * df_c;
+          radial_gradient_data =
+              workspace.pair_gradient_contribution_p1.data();
+        }
+        Eigen::Map<const Matrix_t> radial_gradient(radial_gradient_data,
+                                                   n_radial, n_angular);
+
+        for (Eigen::Index angular_l{0}; angular_l < n_angular; ++angular_l) {
+          const Eigen::Index l_block_idx{angular_l * angular_l};
+          const Eigen::Index l_block_size{2 * angular_l + 1};
+          const auto adjoint_l{adjoint.middleCols(l_block_idx, l_block_size)};
+          adjoint_radial.block(0, l_block_idx, 1, l_block_size).noalias() =
+              radial_gradient.col(angular_l).transpose() * adjoint_l;
+          adjoint_radial.block(1, l_block_idx, 1, l_block_size).noalias() =
+              (f_c / dist) *
+              neighbour_contribution.col(angular_l).transpose() * adjoint_l;
+        }
+        const double radial_term{
+            adjoint_radial.row(0).dot(harmonics_batch.row(i_neigh))};
+        for (int cartesian_idx{0}; cartesian_idx < ThreeD; ++cartesian_idx) {
+          pair_gradients(i_neigh + 1, cartesian_idx) =
+              radial_term * directions(i_neigh, cartesian_idx) +
+              adjoint_radial.row(1).dot(
+                  harmonics_gradients_batch.row(i_neigh).segment(
+                      cartesian_idx * n_harmonics, n_harmonics));
+        }
+        // the periodic images move with the center
+        if (neigh.get_atom_j().get_atom_tag() != atom_i_tag) {
+          pair_gradients.row(0) -= pair_gradients.row(i_neigh + 1);
+        }
+        ++i_neigh;
+      }  // for (neigh : center)
+      accumulate(center, pair_gradients);
     }  // for (center : manager)
-  }    // compute()
+  }
+
+  template <class StructureManager>
+  std::vector<bool> CalculatorSphericalExpansion::update_incremental_state(
+      std::shared_ptr<StructureManager> manager,
+      const internal::BlockSparsePropertyBackup<Property_t<StructureManager>> &
+          previous_coefficients,
+      Property_t<StructureManager> & expansions_coefficients) {
+    constexpr bool ExcludeGhosts{true};
+    auto && state{
+        *manager->template get_property<IncrementalState_t<StructureManager>>(
+            this->get_incremental_state_name(), true, true)};
+    auto && center_state{*manager->template get_property<
+        IncrementalCenterState_t<StructureManager>>(
+        this->get_incremental_center_state_name(), true, true,
+        ExcludeGhosts)};
+    // the states of the centers are kept by resize(), the atoms of new
+    // centers have been marked as changed by the update that added them
+    state.resize();
+    center_state.resize();
+
+    auto manager_root = extract_underlying_manager<0>(manager);
+    const auto & atom_update_indices{manager_root->get_atom_update_indices()};
+    const size_t last_update{state(0)};
+    const size_t current_update{manager_root->get_n_update()};
+    // ghosts are mapped to the atom they are an image of
+    auto has_changed = [&](int atom_tag) {
+      const size_t atom_index{manager->get_atom_index(atom_tag)};
+      return atom_index >= atom_update_indices.size() or
+             atom_update_indices[atom_index] > last_update;
+    };
+
+    std::vector<bool> is_center_outdated{};
+    is_center_outdated.reserve(manager->size());
+    size_t n_centers_recomputed{0};
+    for (auto center : manager) {
+      auto && center_state_values{center_state[center]};
+      size_t n_neighbours{0};
+      bool is_outdated{has_changed(center.get_atom_tag())};
+      for (auto neigh : center.pairs()) {
+        is_outdated = is_outdated or has_changed(neigh.get_atom_tag());
+        ++n_neighbours;
+      }
+      // the neighbours that left the environment are not in the list anymore
+      is_outdated = is_outdated or (n_neighbours != center_state_values(0));
+      if (not is_outdated) {
+        is_outdated = not previous_coefficients.restore(expansions_coefficients,
+                                                        center);
+      }
+      center_state_values(0) = n_neighbours;
+      if (is_outdated) {
+        center_state_values(1) = current_update;
+        ++n_centers_recomputed;
+      }
+      is_center_outdated.push_back(is_outdated);
+    }
+    state(0) = current_update;
+    state(1) = n_centers_recomputed;
+    return is_center_outdated;
+  }
 
   template <class StructureManager>
   void CalculatorSphericalExpansion::initialize_expansion_environment_wise(
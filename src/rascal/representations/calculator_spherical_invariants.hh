@@ -30,11 +30,13 @@
 #ifndef SRC_RASCAL_REPRESENTATIONS_CALCULATOR_SPHERICAL_INVARIANTS_HH_
 #define SRC_RASCAL_REPRESENTATIONS_CALCULATOR_SPHERICAL_INVARIANTS_HH_
 
+#include "rascal/math/clebsch_gordan.hh"
 #include "rascal/math/utils.hh"
 #include "rascal/representations/calculator_base.hh"
 #include "rascal/representations/calculator_spherical_expansion.hh"
 #include "rascal/structure_managers/property_block_sparse.hh"
 #include "rascal/structure_managers/structure_manager.hh"
+#include "rascal/utils/threading.hh"
 #include "rascal/utils/utils.hh"
 
 #include <wigxjpf.h>
@@ -43,8 +45,11 @@
 #include <Eigen/Eigenvalues>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <complex>
 #include <exception>
+#include <map>
 #include <unordered_set>
 #include <vector>
 
@@ -57,6 +62,17 @@ namespace rascal {
       BiSpectrum,
     };
 
+    /**
+     * How the expansion coefficients are contracted into the PowerSpectrum.
+     * Loop computes one dot product per (n1, n2, l) coefficient while GEMM
+     * computes the whole n1 x n2 block of each angular channel as a matrix
+     * product, which requires all the coefficients to be computed.
+     */
+    enum class PowerSpectrumProductType {
+      Loop,
+      GEMM,
+    };
+
     //! factor of 1 / sqrt(2*l+1) in front of the powerspectrum
     inline Eigen::VectorXd precompute_l_factors(size_t max_angular) {
       Eigen::VectorXd l_factors{};
@@ -141,6 +157,183 @@ namespace rascal {
 
       return wigner_w3js;
     }
+
+    /**
+     * Non zero couplings of the BiSpectrum in the basis of the real
+     * spherical harmonics, i.e. the coefficients w such that the column
+     * l_channel of the BiSpectrum of (n1, n2, n3) is the sum of
+     * w c^{1}_{n1 lm1} c^{2}_{n2 lm2} c^{3}_{n3 lm3} over the couplings
+     * with this l_channel.
+     *
+     * The couplings are sorted by (l_channel, lm1, lm2, lm3) so that the
+     * ones sharing (l_channel, lm1, lm2) are consecutive.
+     */
+    struct BiSpectrumCouplings {
+      //! column of the (l1, l2, l3) channel in the BiSpectrum
+      std::vector<int> l_channel{};
+      //! index l^2 + l + m of the three real expansion coefficients
+      std::vector<int> lm1{};
+      std::vector<int> lm2{};
+      std::vector<int> lm3{};
+      std::vector<double> values{};
+
+      size_t size() const { return this->values.size(); }
+
+      bool operator==(const BiSpectrumCouplings & other) const {
+        return this->l_channel == other.l_channel and
+               this->lm1 == other.lm1 and this->lm2 == other.lm2 and
+               this->lm3 == other.lm3 and this->values == other.values;
+      }
+    };
+
+    /**
+     * Contract the Wigner 3j symbols with the transformation from the real to
+     * the complex spherical harmonics so that the BiSpectrum is computed
+     * from the real expansion coefficients only. The descriptor components
+     * are the real or imaginary part of the complex triple product depending
+     * on the parity of l1 + l2 + l3.
+     */
+    inline BiSpectrumCouplings
+    precompute_bispectrum_couplings(size_t max_angular,
+                                    bool inversion_symmetry) {
+      const Eigen::ArrayXd wigner_w3js{
+          precompute_wigner_w3js(max_angular, inversion_symmetry)};
+      // (l_channel, lm1, lm2, lm3) -> coupling
+      std::map<std::array<int, 4>, double> couplings{};
+      int l_channel{0};
+      int wigner_count{0};
+      const int l_max{static_cast<int>(max_angular)};
+      for (int l1{0}; l1 < l_max + 1; ++l1) {
+        for (int l2{0}; l2 < l_max + 1; ++l2) {
+          for (int l3{0}; l3 < l_max + 1; ++l3) {
+            if ((l1 < std::abs(l2 - l3)) || (l1 > l2 + l3)) {
+              continue;
+            }
+            if (inversion_symmetry) {
+              if ((l1 + l2 + l3) % 2 == 1) {
+                continue;
+              }
+            }
+            const bool is_real{(l1 + l2 + l3) % 2 == 0};
+            for (int m1{-l1}; m1 < l1 + 1; ++m1) {
+              for (int m2{-l2}; m2 < l2 + 1; ++m2) {
+                for (int m3{-l3}; m3 < l3 + 1; ++m3) {
+                  if (m1 + m2 + m3 != 0) {
+                    continue;
+                  }
+                  const double w3j{wigner_w3js(wigner_count)};
+                  ++wigner_count;
+                  for (const auto & c1 :
+                       math::real_to_complex_harmonics(l1, m1)) {
+                    for (const auto & c2 :
+                         math::real_to_complex_harmonics(l2, m2)) {
+                      for (const auto & c3 :
+                           math::real_to_complex_harmonics(l3, m3)) {
+                        const auto weight{c1.second * c2.second * c3.second};
+                        couplings[{l_channel, l1 * l1 + c1.first,
+                                   l2 * l2 + c2.first, l3 * l3 + c3.first}] +=
+                            w3j * (is_real ? weight.real() : weight.imag());
+                      }
+                    }
+                  }
+                }
+              }
+            }
+            ++l_channel;
+          }
+        }
+      }
+
+      BiSpectrumCouplings bispectrum_couplings{};
+      for (const auto & coupling : couplings) {
+        // the terms of the transformation cancel out for many couplings
+        if (std::abs(coupling.second) < 1e-14) {
+          continue;
+        }
+        bispectrum_couplings.l_channel.push_back(coupling.first[0]);
+        bispectrum_couplings.lm1.push_back(coupling.first[1]);
+        bispectrum_couplings.lm2.push_back(coupling.first[2]);
+        bispectrum_couplings.lm3.push_back(coupling.first[3]);
+        bispectrum_couplings.values.push_back(coupling.second);
+      }
+      return bispectrum_couplings;
+    }
+
+    /**
+     * Update the gradients \grad_k p^{i} to include normalization, N_i,
+     * resulting in \grad_k \tilde{p}^{i}.
+     * We have:
+     * \grad_k \tilde{p}^{i} = \grad_k p^{i} / N_i
+             - \tilde{p}^{i} [\tilde{p}^{i} \cdot \grad_k p^{i} / N_i],
+     * where $\cdot$ is a dot product between vectors.
+     * Note that this expects the soap vectors to be normalized already, and
+     * the norm stored separately.
+     */
+    template <class StructureManager, class Invariants,
+              class InvariantsDerivative, class SpectrumNorm>
+    void update_gradients_for_normalization(
+        Invariants & soap_vectors, InvariantsDerivative & soap_vector_gradients,
+        std::shared_ptr<StructureManager> manager, SpectrumNorm & inv_norms,
+        const size_t & grad_component_size) {
+      using MapSoapGradFlat_t = Eigen::Map<
+          Eigen::Matrix<double, ThreeD, Eigen::Dynamic, Eigen::RowMajor>>;
+      using ConstMapSoapFlat_t = const Eigen::Map<const Eigen::VectorXd>;
+      // divide all gradients with the normalization factor N_i
+      for (auto center : manager) {
+        for (auto neigh : center.pairs_with_self_pair()) {
+          soap_vector_gradients[neigh].multiply_elements_by(inv_norms[center]);
+        }
+      }
+
+      // \tilde{p}^{i} \cdot \grad_k p^{i} / N_i
+      Eigen::Vector3d soap_vector_dot_gradient{};
+
+      // compute the dot product and update the gradients to be normalized
+      for (auto center : manager) {
+        for (auto neigh : center.pairs_with_self_pair()) {
+          const auto & soap_vector = soap_vectors[center];
+          auto & soap_vector_gradients_by_neigh = soap_vector_gradients[neigh];
+          soap_vector_dot_gradient.setZero();
+          // make sure to iterate over keys that are present in both soap_vector
+          // and soap_vector_gradients_by_neigh
+          const auto keys_grad = soap_vector_gradients_by_neigh.get_keys();
+          const auto keys_intersect = soap_vector.intersection(keys_grad);
+          // compute \tilde{p}^{i} \cdot \grad_k p^{i} / N_i
+          for (const auto & key : keys_intersect) {
+            auto soap_gradient_by_species_pair =
+                soap_vector_gradients_by_neigh[key];
+            const auto & soap_vector_by_species_pair = soap_vector[key];
+            // reshape for easy dot prod
+            MapSoapGradFlat_t soap_gradient_dim_N(
+                soap_gradient_by_species_pair.data(), ThreeD,
+                grad_component_size);
+            ConstMapSoapFlat_t soap_vector_N(soap_vector_by_species_pair.data(),
+                                             grad_component_size);
+            // dot
+            soap_vector_dot_gradient += (soap_gradient_dim_N * soap_vector_N);
+          }  // for (const auto& key : keys_intersect)
+
+          // Now update each species-pair-block using the dot-product just
+          // computed
+          // for (const auto & key : keys_grad) {
+          for (const auto & key : soap_vector.get_keys()) {
+            auto soap_gradient_by_species_pair =
+                soap_vector_gradients_by_neigh[key];
+            const auto & soap_vector_by_species_pair = soap_vector[key];
+            // reshape for easy dot prod
+            MapSoapGradFlat_t soap_gradient_dim_N(
+                soap_gradient_by_species_pair.data(), ThreeD,
+                grad_component_size);
+            ConstMapSoapFlat_t soap_vector_N(soap_vector_by_species_pair.data(),
+                                             grad_component_size);
+            // compute \tilde{p}^{i} [\tilde{p}^{i} \cdot \grad_k p^{i} / N_i]
+            // as an outer product
+            soap_gradient_dim_N -=
+                soap_vector_dot_gradient * soap_vector_N.transpose();
+          }  // for (const auto& key : keys_intersect)
+        }    // (auto neigh : center.pairs_with_self_pair())
+      }      // (auto center : manager)
+    }
   }  // namespace internal
 
   class CalculatorSphericalInvariants : public CalculatorBase {
@@ -148,12 +341,17 @@ namespace rascal {
     using Hypers_t = typename CalculatorBase::Hypers_t;
     using Key_t = typename CalculatorBase::Key_t;
 
-    template <class StructureManager>
-    using Property_t = BlockSparseProperty<double, 1, StructureManager, Key_t>;
+    /**
+     * The invariants are stored in double precision, or in single precision
+     * with the single_precision hyper (see set_hyperparameters).
+     */
+    template <class StructureManager, typename Precision = double>
+    using Property_t =
+        BlockSparseProperty<Precision, 1, StructureManager, Key_t>;
 
-    template <class StructureManager>
+    template <class StructureManager, typename Precision = double>
     using PropertyGradient_t =
-        BlockSparseProperty<double, 2, StructureManager, Key_t>;
+        BlockSparseProperty<Precision, 2, StructureManager, Key_t>;
 
     template <class StructureManager>
     using Dense_t = typename Property_t<StructureManager>::Dense_t;
@@ -167,6 +365,10 @@ namespace rascal {
     template <class StructureManager>
     using SpectrumNorm_t = Property<double, 1, StructureManager, 1>;
 
+    //! update of the structure at which it was last computed
+    template <class StructureManager>
+    using IncrementalState_t = Property<size_t, 0, StructureManager, 1>;
+
     explicit CalculatorSphericalInvariants(const Hypers_t & hypers)
         : CalculatorBase{}, rep_expansion{hypers} {
       this->set_default_prefix("spherical_invariants_");
@@ -191,10 +393,13 @@ namespace rascal {
           inner_invariants_shape{std::move(other.inner_invariants_shape)},
           normalize{std::move(other.normalize)}, compute_gradients{std::move(
                                                      other.compute_gradients)},
+          single_precision{other.single_precision},
           inversion_symmetry{std::move(other.inversion_symmetry)},
           rep_expansion{std::move(other.rep_expansion)},
-          type{std::move(other.type)}, l_factors{std::move(other.l_factors)},
-          wigner_w3js{std::move(other.wigner_w3js)} {}
+          type{std::move(other.type)},
+          powerspectrum_product{other.powerspectrum_product},
+          l_factors{std::move(other.l_factors)},
+          bispectrum_couplings{std::move(other.bispectrum_couplings)} {}
     //! Destructor
     virtual ~CalculatorSphericalInvariants() = default;
 
@@ -321,6 +526,16 @@ namespace rascal {
       this->max_radial = hypers.at("max_radial").get<size_t>();
       this->max_angular = hypers.at("max_angular").get<size_t>();
 
+      // the invariants and their gradients are computed in double precision
+      // and stored in single precision, as
+      // Property_t<StructureManager, float> and
+      // PropertyGradient_t<StructureManager, float>
+      if (hypers.find("single_precision") != hypers.end()) {
+        this->single_precision = hypers.at("single_precision").get<bool>();
+      } else {
+        this->single_precision = false;
+      }
+
       if (soap_type == "PowerSpectrum") {
         this->set_hyperparameters_powerspectrum(hypers);
       } else if (soap_type == "RadialSpectrum") {
@@ -331,7 +546,7 @@ namespace rascal {
       } else if (soap_type == "BiSpectrum") {
         this->type = internal::SphericalInvariantsType::BiSpectrum;
         this->inversion_symmetry = hypers.at("inversion_symmetry").get<bool>();
-        this->wigner_w3js = internal::precompute_wigner_w3js(
+        this->bispectrum_couplings = internal::precompute_bispectrum_couplings(
             this->max_angular, this->inversion_symmetry);
       } else {
         throw std::logic_error(
@@ -359,8 +574,13 @@ namespace rascal {
      *      computed.
      *      Note that values in 'n1', 'n2', 'l' should not exceed max_radial-1
      *      and max_angular.
+     *  - powerspectrum_product (optional)
+     *      'GEMM' (default) or 'Loop', see internal::PowerSpectrumProductType.
+     *      The coefficients selected with coefficient_subselection are always
+     *      computed with 'Loop'.
      */
     void set_hyperparameters_powerspectrum(const Hypers_t & hypers) {
+      using internal::PowerSpectrumProductType;
       using internal::SphericalInvariantsType;
       this->type = SphericalInvariantsType::PowerSpectrum;
 
@@ -520,6 +740,21 @@ namespace rascal {
           }
         }
       }
+
+      this->powerspectrum_product = PowerSpectrumProductType::GEMM;
+      if (hypers.find("powerspectrum_product") != hypers.end()) {
+        auto product = hypers.at("powerspectrum_product").get<std::string>();
+        if (product == "Loop") {
+          this->powerspectrum_product = PowerSpectrumProductType::Loop;
+        } else if (product != "GEMM") {
+          throw std::logic_error("Requested powerspectrum_product \'" +
+                                 product +
+                                 "\' is not one of 'GEMM' or 'Loop'.");
+        }
+      }
+      if (this->is_sparsified) {
+        this->powerspectrum_product = PowerSpectrumProductType::Loop;
+      }
     }
 
     bool operator==(const CalculatorSphericalInvariants & other) const {
@@ -528,10 +763,12 @@ namespace rascal {
           this->max_radial == other.max_radial and
           this->max_angular == other.max_angular and
           this->normalize == other.normalize and
+          this->single_precision == other.single_precision and
           this->inversion_symmetry == other.inversion_symmetry and
           this->type == other.type and
+          this->powerspectrum_product == other.powerspectrum_product and
           (this->l_factors.array() == other.l_factors.array()).all() and
-          (this->wigner_w3js.array() == other.wigner_w3js.array()).all()};
+          this->bispectrum_couplings == other.bispectrum_couplings};
       bool rep_expansion_match{this->rep_expansion == other.rep_expansion};
       bool sparsification_match{
           this->unique_pair_list == other.unique_pair_list and
@@ -543,12 +780,38 @@ namespace rascal {
               sparsification_match);
     }
 
+    /**
+     * Set the number of threads of this calculator and of the underlying
+     * spherical expansion.
+     */
+    void set_n_threads(int n_threads) override {
+      CalculatorBase::set_n_threads(n_threads);
+      this->rep_expansion.set_n_threads(n_threads);
+    }
+
     /**
      * Returns if the calculator is able to compute gradients of the
      * representation w.r.t. atomic positions ?
      */
     bool does_gradients() const override { return this->compute_gradients; }
 
+    //! tells if the invariants are stored in single precision
+    bool is_single_precision() const { return this->single_precision; }
+
+    /**
+     * Number of centers of manager whose spherical expansion was recomputed
+     * the last time it was computed, see
+     * CalculatorSphericalExpansion::get_n_centers_recomputed(). With the
+     * incremental hyper the PowerSpectrum is recomputed for these centers
+     * only, the other types of invariants are recomputed for all the
+     * centers.
+     */
+    template <class StructureManager>
+    size_t
+    get_n_centers_recomputed(std::shared_ptr<StructureManager> manager) const {
+      return this->rep_expansion.get_n_centers_recomputed(manager);
+    }
+
     /**
      * Compute representation for a given structure manager.
      *
@@ -561,6 +824,26 @@ namespace rascal {
     template <class StructureManager>
     void compute(StructureManager & managers);
 
+    /**
+     * Backward-mode (adjoint) gradients of a function E of the PowerSpectrum
+     * of a structure, e.g. the energy of a sparse GPR model, that never
+     * store the gradients of the expansion or of the invariants.
+     *
+     * For each center, compute_adjoint(center, soap_vector_adjoint) sets
+     * dE/dp^{i} in soap_vector_adjoint, which has the keys of p^{i} and is
+     * zero initially. It is back-propagated to dE/dc^{i} and then contracted
+     * with the gradients of the expansion computed on the fly, see
+     * CalculatorSphericalExpansion::contract_gradients() for the
+     * accumulate(center, pair_gradients) callback.
+     *
+     * @param manager structure manager with a full neighbour list whose
+     *          invariants have been computed, with or without gradients
+     */
+    template <class StructureManager, class Adjoint, class Accumulator>
+    void contract_gradients(std::shared_ptr<StructureManager> manager,
+                            Adjoint && compute_adjoint,
+                            Accumulator && accumulate);
+
     /**
      * loop over a collection of manangers if it is an iterator.
      * Or just call compute_impl
@@ -570,8 +853,19 @@ namespace rascal {
         std::enable_if_t<internal::is_proper_iterator<StructureManager>::value,
                          int> = 0>
     void compute_loop(StructureManager & managers) {
+      const int n_threads{this->get_n_threads_for_structures(managers)};
+      if (n_threads > 1) {
+        // the expansions are computed beforehand so that the expansion
+        // calculator is only read from within the parallel region
+        this->rep_expansion.compute(managers);
+        internal::parallel_for_each(
+            managers, n_threads, [this](auto & manager) {
+              this->template compute_structure<BodyOrder>(manager);
+            });
+        return;
+      }
       for (auto & manager : managers) {
-        this->compute_impl<BodyOrder>(manager);
+        this->compute_structure<BodyOrder>(manager);
       }
     }
 
@@ -582,7 +876,62 @@ namespace rascal {
             not(internal::is_proper_iterator<StructureManager>::value), int> =
             0>
     void compute_loop(StructureManager & manager) {
-      this->compute_impl<BodyOrder>(manager);
+      this->compute_structure<BodyOrder>(manager);
+    }
+
+    /**
+     * Compute the invariants of one structure and, with single_precision,
+     * store them in single precision under get_name()
+     */
+    template <internal::SphericalInvariantsType BodyOrder,
+              class StructureManager>
+    void compute_structure(std::shared_ptr<StructureManager> manager) {
+      using Prop_t = Property_t<StructureManager>;
+      using PropGrad_t = PropertyGradient_t<StructureManager>;
+      constexpr bool ExcludeGhosts{true};
+      if (not this->single_precision) {
+        auto && soap_vectors{*manager->template get_property<Prop_t>(
+            this->get_name(), true, true, ExcludeGhosts)};
+        auto && soap_vector_gradients{
+            *manager->template get_property<PropGrad_t>(
+                this->get_gradient_name(), true, true)};
+        this->compute_impl<BodyOrder>(manager, soap_vectors,
+                                      soap_vector_gradients);
+        return;
+      }
+
+      auto && soap_vectors_single{*manager->template get_property<
+          Property_t<StructureManager, float>>(this->get_name(), true, true,
+                                               ExcludeGhosts)};
+      // nothing to convert if the structure did not change since the last
+      // computation
+      if (soap_vectors_single.is_updated()) {
+        return;
+      }
+      // the invariants are computed in double precision in temporaries that
+      // are not attached to the manager so only the float copy is kept
+      Prop_t soap_vectors{*manager, "spherical invariants double precision",
+                          ExcludeGhosts};
+      PropGrad_t soap_vector_gradients{
+          *manager, "spherical invariants gradients double precision"};
+      if (this->rep_expansion.is_incremental()) {
+        // the unchanged centers are restored from the previous invariants,
+        // the conversion back to single precision is exact for them
+        soap_vectors.copy_from(soap_vectors_single);
+      }
+      this->compute_impl<BodyOrder>(manager, soap_vectors,
+                                    soap_vector_gradients);
+
+      soap_vectors_single.copy_from(soap_vectors);
+      soap_vectors_single.set_updated_status(true);
+      if (this->compute_gradients) {
+        auto && soap_vector_gradients_single{
+            *manager->template get_property<
+                PropertyGradient_t<StructureManager, float>>(
+                this->get_gradient_name(), true, true)};
+        soap_vector_gradients_single.copy_from(soap_vector_gradients);
+        soap_vector_gradients_single.set_updated_status(true);
+      }
     }
 
     //! compute representation @f$ \nu == 1 @f$
@@ -592,7 +941,10 @@ namespace rascal {
                              internal::SphericalInvariantsType::RadialSpectrum,
                          int> = 0,
         class StructureManager>
-    void compute_impl(std::shared_ptr<StructureManager> manager);
+    void compute_impl(
+        std::shared_ptr<StructureManager> manager,
+        Property_t<StructureManager> & soap_vectors,
+        PropertyGradient_t<StructureManager> & soap_vector_gradients);
 
     //! compute representation @f$ \nu == 2 @f$
     template <internal::SphericalInvariantsType BodyOrder,
@@ -600,7 +952,10 @@ namespace rascal {
                   BodyOrder == internal::SphericalInvariantsType::PowerSpectrum,
                   int> = 0,
               class StructureManager>
-    void compute_impl(std::shared_ptr<StructureManager> manager);
+    void compute_impl(
+        std::shared_ptr<StructureManager> manager,
+        Property_t<StructureManager> & soap_vectors,
+        PropertyGradient_t<StructureManager> & soap_vector_gradients);
 
     //! compute representation @f$ \nu == 3 @f$
     template <internal::SphericalInvariantsType BodyOrder,
@@ -608,7 +963,10 @@ namespace rascal {
                   BodyOrder == internal::SphericalInvariantsType::BiSpectrum,
                   int> = 0,
               class StructureManager>
-    void compute_impl(std::shared_ptr<StructureManager> manager);
+    void compute_impl(
+        std::shared_ptr<StructureManager> manager,
+        Property_t<StructureManager> & soap_vectors,
+        PropertyGradient_t<StructureManager> & soap_vector_gradients);
 
     //! initialize the soap vectors with only the keys needed for each center
     template <class StructureManager, class Invariants,
@@ -630,100 +988,287 @@ namespace rascal {
         Invariants & soap_vector, ExpansionCoeff & expansions_coefficients,
         std::shared_ptr<StructureManager> manager);
 
+
+   protected:
     /**
-     * Update the gradients \grad_k p^{i} to include normalization, N_i,
-     * resulting in \grad_k \tilde{p}^{i}.
-     * We have:
-     * \grad_k \tilde{p}^{i} = \grad_k p^{i} / N_i
-             - \tilde{p}^{i} [\tilde{p}^{i} \cdot \grad_k p^{i} / N_i],
-     * where $\cdot$ is a dot product between vectors.
-     * Note that this expects the soap vectors to be normalized already, and
-     * the norm stored separately.
+     * Positions of the blocks involved in the PowerSpectrum of one
+     * environment. The species of the environment are indexed in increasing
+     * order and the pair of species (a, b), a <= b, by
+     * i_a * n_species + i_b.
      */
-    template <class StructureManager, class SpectrumNorm>
-    void update_gradients_for_normalization(
-        Property_t<StructureManager> & soap_vectors,
-        PropertyGradient_t<StructureManager> & soap_vector_gradients,
-        std::shared_ptr<StructureManager> manager, SpectrumNorm & inv_norms,
-        const size_t & grad_component_size) {
-      using MapSoapGradFlat_t = Eigen::Map<
-          Eigen::Matrix<double, ThreeD, Eigen::Dynamic, Eigen::RowMajor>>;
-      using ConstMapSoapFlat_t = const Eigen::Map<const Eigen::VectorXd>;
-      // divide all gradients with the normalization factor N_i
-      for (auto center : manager) {
-        for (auto neigh : center.pairs_with_self_pair()) {
-          soap_vector_gradients[neigh].multiply_elements_by(inv_norms[center]);
+    struct SpeciesPairs {
+      //! ids of the keys of c^{i a} (shared with its gradients)
+      std::vector<int> coef_key_ids{};
+      //! index of the species by key id of the expansion, -1 if absent
+      std::vector<int> species_index_by_key_id{};
+      //! ids of the keys of p^{i ab} (shared with its gradients)
+      std::vector<int> soap_key_ids{};
+      //! PowerSpectrum coefficients to compute for each pair of species
+      std::vector<const std::vector<PowerSpectrumCoeffIndex> *>
+          coeff_indices{};
+      //! pairs of species with a non zero gradient for the current neighbour
+      std::vector<bool> has_gradient{};
+    };
+
+    /**
+     * Translate the species keys of the environment coefficients and the
+     * pair keys of soap_vectors to key ids once per environment, so that the
+     * inner loops only do array accesses.
+     */
+    template <class ExpansionCoeffByCenter, class Invariants>
+    void set_up_species_pairs(SpeciesPairs & species_pairs,
+                              const ExpansionCoeffByCenter & coefficients,
+                              const Invariants & soap_vectors) const {
+      internal::Sorted<true> is_sorted{};
+      const auto keys{coefficients.get_keys()};
+      const size_t n_species{keys.size()};
+      species_pairs.coef_key_ids = coefficients.get_key_ids();
+      species_pairs.species_index_by_key_id.assign(
+          coefficients.interner->size(), -1);
+      for (size_t i_species{0}; i_species < n_species; ++i_species) {
+        species_pairs
+            .species_index_by_key_id[species_pairs.coef_key_ids[i_species]] =
+            static_cast<int>(i_species);
+      }
+      species_pairs.soap_key_ids.assign(n_species * n_species, -1);
+      species_pairs.coeff_indices.assign(n_species * n_species, nullptr);
+      species_pairs.has_gradient.assign(n_species * n_species, false);
+      Key_t pair_type{0, 0};
+      for (size_t i_species_1{0}; i_species_1 < n_species; ++i_species_1) {
+        pair_type[0] = keys[i_species_1][0];
+        for (size_t i_species_2{i_species_1}; i_species_2 < n_species;
+             ++i_species_2) {
+          pair_type[1] = keys[i_species_2][0];
+          internal::SortedKey<Key_t> spair_type{is_sorted, pair_type};
+          const size_t i_pair{i_species_1 * n_species + i_species_2};
+          species_pairs.soap_key_ids[i_pair] =
+              soap_vectors.find_key_id(this->key_map.at(spair_type));
+          species_pairs.coeff_indices[i_pair] =
+              &this->get_coeff_indices(spair_type);
         }
       }
+    }
 
-      // \tilde{p}^{i} \cdot \grad_k p^{i} / N_i
-      Eigen::Vector3d soap_vector_dot_gradient{};
+    /**
+     * Compute p^{i ab}_{n_1 n_2 l} of one environment with one matrix
+     * product per pair of species and angular channel
+     *   P^{ab}_l = c^{a}_l (c^{b}_l)^T / \sqrt(2l+1),
+     * where c^{a}_l is the n_max x (2l+1) block of the coefficients of
+     * species a. The products of all the channels of a pair are gathered in
+     * buffer, of shape (l_max+1) x n_max^2, and then transposed at once into
+     * the (n_1 n_2) x l layout of soap_vector.
+     */
+    template <class ExpansionCoeffByCenter, class InvariantsByCenter>
+    void compute_powerspectrum_gemm(const ExpansionCoeffByCenter & coefficients,
+                                    InvariantsByCenter & soap_vector,
+                                    const SpeciesPairs & species_pairs,
+                                    math::Matrix_t & buffer) const {
+      using MatrixMap_t = Eigen::Map<math::Matrix_t>;
+      const auto & coef_key_ids{species_pairs.coef_key_ids};
+      const size_t n_species{coef_key_ids.size()};
+      const Eigen::Index n_max{static_cast<Eigen::Index>(this->max_radial)};
+      const Eigen::Index n_l{static_cast<Eigen::Index>(this->max_angular + 1)};
+      buffer.resize(n_l, n_max * n_max);
+      // avoid computing p^{ab} and p^{ba} since p^{ab} = p^{ba}^T
+      for (size_t i_species_1{0}; i_species_1 < n_species; ++i_species_1) {
+        const auto coef1{coefficients.block_by_id(coef_key_ids[i_species_1])};
+        for (size_t i_species_2{i_species_1}; i_species_2 < n_species;
+             ++i_species_2) {
+          const auto coef2{
+              coefficients.block_by_id(coef_key_ids[i_species_2])};
+          // the \sqrt(2) factor to account for the missing (b,a) components
+          const double pair_factor{i_species_1 < i_species_2 ? math::SQRT_TWO
+                                                             : 1.};
+          for (Eigen::Index l{0}; l < n_l; ++l) {
+            MatrixMap_t product(buffer.row(l).data(), n_max, n_max);
+            product.noalias() = (pair_factor * this->l_factors(l)) *
+                                coef1.middleCols(l * l, 2 * l + 1) *
+                                coef2.middleCols(l * l, 2 * l + 1).transpose();
+          }
+          const size_t i_pair{i_species_1 * n_species + i_species_2};
+          auto soap_vector_by_pair{
+              soap_vector.block_by_id(species_pairs.soap_key_ids[i_pair])};
+          soap_vector_by_pair = buffer.transpose();
+        }
+      }
+    }
 
-      // compute the dot product and update the gradients to be normalized
-      for (auto center : manager) {
-        for (auto neigh : center.pairs_with_self_pair()) {
-          const auto & soap_vector = soap_vectors[center];
-          auto & soap_vector_gradients_by_neigh = soap_vector_gradients[neigh];
-          soap_vector_dot_gradient.setZero();
-          // make sure to iterate over keys that are present in both soap_vector
-          // and soap_vector_gradients_by_neigh
-          const auto keys_grad = soap_vector_gradients_by_neigh.get_keys();
-          const auto keys_intersect = soap_vector.intersection(keys_grad);
-          // compute \tilde{p}^{i} \cdot \grad_k p^{i} / N_i
-          for (const auto & key : keys_intersect) {
-            auto soap_gradient_by_species_pair =
-                soap_vector_gradients_by_neigh[key];
-            const auto & soap_vector_by_species_pair = soap_vector[key];
-            // reshape for easy dot prod
-            MapSoapGradFlat_t soap_gradient_dim_N(
-                soap_gradient_by_species_pair.data(), ThreeD,
-                grad_component_size);
-            ConstMapSoapFlat_t soap_vector_N(soap_vector_by_species_pair.data(),
-                                             grad_component_size);
-            // dot
-            soap_vector_dot_gradient += (soap_gradient_dim_N * soap_vector_N);
-          }  // for (const auto& key : keys_intersect)
+    /**
+     * Accumulate \grad_k p^{i ab} for one neighbour k with matrix products,
+     * see compute_powerspectrum_gemm(). \grad_k c^{i a}_l is a
+     * (3 n_max) x (2l+1) block so \grad_k c^{i a}_l (c^{i b}_l)^T gives the
+     * three cartesian components at once, in the layout of the buffer of
+     * shape (l_max+1) x (3 n_max^2).
+     */
+    template <class ExpansionCoeffGradByNeigh, class ExpansionCoeffByCenter,
+              class InvariantsGradByNeigh>
+    void compute_powerspectrum_gradient_gemm(
+        const ExpansionCoeffGradByNeigh & grad_coefficients,
+        const ExpansionCoeffByCenter & coefficients,
+        InvariantsGradByNeigh & soap_gradient,
+        const SpeciesPairs & species_pairs, math::Matrix_t & buffer) const {
+      using MatrixMap_t = Eigen::Map<math::Matrix_t>;
+      const auto & coef_key_ids{species_pairs.coef_key_ids};
+      const size_t n_species{coef_key_ids.size()};
+      const Eigen::Index n_max{static_cast<Eigen::Index>(this->max_radial)};
+      const Eigen::Index n_max_sq{n_max * n_max};
+      const Eigen::Index n_l{static_cast<Eigen::Index>(this->max_angular + 1)};
+      buffer.resize(n_l, ThreeD * n_max_sq);
+      // \grad_k p^{iab} = \grad_k c^{i a} c^{i b} + c^{i a} \grad_k c^{i b}
+      // where \grad_k c^{i a} is non zero for one key 'a' when k!=i
+      for (const int & grad_key_id : grad_coefficients.get_key_ids()) {
+        const size_t i_species_1{static_cast<size_t>(
+            species_pairs.species_index_by_key_id[grad_key_id])};
+        const auto grad_coef1{grad_coefficients.block_by_id(grad_key_id)};
+        for (size_t i_species_2{0}; i_species_2 < n_species; ++i_species_2) {
+          const auto coef2{
+              coefficients.block_by_id(coef_key_ids[i_species_2])};
+          const size_t i_pair{i_species_1 <= i_species_2
+                                  ? i_species_1 * n_species + i_species_2
+                                  : i_species_2 * n_species + i_species_1};
+          const double pair_factor{
+              i_species_1 != i_species_2 ? math::SQRT_TWO : 1.};
+          for (Eigen::Index l{0}; l < n_l; ++l) {
+            const double factor{pair_factor * this->l_factors(l)};
+            const auto grad_coef1_l{grad_coef1.middleCols(l * l, 2 * l + 1)};
+            const auto coef2_l{coef2.middleCols(l * l, 2 * l + 1)};
+            // \grad_k c^{i a}_{n_1} c^{i b}_{n_2}
+            if (i_species_1 <= i_species_2) {
+              MatrixMap_t product(buffer.row(l).data(), ThreeD * n_max, n_max);
+              product.noalias() = factor * grad_coef1_l * coef2_l.transpose();
+            }
+            // c^{i b}_{n_1} \grad_k c^{i a}_{n_2}
+            if (i_species_1 >= i_species_2) {
+              for (Eigen::Index cartesian_idx{0}; cartesian_idx < ThreeD;
+                   ++cartesian_idx) {
+                MatrixMap_t product(
+                    buffer.row(l).data() + cartesian_idx * n_max_sq, n_max,
+                    n_max);
+                const auto grad_coef1_l_x{
+                    grad_coef1_l.middleRows(cartesian_idx * n_max, n_max)};
+                if (i_species_1 == i_species_2) {
+                  product.noalias() +=
+                      factor * coef2_l * grad_coef1_l_x.transpose();
+                } else {
+                  product.noalias() =
+                      factor * coef2_l * grad_coef1_l_x.transpose();
+                }
+              }
+            }
+          }
+          auto soap_gradient_by_pair{
+              soap_gradient.block_by_id(species_pairs.soap_key_ids[i_pair])};
+          soap_gradient_by_pair += buffer.transpose();
+        }
+      }
+    }
 
-          // Now update each species-pair-block using the dot-product just
-          // computed
-          // for (const auto & key : keys_grad) {
-          for (const auto & key : soap_vector.get_keys()) {
-            auto soap_gradient_by_species_pair =
-                soap_vector_gradients_by_neigh[key];
-            const auto & soap_vector_by_species_pair = soap_vector[key];
-            // reshape for easy dot prod
-            MapSoapGradFlat_t soap_gradient_dim_N(
-                soap_gradient_by_species_pair.data(), ThreeD,
-                grad_component_size);
-            ConstMapSoapFlat_t soap_vector_N(soap_vector_by_species_pair.data(),
-                                             grad_component_size);
-            // compute \tilde{p}^{i} [\tilde{p}^{i} \cdot \grad_k p^{i} / N_i]
-            // as an outer product
-            soap_gradient_dim_N -=
-                soap_vector_dot_gradient * soap_vector_N.transpose();
-          }  // for (const auto& key : keys_intersect)
-        }    // (auto neigh : center.pairs_with_self_pair())
-      }      // (auto center : manager)
+    /**
+     * Back-propagate soap_vector_adjoint, dE/dp^{i} of one environment, to
+     * dE/dc^{i}, which is accumulated in expansion_adjoint. Since
+     *   P^{ab}_l = c^{a}_l (c^{b}_l)^T / \sqrt(2l+1),
+     * dE/dP^{ab}_l c^{b}_l and (dE/dP^{ab}_l)^T c^{a}_l are added to
+     * dE/dc^{a}_l and dE/dc^{b}_l (with the factors of the pairs of
+     * species), with matrix products or coefficient by coefficient like
+     * the PowerSpectrum itself.
+     */
+    template <class ExpansionCoeffByCenter, class InvariantsByCenter,
+              class ExpansionAdjointByCenter>
+    void backpropagate_powerspectrum(
+        const ExpansionCoeffByCenter & coefficients,
+        const InvariantsByCenter & soap_vector_adjoint,
+        ExpansionAdjointByCenter & expansion_adjoint,
+        const SpeciesPairs & species_pairs, const bool use_gemm,
+        math::Matrix_t & buffer) const {
+      using ConstMatrixMap_t = Eigen::Map<const math::Matrix_t>;
+      const auto & coef_key_ids{species_pairs.coef_key_ids};
+      const size_t n_species{coef_key_ids.size()};
+      const Eigen::Index n_max{static_cast<Eigen::Index>(this->max_radial)};
+      const Eigen::Index n_l{static_cast<Eigen::Index>(this->max_angular + 1)};
+      for (size_t i_species_1{0}; i_species_1 < n_species; ++i_species_1) {
+        const auto coef1{coefficients.block_by_id(coef_key_ids[i_species_1])};
+        auto adjoint1{
+            expansion_adjoint.block_by_id(coef_key_ids[i_species_1])};
+        for (size_t i_species_2{i_species_1}; i_species_2 < n_species;
+             ++i_species_2) {
+          const auto coef2{
+              coefficients.block_by_id(coef_key_ids[i_species_2])};
+          auto adjoint2{
+              expansion_adjoint.block_by_id(coef_key_ids[i_species_2])};
+          const size_t i_pair{i_species_1 * n_species + i_species_2};
+          const auto soap_adjoint_by_pair{soap_vector_adjoint.block_by_id(
+              species_pairs.soap_key_ids[i_pair])};
+          const double pair_factor{i_species_1 < i_species_2 ? math::SQRT_TWO
+                                                             : 1.};
+          if (use_gemm) {
+            // dE/dP^{ab}_l is row l of the buffer in the n_1 x n_2 layout
+            buffer = soap_adjoint_by_pair.transpose();
+            for (Eigen::Index l{0}; l < n_l; ++l) {
+              ConstMatrixMap_t adjoint_product(buffer.row(l).data(), n_max,
+                                               n_max);
+              const double factor{pair_factor * this->l_factors(l)};
+              adjoint1.middleCols(l * l, 2 * l + 1).noalias() +=
+                  factor * adjoint_product *
+                  coef2.middleCols(l * l, 2 * l + 1);
+              adjoint2.middleCols(l * l, 2 * l + 1).noalias() +=
+                  factor * adjoint_product.transpose() *
+                  coef1.middleCols(l * l, 2 * l + 1);
+            }
+          } else {
+            for (const auto & coef_idx : *species_pairs.coeff_indices[i_pair]) {
+              const double adjoint_value{
+                  pair_factor * coef_idx.l_factor *
+                  soap_adjoint_by_pair(coef_idx.n1n2, coef_idx.l)};
+              adjoint1.block(coef_idx.n1, coef_idx.l_block_idx, 1,
+                             coef_idx.l_block_size) +=
+                  adjoint_value * coef2.block(coef_idx.n2, coef_idx.l_block_idx,
+                                              1, coef_idx.l_block_size);
+              adjoint2.block(coef_idx.n2, coef_idx.l_block_idx, 1,
+                             coef_idx.l_block_size) +=
+                  adjoint_value * coef1.block(coef_idx.n1, coef_idx.l_block_idx,
+                                              1, coef_idx.l_block_size);
+            }
+          }
+        }
+      }
+    }
+
+    //! PowerSpectrum coefficients to compute for the pair of species spair
+    const std::vector<PowerSpectrumCoeffIndex> &
+    get_coeff_indices(const internal::SortedKey<Key_t> & spair) const {
+      static const std::vector<PowerSpectrumCoeffIndex> no_coeff_indices{};
+      if (not this->is_sparsified) {
+        return this->coeff_indices;
+      }
+      auto it{this->coeff_indices_map.find(spair)};
+      if (it == this->coeff_indices_map.end()) {
+        return no_coeff_indices;
+      }
+      return it->second;
     }
 
-   protected:
     size_t max_radial{};
     size_t max_angular{};
     // shape of the inner dense section of the computed invariant coefficients
     std::array<size_t, 2> inner_invariants_shape{{0, 0}};
     bool normalize{};
     bool compute_gradients{};
+    //! store the invariants in single precision
+    bool single_precision{false};
     bool inversion_symmetry{false};
 
     CalculatorSphericalExpansion rep_expansion;
 
     internal::SphericalInvariantsType type{};
 
+    internal::PowerSpectrumProductType powerspectrum_product{
+        internal::PowerSpectrumProductType::Loop};
+
     //! precomputed l-factors the PowerSpectrum
     Eigen::VectorXd l_factors{};
 
-    //! precomputed wigner symbols for the BiSpectrum
-    Eigen::ArrayXd wigner_w3js{};
+    //! precomputed couplings of the real coefficients for the BiSpectrum
+    internal::BiSpectrumCouplings bispectrum_couplings{};
   };
 
   template <class StructureManager>
@@ -745,20 +1290,113 @@ namespace rascal {
     }
   }
 
+  template <class StructureManager, class Adjoint, class Accumulator>
+  void CalculatorSphericalInvariants::contract_gradients(
+      std::shared_ptr<StructureManager> manager, Adjoint && compute_adjoint,
+      Accumulator && accumulate) {
+    using PropExp_t =
+        typename CalculatorSphericalExpansion::Property_t<StructureManager>;
+    using Prop_t = Property_t<StructureManager>;
+    if (this->type != internal::SphericalInvariantsType::PowerSpectrum) {
+      throw std::logic_error("The adjoint gradients are only implemented for "
+                             "the PowerSpectrum");
+    }
+
+    constexpr bool ExcludeGhosts{true};
+    auto && expansions_coefficients{*manager->template get_property<PropExp_t>(
+        rep_expansion.get_name(), true, true, ExcludeGhosts)};
+    // with single_precision the invariants are converted back to double
+    // precision for the back-propagation
+    Prop_t soap_vectors_double{
+        *manager, "spherical invariants double precision", ExcludeGhosts};
+    if (this->single_precision) {
+      soap_vectors_double.copy_from(
+          *manager->template get_property<Property_t<StructureManager, float>>(
+              this->get_name(), true, true, ExcludeGhosts));
+    }
+    Prop_t & soap_vectors{
+        this->single_precision
+            ? soap_vectors_double
+            : *manager->template get_property<Prop_t>(this->get_name(), true,
+                                                      true, ExcludeGhosts)};
+
+    // dE/dp^{i} and dE/dc^{i} with the layout and the key ids of p^{i} and
+    // c^{i}, they only take as much memory as the representation
+    Prop_t soap_vector_adjoints{*manager, "power spectrum adjoints",
+                                ExcludeGhosts};
+    soap_vector_adjoints.copy_from(soap_vectors);
+    soap_vector_adjoints.setZero();
+    PropExp_t expansion_adjoints{*manager, "spherical expansion adjoints",
+                                 ExcludeGhosts};
+    expansion_adjoints.copy_from(expansions_coefficients);
+    expansion_adjoints.setZero();
+
+    SpeciesPairs species_pairs{};
+    const bool use_gemm{this->powerspectrum_product ==
+                        internal::PowerSpectrumProductType::GEMM};
+    math::Matrix_t product_buffer{};
+    for (auto center : manager) {
+      auto & soap_vector_adjoint{soap_vector_adjoints[center]};
+      compute_adjoint(center, soap_vector_adjoint);
+      const auto & coefficients{expansions_coefficients[center]};
+      auto & expansion_adjoint{expansion_adjoints[center]};
+      this->set_up_species_pairs(species_pairs, coefficients, soap_vectors);
+      if (not this->normalize) {
+        this->backpropagate_powerspectrum(coefficients, soap_vector_adjoint,
+                                          expansion_adjoint, species_pairs,
+                                          use_gemm, product_buffer);
+        continue;
+      }
+      // with \tilde{p} = p / |p| and J = dp/dc,
+      //   dE/dc = J^T (dE/d\tilde{p} - (dE/d\tilde{p} \cdot \tilde{p})
+      //                \tilde{p}) / |p|
+      // and |p| = \tilde{p} \cdot p = c \cdot J^T \tilde{p} / 2 since p is
+      // quadratic in c, so the norm does not have to be stored
+      const auto & soap_vector{soap_vectors[center]};
+      this->backpropagate_powerspectrum(coefficients, soap_vector,
+                                        expansion_adjoint, species_pairs,
+                                        use_gemm, product_buffer);
+      double norm{0.};
+      for (const int & key_id : species_pairs.coef_key_ids) {
+        norm += 0.5 * (coefficients.block_by_id(key_id).array() *
+                       expansion_adjoint.block_by_id(key_id).array())
+                          .sum();
+      }
+      double adjoint_dot_soap_vector{0.};
+      for (const int & key_id : species_pairs.soap_key_ids) {
+        if (key_id >= 0) {
+          adjoint_dot_soap_vector +=
+              (soap_vector_adjoint.block_by_id(key_id).array() *
+               soap_vector.block_by_id(key_id).array())
+                  .sum();
+        }
+      }
+      expansion_adjoint.multiply_elements_by(-adjoint_dot_soap_vector);
+      this->backpropagate_powerspectrum(coefficients, soap_vector_adjoint,
+                                        expansion_adjoint, species_pairs,
+                                        use_gemm, product_buffer);
+      expansion_adjoint.multiply_elements_by(1. / norm);
+    }
+
+    this->rep_expansion.contract_gradients(manager, expansion_adjoints,
+                                           accumulate);
+  }
+
   template <
       internal::SphericalInvariantsType BodyOrder,
       std::enable_if_t<
           BodyOrder == internal::SphericalInvariantsType::PowerSpectrum, int>,
       class StructureManager>
   void CalculatorSphericalInvariants::compute_impl(
-      std::shared_ptr<StructureManager> manager) {
+      std::shared_ptr<StructureManager> manager,
+      Property_t<StructureManager> & soap_vectors,
+      PropertyGradient_t<StructureManager> & soap_vector_gradients) {
     using PropExp_t =
         typename CalculatorSphericalExpansion::Property_t<StructureManager>;
     using PropGradExp_t =
         typename CalculatorSphericalExpansion::PropertyGradient_t<
             StructureManager>;
     using Prop_t = Property_t<StructureManager>;
-    using PropGrad_t = PropertyGradient_t<StructureManager>;
     using internal::SphericalInvariantsType;
     using math::pow;
 
@@ -774,73 +1412,108 @@ namespace rascal {
         *manager->template get_property<PropGradExp_t>(
             rep_expansion.get_gradient_name(), true, true)};
 
-    auto && soap_vectors{*manager->template get_property<Prop_t>(
-        this->get_name(), true, true, ExcludeGhosts)};
-
-    auto && soap_vector_gradients{*manager->template get_property<PropGrad_t>(
-        this->get_gradient_name(), true, true)};
-
     // if the representation has already been computed for the current
     // structure then do nothing
     if (soap_vectors.is_updated()) {
       return;
     }
 
+    // with the incremental expansion only the centers whose expansion has
+    // been recomputed since the last computation get a new soap vector
+    const bool incremental{this->rep_expansion.is_incremental()};
+    internal::BlockSparsePropertyBackup<Prop_t> previous_soap_vectors{};
+    if (incremental) {
+      previous_soap_vectors.save(soap_vectors);
+    }
+
     this->initialize_per_center_powerspectrum_soap_vectors(
         soap_vectors, soap_vector_gradients, expansions_coefficients, manager);
 
-    Key_t pair_type{0, 0};
-    // use special container to tell that there is not need to sort when
-    // using operator[] of soap_vector
-    internal::SortedKey<Key_t> spair_type{pair_type};
+    size_t last_update{0};
+    if (incremental) {
+      auto && state{
+          *manager->template get_property<IncrementalState_t<StructureManager>>(
+              this->get_name() + " incremental state", true, true)};
+      state.resize();
+      last_update = state(0);
+      state(0) = extract_underlying_manager<0>(manager)->get_n_update();
+    }
+    using ExpansionCenterState_t = typename CalculatorSphericalExpansion::
+        IncrementalCenterState_t<StructureManager>;
+    auto expansion_center_state{
+        incremental
+            ? manager->template get_property<ExpansionCenterState_t>(
+                  rep_expansion.get_incremental_center_state_name(), true)
+            : nullptr};
 
     // to store the norm of the soap vectors
     SpectrumNorm_t<StructureManager> soap_vector_norm_inv{
         *manager, "power spectrums inverse norms", true};
     soap_vector_norm_inv.resize();
 
+    // blocks of the species pairs of the current environment, see
+    // set_up_species_pairs()
+    SpeciesPairs species_pairs{};
+    const bool use_gemm{this->powerspectrum_product ==
+                        internal::PowerSpectrumProductType::GEMM};
+    // work space of the GEMM products, see compute_powerspectrum_gemm()
+    math::Matrix_t product_buffer{};
+
     for (auto center : manager) {
+      if (incremental and
+          (*expansion_center_state)[center](1) <= last_update and
+          previous_soap_vectors.restore(soap_vectors, center)) {
+        continue;
+      }
       auto & coefficients{expansions_coefficients[center]};
       auto & soap_vector{soap_vectors[center]};
-      // Compute the Powerspectrum coefficients
-      for (const auto & el1 : coefficients) {
-        spair_type[0] = el1.first[0];
-        auto & coef1{el1.second};
+      this->set_up_species_pairs(species_pairs, coefficients, soap_vectors);
+      const auto & coef_key_ids{species_pairs.coef_key_ids};
+      const size_t n_species{coef_key_ids.size()};
 
-        for (const auto & el2 : coefficients) {
-          // avoid computing p^{ab} and p^{ba} since p^{ab} = p^{ba}^T
-          if (spair_type[0] > el2.first[0]) {
-            continue;
-          }
-
-          spair_type[1] = el2.first[0];
-          auto & coef2{el2.second};
-          auto && soap_vector_by_pair{soap_vector[this->key_map[spair_type]]};
-          const auto & coef_ids{coeff_indices_map[spair_type]};
-          for (const auto & coef_idx : coef_ids) {
-            // the Powerspectrum coefficient and
-            // multiply with the constant 1 / \sqrt(2l+1)
-            soap_vector_by_pair(coef_idx.n1n2, coef_idx.l) =
-                (coef1
-                     .block(coef_idx.n1, coef_idx.l_block_idx, 1,
-                            coef_idx.l_block_size)
-                     .array() *
-                 coef2
-                     .block(coef_idx.n2, coef_idx.l_block_idx, 1,
-                            coef_idx.l_block_size)
-                     .array())
-                    .sum() *
-                coef_idx.l_factor;
-          }
-
-          // the \sqrt(2) factor to account for the missing (b,a) components
-          if (spair_type[0] < spair_type[1]) {
+      // Compute the Powerspectrum coefficients
+      if (use_gemm) {
+        this->compute_powerspectrum_gemm(coefficients, soap_vector,
+                                         species_pairs, product_buffer);
+      } else {
+        // avoid computing p^{ab} and p^{ba} since p^{ab} = p^{ba}^T
+        for (size_t i_species_1{0}; i_species_1 < n_species; ++i_species_1) {
+          const auto coef1{
+              coefficients.block_by_id(coef_key_ids[i_species_1])};
+          for (size_t i_species_2{i_species_1}; i_species_2 < n_species;
+               ++i_species_2) {
+            const auto coef2{
+                coefficients.block_by_id(coef_key_ids[i_species_2])};
+            const size_t i_pair{i_species_1 * n_species + i_species_2};
+            auto soap_vector_by_pair{
+                soap_vector.block_by_id(species_pairs.soap_key_ids[i_pair])};
+            const auto & coef_ids{*species_pairs.coeff_indices[i_pair]};
             for (const auto & coef_idx : coef_ids) {
-              soap_vector_by_pair(coef_idx.n1n2, coef_idx.l) *= math::SQRT_TWO;
+              // the Powerspectrum coefficient and
+              // multiply with the constant 1 / \sqrt(2l+1)
+              soap_vector_by_pair(coef_idx.n1n2, coef_idx.l) =
+                  (coef1
+                       .block(coef_idx.n1, coef_idx.l_block_idx, 1,
+                              coef_idx.l_block_size)
+                       .array() *
+                   coef2
+                       .block(coef_idx.n2, coef_idx.l_block_idx, 1,
+                              coef_idx.l_block_size)
+                       .array())
+                      .sum() *
+                  coef_idx.l_factor;
             }
-          }
-        }  // for el1 : coefficients
-      }    // for el2 : coefficients
+
+            // the \sqrt(2) factor to account for the missing (b,a) components
+            if (i_species_1 < i_species_2) {
+              for (const auto & coef_idx : coef_ids) {
+                soap_vector_by_pair(coef_idx.n1n2, coef_idx.l) *=
+                    math::SQRT_TWO;
+              }
+            }
+          }  // for i_species_2
+        }    // for i_species_1
+      }      // if use_gemm
 
       // normalize the soap vector
       if (this->normalize) {
@@ -849,57 +1522,58 @@ namespace rascal {
       }
 
       if (this->compute_gradients) {
-        // const int atom_i_tag{center.get_atom_tag()};
-        // c^{i}
-        auto & coefficients{expansions_coefficients[center]};
-        std::vector<Key_t> keys_coef{coefficients.get_keys()};
-
         // Sum the gradients wrt the neighbour atom position
         // compute the \grad_k p^{i} coeffs where k is either i or j
         for (auto neigh : center.pairs_with_self_pair()) {
           // \grad_k c^{i}
           auto & grad_neigh_coefficients{
               expansions_coefficients_gradient[neigh]};
-          std::vector<Key_t> keys_coef_grad_neigh{
-              grad_neigh_coefficients.get_keys()};
           // \grad_k p^{i}
           auto & soap_neigh_gradient{soap_vector_gradients[neigh]};
 
-          std::set<internal::SortedKey<Key_t>, internal::CompareSortedKeyLess>
-              grad_neigh_keys{};
+          if (use_gemm) {
+            this->compute_powerspectrum_gradient_gemm(
+                grad_neigh_coefficients, coefficients, soap_neigh_gradient,
+                species_pairs, product_buffer);
+            continue;
+          }
+
+          // pairs of species with a non zero \grad_k p^{i ab}
+          std::fill(species_pairs.has_gradient.begin(),
+                    species_pairs.has_gradient.end(), false);
           // \grad_k p^{iab} = \grad_k c^{i a} c^{i b} + c^{i a} \grad_k c^{i b}
           // by definition \grad_k c^{i a} is non zero for one key 'a' for k!=i
           // so either a == b and we compute one term with a factor of 2 or only
           // one of the two terms is non zero hence the swap of entry when
-          // spair_type[0] > spair_type[1] == true
-          for (const auto & coef_key_1 : keys_coef_grad_neigh) {
+          // a > b
+          // the gradients of the expansion use the same key ids as the
+          // expansion
+          const auto grad_key_ids{grad_neigh_coefficients.get_key_ids()};
+          for (const int & grad_key_id : grad_key_ids) {
+            const size_t i_species_1{static_cast<size_t>(
+                species_pairs.species_index_by_key_id[grad_key_id])};
             // \grad_k c^{i a}
-            const auto & grad_neigh_coefficients_1{
-                grad_neigh_coefficients[coef_key_1]};
+            const auto grad_neigh_coefficients_1{
+                grad_neigh_coefficients.block_by_id(grad_key_id)};
 
-            for (const auto & coef_key_2 : keys_coef) {
+            for (size_t i_species_2{0}; i_species_2 < n_species;
+                 ++i_species_2) {
               // c^{i b}
-              const auto & expansion_coefficients_2{coefficients[coef_key_2]};
-              bool sorted{true}, equal{false};
-              // make sure spair_type has sorted entries
-              if (coef_key_1[0] > coef_key_2[0]) {
-                sorted = false;
-                spair_type[0] = coef_key_2[0];
-                spair_type[1] = coef_key_1[0];
-              } else if (coef_key_1[0] == coef_key_2[0]) {
-                equal = true;
-                spair_type[0] = coef_key_1[0];
-                spair_type[1] = coef_key_2[0];
-              } else {
-                spair_type[0] = coef_key_1[0];
-                spair_type[1] = coef_key_2[0];
-              }
-
-              grad_neigh_keys.insert(spair_type);
+              const auto expansion_coefficients_2{
+                  coefficients.block_by_id(coef_key_ids[i_species_2])};
+              const bool sorted{i_species_1 < i_species_2};
+              const bool equal{i_species_1 == i_species_2};
+              // index of the sorted pair of species
+              const size_t i_pair{
+                  i_species_1 <= i_species_2
+                      ? i_species_1 * n_species + i_species_2
+                      : i_species_2 * n_species + i_species_1};
+              species_pairs.has_gradient[i_pair] = true;
               // \grad_k p^{i ab}
               auto soap_neigh_gradient_by_species_pair{
-                  soap_neigh_gradient[this->key_map[spair_type]]};
-              const auto & coef_ids{coeff_indices_map[spair_type]};
+                  soap_neigh_gradient.block_by_id(
+                      species_pairs.soap_key_ids[i_pair])};
+              const auto & coef_ids{*species_pairs.coeff_indices[i_pair]};
 
               // computes  \grad_k c^{i a}_{n_1} c^{i b}_{n_2}
               if (sorted or equal) {
@@ -950,16 +1624,22 @@ namespace rascal {
                   }  // for const auto& coef_idx : coef_ids
                 }    // for cartesian_idx
               }      // if (not sorted or equal)
-            }        // keys_coef
-          }          // keys_coef_grad_neigh
+            }        // for i_species_2
+          }          // for grad_key_id
 
           // multiply with \sqrt(2) factor to account
           // for the missing (b,a) components
-          for (const auto & key : grad_neigh_keys) {
-            if (key[0] != key[1]) {
+          for (size_t i_species_1{0}; i_species_1 < n_species; ++i_species_1) {
+            for (size_t i_species_2{i_species_1 + 1}; i_species_2 < n_species;
+                 ++i_species_2) {
+              const size_t i_pair{i_species_1 * n_species + i_species_2};
+              if (not species_pairs.has_gradient[i_pair]) {
+                continue;
+              }
               auto soap_neigh_gradient_by_species_pair{
-                  soap_neigh_gradient[this->key_map[key]]};
-              const auto & coef_ids{coeff_indices_map[key]};
+                  soap_neigh_gradient.block_by_id(
+                      species_pairs.soap_key_ids[i_pair])};
+              const auto & coef_ids{*species_pairs.coeff_indices[i_pair]};
               for (size_t cartesian_idx{0}; cartesian_idx < 3;
                    ++cartesian_idx) {
                 const size_t cartesian_offset_n1n2{
@@ -979,7 +1659,7 @@ namespace rascal {
     if (this->normalize and this->compute_gradients) {
       const size_t grad_component_size{this->inner_invariants_shape[0] *
                                        this->inner_invariants_shape[1]};
-      this->update_gradients_for_normalization(
+      internal::update_gradients_for_normalization(
           soap_vectors, soap_vector_gradients, manager, soap_vector_norm_inv,
           grad_component_size);
     }  // if normalize and compute_gradients
@@ -991,14 +1671,14 @@ namespace rascal {
           BodyOrder == internal::SphericalInvariantsType::RadialSpectrum, int>,
       class StructureManager>
   void CalculatorSphericalInvariants::compute_impl(
-      std::shared_ptr<StructureManager> manager) {
+      std::shared_ptr<StructureManager> manager,
+      Property_t<StructureManager> & soap_vectors,
+      PropertyGradient_t<StructureManager> & soap_vector_gradients) {
     using PropExp_t =
         typename CalculatorSphericalExpansion::Property_t<StructureManager>;
     using PropGradExp_t =
         typename CalculatorSphericalExpansion::PropertyGradient_t<
             StructureManager>;
-    using Prop_t = Property_t<StructureManager>;
-    using PropGrad_t = PropertyGradient_t<StructureManager>;
     using math::pow;
     constexpr bool ExcludeGhosts{true};
 
@@ -1011,11 +1691,6 @@ namespace rascal {
         *manager->template get_property<PropGradExp_t>(
             rep_expansion.get_gradient_name(), true, true)};
 
-    auto && soap_vectors{*manager->template get_property<Prop_t>(
-        this->get_name(), true, true, ExcludeGhosts)};
-
-    auto && soap_vector_gradients{*manager->template get_property<PropGrad_t>(
-        this->get_gradient_name(), true, true)};
     // if the representation has already been computed for the current
     // structure then do nothing
     if (soap_vectors.is_updated()) {
@@ -1059,7 +1734,7 @@ namespace rascal {
     }      // for (auto center : manager)
 
     if (this->normalize and this->compute_gradients) {
-      this->update_gradients_for_normalization(
+      internal::update_gradients_for_normalization(
           soap_vectors, soap_vector_gradients, manager, soap_vector_norm_inv,
           this->max_radial);
     }  // if (this->normalize and this->compute_gradients)
@@ -1071,10 +1746,12 @@ namespace rascal {
           BodyOrder == internal::SphericalInvariantsType::BiSpectrum, int>,
       class StructureManager>
   void CalculatorSphericalInvariants::compute_impl(
-      std::shared_ptr<StructureManager> manager) {
+      std::shared_ptr<StructureManager> manager,
+      Property_t<StructureManager> & soap_vectors,
+      PropertyGradient_t<StructureManager> &
+      /* the BiSpectrum does not have gradients */) {
     using PropExp_t =
         typename CalculatorSphericalExpansion::Property_t<StructureManager>;
-    using Prop_t = Property_t<StructureManager>;
     using internal::SphericalInvariantsType;
     using math::pow;
 
@@ -1084,9 +1761,6 @@ namespace rascal {
     auto && expansions_coefficients{*manager->template get_property<PropExp_t>(
         rep_expansion.get_name(), true, true, ExcludeGhosts)};
 
-    auto && soap_vectors{*manager->template get_property<Prop_t>(
-        this->get_name(), true, true, ExcludeGhosts)};
-
     // if the representation has already been computed for the current
     // structure then do nothing
     if (soap_vectors.is_updated()) {
@@ -1096,7 +1770,17 @@ namespace rascal {
     this->initialize_per_center_bispectrum_soap_vectors(
         soap_vectors, expansions_coefficients, manager);
 
-    using complex = std::complex<double>;
+    const auto & couplings{this->bispectrum_couplings};
+    const int n_couplings{static_cast<int>(couplings.size())};
+    const int n_max{static_cast<int>(this->max_radial)};
+    // BiSpectrum of a triplet of species, column major so that the n3
+    // components of a (n1, n2, l_channel) are contiguous
+    Eigen::MatrixXd bispectrum{};
+    // coefficients of the third species, column major for the same reason
+    Eigen::MatrixXd coef3_by_lm{};
+    // sum over lm3 of the couplings times the coefficients of the third
+    // species, for a given (l_channel, lm1, lm2)
+    Eigen::VectorXd coupled_coef3{};
 
     // factor that takes into acount the missing equivalent off diagonal
     // element with respect to the key (or species) index
@@ -1115,7 +1799,6 @@ namespace rascal {
           auto & coef2{el2.second};
           for (const auto & el3 : coefficients) {
             triplet_type[2] = el3.first[0];
-            auto & coef3{el3.second};
             // triplet multiplicity
             // all the same
             if (triplet_type[0] == triplet_type[1] &&
@@ -1132,114 +1815,40 @@ namespace rascal {
 
             if (soap_vector.count(triplet_type) == 1) {
               auto && soap_vector_by_type{soap_vector[triplet_type]};
-
-              size_t nn{0};
-              for (size_t n1{0}; n1 < this->max_radial; n1++) {
-                for (size_t n2{0}; n2 < this->max_radial; n2++) {
-                  for (size_t n3{0}; n3 < this->max_radial; n3++) {
-                    size_t l0{0};
-                    int wigner_count{0};
-                    for (size_t l1{0}; l1 < this->max_angular + 1; l1++) {
-                      for (size_t l2{0}; l2 < this->max_angular + 1; l2++) {
-                        for (size_t l3{0}; l3 < this->max_angular + 1; l3++) {
-                          if (this->inversion_symmetry == true) {
-                            if ((l1 + l2 + l3) % 2 == 1) {
-                              continue;
-                            }
-                          }
-
-                          if ((l1 <
-                               static_cast<size_t>(std::abs<int>(l2 - l3))) ||
-                              (l1 > l2 + l3)) {
-                            continue;
-                          }
-
-                          for (size_t m1{0}; m1 < 2 * l1 + 1; m1++) {
-                            int m1s{static_cast<int>(m1 - l1)};
-                            size_t lm1{math::pow(l1, 2_size_t) + m1};
-                            for (size_t m2{0}; m2 < 2 * l2 + 1; m2++) {
-                              int m2s{static_cast<int>(m2 - l2)};
-                              size_t lm2{math::pow(l2, 2_size_t) + m2};
-                              for (size_t m3{0}; m3 < 2 * l3 + 1; m3++) {
-                                int m3s{static_cast<int>(m3 - l3)};
-                                if (m1s + m2s + m3s != 0) {
-                                  continue;
-                                }
-                                size_t lm3{math::pow(l3, 2_size_t) + m3};
-                                double w3j = this->wigner_w3js[wigner_count];
-                                complex coef1c, coef2c, coef3c;
-                                // usual formulae for converting from real to
-                                // complex
-                                // see src/math/spherical_harmonics.hh for the
-                                // inverse transformation
-                                // TODO(andrea, michael) avoid complex
-                                // arithmetic
-                                if (m1s > 0) {
-                                  coef1c = math::pow(-1, m1s) *
-                                           complex{coef1(n1, lm1),
-                                                   coef1(n1, lm1 - 2 * m1s)};
-                                } else if (m1s == 0) {
-                                  coef1c = complex(coef1(n1, lm1), 0.0) *
-                                           math::SQRT_TWO;
-                                } else if (m1s < 0) {
-                                  coef1c = complex{coef1(n1, lm1 - 2 * m1s),
-                                                   -coef1(n1, lm1)};
-                                }
-                                if (m2s > 0) {
-                                  coef2c = math::pow(-1.0, m2s) *
-                                           complex{coef2(n2, lm2),
-                                                   coef2(n2, lm2 - 2 * m2s)};
-                                } else if (m2s == 0) {
-                                  coef2c = complex(coef2(n2, lm2), 0.0) *
-                                           math::SQRT_TWO;
-                                } else if (m2s < 0) {
-                                  coef2c = complex{coef2(n2, lm2 - 2 * m2s),
-                                                   -coef2(n2, lm2)};
-                                }
-                                if (m3s > 0) {
-                                  coef3c = math::pow(-1.0, m3s) *
-                                           complex{coef3(n3, lm3),
-                                                   coef3(n3, lm3 - 2 * m3s)};
-                                } else if (m3s == 0) {
-                                  coef3c = complex(coef3(n3, lm3), 0.0) *
-                                           math::SQRT_TWO;
-                                } else if (m3s < 0) {
-                                  coef3c = complex{coef3(n3, lm3 - 2 * m3s),
-                                                   -coef3(n3, lm3)};
-                                }
-                                coef1c *= math::INV_SQRT_TWO;
-                                coef2c *= math::INV_SQRT_TWO;
-                                coef3c *= math::INV_SQRT_TWO;
-
-                                // The descriptor components are purely real or
-                                // imaginary
-                                // depending on the divisibility of l1 + l2 +l3
-                                // by 2.
-                                if ((l1 + l2 + l3) % 2 == 0) {
-                                  soap_vector_by_type(nn, l0) +=
-                                      w3j * mult *
-                                      (coef1c * coef2c * coef3c).real();
-                                } else {
-                                  soap_vector_by_type(nn, l0) +=
-                                      w3j * mult *
-                                      (coef1c * coef2c * coef3c).imag();
-                                }
-                                wigner_count++;
-                              }  // m3
-                            }    // m2
-                          }      // m1
-                          l0++;
-                        }  // l3
-                      }    // l2
-                    }      // l1
-                    nn++;
-                  }  // n3
-                }    // n2
-              }      // n1
-            }        // if count triplet
-          }          // coef3
-        }            // coef2
-      }              // coef1
+              coef3_by_lm = el3.second;
+              bispectrum.setZero(soap_vector_by_type.rows(),
+                                 soap_vector_by_type.cols());
+
+              int i_coupling{0};
+              while (i_coupling < n_couplings) {
+                const int l_channel{couplings.l_channel[i_coupling]};
+                const int lm1{couplings.lm1[i_coupling]};
+                const int lm2{couplings.lm2[i_coupling]};
+                coupled_coef3.setZero(n_max);
+                // the couplings sharing (l_channel, lm1, lm2) are consecutive
+                for (; i_coupling < n_couplings and
+                       couplings.l_channel[i_coupling] == l_channel and
+                       couplings.lm1[i_coupling] == lm1 and
+                       couplings.lm2[i_coupling] == lm2;
+                     ++i_coupling) {
+                  coupled_coef3 += couplings.values[i_coupling] *
+                                   coef3_by_lm.col(couplings.lm3[i_coupling]);
+                }
+                for (int n1{0}; n1 < n_max; ++n1) {
+                  for (int n2{0}; n2 < n_max; ++n2) {
+                    bispectrum.col(l_channel).segment((n1 * n_max + n2) *
+                                                          n_max,
+                                                      n_max) +=
+                        (mult * coef1(n1, lm1) * coef2(n2, lm2)) *
+                        coupled_coef3;
+                  }
+                }
+              }
+              soap_vector_by_type += bispectrum;
+            }  // if count triplet
+          }    // coef3
+        }      // coef2
+      }        // coef1
 
       // normalize the soap vector
       if (this->normalize) {
@@ -1308,6 +1917,8 @@ namespace rascal {
           InvariantsDerivative & soap_vector_gradients,
           ExpansionCoeff & expansions_coefficients,
           std::shared_ptr<StructureManager> manager) {
+    // the invariants and their gradients share the ids of the pair keys
+    soap_vector_gradients.set_key_interner(soap_vectors.get_key_interner());
     if (this->is_sparsified) {
       size_t n_row{this->inner_invariants_shape[0]};
       size_t n_col{this->inner_invariants_shape[1]};
@@ -1336,7 +1947,6 @@ namespace rascal {
     } else {
       size_t n_row{this->inner_invariants_shape[0]};
       size_t n_col{this->inner_invariants_shape[1]};
-      this->coeff_indices_map.clear();
       // clear the data container and resize it
       soap_vectors.clear();
       soap_vectors.set_shape(n_row, n_col);
@@ -1433,14 +2043,7 @@ namespace rascal {
             }
           }  // auto neigh : center.pairs()
         }    // if compute_gradients
-
-        // initialize coeff_indices_map if the representation is not sparsified
-        for (const auto & key : pair_list) {
-          if (not this->coeff_indices_map.count(key)) {
-            this->coeff_indices_map[key] = coeff_indices;
-          }
-        }
-      }  // for center : manager
+      }      // for center : manager
 
       soap_vectors.resize(keys_list);
       soap_vectors.setZero();
@@ -34,7 +34,9 @@
 
 #include <Eigen/Dense>
 
+#include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace rascal {
@@ -104,6 +106,19 @@ namespace rascal {
       return (-0.5 * math::PI / smooth_width * std::sin(r_scaled));
     }
 
+    /**
+     * Smooth continuation of switching_function_cosine() outside of the
+     * switching region (cutoff - smooth_width < r <= cutoff), where it is
+     * not clamped to one or zero. This is the function to tabulate with
+     * cubic splines around the edges of the switching region, since the
+     * second derivative of switching_function_cosine() jumps there.
+     */
+    inline double switching_function_cosine_continued(double r, double cutoff,
+                                                      double smooth_width) {
+      double r_scaled{math::PI * (r - cutoff + smooth_width) / smooth_width};
+      return (0.5 * (1. + std::cos(r_scaled)));
+    }
+
     /**
      * List of implemented cutoff function
      */
@@ -300,6 +315,43 @@ namespace rascal {
         cutoff_function);
   }
 
+  /**
+   * Make a function evaluating the factor that multiplies the cosine
+   * switching function in the cutoff function described by fc_hypers, i.e.
+   * the radial scaling u(r) of a RadialScaling and one for a ShiftedCosine.
+   * Unlike f_c it is smooth everywhere so it can be tabulated with cubic
+   * splines. The type of the cutoff function is dispatched at runtime so it
+   * is not meant to be called in the inner loops.
+   *
+   * @throw logic_error for a RadialScaling with a zero rate since it
+   * diverges at r = 0
+   */
+  template <class Hypers>
+  std::function<double(double)>
+  make_radial_scaling_function(const Hypers & fc_hypers) {
+    using internal::CutoffFunction;
+    using internal::CutoffFunctionType;
+    auto fc_type = fc_hypers.at("type").template get<std::string>();
+    if (fc_type == "ShiftedCosine") {
+      return [](double /*distance*/) { return 1.; };
+    } else if (fc_type == "RadialScaling") {
+      auto cutoff_function{
+          std::make_shared<CutoffFunction<CutoffFunctionType::RadialScaling>>(
+              fc_hypers)};
+      if (std::abs(cutoff_function->rate) <= math::DBL_FTOL and
+          cutoff_function->exponent != 0) {
+        throw std::logic_error("RadialScaling with a zero rate diverges at "
+                               "r = 0 and can not be tabulated");
+      }
+      return [cutoff_function](double distance) {
+        return cutoff_function->value(distance);
+      };
+    }
+    throw std::logic_error("Requested cutoff function type \'" + fc_type +
+                           "\' has not been implemented.  Must be one of" +
+                           ": \'ShiftedCosine\' or 'RadialScaling'.");
+  }
+
 }  // namespace rascal
 
 #endif  // SRC_RASCAL_REPRESENTATIONS_CUTOFF_FUNCTIONS_HH_
@@ -0,0 +1,294 @@
+/**
+ * @file   rascal/representations/optimal_radial_basis.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   17 October 2026
+ *
+ * @brief  Estimate an optimal (PCA contracted) radial basis from the
+ *         covariance of the spherical expansion coefficients
+ *
+ * Copyright  2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_REPRESENTATIONS_OPTIMAL_RADIAL_BASIS_HH_
+#define SRC_RASCAL_REPRESENTATIONS_OPTIMAL_RADIAL_BASIS_HH_
+
+#include "rascal/math/utils.hh"
+#include "rascal/representations/calculator_spherical_expansion.hh"
+#include "rascal/utils/json_io.hh"
+
+#include <Eigen/Dense>
+
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace rascal {
+
+  /**
+   * Streaming estimate of the covariance of the spherical expansion
+   * coefficients following Goscinski et al, arxiv:2105.08717
+   *
+   * @f[
+   *    C^{a l}_{n n'} = \frac{1}{N} \sum_i \sum_m
+   *                     c^{i a}_{n l m} c^{i a}_{n' l m},
+   * @f]
+   *
+   * for each neighbour species a and angular channel l, where N is the
+   * number of environments. The structures can be given in several chunks
+   * so the expansion coefficients of the whole dataset never have to be
+   * stored at once. The principal components of C^{a l} give the projection
+   * matrices of the RadialDimReduction optimization of the spherical
+   * expansion, which bakes them into its spline of the radial integral.
+   */
+  class RadialBasisCovariance {
+   public:
+    using Matrix_t = math::Matrix_t;
+    //! covariance or projection matrix per neighbour species and l
+    using Matrices_t = std::map<int, std::vector<Matrix_t>>;
+
+    RadialBasisCovariance(const size_t max_radial, const size_t max_angular)
+        : max_radial{max_radial}, max_angular{max_angular} {}
+
+    /**
+     * Compute the spherical expansion of the structures in managers and
+     * add their environments to the covariance.
+     *
+     * @param calculator spherical expansion with max_radial and max_angular
+     *          of this covariance, i.e. the expanded radial basis
+     * @param managers a ManagerCollection or similar collection of
+     *          structure managers
+     */
+    template <class StructureManagers>
+    void accumulate(CalculatorSphericalExpansion & calculator,
+                    StructureManagers & managers) {
+      calculator.compute(managers);
+      for (auto & manager : managers) {
+        this->accumulate_structure(calculator, manager);
+      }
+    }
+
+    //! add the environments of manager, whose expansion has been computed
+    template <class StructureManager>
+    void accumulate_structure(const CalculatorSphericalExpansion & calculator,
+                              std::shared_ptr<StructureManager> manager) {
+      using Prop_t = typename CalculatorSphericalExpansion::template Property_t<
+          StructureManager>;
+      auto && expansions_coefficients{*manager->template get_property<Prop_t>(
+          calculator.get_name(), true)};
+      const size_t n_lm{(this->max_angular + 1) * (this->max_angular + 1)};
+      if (static_cast<size_t>(expansions_coefficients.get_nb_row()) !=
+              this->max_radial or
+          static_cast<size_t>(expansions_coefficients.get_nb_col()) != n_lm) {
+        std::stringstream err_str{};
+        err_str << "The spherical expansion has the shape ("
+                << expansions_coefficients.get_nb_row() << ", "
+                << expansions_coefficients.get_nb_col()
+                << ") instead of (max_radial, (max_angular+1)^2) = ("
+                << this->max_radial << ", " << n_lm << ").";
+        throw std::runtime_error(err_str.str());
+      }
+
+      for (auto center : manager) {
+        auto && coefficients{expansions_coefficients[center]};
+        for (const auto & key : coefficients.get_keys()) {
+          auto & covariance{this->get_or_create(key[0])};
+          auto coefficients_by_key{coefficients[key]};
+          for (size_t angular_l{0}; angular_l < this->max_angular + 1;
+               ++angular_l) {
+            // only the lower triangle is accumulated
+            covariance[angular_l]
+                .template selfadjointView<Eigen::Lower>()
+                .rankUpdate(coefficients_by_key.middleCols(
+                    angular_l * angular_l, 2 * angular_l + 1));
+          }
+        }
+        ++this->n_environments;
+      }
+    }
+
+    //! number of environments accumulated so far
+    size_t get_n_environments() const { return this->n_environments; }
+
+    //! covariance matrices [max_radial, max_radial] by species and l
+    Matrices_t get_covariances() const {
+      Matrices_t covariances{};
+      for (const auto & sp_covariance : this->covariances) {
+        auto & covariances_by_sp{covariances[sp_covariance.first]};
+        for (const auto & covariance : sp_covariance.second) {
+          Matrix_t full{covariance.selfadjointView<Eigen::Lower>()};
+          if (this->n_environments > 0) {
+            full /= static_cast<double>(this->n_environments);
+          }
+          covariances_by_sp.push_back(std::move(full));
+        }
+      }
+      return covariances;
+    }
+
+    /**
+     * Projection matrices [n_components, max_radial] on the n_components
+     * principal components of the covariance by species and l, in the
+     * layout of the projection_matrices of RadialDimReduction
+     */
+    Matrices_t get_projection_matrices(const size_t n_components) const {
+      if (n_components > this->max_radial) {
+        std::stringstream err_str{};
+        err_str << "Cannot keep " << n_components
+                << " radial components out of max_radial="
+                << this->max_radial << ".";
+        throw std::logic_error(err_str.str());
+      }
+      Matrices_t projection_matrices{};
+      Eigen::SelfAdjointEigenSolver<Matrix_t> eigen_solver{};
+      for (const auto & sp_covariances : this->get_covariances()) {
+        auto & projection_matrices_by_sp{
+            projection_matrices[sp_covariances.first]};
+        for (const auto & covariance : sp_covariances.second) {
+          eigen_solver.compute(covariance);
+          // the eigenvalues are in increasing order
+          projection_matrices_by_sp.emplace_back(
+              eigen_solver.eigenvectors()
+                  .rightCols(n_components)
+                  .rowwise()
+                  .reverse()
+                  .transpose());
+        }
+      }
+      return projection_matrices;
+    }
+
+   protected:
+    std::vector<Matrix_t> & get_or_create(const int neighbour_type) {
+      auto covariance_it{this->covariances.find(neighbour_type)};
+      if (covariance_it == this->covariances.end()) {
+        covariance_it =
+            this->covariances
+                .emplace(neighbour_type,
+                         std::vector<Matrix_t>(
+                             this->max_angular + 1,
+                             Matrix_t::Zero(this->max_radial,
+                                            this->max_radial)))
+                .first;
+      }
+      return covariance_it->second;
+    }
+
+    size_t max_radial;
+    size_t max_angular;
+    size_t n_environments{0};
+    //! unnormalized covariances, only their lower triangle is filled
+    Matrices_t covariances{};
+  };
+
+  /**
+   * Hypers of a spherical expansion (or of the invariants built on it) on
+   * an optimal radial basis, see RadialBasisCovariance.
+   *
+   * @param hypers hypers of the representation, max_radial is the size of
+   *          the optimal basis
+   * @param covariance covariance estimated with an expanded radial basis
+   * @return hypers with the RadialDimReduction projection matrices, the
+   *          expanded basis is only evaluated to build the spline
+   */
+  inline json
+  make_optimal_radial_basis_hypers(const json & hypers,
+                                   const RadialBasisCovariance & covariance) {
+    const auto max_radial{hypers.at("max_radial").get<size_t>()};
+    std::map<std::string, std::vector<std::vector<std::vector<double>>>>
+        projection_matrices{};
+    for (const auto & sp_projections :
+         covariance.get_projection_matrices(max_radial)) {
+      auto & projection_matrices_by_sp{
+          projection_matrices[std::to_string(sp_projections.first)]};
+      for (const auto & projection : sp_projections.second) {
+        std::vector<std::vector<double>> rows{};
+        for (Eigen::Index i_row{0}; i_row < projection.rows(); ++i_row) {
+          rows.emplace_back(projection.row(i_row).data(),
+                            projection.row(i_row).data() + projection.cols());
+        }
+        projection_matrices_by_sp.push_back(std::move(rows));
+      }
+    }
+
+    json optimal_hypers = hypers;
+    auto & radial_contribution = optimal_hypers["radial_contribution"];
+    if (not radial_contribution.count("optimization") or
+        radial_contribution.at("optimization").is_null()) {
+      radial_contribution["optimization"] = json::object();
+    }
+    auto & optimization = radial_contribution["optimization"];
+    optimization["RadialDimReduction"]["projection_matrices"] =
+        projection_matrices;
+    if (not optimization.count("Spline")) {
+      optimization["Spline"]["accuracy"] = 1e-8;
+    }
+    return optimal_hypers;
+  }
+
+  /**
+   * Compute an optimal radial basis of max_radial functions from the
+   * spherical expansion of managers on expanded_max_radial functions
+   * (2*max_radial by default).
+   *
+   * @param hypers hypers of the representation
+   * @param managers structures used to estimate the covariance
+   * @return hypers with the RadialDimReduction projection matrices
+   */
+  template <class StructureManagers>
+  json get_optimal_radial_basis_hypers(const json & hypers,
+                                       StructureManagers & managers,
+                                       int expanded_max_radial = -1) {
+    const auto max_radial{hypers.at("max_radial").get<int>()};
+    if (expanded_max_radial == -1) {
+      expanded_max_radial = 2 * max_radial;
+    }
+    if (expanded_max_radial < max_radial) {
+      throw std::logic_error(
+          "expanded_max_radial should be larger than max_radial");
+    }
+
+    // the expansion hypers without the options of the invariants
+    json expansion_hypers = hypers;
+    for (const auto & name : {"normalize", "soap_type", "compute_gradients",
+                              "inversion_symmetry", "single_precision"}) {
+      expansion_hypers.erase(name);
+    }
+    auto & radial_contribution = expansion_hypers["radial_contribution"];
+    if (radial_contribution.count("optimization") and
+        radial_contribution.at("optimization").is_object()) {
+      radial_contribution["optimization"].erase("RadialDimReduction");
+    }
+    expansion_hypers["max_radial"] = expanded_max_radial;
+    // the expansion is registered under a name of its own in the managers
+    expansion_hypers.erase("identifier");
+
+    CalculatorSphericalExpansion expansion{expansion_hypers};
+    RadialBasisCovariance covariance{
+        static_cast<size_t>(expanded_max_radial),
+        hypers.at("max_angular").get<size_t>()};
+    covariance.accumulate(expansion, managers);
+    return make_optimal_radial_basis_hypers(hypers, covariance);
+  }
+
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_REPRESENTATIONS_OPTIMAL_RADIAL_BASIS_HH_
@@ -662,9 +662,13 @@ namespace rascal {
       return this->manager->get_shared_ptr();
     }
 
+    //! Returns the number of times the neighbour list has been rebuilt
     size_t get_n_update() const { return this->n_update; }
 
-    size_t get_skin2() const { return this->skin2; }
+    //! Returns the skin distance of the Verlet list
+    double get_skin() const { return this->skin; }
+
+    double get_skin2() const { return this->skin2; }
 
    protected:
     /* ---------------------------------------------------------------------- */
@@ -696,6 +700,50 @@ namespace rascal {
       this->n_ghosts++;
     }
 
+    /**
+     * Records from which atom of the underlying manager the last added ghost
+     * atom originates and by how much it is shifted from it, so that its
+     * position can be refreshed without rebuilding the neighbour list.
+     */
+    void add_ghost_atom_source(int source_atom_tag, const Vector_t & shift) {
+      this->ghost_source_atom_tags.push_back(source_atom_tag);
+      for (auto dim{0}; dim < traits::Dim; ++dim) {
+        this->ghost_shifts.push_back(shift(dim));
+      }
+    }
+
+    /**
+     * Moves the ghost atoms along with the atoms of the underlying manager
+     * they are periodic images of. Used when the Verlet list is reused.
+     */
+    void update_ghost_positions() {
+      for (size_t i_ghost{0}; i_ghost < this->n_ghosts; ++i_ghost) {
+        auto pos = this->manager->get_position(
+            this->ghost_source_atom_tags[i_ghost]);
+        for (auto dim{0}; dim < traits::Dim; ++dim) {
+          this->ghost_positions[i_ghost * traits::Dim + dim] =
+              pos(dim) + this->ghost_shifts[i_ghost * traits::Dim + dim];
+        }
+      }
+    }
+
+    /**
+     * Decides if the neighbour list has to be rebuilt. With a finite skin the
+     * list built with cutoff + skin is still complete as long as no atom has
+     * moved by more than skin / 2 since the last rebuild (each atom of a pair
+     * can move toward the other).
+     */
+    bool is_rebuild_needed() const {
+      if (this->n_update == 0 or this->skin2 == 0.) {
+        return true;
+      }
+      // TODO(felix) should not have to assume that the underlying manager is
+      // manager centers.
+      auto && atomic_structure{this->manager->get_atomic_structure()};
+      return not this->structure_at_last_build.is_similar(atomic_structure,
+                                                          0.25 * this->skin2);
+    }
+
     //! Extends the list containing the number of neighbours with a 0
     void add_entry_number_of_neighbours() { this->nb_neigh.push_back(0); }
 
@@ -722,14 +770,15 @@ namespace rascal {
     //! Cutoff radius for neighbour list
     const double cutoff;
     /**
-     * If no atom has moved more than the skin-distance since the
-     * last call to the update method, then the linked cell neighbor list can
-     * be reused. This will save some expensive rebuilds of the list, but
-     * extra neighbors outside the cutoff will be considered.
-     *
-     * use squared skin to avoid computing the sqrt of the squared norm
-     * between the two .
+     * If no atom has moved more than half the skin-distance since the
+     * last rebuild, then the linked cell neighbor list, which is built with
+     * cutoff + skin, can be reused. This will save some expensive rebuilds of
+     * the list, but extra neighbors outside the cutoff will be considered
+     * (use AdaptorStrict to filter them out).
      */
+    const double skin;
+
+    //! use squared skin to avoid computing the sqrt of the squared norm
     const double skin2;
 
     //! stores i-atom and ghost atom tags
@@ -785,6 +834,15 @@ namespace rascal {
     //! ghost atom type
     std::vector<int> ghost_types{};
 
+    //! atom tag in the underlying manager from which each ghost is an image
+    std::vector<int> ghost_source_atom_tags{};
+
+    //! shift between each ghost atom and its source atom
+    std::vector<double> ghost_shifts{};
+
+    //! structure used for the last rebuild, reference for the skin criterion
+    AtomicStructure<traits::Dim> structure_at_last_build{};
+
    private:
   };
 
@@ -794,13 +852,13 @@ namespace rascal {
   AdaptorNeighbourList<ManagerImplementation>::AdaptorNeighbourList(
       std::shared_ptr<ManagerImplementation> manager, double cutoff,
       double skin)
-      : manager{std::move(manager)}, cutoff{cutoff}, skin2{skin * skin},
-        atom_tag_list{}, atom_types{}, ghost_atom_tag_list{}, nb_neigh{},
-        neighbours_atom_tag{}, offsets{}, n_centers{0}, n_ghosts{0} {
+      : manager{std::move(manager)}, cutoff{cutoff}, skin{skin},
+        skin2{skin * skin}, atom_tag_list{}, atom_types{},
+        ghost_atom_tag_list{}, nb_neigh{}, neighbours_atom_tag{}, offsets{},
+        n_centers{0}, n_ghosts{0} {
     static_assert(not(traits::MaxOrder < 1), "No atom list in manager");
-    if (this->skin2 > 0.) {
-      throw std::runtime_error(
-          "The verlet list is not functional for the moment, keep skin == 0");
+    if (this->skin < 0.) {
+      throw std::runtime_error("The skin of the verlet list should be >= 0");
     }
   }
 
@@ -813,29 +871,25 @@ namespace rascal {
   template <class... Args>
   void
   AdaptorNeighbourList<ManagerImplementation>::update(Args &&... arguments) {
-    if (sizeof...(arguments) > 0) {
-      // TODO(felix) should not have to assume that the underlying manager is
-      // manager centers.
-      auto && atomic_structure{this->manager->get_atomic_structure()};
-      // if the structure has not changed by more than skin**2
-      if (not atomic_structure.is_similar(std::forward<Args>(arguments)...,
-                                          this->skin2)) {
-        this->need_update = true;
-      } else {
-        this->need_update = false;
-      }
-    }
     this->manager->update(std::forward<Args>(arguments)...);
   }
   /* ---------------------------------------------------------------------- */
   /**
    * build a neighbour list based on atomic positions, types and indices, in the
    * following the needed data structures are initialized, after construction,
-   * this function must be called to invoke the neighbour list algorithm
+   * this function must be called to invoke the neighbour list algorithm.
+   *
+   * The decision to rebuild is taken here rather than in update() so that it
+   * also applies when the update is triggered from the root of the stack.
+   * When the Verlet list can be reused only the ghost positions are refreshed,
+   * the lists of neighbours and the cluster indices are kept as they are.
    */
   template <class ManagerImplementation>
   void AdaptorNeighbourList<ManagerImplementation>::update_self() {
-    if (this->need_update) {
+    this->need_update = this->is_rebuild_needed();
+    if (not this->need_update) {
+      this->update_ghost_positions();
+    } else {
       // set the number of centers
       this->n_centers = this->manager->get_size();
       // this->n_atoms = this->manager->get_n_atoms();
@@ -853,6 +907,8 @@ namespace rascal {
       this->offsets.clear();
       this->ghost_positions.clear();
       this->ghost_types.clear();
+      this->ghost_source_atom_tags.clear();
+      this->ghost_shifts.clear();
       this->atom_index_from_atom_tag_list.clear();
       // actual call for building the neighbour list
       this->make_full_neighbour_list();
@@ -865,6 +921,9 @@ namespace rascal {
 
       atom_cluster_indices.fill_sequence();
       pair_cluster_indices.fill_sequence();
+      if (this->skin2 > 0.) {
+        this->structure_at_last_build = this->manager->get_atomic_structure();
+      }
       ++this->n_update;
     }
   }
@@ -893,6 +952,9 @@ namespace rascal {
    * the mesh are also binned.
    * Then each binned atoms is assigned its neighbor depending on the bin's
    * connectivity criteria (in 3d the 27 nearest bins).
+   *
+   * When a skin is used, \f$r_c\f$ is replaced by \f$r_c + skin\f$ in
+   * all of the above so that the list stays valid for small displacements.
    */
   template <class ManagerImplementation>
   void AdaptorNeighbourList<ManagerImplementation>::make_full_neighbour_list() {
@@ -901,7 +963,7 @@ namespace rascal {
     // short hands for parameters and inputs
     constexpr auto dim{traits::Dim};
     const auto & cell{this->manager->get_cell()};
-    const double & cutoff{this->cutoff};
+    const double cutoff{this->cutoff + this->skin};
 
     // minimum/maximum coordinate of mesh for neighbour list, it is larger by
     // one cell to be able to provide a neighbour list also over ghost atoms;
@@ -1031,6 +1093,7 @@ namespace rascal {
       auto atom_type = this->manager->get_atom_type(atom_tag);
       auto new_atom_tag{this->n_centers + this->n_ghosts};
       this->add_ghost_atom(new_atom_tag, pos, atom_type);
+      this->add_ghost_atom_source(atom_tag, Vector_t::Zero());
       size_t atom_index = this->manager->get_atom_index(atom_tag);
       this->atom_index_from_atom_tag_list.push_back(atom_index);
     }
@@ -1046,7 +1109,8 @@ namespace rascal {
         // exclude the original unit cell
         //! assumption: this assumes atoms were inside the cell initially
         if (not(p_image.array() == 0).all()) {
-          Vector_t pos_ghost{pos + cell * p_image.template cast<double>()};
+          Vector_t shift{cell * p_image.template cast<double>()};
+          Vector_t pos_ghost{pos + shift};
           auto flag_inside = internal::position_in_bounds(ghost_min, ghost_max,
                                                           pos_ghost, bound_tol);
 
@@ -1054,6 +1118,7 @@ namespace rascal {
             // next atom tag is size, since start is at index = 0
             auto new_atom_tag{this->n_centers + this->n_ghosts};
             this->add_ghost_atom(new_atom_tag, pos_ghost, atom_type);
+            this->add_ghost_atom_source(atom_tag, shift);
             // adds origin atom cluster_index if true
             // adds ghost atom cluster index if false
             size_t atom_index = this->manager->get_atom_index(atom_tag);
@@ -376,6 +376,13 @@ namespace rascal {
   }
 
   /* ---------------------------------------------------------------------- */
+  /**
+   * The pairs of the underlying manager are filtered with the current
+   * positions at every update. When the underlying neighbour list is a Verlet
+   * list that has been reused (the skin criterion was met) this is the only
+   * work left: the candidate pairs are a superset of the pairs within the
+   * cutoff so filtering them yields the same list as a full rebuild.
+   */
   template <class ManagerImplementation>
   void AdaptorStrict<ManagerImplementation>::update_self() {
     //! Reset cluster_indices for adaptor to fill with push back.
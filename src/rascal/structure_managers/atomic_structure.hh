@@ -331,7 +331,8 @@ namespace rascal {
      * Used for the verlet list
      *
      * @param threshold2 tolerance parameter squared for the similarity
-     *                    comparison
+     *                    comparison, i.e. the maximum squared displacement
+     *                    of any atom
      */
     bool is_similar(double threshold2) const {
       (void)threshold2;
@@ -353,7 +354,7 @@ namespace rascal {
             (this->center_atoms_mask != other.center_atoms_mask).any() or
             (this->atom_types.array() != other.atom_types.array()).any() or
             (this->positions - other.positions)
-                    .rowwise()
+                    .colwise()
                     .squaredNorm()
                     .maxCoeff() > threshold2) {
           is_similar_ = false;
@@ -383,7 +384,7 @@ namespace rascal {
             (this->cell.array() != cell.array()).any() or
             (this->center_atoms_mask != center_atoms_mask).any() or
             (this->atom_types.array() != atom_types.array()).any() or
-            (this->positions - positions).rowwise().squaredNorm().maxCoeff() >
+            (this->positions - positions).colwise().squaredNorm().maxCoeff() >
                 threshold2) {
           is_similar_ = false;
         }
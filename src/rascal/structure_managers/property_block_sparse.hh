@@ -38,9 +38,13 @@
 #include <iterator>
 #include <list>
 #include <map>
+#include <memory>
 #include <set>
+#include <stdexcept>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 namespace rascal {
   namespace internal {
@@ -135,6 +139,82 @@ namespace rascal {
       }
     };
 
+    /**
+     * Gives a small integer id to each distinct (sorted) key, in order of
+     * first appearance. The ids never change so the blocks associated with a
+     * key can be stored in a dense array indexed by id, see
+     * InternallySortedKeyMap, and the lookups in the hot loops become array
+     * accesses once the keys of interest have been translated to ids.
+     *
+     * Keys made of a single element in [0, MaxChemElements), i.e. the atomic
+     * species, are found without hashing.
+     */
+    template <class KeyType>
+    class KeyInterner {
+     public:
+      using Key_t = KeyType;
+      using Value_t = typename Key_t::value_type;
+      using SortedKey_t = SortedKey<Key_t>;
+
+      KeyInterner() : ids_by_element(MaxChemElements, -1) {}
+
+      //! id of the key, registered if it is new
+      int get_id(const SortedKey_t & skey) {
+        return this->get_id(skey.get_key());
+      }
+
+      //! id of the already sorted key, registered if it is new
+      int get_id(const Key_t & key) {
+        int id{this->find_id(key)};
+        if (id < 0) {
+          id = static_cast<int>(this->keys.size());
+          this->keys.push_back(key);
+          if (is_element(key)) {
+            this->ids_by_element[key[0]] = id;
+          } else {
+            this->ids.emplace(key, id);
+          }
+        }
+        return id;
+      }
+
+      //! id of the key or -1 if it has not been registered
+      int find_id(const SortedKey_t & skey) const {
+        return this->find_id(skey.get_key());
+      }
+
+      //! id of the already sorted key or -1 if it has not been registered
+      int find_id(const Key_t & key) const {
+        if (is_element(key)) {
+          return this->ids_by_element[key[0]];
+        }
+        auto it{this->ids.find(key)};
+        return it == this->ids.end() ? -1 : it->second;
+      }
+
+      //! id of the key {element} or -1 if it has not been registered
+      int find_id_by_element(const Value_t & element) const {
+        if (element >= 0 and element < MaxChemElements) {
+          return this->ids_by_element[element];
+        }
+        return this->find_id(Key_t{element});
+      }
+
+      const Key_t & get_key(int id) const { return this->keys[id]; }
+
+      //! number of registered keys
+      size_t size() const { return this->keys.size(); }
+
+     protected:
+      static bool is_element(const Key_t & key) {
+        return key.size() == 1 and key[0] >= 0 and key[0] < MaxChemElements;
+      }
+
+      std::unordered_map<Key_t, int, Hash<Key_t>> ids{};
+      std::vector<int> ids_by_element;
+      std::vector<Key_t> keys{};
+    };
+
     template <class K, class V>
     class InternallySortedKeyMap {
      public:
@@ -143,15 +223,22 @@ namespace rascal {
       using Precision_t = typename V::value_type;
       using Array_t = Eigen::Array<Precision_t, Eigen::Dynamic, 1>;
       using Vector_t = Eigen::Matrix<Precision_t, Eigen::Dynamic, 1>;
+      using RowVector_t = Eigen::Matrix<Precision_t, 1, Eigen::Dynamic>;
       using VectorMap_Ref_t = typename Eigen::Map<Vector_t>;
       using VectorMapConst_Ref_t = typename Eigen::Map<const Vector_t>;
       using ArrayMap_Ref_t = typename Eigen::Map<Array_t>;
       using Array_Ref_t = typename Eigen::Ref<Array_t>;
       using Self_t = InternallySortedKeyMap<K, V>;
+      using Position_t = std::tuple<int, int, int>;
+      using KeyInterner_t = KeyInterner<K>;
       //! ref to the main data.
       Array_t & data;
       //! map the keys to positions in data
       Map_t map{};
+      //! ids of the keys, usually shared by all the entries of a property
+      std::shared_ptr<KeyInterner_t> interner;
+      //! positions in data indexed by key id, the missing keys have offset -1
+      std::vector<Position_t> positions{};
       //! start of the chunck in data relevant to the object
       size_t global_offset;
       //! size of the chunck in data relevant to the object
@@ -248,9 +335,12 @@ namespace rascal {
       }
 
       //! Default constructor
-      explicit InternallySortedKeyMap(Array_t & data,
-                                      const size_t & global_offset = 0)
-          : data{data}, global_offset{global_offset} {};
+      explicit InternallySortedKeyMap(
+          Array_t & data, const size_t & global_offset = 0,
+          std::shared_ptr<KeyInterner_t> interner = nullptr)
+          : data{data}, interner{interner ? interner
+                                          : std::make_shared<KeyInterner_t>()},
+            global_offset{global_offset} {};
 
       //! Copy constructor
       InternallySortedKeyMap(const InternallySortedKeyMap & other) = default;
@@ -265,6 +355,8 @@ namespace rascal {
       Self_t & operator=(const Self_t & other) {
         this->data = other.data;
         this->map = other.map;
+        this->interner = other.interner;
+        this->positions = other.positions;
         this->global_offset = other.global_offset;
         this->total_length = other.total_length;
         this->normalized = other.normalized;
@@ -275,6 +367,8 @@ namespace rascal {
       Self_t & operator=(Self_t && other) {
         this->data = std::move(other.data);
         this->map = std::move(other.map);
+        this->interner = std::move(other.interner);
+        this->positions = std::move(other.positions);
         this->global_offset = std::move(other.global_offset);
         this->total_length = std::move(other.total_length);
         this->normalized = std::move(other.normalized);
@@ -310,39 +404,65 @@ namespace rascal {
        * Same as above but does not try to sort since we know it already is.
        */
       reference at(const SortedKey_t & skey) {
-        auto & pos{this->map.at(skey.get_key())};
+        auto & pos{this->get_position(skey)};
         return reference(&this->data[std::get<0>(pos)], std::get<1>(pos),
                          std::get<2>(pos));
       }
 
       const_reference at(const SortedKey_t & skey) const {
-        auto & pos{this->map.at(skey.get_key())};
+        auto & pos{this->get_position(skey)};
         return const_reference(&this->data[std::get<0>(pos)], std::get<1>(pos),
                                std::get<2>(pos));
       }
       //! access or insert specified element
       reference operator[](const SortedKey_t & skey) {
-        auto & pos{this->map[skey.get_key()]};
+        auto & pos{this->get_or_insert_position(skey)};
         assert(std::get<1>(pos) * std::get<2>(pos) > 0);
         return reference(&this->data[std::get<0>(pos)], std::get<1>(pos),
                          std::get<2>(pos));
       }
       const_reference operator[](const SortedKey_t & skey) const {
-        auto & pos{this->map.at(skey.get_key())};
+        auto & pos{this->get_position(skey)};
         assert(std::get<1>(pos) * std::get<2>(pos) > 0);
         return const_reference(&this->data[std::get<0>(pos)], std::get<1>(pos),
                                std::get<2>(pos));
       }
 
-      Eigen::Map<const math::Vector_t> flat(const key_type & key) {
+      /**
+       * Access the block of the key with id key_id (see KeyInterner), which
+       * is expected to be present. This is the fast path to be used in the
+       * hot loops.
+       */
+      reference block_by_id(int key_id) {
+        auto & pos{this->positions[key_id]};
+        assert(this->has_key_id(key_id));
+        return reference(&this->data[std::get<0>(pos)], std::get<1>(pos),
+                         std::get<2>(pos));
+      }
+
+      const_reference block_by_id(int key_id) const {
+        auto & pos{this->positions[key_id]};
+        assert(this->has_key_id(key_id));
+        return const_reference(&this->data[std::get<0>(pos)], std::get<1>(pos),
+                               std::get<2>(pos));
+      }
+
+      //! tells if the key with id key_id has a block
+      bool has_key_id(int key_id) const {
+        return key_id >= 0 and
+               key_id < static_cast<int>(this->positions.size()) and
+               std::get<0>(this->positions[key_id]) >= 0;
+      }
+
+      Eigen::Map<const RowVector_t> flat(const key_type & key) {
         SortedKey_t skey{key};
         return this->flat(skey);
       }
 
-      Eigen::Map<const math::Vector_t> flat(const SortedKey_t & skey) {
-        auto & pos{this->map[skey.get_key()]};
+      Eigen::Map<const RowVector_t> flat(const SortedKey_t & skey) {
+        auto & pos{this->get_or_insert_position(skey)};
         assert(std::get<1>(pos) * std::get<2>(pos) > 0);
-        return Eigen::Map<const math::Vector_t>(
+        return Eigen::Map<const RowVector_t>(
             &this->data[std::get<0>(pos)], std::get<1>(pos) * std::get<2>(pos));
       }
 
@@ -352,8 +472,12 @@ namespace rascal {
       }
 
       int get_location_by_key(const SortedKey_t & skey) const {
-        const auto & pos{this->map.at(skey.get_key())};
-        return std::get<0>(pos);
+        return std::get<0>(this->get_position(skey));
+      }
+
+      int get_location_by_id(int key_id) const {
+        assert(this->has_key_id(key_id));
+        return std::get<0>(this->positions[key_id]);
       }
       /**
        * Resize the view of the data to the proper size using the keys, and
@@ -389,8 +513,8 @@ namespace rascal {
         size_t current_position{global_offset};
         size_t block_size{static_cast<size_t>(n_row * n_col)};
         for (auto && skey : skeys) {
-          auto && key{skey.get_key()};
-          this->map[key] = std::make_tuple(current_position, n_row, n_col);
+          this->set_position(skey,
+                             std::make_tuple(current_position, n_row, n_col));
           current_position += block_size;
         }
         this->total_length = current_position - global_offset;
@@ -416,11 +540,14 @@ namespace rascal {
       }
 
       size_t count(const SortedKey_t & skey) const {
-        return this->map.count(skey.get_key());
+        return this->has_key_id(this->interner->find_id(skey)) ? 1 : 0;
       }
 
       //! clear the map but does not change the underlying data
-      void clear() noexcept { this->map.clear(); }
+      void clear() noexcept {
+        this->map.clear();
+        this->positions.clear();
+      }
 
       VectorMap_Ref_t get_full_vector() {
         return VectorMap_Ref_t(&this->data[this->global_offset],
@@ -445,9 +572,22 @@ namespace rascal {
         return keys;
       }
 
+      /**
+       * returns the ids of the valid keys of the map, in the same order as
+       * get_keys()
+       */
+      std::vector<int> get_key_ids() const {
+        std::vector<int> key_ids{};
+        key_ids.reserve(this->map.size());
+        for (const auto & el : this->map) {
+          key_ids.push_back(this->interner->find_id(el.first));
+        }
+        return key_ids;
+      }
+
       void multiply_elements_by(double fac) {
         auto block{this->get_full_vector()};
-        block *= fac;
+        block *= static_cast<Precision_t>(fac);
       }
 
       /**
@@ -470,7 +610,7 @@ namespace rascal {
         double norm{this->norm()};
         auto block{this->get_full_vector()};
         if (std::abs(norm) > 0.) {
-          block /= norm;
+          block /= static_cast<Precision_t>(norm);
         }
         return norm;
       }
@@ -488,7 +628,7 @@ namespace rascal {
           if (pair_type[0] != pair_type[1]) {
             auto block{reference(&this->data[std::get<0>(pos)],
                                  std::get<1>(pos), std::get<2>(pos))};
-            block *= fac;
+            block *= static_cast<Precision_t>(fac);
           }
         }
       }
@@ -567,6 +707,35 @@ namespace rascal {
       }
 
      private:
+      //! position of the block of skey, throws std::out_of_range if missing
+      const Position_t & get_position(const SortedKey_t & skey) const {
+        int key_id{this->interner->find_id(skey)};
+        if (not this->has_key_id(key_id)) {
+          throw std::out_of_range("InternallySortedKeyMap: unknown key");
+        }
+        return this->positions[key_id];
+      }
+
+      //! position of the block of skey, an empty block is added if missing
+      Position_t & get_or_insert_position(const SortedKey_t & skey) {
+        int key_id{this->interner->find_id(skey)};
+        if (not this->has_key_id(key_id)) {
+          key_id = this->set_position(skey, std::make_tuple(0, 0, 0));
+        }
+        return this->positions[key_id];
+      }
+
+      //! register the block of skey in map and positions
+      int set_position(const SortedKey_t & skey, const Position_t & pos) {
+        this->map[skey.get_key()] = pos;
+        const int key_id{this->interner->get_id(skey)};
+        if (key_id >= static_cast<int>(this->positions.size())) {
+          this->positions.resize(key_id + 1, std::make_tuple(-1, 0, 0));
+        }
+        this->positions[key_id] = pos;
+        return key_id;
+      }
+
       /**
        * Functor to get a key from a map
        */
@@ -582,6 +751,10 @@ namespace rascal {
   /* ---------------------------------------------------------------------- */
   /**
    * Typed ``property`` class definition, inherits from the base property class
+   *
+   * The blocks are stored with Precision_t, e.g. float to halve the memory
+   * footprint of large features, while the dense matrices built from them
+   * (get_features, dot, ...) are always in double precision.
    */
   template <typename Precision_t, size_t Order_, class Manager, typename Key>
   class BlockSparseProperty : public PropertyBase {
@@ -591,16 +764,25 @@ namespace rascal {
     using Self_t = BlockSparseProperty<Precision_t, Order_, Manager, Key>;
     using traits = typename Manager::traits;
 
+    //! same property with blocks stored with another precision
+    template <typename OtherPrecision_t>
+    using WithPrecision_t =
+        BlockSparseProperty<OtherPrecision_t, Order_, Manager, Key>;
+
     using Matrix_t = math::Matrix_t;
-    using MatrixMap_Ref_t = Eigen::Map<Matrix_t>;
-    using MatrixMapConst_Ref_t = const Eigen::Map<const Matrix_t>;
-    using MatrixRefConst_t = const Eigen::Ref<const Matrix_t>;
+    //! storage of the blocks
+    using Block_t = Eigen::Matrix<Precision_t, Eigen::Dynamic, Eigen::Dynamic,
+                                  Eigen::RowMajor>;
+    using MatrixMap_Ref_t = Eigen::Map<Block_t>;
+    using MatrixMapConst_Ref_t = const Eigen::Map<const Block_t>;
+    using MatrixRefConst_t = const Eigen::Ref<const Block_t>;
     using Key_t = Key;
     using Keys_t = std::set<Key_t>;
     using SortedKey_t = internal::SortedKey<Key_t>;
-    using InputData_t = internal::InternallySortedKeyMap<Key_t, Matrix_t>;
+    using InputData_t = internal::InternallySortedKeyMap<Key_t, Block_t>;
     using Data_t = Eigen::Array<Precision_t, Eigen::Dynamic, 1>;
     using Maps_t = std::vector<InputData_t>;
+    using KeyInterner_t = internal::KeyInterner<Key_t>;
     // using Data_t = std::vector<InputData_t>;
 
     constexpr static size_t Order{Order_};
@@ -609,6 +791,9 @@ namespace rascal {
    protected:
     Data_t values{};
     Maps_t maps{};
+    //! ids of the keys used by all the entries
+    std::shared_ptr<KeyInterner_t> key_interner{
+        std::make_shared<KeyInterner_t>()};
     std::string type_id;
     /**
      * boolean deciding on including the ghost atoms in the sizing of the
@@ -682,13 +867,14 @@ namespace rascal {
     template <size_t Order__ = Order, std::enable_if_t<(Order__ > 1), int> = 0>
     void resize() {
       size_t new_size{this->base_manager.nb_clusters(Order)};
-      this->maps.resize(new_size, std::move(InputData_t(this->values)));
+      this->maps.resize(new_size,
+                        InputData_t(this->values, 0, this->key_interner));
     }
 
     //! Adjust size of maps to match the number of entries of the manager
     template <size_t Order__ = Order, std::enable_if_t<(Order__ == 0), int> = 0>
     void resize() {
-      this->maps.resize(1, std::move(InputData_t(this->values)));
+      this->maps.resize(1, InputData_t(this->values, 0, this->key_interner));
     }
 
     //! Adjust size of maps to match the number of entries of the manager
@@ -697,7 +883,8 @@ namespace rascal {
       size_t new_size{this->exclude_ghosts
                           ? this->get_manager().size()
                           : this->get_manager().size_with_ghosts()};
-      this->maps.resize(new_size, std::move(InputData_t(this->values)));
+      this->maps.resize(new_size,
+                        InputData_t(this->values, 0, this->key_interner));
     }
 
     /**
@@ -766,6 +953,25 @@ namespace rascal {
       // check if the keys are the same across cluster entries
       this->check_for_uniform_keys();
     }
+
+    /**
+     * Make this property a copy of other, with the same entries, keys, key
+     * ids and layout, converting the values to Precision_t.
+     */
+    template <typename OtherPrecision_t>
+    void copy_from(const WithPrecision_t<OtherPrecision_t> & other) {
+      this->set_shape(other.get_nb_row(), other.get_nb_col());
+      this->set_key_interner(other.get_key_interner());
+      std::vector<Keys_t> keys_list{};
+      keys_list.reserve(other.size());
+      for (size_t i_entry{0}; i_entry < other.size(); ++i_entry) {
+        const auto keys{other[i_entry].get_keys()};
+        keys_list.emplace_back(keys.begin(), keys.end());
+      }
+      this->resize(keys_list);
+      this->values = other.get_raw_data().template cast<Precision_t>();
+    }
+
     /**
      * check that all element in maps have the same set of keys
      */
@@ -785,6 +991,47 @@ namespace rascal {
 
     void setZero() { this->values = 0.; }
 
+    /**
+     * Use the key ids of another property, e.g. so that the ids of the
+     * species are the same for a representation and its gradients. The
+     * entries are cleared so it should be called before resize().
+     */
+    void set_key_interner(std::shared_ptr<KeyInterner_t> interner) {
+      this->key_interner = std::move(interner);
+      this->clear();
+    }
+
+    std::shared_ptr<KeyInterner_t> get_key_interner() const {
+      return this->key_interner;
+    }
+
+    //! id of the key (registered if it is new) to use with block_by_id
+    int get_key_id(const Key_t & key) {
+      return this->key_interner->get_id(SortedKey_t{key});
+    }
+
+    int get_key_id(const SortedKey_t & skey) {
+      return this->key_interner->get_id(skey);
+    }
+
+    //! id of the key or -1 if no entry has it
+    int find_key_id(const SortedKey_t & skey) const {
+      return this->key_interner->find_id(skey);
+    }
+
+    //! id of the single element key {element} (e.g. an atomic species)
+    int find_key_id_by_element(int element) const {
+      return this->key_interner->find_id_by_element(element);
+    }
+
+    /**
+     * Contiguous storage of the blocks of all the entries. The position of a
+     * given block is given by InternallySortedKeyMap::get_location_by_key.
+     */
+    Data_t & get_raw_data() { return this->values; }
+
+    const Data_t & get_raw_data() const { return this->values; }
+
     size_t size() const { return this->maps.size(); }
 
     bool are_keys_uniform() const { return this->has_uniform_keys; }
@@ -960,8 +1207,9 @@ namespace rascal {
     void fill_dense_feature_matrix_gradient(Eigen::Ref<Matrix_t> features,
                                             const Keys_t & all_keys) const {
       static_assert(Order_ == 2, "Gradients are a property of order 2.");
-      using ConstMapSoapGradFlat_t = const Eigen::Map<
-          const Eigen::Matrix<double, ThreeD, Eigen::Dynamic, Eigen::RowMajor>>;
+      using SoapGradFlat_t = Eigen::Matrix<Precision_t, ThreeD, Eigen::Dynamic,
+                                           Eigen::RowMajor>;
+      using ConstMapSoapGradFlat_t = const Eigen::Map<const SoapGradFlat_t>;
       int inner_size{this->get_nb_comp() / ThreeD};
       int i_row_global{0};
       size_t n_pairs{this->maps.size()};
@@ -974,7 +1222,7 @@ namespace rascal {
             ConstMapSoapGradFlat_t neigh_key_val_flat(neigh_key_val.data(),
                                                       ThreeD, inner_size);
             features.block(i_row_global, i_feat, ThreeD, inner_size) =
-                neigh_key_val_flat;
+                neigh_key_val_flat.template cast<double>();
           }
           i_feat += inner_size;
         }  // keys
@@ -996,6 +1244,71 @@ namespace rascal {
       return features;
     }
 
+    /**
+     * Describe the dense feature matrix of fill_dense_feature_matrix
+     * (n_entries x inner_size n_keys) as a block sparse row (BSR) matrix with
+     * one block of get_nb_comp() values per entry and key that is actually
+     * present.
+     *
+     * The blocks of an entry are contiguous in the underlying storage, so the
+     * raw data (see get_raw_data) already is the array of the blocks and only
+     * the block structure is built here. Within an entry the blocks follow
+     * the storage order, which is not necessarily the order of all_keys.
+     *
+     * @param all_keys keys defining the block columns, it has to contain all
+     * the keys present in the property
+     * @param block_columns position in all_keys of the key of each block
+     * @param block_row_pointers index of the first block of each entry
+     * followed by the total number of blocks
+     */
+    void
+    get_block_sparse_structure(const Keys_t & all_keys,
+                               Eigen::VectorXi & block_columns,
+                               Eigen::VectorXi & block_row_pointers) const {
+      std::map<SortedKey_t, int, internal::CompareSortedKeyLess> key_columns{};
+      int i_key{0};
+      for (const auto & key : all_keys) {
+        key_columns.emplace(SortedKey_t{key}, i_key);
+        ++i_key;
+      }
+      const int block_size{this->get_nb_comp()};
+      const size_t n_entries{this->maps.size()};
+      block_row_pointers.resize(n_entries + 1);
+      int i_block{0};
+      for (size_t i_entry{0}; i_entry < n_entries; i_entry++) {
+        block_row_pointers(i_entry) = i_block;
+        i_block += static_cast<int>(this->maps[i_entry].size()) / block_size;
+      }
+      block_row_pointers(n_entries) = i_block;
+      block_columns.resize(i_block);
+      for (size_t i_entry{0}; i_entry < n_entries; i_entry++) {
+        const auto & entry_val = this->maps[i_entry];
+        for (const auto & key : entry_val.get_keys()) {
+          auto key_column = key_columns.find(SortedKey_t{key});
+          if (key_column == key_columns.end()) {
+            throw std::runtime_error(
+                "The key of a block is missing from all_keys.");
+          }
+          const int location{entry_val.get_location_by_key(key)};
+          block_columns(location / block_size) = key_column->second;
+        }
+      }
+    }
+
+    /**
+     * Describe the dense gradient matrix of fill_dense_feature_matrix_gradient
+     * (3 n_pairs x inner_size n_keys) as a block sparse row (BSR) matrix
+     * with blocks of 3 x inner_size, i.e. one block per pair and key that is
+     * actually present. See get_block_sparse_structure.
+     */
+    void get_block_sparse_gradient_structure(
+        const Keys_t & all_keys, Eigen::VectorXi & block_columns,
+        Eigen::VectorXi & block_row_pointers) const {
+      static_assert(Order_ == 2, "Gradients are a property of order 2.");
+      this->get_block_sparse_structure(all_keys, block_columns,
+                                       block_row_pointers);
+    }
+
     /**
      * @return set of unique keys at the level of the structure
      */
@@ -1098,7 +1411,7 @@ namespace rascal {
       if (do_direct_dot) {
         const auto blockA = this->get_raw_data_view();
         const auto blockB = B.get_raw_data_view();
-        mat.noalias() = blockA * blockB.transpose();
+        mat.noalias() = (blockA * blockB.transpose()).template cast<double>();
       } else if (do_block_by_key_dot) {
         mat.setZero();
         auto center_it = B.get_manager().get_iterator_at(0);
@@ -1112,9 +1425,10 @@ namespace rascal {
           SortedKey_t skey{key};
           auto mA_info = this->get_block_info_by_key(skey);
           auto mB_info = B.get_block_info_by_key(skey);
-          mat += matA.block(mA_info[0], mA_info[1], mA_info[2], mA_info[3]) *
-                 matB.block(mB_info[0], mB_info[1], mB_info[2], mB_info[3])
-                     .transpose();
+          mat += (matA.block(mA_info[0], mA_info[1], mA_info[2], mA_info[3]) *
+                  matB.block(mB_info[0], mB_info[1], mB_info[2], mB_info[3])
+                      .transpose())
+                     .template cast<double>();
         }
       } else {
         auto && manager_a{this->get_manager()};
@@ -404,6 +404,9 @@ namespace rascal {
      * @throw runtime_error if property with name does already exist
      * @return reference of to `UserProperty`
      *
+     * Like get_property(), it must not be called concurrently on the same
+     * manager stack.
+     *
      */
     template <typename UserProperty_t>
     UserProperty_t &
@@ -494,6 +497,12 @@ namespace rascal {
      * not compatible with the property with the given name.
      * @throw runtime_error If force_creation is false and property has not been
      * found in manager stack.
+     *
+     * Thread safety: the properties are held by each layer of the stack and
+     * the request only goes down the stack of this manager, so concurrent
+     * requests on managers that do not share layers (e.g. the structures of a
+     * ManagerCollection) are safe. Concurrent requests on the same stack are
+     * not, in particular when they might create the property.
      */
     template <typename UserProperty_t>
     std::shared_ptr<UserProperty_t>
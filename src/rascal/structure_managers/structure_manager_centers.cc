@@ -92,6 +92,30 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  void StructureManagerCenters::mark_changed_atoms(
+      const AtomicStructure<traits::Dim> & previous) {
+    ++this->n_update;
+    const auto & current{this->atoms_object};
+    const size_t n_atoms{current.get_number_of_atoms()};
+    const bool is_same_frame{
+        previous.positions.cols() == current.positions.cols() and
+        (previous.pbc.array() == current.pbc.array()).all() and
+        (previous.cell.array() == current.cell.array()).all() and
+        (previous.center_atoms_mask == current.center_atoms_mask).all() and
+        this->atom_update_indices.size() == n_atoms};
+    if (not is_same_frame) {
+      this->atom_update_indices.assign(n_atoms, this->n_update);
+      return;
+    }
+    for (size_t i_atom{0}; i_atom < n_atoms; ++i_atom) {
+      if ((previous.positions.col(i_atom) != current.positions.col(i_atom)) or
+          (previous.atom_types(i_atom) != current.atom_types(i_atom))) {
+        this->atom_update_indices[i_atom] = this->n_update;
+      }
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   // returns the number of cluster at Order=1, which is the number of atoms
   size_t StructureManagerCenters::get_nb_clusters(size_t order) const {
@@ -311,8 +311,23 @@ namespace rascal {
      */
     template <class... Args>
     void update_self(Args &&... arguments) {
+      AtomicStructure<traits::Dim> previous_structure{this->atoms_object};
       this->atoms_object.set_structure(std::forward<Args>(arguments)...);
       this->build();
+      this->mark_changed_atoms(previous_structure);
+    }
+
+    //! number of times the structure has been updated
+    size_t get_n_update() const { return this->n_update; }
+
+    /**
+     * For each atom (indexed like the positions, see get_atom_index()) the
+     * number of the update, see get_n_update(), at which it was last
+     * displaced or changed species. A change of the cell, of the periodicity,
+     * of the center mask or of the number of atoms marks all the atoms.
+     */
+    const std::vector<size_t> & get_atom_update_indices() const {
+      return this->atom_update_indices;
     }
 
     const AtomicStructure<traits::Dim> & get_atomic_structure() const {
@@ -324,6 +339,9 @@ namespace rascal {
    protected:
     //! makes atom tag lists and offsets
     void build();
+
+    //! count the update and record the atoms that differ from previous
+    void mark_changed_atoms(const AtomicStructure<traits::Dim> & previous);
     /**
      * Get a ptr of the previous manager, required for forwarding requests
      * downwards a stack. Since there is no last manager, the manager returns
@@ -380,6 +398,9 @@ namespace rascal {
     //! number of time the structure has been updated
     size_t n_update{0};
 
+    //! update at which each atom last changed, see get_atom_update_indices()
+    std::vector<size_t> atom_update_indices{};
+
     //! keep track of the masking of atoms
     bool are_any_centers_masked{false};
   };
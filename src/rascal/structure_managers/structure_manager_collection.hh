@@ -34,6 +34,7 @@
 #include "rascal/structure_managers/structure_manager.hh"
 #include "rascal/structure_managers/updateable_base.hh"
 #include "rascal/utils/json_io.hh"
+#include "rascal/utils/threading.hh"
 #include "rascal/utils/utils.hh"
 
 namespace rascal {
@@ -263,34 +264,27 @@ namespace rascal {
      * Note that start refers to 0 based indexing so 0 corresponds to the
      * first and 3 would corresponds to the 4th structure irrespective of the
      * actual indices in the file.
+     *
+     * Only the requested structures are parsed, see json_io::AseReader to
+     * go through a large file in chunks.
      */
     void add_structures(const std::string & filename, int start = 0,
                         int length = -1) {
-      // important not to do brace initialization because it adds an extra
-      // nesting layer
-      json structures = json_io::load(filename);
+      json_io::AseReader reader{filename};
+      this->add_structures(reader, start, length);
+    }
 
-      if (not structures.is_object()) {
-        throw std::runtime_error(
-            R"(The first level of the ase format is a dictionary with indices
-                as keys to the structures)");
+    /**
+     * load structures from a file opened with json_io::AseReader, which
+     * avoids indexing the file again when it is read in several steps
+     */
+    void add_structures(json_io::AseReader & reader, int start = 0,
+                        int length = -1) {
+      if (length == -1) {
+        length = static_cast<int>(reader.size()) - start;
       }
-
-      if (structures.count("ids") == 1) {
-        // structures is in the ase format
-        auto ids{structures["ids"].get<std::vector<int>>()};
-        std::sort(ids.begin(), ids.end());
-        ids.erase(ids.begin(), ids.begin() + start);
-        if (length == -1) {
-          length = ids.size();
-        }
-        ids.erase(ids.begin() + length, ids.end());
-
-        for (auto & idx : ids) {
-          this->add_structure(structures[std::to_string(idx)].get<Hypers_t>());
-        }
-      } else {
-        throw std::runtime_error("The json structure format is not recognized");
+      for (int index{start}; index < start + length; ++index) {
+        this->add_structure(reader.read(index));
       }
     }
 
@@ -339,6 +333,59 @@ namespace rascal {
       return features;
     }
 
+    /**
+     * Fill a preallocated dense feature matrix with the BlockSparseProperty
+     * built with calculator in the elements of the manager collection, e.g.
+     * a buffer owned by the caller, so that no temporary matrix is needed.
+     *
+     * Each structure fills its own block of rows so the structures are
+     * split among n_threads threads (0 uses the default of the OpenMP
+     * runtime, see internal::get_n_threads).
+     *
+     * @param features matrix of size n_centers x (inner_size all_keys.size())
+     * @param all_keys set of all the keys defining the columns, the missing
+     * entries are filled with zeros
+     */
+    template <class Calculator, class Keys>
+    void fill_features(const Calculator & calculator,
+                       Eigen::Ref<Matrix_t> features, const Keys & all_keys,
+                       int n_threads = 1) {
+      using Prop_t = typename Calculator::template Property_t<Manager_t>;
+
+      auto property_name{this->get_calculator_name(calculator, false)};
+
+      // the properties are looked up serially, the threads only fill rows
+      std::vector<std::pair<const Prop_t *, int>> properties{};
+      int n_rows{0};
+      int inner_size{0};
+      for (auto & manager : this->managers) {
+        auto && property =
+            *manager->template get_property<Prop_t>(property_name);
+        properties.emplace_back(&property, n_rows);
+        n_rows += static_cast<int>(property.size());
+        inner_size = property.get_nb_comp();
+      }
+      const auto n_cols{static_cast<int>(all_keys.size()) * inner_size};
+      if (features.rows() != n_rows or features.cols() != n_cols) {
+        std::stringstream err_str{};
+        err_str << "The feature matrix has the shape [" << features.rows()
+                << ", " << features.cols() << "] instead of [" << n_rows
+                << ", " << n_cols << "].";
+        throw std::runtime_error(err_str.str());
+      }
+
+      internal::parallel_for_each(
+          properties, internal::get_n_threads(n_threads),
+          [&features, &all_keys, n_cols](
+              const std::pair<const Prop_t *, int> & property_row) {
+            const auto & property = *property_row.first;
+            auto features_manager{features.block(
+                property_row.second, 0, property.size(), n_cols)};
+            features_manager.setZero();
+            property.fill_dense_feature_matrix(features_manager, all_keys);
+          });
+    }
+
     /**
      * @param calculator a calculator
      * @param is_gradients wether to return the name associated with the
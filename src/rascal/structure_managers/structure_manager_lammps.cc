@@ -32,10 +32,10 @@
 namespace rascal {
 
   /* ---------------------------------------------------------------------- */
-  void StructureManagerLammps::update_self(int inum, int tot_num, int * ilist,
-                                           int * numneigh, int ** firstneigh,
-                                           double ** x, double ** f, int * type,
-                                           double * eatom, double ** vatom) {
+  template <AdaptorTraits::NeighbourListType NeighbourListType_>
+  void StructureManagerLammpsImpl<NeighbourListType_>::update_self(
+      int inum, int tot_num, int * ilist, int * numneigh, int ** firstneigh,
+      double ** x, double ** f, int * type, double * eatom, double ** vatom) {
     // setting the class variables
     this->inum = inum;
     this->tot_num = tot_num;
@@ -63,12 +63,14 @@ namespace rascal {
     // good enough, does ilist have huge gaps?
     // e.g. ilist = [1,5000], then the atom_index_from_atom_tag_list list will
     // have 5000 elements.
-    // Also the dummy 0 values which will could undefined behaviour instead
-    // necessary an error
+    // The atoms that are not in ilist, i.e. the ghosts, map onto their tag.
     this->make_atom_index_from_atom_tag_list();
 
     atom_cluster_indices.fill_sequence();
     pair_cluster_indices.fill_sequence();
+
+    ++this->n_update;
+    this->atom_update_indices.assign(this->tot_num, this->n_update);
   }
 
   /* ---------------------------------------------------------------------- */
@@ -76,7 +78,9 @@ namespace rascal {
    * Return the number of clusters of size cluster_size.  Can only handle
    * cluster_size 1 (atoms) and cluster_size 2 (pairs).
    */
-  size_t StructureManagerLammps::get_nb_clusters(int order) const {
+  template <AdaptorTraits::NeighbourListType NeighbourListType_>
+  size_t StructureManagerLammpsImpl<NeighbourListType_>::get_nb_clusters(
+      int order) const {
     switch (order) {
     case 1:
       return inum;
@@ -92,4 +96,9 @@ namespace rascal {
       throw std::runtime_error("Can only handle single atoms and pairs");
     }
   }
+
+  template class StructureManagerLammpsImpl<
+      AdaptorTraits::NeighbourListType::half>;
+  template class StructureManagerLammpsImpl<
+      AdaptorTraits::NeighbourListType::full>;
 }  // namespace rascal
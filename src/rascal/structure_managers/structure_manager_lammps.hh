@@ -34,7 +34,20 @@
 
 namespace rascal {
   //! forward declaration for traits
-  class StructureManagerLammps;
+  template <AdaptorTraits::NeighbourListType NeighbourListType_>
+  class StructureManagerLammpsImpl;
+
+  //! manager of a lammps half neighbour list
+  using StructureManagerLammps =
+      StructureManagerLammpsImpl<AdaptorTraits::NeighbourListType::half>;
+
+  /**
+   * manager of a lammps full neighbour list, i.e. the one requested by many
+   * body pair styles, in which the neighbours of the local atoms include
+   * all the ghost atoms within the cutoff
+   */
+  using StructureManagerLammpsFull =
+      StructureManagerLammpsImpl<AdaptorTraits::NeighbourListType::full>;
 
   /*
    * traits specialisation for Lammps manager The traits are used for vector
@@ -42,8 +55,9 @@ namespace rascal {
    * functionality the given StructureManager already contains to avoid
    * recomputation. See also the implementation of adaptors.
    */
-  template <>
-  struct StructureManager_traits<StructureManagerLammps> {
+  template <AdaptorTraits::NeighbourListType NeighbourListType_>
+  struct StructureManager_traits<
+      StructureManagerLammpsImpl<NeighbourListType_>> {
     constexpr static int Dim{3};
     constexpr static size_t MaxOrder{2};
     constexpr static AdaptorTraits::Strict Strict{AdaptorTraits::Strict::no};
@@ -53,45 +67,58 @@ namespace rascal {
     constexpr static int StackLevel{0};
     using LayerByOrder = std::index_sequence<0, 0>;
     constexpr static AdaptorTraits::NeighbourListType NeighbourListType{
-        AdaptorTraits::NeighbourListType::half};
-    using PreviousManager_t = StructureManagerLammps;
+        NeighbourListType_};
+    using PreviousManager_t = StructureManagerLammpsImpl<NeighbourListType_>;
   };
 
   /* ---------------------------------------------------------------------- */
-  //! Definition of the new StructureManagerLammps class.
-  class StructureManagerLammps
-      : public StructureManager<StructureManagerLammps>,
-        public std::enable_shared_from_this<StructureManagerLammps> {
+  /**
+   * Definition of the new StructureManagerLammps class.
+   *
+   * The atoms that are not in ilist, i.e. the ghost atoms of lammps, are
+   * stored in x and type at the index given by their atom tag.
+   */
+  template <AdaptorTraits::NeighbourListType NeighbourListType_>
+  class StructureManagerLammpsImpl
+      : public StructureManager<StructureManagerLammpsImpl<NeighbourListType_>>,
+        public std::enable_shared_from_this<
+            StructureManagerLammpsImpl<NeighbourListType_>> {
    public:
-    using traits = StructureManager_traits<StructureManagerLammps>;
+    using traits =
+        StructureManager_traits<StructureManagerLammpsImpl<NeighbourListType_>>;
     using PreviousManager_t = typename traits::PreviousManager_t;
-    using Parent = StructureManager<StructureManagerLammps>;
+    using Parent =
+        StructureManager<StructureManagerLammpsImpl<NeighbourListType_>>;
     using Vector_ref = typename Parent::Vector_ref;
     using AtomRef_t = typename Parent::AtomRef;
-    using ManagerImplementation_t = StructureManagerLammps;
-    using ImplementationPtr_t = std::shared_ptr<StructureManagerLammps>;
+    using ManagerImplementation_t =
+        StructureManagerLammpsImpl<NeighbourListType_>;
+    using ImplementationPtr_t = std::shared_ptr<ManagerImplementation_t>;
     using ConstImplementationPtr_t =
-        const std::shared_ptr<const StructureManagerLammps>;
+        const std::shared_ptr<const ManagerImplementation_t>;
+    using Cell_t = Eigen::Vector3d;
+    using PBC_t = Eigen::Matrix<int, 3, 1>;
 
     //! Default constructor
-    StructureManagerLammps() = default;
+    StructureManagerLammpsImpl() = default;
 
     //! Copy constructor
-    StructureManagerLammps(const StructureManagerLammps & other) = delete;
+    StructureManagerLammpsImpl(const StructureManagerLammpsImpl & other) =
+        delete;
 
     //! Move constructor
-    StructureManagerLammps(StructureManagerLammps && other) = delete;
+    StructureManagerLammpsImpl(StructureManagerLammpsImpl && other) = delete;
 
     //! Destructor
-    virtual ~StructureManagerLammps() = default;
+    virtual ~StructureManagerLammpsImpl() = default;
 
     //! Copy assignment operator
-    StructureManagerLammps &
-    operator=(const StructureManagerLammps & other) = delete;
+    StructureManagerLammpsImpl &
+    operator=(const StructureManagerLammpsImpl & other) = delete;
 
     //! Move assignment operator
-    StructureManagerLammps &
-    operator=(StructureManagerLammps && other) = delete;
+    StructureManagerLammpsImpl &
+    operator=(StructureManagerLammpsImpl && other) = delete;
 
     //! Updates the manager using the impl
     template <class... Args>
@@ -124,6 +151,15 @@ namespace rascal {
       return this->type[this->get_atom_index(atom_tag)];
     }
 
+    /**
+     * The periodic images are explicit ghost atoms so the structure is seen
+     * as non periodic and the cell has no extent.
+     */
+    Cell_t get_cell_length() const { return Cell_t::Zero(); }
+
+    //! no periodic boundary conditions, see get_cell_length()
+    PBC_t get_periodic_boundary_conditions() const { return PBC_t::Zero(); }
+
     //! return number of I atoms in the list
     size_t get_size() const { return this->inum; }
 
@@ -153,10 +189,14 @@ namespace rascal {
     /**
      * return the atom_tag of the index-th atom in manager parent here is
      * dummy and is used for consistency in other words, atom_tag is the
-     * global LAMMPS atom tag.
+     * global LAMMPS atom tag. The ghost atoms follow the atoms of ilist and
+     * their tag is their index in x.
      */
     int get_neighbour_atom_tag(const Parent &, size_t cluster_index) const {
-      return this->ilist[cluster_index];
+      if (cluster_index < static_cast<size_t>(this->inum)) {
+        return this->ilist[cluster_index];
+      }
+      return static_cast<int>(cluster_index);
     }
 
     // #BUG8486@(all) I do not know how the structure of ilist is implemented,
@@ -165,7 +205,7 @@ namespace rascal {
     // firstneigh also uses this kind of access structure and is given by
     // lammps, so it should be fine.
     int get_atom_index(int atom_tag) const {
-      return this->atom_index_from_atom_tag_list[atom_tag];
+      return static_cast<int>(this->atom_index_from_atom_tag_list[atom_tag]);
     }
 
     /**
@@ -181,7 +221,8 @@ namespace rascal {
      */
     size_t get_nb_clusters(int order) const;
 
-    bool is_not_masked() const { return false; }
+    //! all the atoms of ilist are centers and the ghost atoms are not
+    bool is_not_masked() const { return true; }
 
     //! overload of update that does not change the underlying structure
     void update_self() {}
@@ -218,6 +259,18 @@ namespace rascal {
                      int ** firstneigh, double ** x, double ** f, int * type,
                      double * eatom, double ** vatom);
 
+    //! number of times the structure has been updated
+    size_t get_n_update() const { return this->n_update; }
+
+    /**
+     * For each atom the number of the update at which it last changed. The
+     * positions are owned by lammps so the changes can't be tracked and every
+     * update marks all the atoms.
+     */
+    const std::vector<size_t> & get_atom_update_indices() const {
+      return this->atom_update_indices;
+    }
+
    protected:
     /**
      * Get a ptr of the previous manager, required for forwarding requests
@@ -225,12 +278,12 @@ namespace rascal {
      * itself.
      */
     ImplementationPtr_t get_previous_manager_impl() {
-      return shared_from_this();
+      return this->shared_from_this();
     }
 
     //! Get the manager used to build the instance
     ConstImplementationPtr_t get_previous_manager_impl() const {
-      return shared_from_this();
+      return this->shared_from_this();
     }
 
     int inum{};           //!< total numer of atoms
@@ -249,18 +302,25 @@ namespace rascal {
     // the inverse mapping from the ilist
     std::vector<size_t> atom_index_from_atom_tag_list{};
 
+    //! number of time the structure has been updated
+    size_t n_update{0};
+
+    //! update at which each atom last changed, see get_atom_update_indices()
+    std::vector<size_t> atom_update_indices{};
+
    private:
     void make_atom_index_from_atom_tag_list() {
-      int max_atomic_index = 0;
+      // the ghost atoms have tags up to tot_num
+      int max_atomic_index = this->tot_num - 1;
       for (int i{0}; i < this->inum; ++i) {
         if (this->ilist[i] > max_atomic_index) {
           max_atomic_index = this->ilist[i];
         }
       }
-      //! Filling dummy cluster index
+      //! Filling the atoms that are not in ilist, i.e. the ghost atoms
       this->atom_index_from_atom_tag_list.reserve(max_atomic_index + 1);
       for (int i{0}; i < max_atomic_index + 1; ++i) {
-        this->atom_index_from_atom_tag_list.push_back(0);
+        this->atom_index_from_atom_tag_list.push_back(i);
       }
       //! Replacing dummy values with correct cluster index
       for (int i{0}; i < this->inum; ++i) {
@@ -276,8 +336,9 @@ namespace rascal {
    * provided an atom, returns the cumulative numbers of pairs up to the first
    * pair in which the atom is the I atom this only works for atom
    */
+  template <AdaptorTraits::NeighbourListType NeighbourListType_>
   template <size_t Order>
-  size_t StructureManagerLammps::get_offset_impl(
+  size_t StructureManagerLammpsImpl<NeighbourListType_>::get_offset_impl(
       const std::array<size_t, Order> & counters) const {
     // The static assert with <= is necessary, because the template parameter
     // ``Order`` is one Order higher than the MaxOrder at the current level. The
@@ -26,6 +26,9 @@
 
 #include "rascal/utils/json_io.hh"
 
+#include <map>
+#include <sstream>
+
 namespace rascal {
   namespace json_io {
 
@@ -59,6 +62,195 @@ namespace rascal {
       return json::from_ubjson(internal::read_binary_file(filename));
     }
 
+    namespace {
+      /**
+       * SAX handler recording the position in the file of the values of the
+       * first level of a json dictionary and the content of its "ids" entry.
+       * The other values are only tokenized, no json object is built.
+       */
+      class AseIndexer {
+       public:
+        using number_integer_t = json::number_integer_t;
+        using number_unsigned_t = json::number_unsigned_t;
+        using number_float_t = json::number_float_t;
+        using string_t = json::string_t;
+
+        explicit AseIndexer(std::streambuf & buffer) : buffer{buffer} {}
+
+        bool null() { return true; }
+
+        bool boolean(bool /*val*/) { return true; }
+
+        bool number_integer(number_integer_t val) {
+          return this->id(static_cast<int>(val));
+        }
+
+        bool number_unsigned(number_unsigned_t val) {
+          return this->id(static_cast<int>(val));
+        }
+
+        bool number_float(number_float_t /*val*/, const string_t & /*s*/) {
+          return true;
+        }
+
+        bool string(string_t & /*val*/) { return true; }
+
+        bool start_object(std::size_t /*elements*/) {
+          if (this->depth == 0) {
+            this->is_object = true;
+          }
+          ++this->depth;
+          return true;
+        }
+
+        bool key(string_t & val) {
+          if (this->depth == 1) {
+            // the stream is positioned just after the key
+            this->offsets[val] = this->buffer.pubseekoff(0, std::ios_base::cur,
+                                                         std::ios_base::in);
+            this->in_ids = (val == "ids");
+          }
+          return true;
+        }
+
+        bool end_object() {
+          --this->depth;
+          return true;
+        }
+
+        bool start_array(std::size_t /*elements*/) {
+          ++this->depth;
+          return true;
+        }
+
+        bool end_array() {
+          --this->depth;
+          return true;
+        }
+
+        bool parse_error(std::size_t /*position*/,
+                         const std::string & /*last_token*/,
+                         const nlohmann::detail::exception & ex) {
+          throw std::runtime_error(ex.what());
+        }
+
+        std::streambuf & buffer;
+        size_t depth{0};
+        bool is_object{false};
+        bool in_ids{false};
+        std::map<std::string, std::streamoff> offsets{};
+        std::vector<int> ids{};
+
+       protected:
+        bool id(int val) {
+          if (this->depth == 2 and this->in_ids) {
+            this->ids.push_back(val);
+          }
+          return true;
+        }
+      };
+    }  // namespace
+
+    /* ---------------------------------------------------------------------- */
+    AseReader::AseReader(const std::string & filename)
+        : filename{filename},
+          is_binary{internal::get_filename_extension(filename) == "ubjson"} {
+      auto extension{internal::get_filename_extension(filename)};
+      if (extension != "json" and extension != "ubjson") {
+        throw std::runtime_error(std::string("Don't know the extension of ") +
+                                 filename);
+      }
+      this->reader.open(filename, std::ios::in | std::ios::binary);
+      if (not this->reader.is_open()) {
+        throw std::runtime_error(std::string("Could not open the file: ") +
+                                 filename);
+      }
+
+      // the json input adapter reads the file one character at a time from
+      // the stream buffer so its position is the one of the parser
+      AseIndexer indexer{*this->reader.rdbuf()};
+      json::sax_parse(nlohmann::detail::input_adapter(this->reader), &indexer,
+                      this->is_binary ? json::input_format_t::ubjson
+                                      : json::input_format_t::json);
+
+      if (not indexer.is_object) {
+        throw std::runtime_error(
+            R"(The first level of the ase format is a dictionary with indices
+                as keys to the structures)");
+      }
+      if (indexer.offsets.count("ids") == 0) {
+        throw std::runtime_error("The json structure format is not recognized");
+      }
+
+      auto & ids{indexer.ids};
+      std::sort(ids.begin(), ids.end());
+      this->offsets.reserve(ids.size());
+      for (auto & idx : ids) {
+        auto offset{indexer.offsets.find(std::to_string(idx))};
+        if (offset == indexer.offsets.end()) {
+          std::stringstream error{};
+          error << "The structure with id " << idx << " is missing from "
+                << filename;
+          throw std::runtime_error(error.str());
+        }
+        this->offsets.push_back(offset->second);
+      }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    json AseReader::read(size_t index) {
+      if (index >= this->size()) {
+        std::stringstream error{};
+        error << "Structure index " << index << " is out of range, "
+              << this->filename << " has " << this->size() << " structures";
+        throw std::runtime_error(error.str());
+      }
+      this->reader.clear();
+      this->reader.seekg(this->offsets[index]);
+      json structure{};
+      if (this->is_binary) {
+        structure = json::from_ubjson(
+            nlohmann::detail::input_adapter(this->reader), false);
+      } else {
+        // the text format has a name separator between the key and the value
+        char separator{};
+        this->reader >> separator;
+        if (separator != ':') {
+          throw std::runtime_error(std::string("Could not read a structure "
+                                               "from the file: ") +
+                                   this->filename);
+        }
+        this->reader >> structure;
+      }
+      return structure;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    json AseReader::read(size_t start, int length) {
+      if (start > this->size()) {
+        std::stringstream error{};
+        error << "Structure index " << start << " is out of range, "
+              << this->filename << " has " << this->size() << " structures";
+        throw std::runtime_error(error.str());
+      }
+      if (length == -1) {
+        length = static_cast<int>(this->size() - start);
+      }
+      json structures = json::array();
+      for (size_t index{start}; index < start + length; ++index) {
+        structures.push_back(this->read(index));
+      }
+      return structures;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    AseReader::Chunks AseReader::chunks(size_t chunk_size) {
+      if (chunk_size == 0) {
+        throw std::runtime_error("The size of the chunks should be positive");
+      }
+      return Chunks{*this, chunk_size};
+    }
+
     /* ---------------------------------------------------------------------- */
     void to_json(json & j, AtomicJsonData & s) {
       j = json{{"cell", s.cell},
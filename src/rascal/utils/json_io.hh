@@ -46,7 +46,11 @@
 
 #include <Eigen/Dense>
 
+#include <algorithm>
 #include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
 
 // For convenience
 using json = nlohmann::json;
@@ -309,6 +313,122 @@ namespace rascal {
     //! load a json file in ubjson binary format
     json load_bin(const std::string & filename);
 
+    /**
+     * Reads the structures of a file in the ase json format, i.e. a
+     * dictionary with the ids of the structures as keys and an "ids" entry,
+     * without loading the whole file in memory.
+     *
+     * The constructor goes once through the file with the SAX interface of
+     * nlohmann::json to record where each structure starts, then only the
+     * requested structures are parsed. Compatible file formats are text and
+     * ubjson (binary).
+     *
+     * As in ManagerCollection::add_structures, the structures are indexed
+     * from 0 following the sorted ids of the file.
+     *
+     * Usage to process a large dataset in chunks of 100 structures:
+     *
+     *   json_io::AseReader reader{"dataset.ubjson"};
+     *   for (auto && structures : reader.chunks(100)) {
+     *     ManagerCollection_t collection{adaptors};
+     *     collection.add_structures(structures);
+     *     ...
+     *   }
+     */
+    class AseReader {
+     public:
+      class ChunkIterator;
+      class Chunks;
+
+      explicit AseReader(const std::string & filename);
+
+      //! number of structures in the file
+      size_t size() const { return this->offsets.size(); }
+
+      //! parse the structure at index
+      json read(size_t index);
+
+      /**
+       * parse length structures starting at index start into a json array,
+       * length = -1 corresponds to all the structures after start
+       */
+      json read(size_t start, int length);
+
+      /**
+       * range over the structures of the file in consecutive json arrays of
+       * chunk_size structures (the last one can be shorter)
+       */
+      Chunks chunks(size_t chunk_size);
+
+     protected:
+      std::string filename;
+      bool is_binary;
+      std::ifstream reader{};
+      //! position of the structures in the file following the sorted ids
+      std::vector<std::streamoff> offsets{};
+    };
+
+    /**
+     * Input iterator over the chunks of an AseReader, the structures of a
+     * chunk are parsed when the iterator is dereferenced.
+     */
+    class AseReader::ChunkIterator {
+     public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = json;
+      using difference_type = std::ptrdiff_t;
+      using pointer = json *;
+      using reference = json;
+
+      ChunkIterator(AseReader & reader, size_t chunk_size, size_t index)
+          : reader{reader}, chunk_size{chunk_size}, index{index} {}
+
+      json operator*() const {
+        auto length{std::min(this->chunk_size,
+                             this->reader.size() - this->index)};
+        return this->reader.read(this->index, static_cast<int>(length));
+      }
+
+      ChunkIterator & operator++() {
+        this->index = std::min(this->index + this->chunk_size,
+                               this->reader.size());
+        return *this;
+      }
+
+      bool operator==(const ChunkIterator & other) const {
+        return this->index == other.index;
+      }
+
+      bool operator!=(const ChunkIterator & other) const {
+        return not(*this == other);
+      }
+
+     protected:
+      AseReader & reader;
+      size_t chunk_size;
+      //! index of the first structure of the chunk
+      size_t index;
+    };
+
+    class AseReader::Chunks {
+     public:
+      Chunks(AseReader & reader, size_t chunk_size)
+          : reader{reader}, chunk_size{chunk_size} {}
+
+      ChunkIterator begin() {
+        return ChunkIterator{this->reader, this->chunk_size, 0};
+      }
+
+      ChunkIterator end() {
+        return ChunkIterator{this->reader, this->chunk_size,
+                             this->reader.size()};
+      }
+
+     protected:
+      AseReader & reader;
+      size_t chunk_size;
+    };
+
     /**
      * Object to deserialize the content of a JSON file containing Atomic
      * Simulation Environment (ASE) type atomic structures, the nlohmann::json
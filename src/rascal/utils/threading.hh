@@ -0,0 +1,132 @@
+/**
+ * @file   rascal/utils/threading.hh
+ *
+ * @author agent <agent@local>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  thin wrappers around the OpenMP runtime so that the library also
+ *         compiles (and runs serially) without OpenMP support
+ *
+ * Copyright  2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef SRC_RASCAL_UTILS_THREADING_HH_
+#define SRC_RASCAL_UTILS_THREADING_HH_
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace rascal {
+  namespace internal {
+
+    //! tells if the library has been compiled with OpenMP support
+    constexpr bool has_openmp() {
+#ifdef _OPENMP
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    //! maximum number of threads a parallel region would use by default
+    inline int get_max_threads() {
+#ifdef _OPENMP
+      return omp_get_max_threads();
+#else
+      return 1;
+#endif
+    }
+
+    //! index of the calling thread in the current team (0 outside of one)
+    inline int get_thread_num() {
+#ifdef _OPENMP
+      return omp_get_thread_num();
+#else
+      return 0;
+#endif
+    }
+
+    //! tells if the caller is already inside an active parallel region
+    inline bool in_parallel() {
+#ifdef _OPENMP
+      return omp_in_parallel();
+#else
+      return false;
+#endif
+    }
+
+    /**
+     * Number of threads to actually use given the requested number.
+     * A request of 0 (or less) means to use the default of the OpenMP runtime
+     * and without OpenMP support everything runs on a single thread.
+     */
+    inline int get_n_threads(int n_threads_requested) {
+      if (not has_openmp()) {
+        return 1;
+      }
+      return n_threads_requested > 0 ? n_threads_requested : get_max_threads();
+    }
+
+    /**
+     * Call func on each element of items using n_threads threads.
+     *
+     * The elements are handed out one at a time to the next idle thread
+     * (dynamic scheduling) since the cost of each element, e.g. the size of a
+     * structure, can vary a lot. func must be safe to call concurrently on
+     * different elements. An exception thrown by func does not escape the
+     * parallel region, the first one is rethrown once all elements have been
+     * processed.
+     */
+    template <class Container, class Function>
+    void parallel_for_each(Container & items, int n_threads, Function && func) {
+      using Element_t = std::remove_reference_t<decltype(*std::begin(items))>;
+      std::vector<Element_t *> elements{};
+      for (auto & item : items) {
+        elements.push_back(std::addressof(item));
+      }
+      const int n_elements{static_cast<int>(elements.size())};
+      std::exception_ptr error{nullptr};
+#pragma omp parallel for schedule(dynamic) num_threads(n_threads)
+      for (int i_element = 0; i_element < n_elements; ++i_element) {
+        try {
+          func(*elements[i_element]);
+        } catch (...) {
+#pragma omp critical(rascal_parallel_for_each_error)
+          {
+            if (not error) {
+              error = std::current_exception();
+            }
+          }
+        }
+      }
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+
+  }  // namespace internal
+}  // namespace rascal
+
+#endif  // SRC_RASCAL_UTILS_THREADING_HH_
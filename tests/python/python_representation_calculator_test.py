@@ -1,4 +1,5 @@
 from rascal.representations import (
+    KspaceSphericalExpansion,
     SortedCoulombMatrix,
     SphericalExpansion,
     SphericalInvariants,
@@ -200,6 +201,53 @@ class TestSphericalExpansionRepresentation(unittest.TestCase):
             features_test = rep.transform(self.frames).get_features(rep)
 
 
+class TestKspaceSphericalExpansionRepresentation(unittest.TestCase):
+    def setUp(self):
+        """
+        builds the test case. The k-space spherical expansion only supports
+        periodic structures.
+        """
+        fns = [
+            os.path.join(inputs_path, "CaCrP2O7_mvc-11955_symmetrized.json"),
+            os.path.join(inputs_path, "SiC_moissanite_supercell.json"),
+        ]
+        self.frames = [load_json_frame(fn) for fn in fns]
+
+        self.hypers = {
+            "interaction_cutoff": 3.0,
+            "max_radial": 4,
+            "max_angular": 3,
+            "gaussian_sigma_type": "Constant",
+            "gaussian_sigma_constant": 0.5,
+        }
+
+    def test_representation_transform(self):
+        rep = KspaceSphericalExpansion(**self.hypers)
+
+        features = rep.transform(self.frames)
+
+        X = features.get_features(rep)
+        n_atoms = sum(len(frame["atom_types"]) for frame in self.frames)
+        self.assertEqual(X.shape[0], n_atoms)
+
+    def test_serialization(self):
+        rep = KspaceSphericalExpansion(k_cutoff=4.0, **self.hypers)
+
+        rep_dict = to_dict(rep)
+
+        rep_copy = from_dict(rep_dict)
+
+        rep_copy_dict = to_dict(rep_copy)
+
+        self.assertTrue(rep_dict == rep_copy_dict)
+
+    def test_pickle(self):
+        rep = KspaceSphericalExpansion(**self.hypers)
+        serialized = pickle.dumps(rep)
+        rep_ = pickle.loads(serialized)
+        self.assertTrue(to_dict(rep) == to_dict(rep_))
+
+
 class TestSphericalInvariantsRepresentation(unittest.TestCase):
     def setUp(self):
         """
@@ -258,6 +306,13 @@ class TestSphericalInvariantsRepresentation(unittest.TestCase):
         kk = dot(X_t, X_t)
         self.assertTrue(np.allclose(kk, kk_ref))
 
+        X_t = np.full_like(test, np.nan)
+        features.get_features(rep, out=X_t, n_threads=2)
+        self.assertTrue(np.allclose(X_t, test))
+
+        X_t = np.vstack([X.toarray() for X in features.get_features_views(rep)])
+        self.assertTrue(np.allclose(X_t, test))
+
     def test_representation_gradient(self):
         """
         Test the get_features and get_features_gradient functions by computing
@@ -306,6 +361,10 @@ class TestSphericalInvariantsRepresentation(unittest.TestCase):
         KNM_ref = kernel(features, X_pseudo, (True, False))
 
         X_der = features.get_features_gradient(rep).reshape((n_neigh, 3, n_feat))
+        X_der_sparse = features.get_features_gradient_sparse(rep)
+        self.assertTrue(
+            np.allclose(X_der_sparse.toarray().reshape((n_neigh, 3, n_feat)), X_der)
+        )
 
         KNM = np.zeros((n_atoms, 3, n_sparse))
         for ii, (i_frame, i, j, i_sp, j_sp) in enumerate(ij):
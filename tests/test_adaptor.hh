@@ -319,7 +319,7 @@ namespace rascal {
     const std::string filename{
         "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json"};
     const double cutoff{3.};
-    const std::vector<double> skins{0.};
+    const std::vector<double> skins{0., 0.2, 1.};
 
     json factory_args{};
   };
@@ -38,44 +38,138 @@ namespace rascal {
 
   BOOST_AUTO_TEST_SUITE(neighbour_list_adaptor_test);
 
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Displace the atoms of structure by disp, except the ones that would leave
+   * the unit cell, so that no wrapping is needed
+   */
+  void displace_atoms_inside_cell(AtomicStructure<3> & structure,
+                                  const Eigen::Vector3d & disp) {
+    Eigen::Matrix3d cell_inv{structure.cell.inverse()};
+    for (size_t i_atom{0}; i_atom < structure.get_number_of_atoms();
+         ++i_atom) {
+      Eigen::Vector3d scaled{cell_inv *
+                             (structure.positions.col(i_atom) + disp)};
+      if ((scaled.array() > 0.).all() and (scaled.array() < 1.).all()) {
+        structure.displace_position(i_atom, disp);
+      }
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   /**
    * Test that the verlet list allows to not recompute the linked cell
    * neighborlist when the structure has changed depending on the skin
-   * parameter
-   *
-   * Commented out because the feature does not work at the moment
+   * parameter. The list has to be rebuilt when an atom moved by more than
+   * skin / 2 since the last rebuild.
+   */
+  using verlet_list_fixtures = boost::mpl::list<
+      MultipleStructureFixture<MultipleStructureManagerNLRattleFixture>>;
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(verlet_list_test, Fix, verlet_list_fixtures,
+                                   Fix) {
+    auto & managers = Fix::managers;
+    auto managers_no_skin = managers[0];
+    auto managers_small_skin = managers[1];
+    auto managers_skin = managers[2];
+    auto & filename = Fix::filename;
+    AtomicStructure<3> structure{};
+    structure.set_structure(filename);
+
+    int n_update{3};
+
+    // displacement of sqrt(3) * 0.05 < 0.2 / 2
+    displace_atoms_inside_cell(structure, Eigen::Vector3d::Constant(0.05));
+    managers_no_skin->update(structure);
+    managers_small_skin->update(structure);
+    managers_skin->update(structure);
+
+    // displacement of sqrt(3) * 0.07 > 0.2 / 2
+    structure.set_structure(filename);
+    displace_atoms_inside_cell(structure, Eigen::Vector3d::Constant(0.07));
+    managers_small_skin->update(structure);
+    managers_no_skin->update(structure);
+    managers_skin->update(structure);
+
+    BOOST_CHECK_EQUAL(n_update, managers_no_skin->get_n_update());
+    BOOST_CHECK_EQUAL(n_update - 1, managers_small_skin->get_n_update());
+    BOOST_CHECK_EQUAL(1, managers_skin->get_n_update());
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test that a strict neighbour list built on top of a reused verlet list
+   * gives the same pairs and distances as the one built from scratch.
    */
-  // using verlet_list_fixtures = boost::mpl::list<
-  //     MultipleStructureFixture<MultipleStructureManagerNLRattleFixture>>;
-  // BOOST_FIXTURE_TEST_CASE_TEMPLATE(verlet_list_test, Fix,
-  // verlet_list_fixtures,
-  //                                  Fix) {
-  //   auto & managers = Fix::managers;
-  //   auto managers_no_skin = managers[0];
-  //   auto managers_small_skin = managers[1];
-  //   auto managers_skin = managers[2];
-  //   auto & filename = Fix::filename;
-  //   AtomicStructure<3> structure{};
-  //   structure.set_structure(filename);
-
-  //   int n_update{3};
-
-  //   structure.positions.array() += 0.05;
-  //   managers_no_skin->update(structure);
-  //   managers_small_skin->update(structure);
-  //   managers_skin->update(structure);
-
-  //   structure.set_structure(filename);
-  //   structure.positions.array() += 0.07;
-  //   managers_small_skin->update(structure);
-  //   managers_no_skin->update(structure);
-  //   managers_skin->update(structure);
-
-  //   BOOST_CHECK_EQUAL(n_update, managers_no_skin->get_n_update());
-  //   BOOST_CHECK_EQUAL(n_update - 1, managers_small_skin->get_n_update());
-  //   BOOST_CHECK_EQUAL(1, managers_skin->get_n_update());
-  // }
+  BOOST_AUTO_TEST_CASE(verlet_list_strict_test) {
+    const std::string filename{
+        "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json"};
+    const double cutoff{3.};
+    const std::vector<double> skins{0., 1.};
+    constexpr bool verbose{false};
+
+    using Manager_t =
+        AdaptorStrict<AdaptorNeighbourList<StructureManagerCenters>>;
+    std::vector<std::shared_ptr<Manager_t>> managers{};
+    for (auto && skin : skins) {
+      json structure{{"filename", filename}};
+      json adaptors;
+      json ad1{
+          {"name", "AdaptorNeighbourList"},
+          {"initialization_arguments", {{"cutoff", cutoff}, {"skin", skin}}}};
+      json ad2{{"name", "AdaptorStrict"},
+               {"initialization_arguments", {{"cutoff", cutoff}}}};
+      adaptors.push_back(ad1);
+      adaptors.push_back(ad2);
+      managers.push_back(
+          make_structure_manager_stack<StructureManagerCenters,
+                                       AdaptorNeighbourList, AdaptorStrict>(
+              structure, adaptors));
+    }
+
+    AtomicStructure<3> structure{};
+    structure.set_structure(filename);
+    for (int i_step{0}; i_step < 4; ++i_step) {
+      Eigen::Vector3d disp{0.04 * std::sin(i_step), 0.03 * std::cos(i_step),
+                           -0.02};
+      displace_atoms_inside_cell(structure, disp);
+      // list of (neighbour atom index, distance) for each center and manager
+      std::vector<std::vector<std::vector<std::pair<size_t, double>>>>
+          neighbours(managers.size());
+      for (size_t i_manager{0}; i_manager < managers.size(); ++i_manager) {
+        auto & manager = managers[i_manager];
+        manager->update(structure);
+        for (auto center : manager) {
+          neighbours[i_manager].emplace_back();
+          for (auto neigh : center.pairs()) {
+            neighbours[i_manager].back().emplace_back(
+                manager->get_atom_index(neigh.back()),
+                manager->get_distance(neigh));
+          }
+          std::sort(neighbours[i_manager].back().begin(),
+                    neighbours[i_manager].back().end());
+        }
+      }
+      auto && n_update_skin{
+          extract_underlying_manager<1>(managers[1])->get_n_update()};
+      if (verbose) {
+        std::cout << "step " << i_step << " n_update " << n_update_skin
+                  << std::endl;
+      }
+      // the skin is large enough to never need a rebuild
+      BOOST_CHECK_EQUAL(n_update_skin, 1);
+
+      BOOST_REQUIRE_EQUAL(neighbours[0].size(), neighbours[1].size());
+      for (size_t i_center{0}; i_center < neighbours[0].size(); ++i_center) {
+        auto & ref = neighbours[0][i_center];
+        auto & test = neighbours[1][i_center];
+        BOOST_REQUIRE_EQUAL(ref.size(), test.size());
+        for (size_t i_neigh{0}; i_neigh < ref.size(); ++i_neigh) {
+          BOOST_CHECK_EQUAL(ref[i_neigh].first, test[i_neigh].first);
+          BOOST_CHECK_CLOSE(ref[i_neigh].second, test[i_neigh].second, 1e-10);
+        }
+      }
+    }
+  }
 
   /* ---------------------------------------------------------------------- */
   /*
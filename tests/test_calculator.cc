@@ -32,6 +32,9 @@
 #include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <complex>
+#include <random>
+
 namespace rascal {
   /* ---------------------------------------------------------------------- */
   using multiple_fixtures =
@@ -493,6 +496,65 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that the GEMM and Loop products of the PowerSpectrum give the same
+   * representation and gradients on a multi-species structure.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(powerspectrum_product_test, Fix,
+                                   grad_sparse_fixtures, Fix) {
+    auto & managers = Fix::managers;
+    using Representation_t = typename Fix::Representation_t;
+    using Prop_t = typename Representation_t::template Property_t<
+        typename Fix::Manager_t>;
+    using PropGrad_t = typename Representation_t::template PropertyGradient_t<
+        typename Fix::Manager_t>;
+    auto & hypers = Fix::representation_hypers;
+
+    const double delta{1e-12};
+
+    for (auto & manager : managers) {
+      for (auto & hyper : hypers) {
+        json hyper_loop = hyper;
+        hyper_loop["powerspectrum_product"] = "Loop";
+        json hyper_gemm = hyper;
+        hyper_gemm["powerspectrum_product"] = "GEMM";
+        Representation_t representation_loop{hyper_loop};
+        Representation_t representation_gemm{hyper_gemm};
+        BOOST_TEST(representation_loop.get_name() !=
+                   representation_gemm.get_name());
+        representation_loop.compute(manager);
+        representation_gemm.compute(manager);
+
+        auto features_loop = manager
+                                 ->template get_property<Prop_t>(
+                                     representation_loop.get_name())
+                                 ->get_features();
+        auto features_gemm = manager
+                                 ->template get_property<Prop_t>(
+                                     representation_gemm.get_name())
+                                 ->get_features();
+        BOOST_REQUIRE_EQUAL(features_loop.rows(), features_gemm.rows());
+        BOOST_REQUIRE_EQUAL(features_loop.cols(), features_gemm.cols());
+        double diff{(features_loop - features_gemm).cwiseAbs().maxCoeff()};
+        BOOST_TEST(diff < delta);
+
+        auto gradients_loop = manager
+                                  ->template get_property<PropGrad_t>(
+                                      representation_loop.get_gradient_name())
+                                  ->get_features_gradient();
+        auto gradients_gemm = manager
+                                  ->template get_property<PropGrad_t>(
+                                      representation_gemm.get_gradient_name())
+                                  ->get_features_gradient();
+        BOOST_REQUIRE_EQUAL(gradients_loop.rows(), gradients_gemm.rows());
+        BOOST_REQUIRE_EQUAL(gradients_loop.cols(), gradients_gemm.cols());
+        double diff_gradients{
+            (gradients_loop - gradients_gemm).cwiseAbs().maxCoeff()};
+        BOOST_TEST(diff_gradients < delta);
+      }
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   /**
    * Test if the representation computed is equal to a reference from a file
@@ -598,15 +660,189 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that the radial integrals of a batch of neighbours, and their
+   * derivatives, match the ones computed one neighbour at a time
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(spherical_expansion_radial_batch, Fix,
+                                   fixtures_with_gradients, Fix) {
+    auto & managers = Fix::managers;
+    auto & hypers = Fix::representation_hypers;
+    using RadialIntegral_t = typename Fix::RadialIntegral_t;
+    using Matrix_t = typename RadialIntegral_t::Matrix_t;
+    const double delta{1e-14};
+
+    auto manager = managers.front();
+    for (auto & hyper : hypers) {
+      auto radial_integral{std::make_shared<RadialIntegral_t>(hyper)};
+      // RadialDimReduction is only defined for the species with projection
+      // matrices
+      auto && optimization_hypers{
+          hyper.at("radial_contribution").at("optimization")};
+      auto is_supported = [&optimization_hypers](int neighbour_type) {
+        return optimization_hypers.count("RadialDimReduction") == 0 or
+               optimization_hypers.at("RadialDimReduction")
+                       .at("projection_matrices")
+                       .count(std::to_string(neighbour_type)) > 0;
+      };
+      for (auto center : manager) {
+        std::vector<double> distances_vec{};
+        std::vector<int> neighbour_types{};
+        for (auto neigh : center.pairs()) {
+          if (not is_supported(neigh.get_atom_type())) {
+            continue;
+          }
+          distances_vec.push_back(manager->get_distance(neigh));
+          neighbour_types.push_back(neigh.get_atom_type());
+        }
+        Eigen::Map<Eigen::VectorXd> distances(distances_vec.data(),
+                                              distances_vec.size());
+        radial_integral->compute_neighbour_contribution_batch(
+            distances, neighbour_types, true);
+        // copy the batch since the per neighbour computations below may
+        // share some buffers with it
+        Matrix_t contributions_batch{
+            radial_integral->get_radial_integral_neighbour_batch()};
+        Matrix_t derivatives_batch{
+            radial_integral->get_radial_neighbour_derivative_batch()};
+        BOOST_CHECK_EQUAL(contributions_batch.rows(), distances.size());
+        BOOST_CHECK_EQUAL(derivatives_batch.rows(), distances.size());
+
+        Eigen::Index i_neigh{0};
+        for (auto neigh : center.pairs()) {
+          if (not is_supported(neigh.get_atom_type())) {
+            continue;
+          }
+          Matrix_t contribution{
+              radial_integral->template compute_neighbour_contribution(
+                  distances(i_neigh), neigh, neigh.get_atom_type())};
+          Matrix_t derivative{
+              radial_integral->template compute_neighbour_derivative(
+                  distances(i_neigh), neigh, neigh.get_atom_type())};
+          BOOST_REQUIRE_EQUAL(contribution.size(),
+                              contributions_batch.cols());
+          Eigen::Map<Matrix_t> contribution_batch(
+              contributions_batch.row(i_neigh).data(), contribution.rows(),
+              contribution.cols());
+          Eigen::Map<Matrix_t> derivative_batch(
+              derivatives_batch.row(i_neigh).data(), derivative.rows(),
+              derivative.cols());
+          BOOST_CHECK_LE((contribution - contribution_batch).norm(),
+                         delta * (1 + contribution.norm()));
+          BOOST_CHECK_LE((derivative - derivative_batch).norm(),
+                         delta * (1 + derivative.norm()));
+          ++i_neigh;
+        }
+      }
+    }
+  }
+
+  /**
+   * Test that folding the cutoff function in the spline of the radial
+   * integrals gives the same coefficients and gradients as multiplying the
+   * splined radial integrals by the cutoff function of each pair
+   */
+  BOOST_AUTO_TEST_CASE(spherical_expansion_folded_cutoff_test) {
+    const double cutoff{3.};
+    const double delta{1e-8};
+    json adaptors{};
+    adaptors.push_back({{"name", "AdaptorNeighbourList"},
+                        {"initialization_arguments", {{"cutoff", cutoff}}}});
+    adaptors.push_back({{"name", "AdaptorCenterContribution"},
+                        {"initialization_arguments", {}}});
+    adaptors.push_back({{"name", "AdaptorStrict"},
+                        {"initialization_arguments", {{"cutoff", cutoff}}}});
+    auto manager = make_structure_manager_stack<
+        StructureManagerCenters, AdaptorNeighbourList,
+        AdaptorCenterContribution, AdaptorStrict>(
+        json{{"filename",
+              "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json"}},
+        adaptors);
+    using Manager_t = typename decltype(manager)::element_type;
+    using Prop_t = typename CalculatorSphericalExpansion::Property_t<Manager_t>;
+    using PropGrad_t =
+        typename CalculatorSphericalExpansion::PropertyGradient_t<Manager_t>;
+
+    std::vector<json> fc_hypers{
+        {{"type", "ShiftedCosine"},
+         {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+         {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}},
+        {{"type", "RadialScaling"},
+         {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+         {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}},
+         {"rate", {{"value", 1.}, {"unit", "AA"}}},
+         {"exponent", {{"value", 3}, {"unit", ""}}},
+         {"scale", {{"value", 2.}, {"unit", "AA"}}}}};
+    for (const auto & fc_hyper : fc_hypers) {
+      std::vector<math::Matrix_t> features{};
+      std::vector<math::Matrix_t> gradients{};
+      for (bool fold : {false, true}) {
+        json hypers{
+            {"max_radial", 4},
+            {"max_angular", 3},
+            {"compute_gradients", true},
+            {"cutoff_function", fc_hyper},
+            {"gaussian_density",
+             {{"type", "Constant"},
+              {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}}},
+            {"radial_contribution",
+             {{"type", "GTO"},
+              {"optimization",
+               {{"Spline",
+                 {{"accuracy", 1e-10}, {"fold_cutoff_function", fold}}}}}}}};
+        CalculatorSphericalExpansion representation{hypers};
+        representation.compute(manager);
+        auto && coefficients{*manager->template get_property<Prop_t>(
+            representation.get_name())};
+        auto && coefficients_gradient{
+            *manager->template get_property<PropGrad_t>(
+                representation.get_gradient_name())};
+        features.push_back(coefficients.get_features());
+        gradients.push_back(coefficients_gradient.get_features_gradient());
+      }
+      BOOST_REQUIRE_EQUAL(features[0].size(), features[1].size());
+      BOOST_REQUIRE_EQUAL(gradients[0].size(), gradients[1].size());
+      BOOST_TEST(features[0].cwiseAbs().maxCoeff() > 1e-2);
+      double diff{(features[0] - features[1]).cwiseAbs().maxCoeff()};
+      BOOST_TEST(diff < delta);
+      double diff_gradients{
+          (gradients[0] - gradients[1]).cwiseAbs().maxCoeff()};
+      BOOST_TEST(diff_gradients < delta);
+    }
+
+    // a radial scaling with a zero rate diverges at r = 0
+    json hypers{
+        {"max_radial", 4},
+        {"max_angular", 3},
+        {"cutoff_function",
+         {{"type", "RadialScaling"},
+          {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+          {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}},
+          {"rate", {{"value", 0.}, {"unit", "AA"}}},
+          {"exponent", {{"value", 3}, {"unit", ""}}},
+          {"scale", {{"value", 2.}, {"unit", "AA"}}}}},
+        {"gaussian_density",
+         {{"type", "Constant"},
+          {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}}},
+        {"radial_contribution",
+         {{"type", "GTO"},
+          {"optimization",
+           {{"Spline",
+             {{"accuracy", 1e-10}, {"fold_cutoff_function", true}}}}}}}};
+    BOOST_CHECK_THROW(CalculatorSphericalExpansion{hypers}, std::logic_error);
+  }
+
   using gradient_fixtures = boost::mpl::list<
       CalculatorFixture<
           SingleHypersSphericalExpansion<SimplePeriodicNLCCStrictFixture>>,
       CalculatorFixture<
-          SingleHypersSphericalInvariants<SimplePeriodicNLCCStrictFixture>>>;
+          SingleHypersSphericalInvariants<SimplePeriodicNLCCStrictFixture>>,
+      CalculatorFixture<
+          SingleHypersSphericalCovariants<SimplePeriodicNLCCStrictFixture>>>;
   /**
-   * Test the gradient of the SphericalExpansion and SphericalInvariants
-   * representation on a few simple crystal structures (single- and
-   * multi-species, primitive and supercells)
+   * Test the gradient of the SphericalExpansion, SphericalInvariants and
+   * SphericalCovariants representation on a few simple crystal structures
+   * (single- and multi-species, primitive and supercells)
    */
   BOOST_FIXTURE_TEST_CASE_TEMPLATE(spherical_representation_gradients, Fix,
                                    gradient_fixtures, Fix) {
@@ -646,7 +882,8 @@ namespace rascal {
         // the first hyper, since it builds on top of the SphericalExpansion and
         // the SphericalExpansion is tested for all hypers, we do not lose
         // coverage
-        if (hyper.count("soap_type")) {
+        if (std::is_same<typename Fix::Representation_t,
+                         CalculatorSphericalInvariants>::value) {
           break;
         }
       }
@@ -1150,6 +1387,758 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that the incremental update of the spherical expansion and of the
+   * PowerSpectrum along a trajectory where a single atom moves gives the same
+   * features as recomputing all the centers, and that only the centers
+   * around the moving atom are recomputed.
+   */
+  BOOST_AUTO_TEST_CASE(incremental_update_test) {
+    const double cutoff{3.};
+    const double delta{1e-12};
+    const std::string filename{
+        "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json"};
+    AtomicStructure<3> structure{};
+    structure.set_structure(filename);
+    json adaptors{};
+    adaptors.push_back({{"name", "AdaptorNeighbourList"},
+                        {"initialization_arguments", {{"cutoff", cutoff}}}});
+    adaptors.push_back({{"name", "AdaptorCenterContribution"},
+                        {"initialization_arguments", {}}});
+    adaptors.push_back({{"name", "AdaptorStrict"},
+                        {"initialization_arguments", {{"cutoff", cutoff}}}});
+    auto manager{make_structure_manager_stack<
+        StructureManagerCenters, AdaptorNeighbourList,
+        AdaptorCenterContribution, AdaptorStrict>(
+        json{{"filename", filename}}, adaptors)};
+    using Manager_t = typename decltype(manager)::element_type;
+    using Prop_t =
+        typename CalculatorSphericalInvariants::Property_t<Manager_t>;
+    using PropExp_t =
+        typename CalculatorSphericalExpansion::Property_t<Manager_t>;
+
+    json hypers{{"max_radial", 4},
+                {"max_angular", 3},
+                {"soap_type", "PowerSpectrum"},
+                {"normalize", true},
+                {"cutoff_function",
+                 {{"type", "ShiftedCosine"},
+                  {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+                  {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}}},
+                {"gaussian_density",
+                 {{"type", "Constant"},
+                  {"gaussian_sigma", {{"value", 0.3}, {"unit", "AA"}}}}},
+                {"radial_contribution", {{"type", "GTO"}}}};
+    json hypers_incremental = hypers;
+    hypers_incremental["incremental"] = true;
+    CalculatorSphericalInvariants soap{hypers};
+    CalculatorSphericalInvariants soap_incremental{hypers_incremental};
+    // the expansions computed by the invariants have the same names
+    CalculatorSphericalExpansion expansion{hypers};
+    CalculatorSphericalExpansion expansion_incremental{hypers_incremental};
+
+    auto check = [&](auto prop, auto prop_incremental) {
+      auto features = prop->get_features();
+      auto features_incremental = prop_incremental->get_features();
+      BOOST_REQUIRE_EQUAL(features.rows(), features_incremental.rows());
+      BOOST_REQUIRE_EQUAL(features.cols(), features_incremental.cols());
+      double diff{(features - features_incremental).cwiseAbs().maxCoeff()};
+      BOOST_TEST(diff < delta);
+    };
+    auto compute_and_check = [&]() {
+      soap.compute(manager);
+      soap_incremental.compute(manager);
+      check(manager->template get_property<Prop_t>(soap.get_name()),
+            manager->template get_property<Prop_t>(
+                soap_incremental.get_name()));
+      check(manager->template get_property<PropExp_t>(expansion.get_name()),
+            manager->template get_property<PropExp_t>(
+                expansion_incremental.get_name()));
+      const size_t n_centers_recomputed{
+          expansion_incremental.get_n_centers_recomputed(manager)};
+      BOOST_CHECK_EQUAL(soap_incremental.get_n_centers_recomputed(manager),
+                        n_centers_recomputed);
+      return n_centers_recomputed;
+    };
+
+    BOOST_CHECK_EQUAL(compute_and_check(), manager->size());
+
+    // the centers in the environment of the moving atom (the neighbour list
+    // is the same in both positions)
+    const size_t i_moving{3};
+    std::set<int> moving_environment{static_cast<int>(i_moving)};
+    for (auto center : manager) {
+      for (auto neigh : center.pairs()) {
+        if (manager->get_atom_index(neigh.get_atom_tag()) == i_moving) {
+          moving_environment.insert(center.get_atom_tag());
+        }
+      }
+    }
+    BOOST_TEST_REQUIRE(moving_environment.size() < manager->size());
+
+    for (int i_step{0}; i_step < 3; ++i_step) {
+      structure.displace_position(i_moving, Eigen::Vector3d{1e-3, -2e-3, 0.});
+      manager->update(structure);
+      // the centers of a single manager are split among the threads
+      soap_incremental.set_n_threads(i_step + 1);
+      BOOST_CHECK_EQUAL(compute_and_check(), moving_environment.size());
+    }
+
+    // nothing moved
+    manager->update(structure);
+    BOOST_CHECK_EQUAL(compute_and_check(), 0);
+
+    // an atom leaving the environments of some centers
+    structure.displace_position(i_moving, Eigen::Vector3d{0.5, 0.5, 0.5});
+    manager->update(structure);
+    BOOST_TEST(compute_and_check() > 0);
+  }
+
+  /**
+   * Test that the block sparse description of the gradients of the
+   * representation, with the raw data of the property as blocks, gives back
+   * the dense gradient matrix, also when the keys differ between the pairs.
+   */
+  BOOST_AUTO_TEST_CASE(gradient_block_sparse_structure_test) {
+    const double cutoff{3.};
+    const std::string filename{
+        "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json"};
+    json adaptors{};
+    adaptors.push_back({{"name", "AdaptorNeighbourList"},
+                        {"initialization_arguments", {{"cutoff", cutoff}}}});
+    adaptors.push_back({{"name", "AdaptorCenterContribution"},
+                        {"initialization_arguments", {}}});
+    adaptors.push_back({{"name", "AdaptorStrict"},
+                        {"initialization_arguments", {{"cutoff", cutoff}}}});
+    auto manager{make_structure_manager_stack<
+        StructureManagerCenters, AdaptorNeighbourList,
+        AdaptorCenterContribution, AdaptorStrict>(
+        json{{"filename", filename}}, adaptors)};
+    using Manager_t = typename decltype(manager)::element_type;
+    using PropGrad_t =
+        typename CalculatorSphericalInvariants::PropertyGradient_t<Manager_t>;
+
+    for (const std::string species_method :
+         {"environment wise", "structure wise"}) {
+      json hypers{{"max_radial", 3},
+                  {"max_angular", 2},
+                  {"soap_type", "PowerSpectrum"},
+                  {"normalize", true},
+                  {"compute_gradients", true},
+                  {"expansion_by_species_method", species_method},
+                  {"cutoff_function",
+                   {{"type", "ShiftedCosine"},
+                    {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+                    {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}}},
+                  {"gaussian_density",
+                   {{"type", "Constant"},
+                    {"gaussian_sigma", {{"value", 0.3}, {"unit", "AA"}}}}},
+                  {"radial_contribution", {{"type", "GTO"}}}};
+      CalculatorSphericalInvariants soap{hypers};
+      soap.compute(manager);
+      auto & prop_grad{
+          *manager->template get_property<PropGrad_t>(soap.get_gradient_name())};
+      auto all_keys = prop_grad.get_keys();
+      math::Matrix_t features{prop_grad.get_features_gradient(all_keys)};
+
+      Eigen::VectorXi block_columns{}, block_row_pointers{};
+      prop_grad.get_block_sparse_gradient_structure(all_keys, block_columns,
+                                                    block_row_pointers);
+      const auto & blocks{prop_grad.get_raw_data()};
+      const int inner_size{prop_grad.get_nb_comp() / ThreeD};
+      const int block_size{prop_grad.get_nb_comp()};
+      BOOST_REQUIRE_EQUAL(block_row_pointers.size(), prop_grad.size() + 1);
+      BOOST_REQUIRE_EQUAL(block_columns.size() * block_size, blocks.size());
+      if (species_method == "environment wise") {
+        // there are less blocks than in the dense matrix
+        BOOST_TEST(block_columns.size() <
+                   static_cast<int>(prop_grad.size() * all_keys.size()));
+      }
+
+      math::Matrix_t features_from_blocks{
+          math::Matrix_t::Zero(features.rows(), features.cols())};
+      for (int i_pair{0}; i_pair < static_cast<int>(prop_grad.size());
+           ++i_pair) {
+        for (int i_block{block_row_pointers(i_pair)};
+             i_block < block_row_pointers(i_pair + 1); ++i_block) {
+          features_from_blocks.block(ThreeD * i_pair,
+                                     block_columns(i_block) * inner_size,
+                                     ThreeD, inner_size) =
+              Eigen::Map<const math::Matrix_t>(
+                  blocks.data() + i_block * block_size, ThreeD, inner_size);
+        }
+      }
+      BOOST_TEST((features - features_from_blocks).cwiseAbs().maxCoeff() ==
+                 0.);
+    }
+  }
+
+  /**
+   * Test that the couplings of the real expansion coefficients of the
+   * BiSpectrum give the same invariants as the contraction of the Wigner 3j
+   * symbols with the complex coefficients.
+   */
+  BOOST_AUTO_TEST_CASE(bispectrum_couplings_test) {
+    using complex = std::complex<double>;
+    const int l_max{4};
+    const int n_lm{(l_max + 1) * (l_max + 1)};
+    std::mt19937 generator{7};
+    std::uniform_real_distribution<double> distribution{-1., 1.};
+    std::array<Eigen::VectorXd, 3> coefs{};
+    for (auto & coef : coefs) {
+      coef.resize(n_lm);
+      for (int lm{0}; lm < n_lm; ++lm) {
+        coef(lm) = distribution(generator);
+      }
+    }
+    // complex coefficient of order m from the real ones
+    auto to_complex = [](const Eigen::VectorXd & coef, int l, int m) {
+      const int lm{l * l + l + m};
+      if (m > 0) {
+        return math::pow(-1., m) * complex{coef(lm), coef(lm - 2 * m)} *
+               math::INV_SQRT_TWO;
+      } else if (m == 0) {
+        return complex{coef(lm), 0.};
+      }
+      return complex{coef(lm - 2 * m), -coef(lm)} * math::INV_SQRT_TWO;
+    };
+
+    for (bool inversion_symmetry : {true, false}) {
+      const auto couplings{internal::precompute_bispectrum_couplings(
+          l_max, inversion_symmetry)};
+      const auto w3js{
+          internal::precompute_wigner_w3js(l_max, inversion_symmetry)};
+
+      std::vector<double> invariants_ref{};
+      int wigner_count{0};
+      for (int l1{0}; l1 < l_max + 1; ++l1) {
+        for (int l2{0}; l2 < l_max + 1; ++l2) {
+          for (int l3{0}; l3 < l_max + 1; ++l3) {
+            if ((l1 < std::abs(l2 - l3)) or (l1 > l2 + l3) or
+                (inversion_symmetry and (l1 + l2 + l3) % 2 == 1)) {
+              continue;
+            }
+            complex invariant{0., 0.};
+            for (int m1{-l1}; m1 < l1 + 1; ++m1) {
+              for (int m2{-l2}; m2 < l2 + 1; ++m2) {
+                for (int m3{-l3}; m3 < l3 + 1; ++m3) {
+                  if (m1 + m2 + m3 != 0) {
+                    continue;
+                  }
+                  invariant += w3js(wigner_count) *
+                               to_complex(coefs[0], l1, m1) *
+                               to_complex(coefs[1], l2, m2) *
+                               to_complex(coefs[2], l3, m3);
+                  ++wigner_count;
+                }
+              }
+            }
+            invariants_ref.push_back((l1 + l2 + l3) % 2 == 0
+                                         ? invariant.real()
+                                         : invariant.imag());
+          }
+        }
+      }
+
+      std::vector<double> invariants(invariants_ref.size(), 0.);
+      for (size_t i_coupling{0}; i_coupling < couplings.size(); ++i_coupling) {
+        invariants.at(couplings.l_channel[i_coupling]) +=
+            couplings.values[i_coupling] *
+            coefs[0](couplings.lm1[i_coupling]) *
+            coefs[1](couplings.lm2[i_coupling]) *
+            coefs[2](couplings.lm3[i_coupling]);
+      }
+      for (size_t i_channel{0}; i_channel < invariants.size(); ++i_channel) {
+        BOOST_TEST(std::abs(invariants[i_channel] - invariants_ref[i_channel]) <
+                   1e-12);
+      }
+    }
+  }
+
+  /**
+   * Test that filling a preallocated feature matrix, also with several
+   * threads, and the block sparse description of the features, with the raw
+   * data of the property as blocks, give back the dense feature matrix.
+   */
+  BOOST_AUTO_TEST_CASE(preallocated_and_block_sparse_features_test) {
+    const double cutoff{3.};
+    const std::string filename{"reference_data/inputs/small_molecules-20.json"};
+    json adaptors{};
+    adaptors.push_back({{"name", "AdaptorNeighbourList"},
+                        {"initialization_arguments", {{"cutoff", cutoff}}}});
+    adaptors.push_back({{"name", "AdaptorCenterContribution"},
+                        {"initialization_arguments", {}}});
+    adaptors.push_back({{"name", "AdaptorStrict"},
+                        {"initialization_arguments", {{"cutoff", cutoff}}}});
+    using ManagerCollection_t =
+        ManagerCollection<StructureManagerCenters, AdaptorNeighbourList,
+                          AdaptorCenterContribution, AdaptorStrict>;
+    using Manager_t = typename ManagerCollection_t::Manager_t;
+    using Prop_t =
+        typename CalculatorSphericalInvariants::Property_t<Manager_t>;
+    ManagerCollection_t collection{adaptors};
+    collection.add_structures(filename, 0, 10);
+
+    json hypers{{"max_radial", 3},
+                {"max_angular", 2},
+                {"soap_type", "PowerSpectrum"},
+                {"normalize", true},
+                {"expansion_by_species_method", "environment wise"},
+                {"cutoff_function",
+                 {{"type", "ShiftedCosine"},
+                  {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+                  {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}}},
+                {"gaussian_density",
+                 {{"type", "Constant"},
+                  {"gaussian_sigma", {{"value", 0.3}, {"unit", "AA"}}}}},
+                {"radial_contribution", {{"type", "GTO"}}}};
+    CalculatorSphericalInvariants soap{hypers};
+    soap.compute(collection);
+
+    math::Matrix_t features{collection.get_features(soap)};
+    auto all_keys = collection.get_keys(soap);
+    for (int n_threads : {1, 2}) {
+      // the missing keys have to be set to zero by fill_features
+      math::Matrix_t features_filled{math::Matrix_t::Constant(
+          features.rows(), features.cols(), std::nan(""))};
+      collection.fill_features(soap, features_filled, all_keys, n_threads);
+      BOOST_TEST((features - features_filled).cwiseAbs().maxCoeff() == 0.);
+    }
+    math::Matrix_t wrong_shape{features.rows(), features.cols() + 1};
+    BOOST_CHECK_THROW(collection.fill_features(soap, wrong_shape, all_keys),
+                      std::runtime_error);
+
+    int i_row{0};
+    for (auto & manager : collection) {
+      auto & prop{*manager->template get_property<Prop_t>(soap.get_name())};
+      Eigen::VectorXi block_columns{}, block_row_pointers{};
+      prop.get_block_sparse_structure(all_keys, block_columns,
+                                      block_row_pointers);
+      const auto & blocks{prop.get_raw_data()};
+      const int inner_size{prop.get_nb_comp()};
+      BOOST_REQUIRE_EQUAL(block_row_pointers.size(), prop.size() + 1);
+      BOOST_REQUIRE_EQUAL(block_columns.size() * inner_size, blocks.size());
+      math::Matrix_t features_from_blocks{
+          math::Matrix_t::Zero(prop.size(), features.cols())};
+      for (int i_center{0}; i_center < static_cast<int>(prop.size());
+           ++i_center) {
+        for (int i_block{block_row_pointers(i_center)};
+             i_block < block_row_pointers(i_center + 1); ++i_block) {
+          features_from_blocks
+              .block(i_center, block_columns(i_block) * inner_size, 1,
+                     inner_size) =
+              Eigen::Map<const math::Vector_t>(
+                  blocks.data() + i_block * inner_size, inner_size);
+        }
+      }
+      BOOST_TEST((features.middleRows(i_row, prop.size()) -
+                  features_from_blocks)
+                     .cwiseAbs()
+                     .maxCoeff() == 0.);
+      i_row += prop.size();
+    }
+  }
+
+  /**
+   * Test that splitting the centers of a structure among several threads
+   * gives the same representation and gradients as the serial computation,
+   * with full and half neighbour lists.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(multithreaded_centers_test, Fix,
+                                   gradient_half_fixtures, Fix) {
+    using Prop_t = typename Fix::Prop_t;
+    using PropHalf_t = typename Fix::PropHalf_t;
+    using PropGrad_t = typename Fix::PropGrad_t;
+    using PropGradHalf_t = typename Fix::PropGradHalf_t;
+    using Representation_t = typename Fix::Representation_t;
+    auto & managers = Fix::ParentFull::managers;
+    auto & managers_half = Fix::ParentHalf::managers;
+    auto & representation_hypers = Fix::ParentFull::representation_hypers;
+
+    const double delta{1e-12};
+
+    for (size_t i_manager{0}; i_manager < managers.size(); ++i_manager) {
+      for (auto & rep_hypers : representation_hypers[i_manager]) {
+        auto & manager = managers[i_manager];
+        auto & manager_half = managers_half[i_manager];
+        Representation_t representation{rep_hypers};
+        // a different identifier so that the results are stored separately
+        json rep_hypers_threads = rep_hypers;
+        rep_hypers_threads["identifier"] = "multithreaded";
+        Representation_t representation_threads{rep_hypers_threads};
+        representation_threads.set_n_threads(3);
+
+        representation.compute(manager);
+        representation.compute(manager_half);
+        representation_threads.compute(manager);
+        representation_threads.compute(manager_half);
+
+        auto check = [&](auto & prop, auto & prop_threads) {
+          auto features = prop.get_features();
+          auto features_threads = prop_threads.get_features();
+          BOOST_REQUIRE_EQUAL(features.rows(), features_threads.rows());
+          BOOST_REQUIRE_EQUAL(features.cols(), features_threads.cols());
+          double diff{(features - features_threads).cwiseAbs().maxCoeff()};
+          BOOST_TEST(diff < delta);
+        };
+        auto check_gradients = [&](auto & prop, auto & prop_threads) {
+          auto features = prop.get_features_gradient();
+          auto features_threads = prop_threads.get_features_gradient();
+          BOOST_REQUIRE_EQUAL(features.rows(), features_threads.rows());
+          BOOST_REQUIRE_EQUAL(features.cols(), features_threads.cols());
+          double diff{(features - features_threads).cwiseAbs().maxCoeff()};
+          BOOST_TEST(diff < delta);
+        };
+
+        check(*manager->template get_property<Prop_t>(
+                  representation.get_name()),
+              *manager->template get_property<Prop_t>(
+                  representation_threads.get_name()));
+        check(*manager_half->template get_property<PropHalf_t>(
+                  representation.get_name()),
+              *manager_half->template get_property<PropHalf_t>(
+                  representation_threads.get_name()));
+        check_gradients(*manager->template get_property<PropGrad_t>(
+                            representation.get_gradient_name()),
+                        *manager->template get_property<PropGrad_t>(
+                            representation_threads.get_gradient_name()));
+        check_gradients(
+            *manager_half->template get_property<PropGradHalf_t>(
+                representation.get_gradient_name()),
+            *manager_half->template get_property<PropGradHalf_t>(
+                representation_threads.get_gradient_name()));
+      }
+    }
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Test that splitting a collection of structures among several threads
+   * gives the same representation as the serial computation.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(multithreaded_structures_test, Fix,
+                                   multiple_fixtures, Fix) {
+    using ManagerCollection_t =
+        typename TypeHolderInjector<ManagerCollection,
+                                    typename Fix::ManagerTypeList_t>::type;
+    using Property_t = typename Fix::Property_t;
+    using Representation_t = typename Fix::Representation_t;
+    auto & managers = Fix::managers;
+    auto & representation_hypers = Fix::representation_hypers;
+
+    const double delta{1e-12};
+
+    for (auto & hyper : representation_hypers) {
+      double representation_cutoff{
+          extract_interaction_cutoff_from_representation_hyper(hyper)};
+      ManagerCollection_t collection{};
+      for (auto & manager : managers) {
+        if (manager->get_cutoff() == representation_cutoff) {
+          collection.add_structure(manager);
+        }
+      }
+      if (collection.size() < 2) {
+        continue;
+      }
+
+      Representation_t representation{hyper};
+      // a different identifier so that the results are stored separately
+      json hyper_threads = hyper;
+      hyper_threads["identifier"] = "multithreaded";
+      Representation_t representation_threads{hyper_threads};
+      representation_threads.set_n_threads(2);
+
+      representation.compute(collection);
+      representation_threads.compute(collection);
+
+      for (auto manager : collection) {
+        auto features = manager
+                            ->template get_property<Property_t>(
+                                representation.get_name())
+                            ->get_features();
+        auto features_threads = manager
+                                    ->template get_property<Property_t>(
+                                        representation_threads.get_name())
+                                    ->get_features();
+        BOOST_REQUIRE_EQUAL(features.rows(), features_threads.rows());
+        BOOST_REQUIRE_EQUAL(features.cols(), features_threads.cols());
+        double diff{(features - features_threads).cwiseAbs().maxCoeff()};
+        BOOST_TEST(diff < delta);
+      }
+    }
+  }
+
+  /**
+   * Test that the k-space spherical expansion of the long range potential
+   * does not depend on the choice of the unit cell, i.e. that the centers of
+   * a supercell have the same coefficients as in the primitive cell, and
+   * that it is invariant to a translation of the structure.
+   */
+  BOOST_AUTO_TEST_CASE(kspace_spherical_expansion_test) {
+    const double cutoff{3.};
+    const double delta{1e-12};
+    const std::string filename{
+        "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json"};
+    json adaptors{};
+    adaptors.push_back({{"name", "AdaptorNeighbourList"},
+                        {"initialization_arguments", {{"cutoff", cutoff}}}});
+    adaptors.push_back({{"name", "AdaptorCenterContribution"},
+                        {"initialization_arguments", {}}});
+    adaptors.push_back({{"name", "AdaptorStrict"},
+                        {"initialization_arguments", {{"cutoff", cutoff}}}});
+    auto make_manager = [&adaptors](const AtomicStructure<3> & structure) {
+      return make_structure_manager_stack<
+          StructureManagerCenters, AdaptorNeighbourList,
+          AdaptorCenterContribution, AdaptorStrict>(json(structure), adaptors);
+    };
+
+    AtomicStructure<3> structure{};
+    structure.set_structure(filename);
+    const auto n_atoms{structure.positions.cols()};
+
+    // doubles the cell along the first lattice vector
+    AtomicStructure<3> supercell{};
+    Eigen::Matrix3Xd supercell_positions(3, 2 * n_atoms);
+    supercell_positions << structure.positions,
+        structure.positions.colwise() + structure.cell.col(0);
+    Eigen::VectorXi supercell_types(2 * n_atoms);
+    supercell_types << structure.atom_types, structure.atom_types;
+    Eigen::Matrix3d supercell_cell{structure.cell};
+    supercell_cell.col(0) *= 2.;
+    supercell.set_structure(supercell_positions, supercell_types,
+                            supercell_cell, structure.pbc);
+
+    // translates the atoms and wraps them back in the cell
+    AtomicStructure<3> translated{};
+    Eigen::Matrix3Xd fractional{
+        structure.cell.inverse() *
+        (structure.positions.colwise() + Eigen::Vector3d{0.3, -1.2, 0.7})};
+    fractional = fractional.array() - fractional.array().floor();
+    translated.set_structure(structure.cell * fractional,
+                             structure.atom_types, structure.cell,
+                             structure.pbc);
+
+    auto manager{make_manager(structure)};
+    auto manager_supercell{make_manager(supercell)};
+    auto manager_translated{make_manager(translated)};
+    using Manager_t = typename decltype(manager)::element_type;
+    using Prop_t =
+        typename CalculatorKspaceSphericalExpansion::Property_t<Manager_t>;
+
+    json hypers{{"max_radial", 4},
+                {"max_angular", 3},
+                {"cutoff_function",
+                 {{"type", "ShiftedCosine"},
+                  {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+                  {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}}},
+                {"gaussian_density",
+                 {{"type", "Constant"},
+                  {"gaussian_sigma", {{"value", 0.5}, {"unit", "AA"}}}}},
+                {"radial_contribution", {{"type", "GTO"}}}};
+    CalculatorKspaceSphericalExpansion representation{hypers};
+    representation.compute(manager);
+    representation.compute(manager_supercell);
+    representation.compute(manager_translated);
+
+    auto features = manager->template get_property<Prop_t>(
+                               representation.get_name())
+                        ->get_features();
+    auto features_supercell = manager_supercell
+                                  ->template get_property<Prop_t>(
+                                      representation.get_name())
+                                  ->get_features();
+    auto features_translated = manager_translated
+                                   ->template get_property<Prop_t>(
+                                       representation.get_name())
+                                   ->get_features();
+
+    std::set<int> species(structure.atom_types.data(),
+                          structure.atom_types.data() + n_atoms);
+    BOOST_REQUIRE_EQUAL(features.rows(), n_atoms);
+    BOOST_REQUIRE_EQUAL(features.cols(), representation.get_num_coefficients(
+                                             species.size()));
+    BOOST_TEST(features.cwiseAbs().maxCoeff() > 1e-2);
+    BOOST_REQUIRE_EQUAL(features_supercell.rows(), 2 * n_atoms);
+    for (int i_image{0}; i_image < 2; ++i_image) {
+      double diff{
+          (features_supercell.middleRows(i_image * n_atoms, n_atoms) -
+           features)
+              .cwiseAbs()
+              .maxCoeff()};
+      BOOST_TEST(diff < delta);
+    }
+    double diff{(features_translated - features).cwiseAbs().maxCoeff()};
+    BOOST_TEST(diff < delta);
+
+    // only fully periodic structures are supported
+    AtomicStructure<3> molecule{};
+    molecule.set_structure(
+        std::string("reference_data/inputs/small_molecule.json"));
+    auto manager_molecule{make_manager(molecule)};
+    BOOST_CHECK_THROW(representation.compute(manager_molecule),
+                      std::runtime_error);
+  }
+
+  /**
+   * Test the values of the k-space spherical expansion against a direct
+   * quadrature in real space of the projection of the potential on the
+   * radial basis and the spherical harmonics, for a small triclinic cell.
+   * The potential of the smeared atoms is summed from its Fourier series
+   * on the k-vectors within k_cutoff.
+   */
+  BOOST_AUTO_TEST_CASE(kspace_spherical_expansion_reference_test) {
+    using math::PI;
+    const double cutoff{2.5};
+    const double sigma{0.6};
+    const int max_radial{3};
+    const int max_angular{3};
+    const int n_lm{(max_angular + 1) * (max_angular + 1)};
+    const double delta{1e-9};
+
+    Eigen::Matrix3d cell{4. * Eigen::Matrix3d::Identity()};
+    cell(0, 1) = 0.5;
+    cell(1, 2) = -0.3;
+    // fractional coordinates of the atoms, which are the columns
+    Eigen::Matrix3Xd fractional(3, 4);
+    fractional << 0.05, 0.3, 0.7, 0.45, 0.1, 0.5, 0.15, 0.9, 0.05, 0.2, 0.8,
+        0.6;
+    const Eigen::Matrix3Xd positions{cell * fractional};
+    Eigen::VectorXi atom_types(4);
+    atom_types << 1, 8, 8, 8;
+    Eigen::VectorXi pbc{Eigen::VectorXi::Ones(3)};
+    AtomicStructure<3> structure{};
+    structure.set_structure(positions, atom_types, cell, pbc);
+
+    json adaptors{};
+    adaptors.push_back({{"name", "AdaptorNeighbourList"},
+                        {"initialization_arguments", {{"cutoff", cutoff}}}});
+    adaptors.push_back({{"name", "AdaptorCenterContribution"},
+                        {"initialization_arguments", {}}});
+    adaptors.push_back({{"name", "AdaptorStrict"},
+                        {"initialization_arguments", {{"cutoff", cutoff}}}});
+    auto manager{make_structure_manager_stack<
+        StructureManagerCenters, AdaptorNeighbourList,
+        AdaptorCenterContribution, AdaptorStrict>(json(structure), adaptors)};
+    using Manager_t = typename decltype(manager)::element_type;
+    using Prop_t =
+        typename CalculatorKspaceSphericalExpansion::Property_t<Manager_t>;
+
+    json hypers{{"max_radial", max_radial},
+                {"max_angular", max_angular},
+                {"cutoff_function",
+                 {{"type", "ShiftedCosine"},
+                  {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+                  {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}}},
+                {"gaussian_density",
+                 {{"type", "Constant"},
+                  {"gaussian_sigma", {{"value", sigma}, {"unit", "AA"}}}}},
+                {"radial_contribution", {{"type", "GTO"}}}};
+    CalculatorKspaceSphericalExpansion representation{hypers};
+    representation.compute(manager);
+    auto && coefficients{
+        *manager->template get_property<Prop_t>(representation.get_name())};
+
+    // R_n(r) = sum_m O_{mn} r^m e^{-b_m r^2}
+    internal::RadialContribution<internal::RadialBasisType::GTO>
+        radial_contribution{hypers};
+    radial_contribution.precompute();
+    const math::Matrix_t radial_ortho_matrix{
+        radial_contribution.get_radial_orthonormalization_matrix()};
+    const Eigen::VectorXd fac_b{radial_contribution.fac_b};
+
+    // the Fourier components of the potential of a unit Gaussian charge,
+    // twice for the -k vectors that are not listed
+    math::Kvectors kvectors{PI / sigma, structure.cell.transpose(), false,
+                            false};
+    const math::Matrix_t kvecs{kvectors.get_kvectors()};
+    const Eigen::ArrayXd knorms{kvectors.get_kvector_norms()};
+    const double volume{std::abs(structure.cell.determinant())};
+    const Eigen::ArrayXd green{8. * PI / volume *
+                               (-0.5 * sigma * sigma * knorms.square()).exp() /
+                               knorms.square()};
+
+    // Gauss-Legendre in cos(theta) and uniform in phi on the sphere, and
+    // Gauss-Legendre in r where the radial basis has vanished
+    const int n_theta{48};
+    const int n_phi{96};
+    const auto theta_quadrature{
+        math::compute_gauss_legendre_points_weights(-1., 1., n_theta)};
+    const auto radial_quadrature{
+        math::compute_gauss_legendre_points_weights(0., 9., 80)};
+    math::MatrixX3_t directions(n_theta * n_phi, 3);
+    Eigen::VectorXd angular_weights(n_theta * n_phi);
+    for (int i_theta{0}; i_theta < n_theta; ++i_theta) {
+      const double cos_theta{theta_quadrature(i_theta, 0)};
+      const double sin_theta{std::sqrt(1. - cos_theta * cos_theta)};
+      for (int i_phi{0}; i_phi < n_phi; ++i_phi) {
+        const double phi{2. * PI * i_phi / n_phi};
+        const int i_dir{i_theta * n_phi + i_phi};
+        directions.row(i_dir) << sin_theta * std::cos(phi),
+            sin_theta * std::sin(phi), cos_theta;
+        angular_weights(i_dir) = 2. * PI / n_phi * theta_quadrature(i_theta, 1);
+      }
+    }
+    math::SphericalHarmonics harmonics_calculator{};
+    harmonics_calculator.precompute(max_angular);
+    harmonics_calculator.calc_batch(directions, false, false);
+    const math::Matrix_t weighted_harmonics{
+        angular_weights.asDiagonal() *
+        harmonics_calculator.get_harmonics_batch()};
+    const Eigen::ArrayXXd k_dot_directions{kvecs * directions.transpose()};
+
+    const std::vector<int> species{1, 8};
+    const int n_species{static_cast<int>(species.size())};
+    for (auto center : manager) {
+      const Eigen::Vector3d position{center.get_position()};
+      // green times the real and imaginary parts of
+      // sum_{j in a} e^{i k (r_i - r_j)}
+      const Eigen::Index n_k{green.size()};
+      Eigen::MatrixXd factors_re{Eigen::MatrixXd::Zero(n_k, n_species)};
+      Eigen::MatrixXd factors_im{Eigen::MatrixXd::Zero(n_k, n_species)};
+      for (int i_atom{0}; i_atom < atom_types.size(); ++i_atom) {
+        const int i_species{atom_types(i_atom) == species[0] ? 0 : 1};
+        const Eigen::ArrayXd phases{
+            kvecs * (position - structure.positions.col(i_atom))};
+        factors_re.col(i_species).array() += green * phases.cos();
+        factors_im.col(i_species).array() += green * phases.sin();
+      }
+
+      std::vector<math::Matrix_t> references(
+          n_species, math::Matrix_t::Zero(max_radial, n_lm));
+      Eigen::VectorXd gto(max_radial);
+      for (int i_r{0}; i_r < radial_quadrature.rows(); ++i_r) {
+        const double r{radial_quadrature(i_r, 0)};
+        const Eigen::ArrayXXd phases{r * k_dot_directions};
+        // potential at r_i + r * direction for each species
+        const Eigen::MatrixXd potentials{
+            phases.cos().matrix().transpose() * factors_re -
+            phases.sin().matrix().transpose() * factors_im};
+        const Eigen::MatrixXd projections{weighted_harmonics.transpose() *
+                                          potentials};
+        for (int m{0}; m < max_radial; ++m) {
+          gto(m) = std::pow(r, m) * std::exp(-fac_b(m) * r * r);
+        }
+        const Eigen::VectorXd radial_basis{
+            radial_quadrature(i_r, 1) * r * r *
+            radial_ortho_matrix.transpose() * gto};
+        for (int i_species{0}; i_species < n_species; ++i_species) {
+          references[i_species] +=
+              radial_basis * projections.col(i_species).transpose();
+        }
+      }
+
+      for (int i_species{0}; i_species < n_species; ++i_species) {
+        const math::Matrix_t values{
+            coefficients[center][{species[i_species]}]};
+        const double scale{references[i_species].cwiseAbs().maxCoeff()};
+        BOOST_TEST(scale > 1e-2);
+        const double diff{
+            (values - references[i_species]).cwiseAbs().maxCoeff()};
+        BOOST_TEST(diff < delta * scale);
+      }
+    }
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace rascal
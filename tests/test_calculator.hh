@@ -33,6 +33,7 @@
 #include "test_structure.hh"
 
 #include "rascal/representations/calculator_base.hh"
+#include "rascal/representations/calculator_kspace_spherical_expansion.hh"
 #include "rascal/representations/calculator_sorted_coulomb.hh"
 #include "rascal/representations/calculator_spherical_covariants.hh"
 #include "rascal/representations/calculator_spherical_expansion.hh"
@@ -402,6 +403,10 @@ namespace rascal {
         {{"type", "DVR"}, {"optimization", {{"Spline", {{"accuracy", 1e-5}}}}}},
         {{"type", "GTO"}, {"optimization", radial_dim_reduction_spline_hypers}},
         {{"type", "DVR"}, {"optimization", radial_dim_reduction_spline_hypers}},
+        {{"type", "GTO"},
+         {"optimization",
+          {{"Spline",
+            {{"accuracy", 1e-12}, {"fold_cutoff_function", true}}}}}},
     };
     std::vector<json> rep_hypers{
         {{"max_radial", 3}, {"max_angular", 3}, {"compute_gradients", true}}};
@@ -658,7 +663,10 @@ namespace rascal {
         {{"type", "DVR"}, {"optimization", {}}},
         {{"type", "GTO"}, {"optimization", {{"Spline", {{"accuracy", 1e-8}}}}}},
         {{"type", "GTO"},
-         {"optimization", radial_dim_reduction_spline_hypers}}};
+         {"optimization", radial_dim_reduction_spline_hypers}},
+        {{"type", "GTO"},
+         {"optimization",
+          {{"Spline", {{"accuracy", 1e-8}, {"fold_cutoff_function", true}}}}}}};
     // if new hypers are added or current ones changed there will be problems
     // with the projection_matrices defined above since their size depend on
     // max_radial and max_angular
@@ -712,6 +720,59 @@ namespace rascal {
                                   {"compute_gradients", true}}};
   };
 
+  template <typename DataFixture>
+  struct SingleHypersSphericalCovariants : DataFixture {
+    using Parent = DataFixture;
+    using ManagerTypeHolder_t = typename Parent::ManagerTypeHolder_t;
+    using Representation_t = CalculatorSphericalCovariants;
+
+    SingleHypersSphericalCovariants() : Parent{} {
+      for (auto & ri_hyp : this->radial_contribution_hypers) {
+        for (auto & fc_hyp : this->fc_hypers) {
+          for (auto & sig_hyp : this->density_hypers) {
+            for (auto & rep_hyp : this->rep_hypers) {
+              rep_hyp["cutoff_function"] = fc_hyp;
+              rep_hyp["gaussian_density"] = sig_hyp;
+              rep_hyp["radial_contribution"] = ri_hyp;
+              this->representation_hypers.push_back(rep_hyp);
+            }
+          }
+        }
+      }
+    };
+
+    ~SingleHypersSphericalCovariants() = default;
+
+    std::vector<json> representation_hypers{};
+
+    std::vector<json> fc_hypers{
+        {{"type", "ShiftedCosine"},
+         {"cutoff", {{"value", 2.5}, {"unit", "AA"}}},
+         {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}}};
+
+    std::vector<json> density_hypers{
+        {{"type", "Constant"},
+         {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}}};
+    std::vector<json> radial_contribution_hypers{{{"type", "GTO"}}};
+    // the lambda = 1 covariants of the symmetric crystals are close to zero
+    // so their normalization would not be well conditioned for finite
+    // differences, the normalization is tested with lambda = 0
+    std::vector<json> rep_hypers{{{"max_radial", 2},
+                                  {"max_angular", 2},
+                                  {"normalize", false},
+                                  {"soap_type", "LambdaSpectrum"},
+                                  {"covariant_lambda", 1},
+                                  {"inversion_symmetry", false},
+                                  {"compute_gradients", true}},
+                                 {{"max_radial", 2},
+                                  {"max_angular", 2},
+                                  {"normalize", true},
+                                  {"soap_type", "LambdaSpectrum"},
+                                  {"covariant_lambda", 0},
+                                  {"inversion_symmetry", true},
+                                  {"compute_gradients", true}}};
+  };
+
   struct ComplexHypersSphericalInvariants : ComplexPeriodicNLCCStrictFixture {
     using Parent = ComplexPeriodicNLCCStrictFixture;
     using ManagerTypeHolder_t = typename Parent::ManagerTypeHolder_t;
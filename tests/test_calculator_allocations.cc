@@ -0,0 +1,249 @@
+/**
+ * @file   test_calculator_allocations.cc
+ *
+ * @author agent <agent@local>
+ *
+ * @date   16 Oct 2026
+ *
+ * @brief  check that the inner loops of the calculators do not allocate
+ *
+ * Copyright  2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "rascal/representations/calculator_spherical_expansion.hh"
+#include "rascal/structure_managers/adaptor_center_contribution.hh"
+#include "rascal/structure_managers/adaptor_half_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_strict.hh"
+#include "rascal/structure_managers/make_structure_manager.hh"
+#include "rascal/structure_managers/structure_manager_centers.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+  //! only the allocations made while counting_allocations is set are counted
+  bool counting_allocations{false};
+  size_t n_allocations{0};
+}  // namespace
+
+#if defined(__GLIBC__)
+/*
+ * Every heap allocation, from operator new or from Eigen, goes through
+ * malloc so it is intercepted here and forwarded to the glibc
+ * implementation, which free() also belongs to.
+ */
+extern "C" void * __libc_malloc(std::size_t size);
+
+extern "C" void * malloc(std::size_t size) noexcept {
+  if (counting_allocations) {
+    ++n_allocations;
+  }
+  return __libc_malloc(size);
+}
+#endif
+
+namespace rascal {
+
+  /**
+   * Counts the heap allocations made during its lifetime (on the calling
+   * thread only, the counter is not synchronized)
+   */
+  class AllocationCounter {
+   public:
+    AllocationCounter() {
+      n_allocations = 0;
+      counting_allocations = true;
+    }
+
+    ~AllocationCounter() { counting_allocations = false; }
+
+    size_t get_count() const { return n_allocations; }
+
+    //! tells if the allocations can be counted on this platform
+    static constexpr bool is_available() {
+#if defined(__GLIBC__)
+      return true;
+#else
+      return false;
+#endif
+    }
+  };
+
+  /**
+   * Gives access to the accumulation of the expansion of a single center
+   */
+  class CalculatorSphericalExpansionAllocations
+      : public CalculatorSphericalExpansion {
+   public:
+    using Parent = CalculatorSphericalExpansion;
+
+    explicit CalculatorSphericalExpansionAllocations(const Hypers_t & hypers)
+        : Parent{hypers} {}
+
+    /**
+     * Number of heap allocations made while accumulating the expansion of
+     * each center of manager. The representation of manager has to be
+     * computed beforehand, which also brings the scratch memory to its
+     * steady state.
+     */
+    template <internal::CutoffFunctionType FcType,
+              internal::RadialBasisType RadialType,
+              internal::AtomicSmearingType SmearingType,
+              internal::OptimizationType OptType, class StructureManager>
+    std::vector<size_t>
+    count_center_allocations(std::shared_ptr<StructureManager> manager) {
+      using Prop_t = Property_t<StructureManager>;
+      using PropGrad_t = PropertyGradient_t<StructureManager>;
+      auto && coefficients{
+          *manager->template get_property<Prop_t>(this->get_name())};
+      auto && coefficients_gradient{
+          *manager->template get_property<PropGrad_t>(
+              this->get_gradient_name())};
+      auto cutoff_function{
+          downcast_cutoff_function<FcType>(this->cutoff_function)};
+      auto radial_integral{
+          downcast_radial_integral_handler<RadialType, SmearingType, OptType>(
+              this->radial_integral)};
+
+      std::vector<size_t> allocations{};
+      for (auto center : manager) {
+        size_t count{0};
+        {
+          AllocationCounter counter{};
+          this->compute_center_expansion<FcType, RadialType, SmearingType,
+                                         OptType>(
+              manager, center, coefficients, coefficients_gradient,
+              radial_integral, cutoff_function, this->spherical_harmonics,
+              this->workspace);
+          count = counter.get_count();
+        }
+        allocations.push_back(count);
+      }
+      return allocations;
+    }
+  };
+
+  struct CalculatorAllocationsFixture {
+    CalculatorAllocationsFixture() {
+      json fc_hypers{{"type", "ShiftedCosine"},
+                     {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+                     {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}};
+      json density_hypers{{"type", "Constant"},
+                          {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}};
+      this->hypers = {{"max_radial", 6},
+                      {"max_angular", 4},
+                      {"compute_gradients", true},
+                      {"cutoff_function", fc_hypers},
+                      {"gaussian_density", density_hypers}};
+    }
+
+    //! hypers of a GTO radial basis with or without spline
+    json get_hypers(bool use_spline) const {
+      json hypers_gto = this->hypers;
+      json optimization_hypers = json::object();
+      if (use_spline) {
+        optimization_hypers["Spline"] = {{"accuracy", 1e-8}};
+      }
+      hypers_gto["radial_contribution"] = {
+          {"type", "GTO"}, {"optimization", optimization_hypers}};
+      return hypers_gto;
+    }
+
+    json get_adaptors(bool half_list) const {
+      json adaptors{};
+      adaptors.push_back({{"name", "AdaptorNeighbourList"},
+                          {"initialization_arguments", {{"cutoff", cutoff}}}});
+      if (half_list) {
+        adaptors.push_back(
+            {{"name", "AdaptorHalfList"}, {"initialization_arguments", {}}});
+      }
+      adaptors.push_back({{"name", "AdaptorCenterContribution"},
+                          {"initialization_arguments", {}}});
+      adaptors.push_back({{"name", "AdaptorStrict"},
+                          {"initialization_arguments", {{"cutoff", cutoff}}}});
+      return adaptors;
+    }
+
+    template <internal::OptimizationType OptType, class Manager>
+    void check_no_allocations(std::shared_ptr<Manager> manager) {
+      using internal::AtomicSmearingType;
+      using internal::CutoffFunctionType;
+      using internal::OptimizationType;
+      using internal::RadialBasisType;
+      CalculatorSphericalExpansionAllocations calculator{
+          this->get_hypers(OptType == OptimizationType::Spline)};
+      calculator.set_n_threads(1);
+      // sizes the scratch memory for the largest environment
+      calculator.compute(manager);
+      auto allocations{calculator.template count_center_allocations<
+          CutoffFunctionType::ShiftedCosine, RadialBasisType::GTO,
+          AtomicSmearingType::Constant, OptType>(manager)};
+      BOOST_CHECK_EQUAL(allocations.size(), manager->size());
+      for (const auto & count : allocations) {
+        BOOST_CHECK_EQUAL(count, 0);
+      }
+    }
+
+    double cutoff{3.};
+    json hypers{};
+    std::vector<std::string> filenames{
+        "reference_data/inputs/CaCrP2O7_mvc-11955_symmetrized.json",
+        "reference_data/inputs/small_molecule.json"};
+  };
+
+  BOOST_FIXTURE_TEST_SUITE(calculator_allocations_test,
+                           CalculatorAllocationsFixture);
+
+  /**
+   * The accumulation of the expansion (and its gradients) of a center does
+   * not allocate once the calculator has seen an environment as large, with
+   * a full and with a half neighbour list and with or without the spline of
+   * the radial integral.
+   */
+  BOOST_AUTO_TEST_CASE(spherical_expansion_center_allocations_test) {
+    using internal::OptimizationType;
+    if (not AllocationCounter::is_available()) {
+      BOOST_TEST_MESSAGE("Heap allocations can't be counted on this platform");
+      return;
+    }
+    for (const auto & filename : this->filenames) {
+      json structure{{"filename", filename}};
+      auto manager{
+          make_structure_manager_stack<StructureManagerCenters,
+                                       AdaptorNeighbourList,
+                                       AdaptorCenterContribution,
+                                       AdaptorStrict>(
+              structure, this->get_adaptors(false))};
+      this->check_no_allocations<OptimizationType::Spline>(manager);
+      this->check_no_allocations<OptimizationType::None>(manager);
+
+      auto manager_half{make_structure_manager_stack<
+          StructureManagerCenters, AdaptorNeighbourList, AdaptorHalfList,
+          AdaptorCenterContribution, AdaptorStrict>(
+          structure, this->get_adaptors(true))};
+      this->check_no_allocations<OptimizationType::Spline>(manager_half);
+      this->check_no_allocations<OptimizationType::None>(manager_half);
+    }
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace rascal
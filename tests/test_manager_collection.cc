@@ -31,6 +31,9 @@
 #include <boost/mpl/list.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <cstdio>
+#include <fstream>
+
 namespace rascal {
 
   BOOST_AUTO_TEST_SUITE(manager_collection_test);
@@ -76,6 +79,64 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that the structures read from the file in text and ubjson format
+   * one by one, by slices and by chunks are the ones of the whole file
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(ase_reader_test, Fix, fixtures_test, Fix) {
+    auto & filename = Fix::filename;
+    auto & start = Fix::start;
+    auto & length = Fix::length;
+
+    json data = json_io::load(filename);
+    auto ids{data["ids"].get<std::vector<int>>()};
+    std::sort(ids.begin(), ids.end());
+    json structures = json::array();
+    for (auto & idx : ids) {
+      structures.push_back(data[std::to_string(idx)]);
+    }
+
+    std::string bin_filename{"ase_reader_test.ubjson"};
+    {
+      auto bin_data{json::to_ubjson(data)};
+      std::ofstream bin_file(bin_filename, std::ios::binary);
+      bin_file.write(reinterpret_cast<const char *>(bin_data.data()),
+                     bin_data.size());
+    }
+
+    for (auto & fname : std::vector<std::string>{filename, bin_filename}) {
+      json_io::AseReader reader{fname};
+      BOOST_REQUIRE_EQUAL(reader.size(), structures.size());
+      BOOST_CHECK(reader.read(start) == structures[start]);
+      BOOST_CHECK(reader.read(structures.size() - 1) == structures.back());
+
+      json slice = reader.read(start, length);
+      BOOST_REQUIRE_EQUAL(slice.size(), static_cast<size_t>(length));
+      for (int i_structure{0}; i_structure < length; ++i_structure) {
+        BOOST_CHECK(slice[i_structure] == structures[start + i_structure]);
+      }
+      BOOST_CHECK_EQUAL(reader.read(start, -1).size(),
+                        structures.size() - start);
+      BOOST_CHECK_THROW(reader.read(structures.size()), std::runtime_error);
+
+      size_t chunk_size{static_cast<size_t>(length)};
+      size_t i_structure{0};
+      size_t n_chunks{0};
+      for (auto && chunk : reader.chunks(chunk_size)) {
+        BOOST_CHECK_LE(chunk.size(), chunk_size);
+        for (auto & structure : chunk) {
+          BOOST_CHECK(structure == structures[i_structure]);
+          ++i_structure;
+        }
+        ++n_chunks;
+      }
+      BOOST_CHECK_EQUAL(i_structure, structures.size());
+      BOOST_CHECK_EQUAL(n_chunks,
+                        (structures.size() + chunk_size - 1) / chunk_size);
+    }
+    std::remove(bin_filename.c_str());
+  }
+
   /**
    * Test adding structures with json hyper parameter format
    */
@@ -0,0 +1,130 @@
+/**
+ * @file   test_math_clebsch_gordan.cc
+ *
+ * @author agent <agent@local>
+ *
+ * @date   17 October 2026
+ *
+ * @brief Test the Clebsch-Gordan coefficients of the real spherical harmonics
+ *
+ * Copyright  2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "rascal/math/clebsch_gordan.hh"
+#include "rascal/math/spherical_harmonics.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace rascal {
+
+  BOOST_AUTO_TEST_SUITE(MathClebschGordanTests);
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * The real Clebsch-Gordan coefficients of (l1, l2) form an orthogonal
+   * matrix between the (m1, m2) and the (L, M) components
+   */
+  BOOST_AUTO_TEST_CASE(clebsch_gordan_orthogonality_test) {
+    const size_t max_angular{4};
+    math::ClebschGordanReal clebsch_gordan{max_angular};
+    BOOST_CHECK_EQUAL(clebsch_gordan.get_max_angular(), max_angular);
+    for (size_t l1{0}; l1 < max_angular + 1; ++l1) {
+      for (size_t l2{0}; l2 < max_angular + 1; ++l2) {
+        const size_t n_m1m2{(2 * l1 + 1) * (2 * l2 + 1)};
+        math::Matrix_t cg_matrix{math::Matrix_t::Zero(n_m1m2, n_m1m2)};
+        size_t LM_offset{0};
+        for (size_t L{0}; L < 2 * max_angular + 1; ++L) {
+          const auto & couplings{clebsch_gordan.get_couplings(l1, l2, L)};
+          const bool triangle{L + l1 >= l2 and L + l2 >= l1 and
+                              L <= l1 + l2};
+          BOOST_CHECK_EQUAL(couplings.empty(), not triangle);
+          for (const auto & coupling : couplings) {
+            cg_matrix(coupling.m1 * (2 * l2 + 1) + coupling.m2,
+                      LM_offset + coupling.M) = coupling.value;
+          }
+          if (triangle) {
+            LM_offset += 2 * L + 1;
+          }
+        }
+        BOOST_CHECK_EQUAL(LM_offset, n_m1m2);
+        const double error{
+            (cg_matrix.transpose() * cg_matrix -
+             math::Matrix_t::Identity(n_m1m2, n_m1m2))
+                .array()
+                .abs()
+                .maxCoeff()};
+        BOOST_CHECK_SMALL(error, 1e-13);
+      }
+    }
+    BOOST_CHECK_THROW(clebsch_gordan.get_couplings(max_angular + 1, 0, 1),
+                      std::out_of_range);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * Coupling the real spherical harmonics of a direction gives back the
+   * spherical harmonics of degree L up to a factor that does not depend on
+   * the direction, or zero when l1 + l2 + L is odd
+   */
+  BOOST_AUTO_TEST_CASE(clebsch_gordan_spherical_harmonics_test) {
+    const size_t max_angular{3};
+    math::ClebschGordanReal clebsch_gordan{max_angular};
+    math::SphericalHarmonics harmonics_calculator{};
+    harmonics_calculator.precompute(2 * max_angular);
+
+    std::vector<Eigen::Vector3d> directions{};
+    directions.emplace_back(0.3, -0.5, 0.8);
+    directions.emplace_back(-0.9, 0.1, 0.2);
+    directions.emplace_back(0.2, 0.7, -0.4);
+
+    for (size_t l1{0}; l1 < max_angular + 1; ++l1) {
+      for (size_t l2{0}; l2 < max_angular + 1; ++l2) {
+        for (size_t L{l1 > l2 ? l1 - l2 : l2 - l1}; L < l1 + l2 + 1; ++L) {
+          double factor{0.};
+          for (size_t i_dir{0}; i_dir < directions.size(); ++i_dir) {
+            harmonics_calculator.calc(directions[i_dir].normalized());
+            const auto harmonics{harmonics_calculator.get_harmonics()};
+            math::Matrix_t Y1(1, 2 * l1 + 1);
+            Y1.row(0) = harmonics.segment(l1 * l1, 2 * l1 + 1);
+            math::Matrix_t Y2(1, 2 * l2 + 1);
+            Y2.row(0) = harmonics.segment(l2 * l2, 2 * l2 + 1);
+            const Eigen::VectorXd YL{harmonics.segment(L * L, 2 * L + 1)};
+            const Eigen::VectorXd coupled{
+                clebsch_gordan.combine(Y1, Y2, L).row(0).transpose()};
+            BOOST_REQUIRE_EQUAL(coupled.size(), YL.size());
+            if ((l1 + l2 + L) % 2 == 1) {
+              BOOST_CHECK_SMALL(coupled.norm(), 1e-13);
+              continue;
+            }
+            if (i_dir == 0) {
+              factor = coupled.dot(YL) / YL.squaredNorm();
+              BOOST_CHECK_GT(std::abs(factor), 1e-3);
+            }
+            BOOST_CHECK_SMALL((coupled - factor * YL).norm(), 1e-12);
+          }
+        }
+      }
+    }
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace rascal
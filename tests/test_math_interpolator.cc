@@ -266,5 +266,98 @@ namespace rascal {
     BOOST_CHECK_LE(error, error_bound);
   }
 
+  /**
+   * Interpolating several points at once into a preallocated matrix gives the
+   * same result as interpolating them one at a time
+   */
+  BOOST_FIXTURE_TEST_CASE(matrix_interpolator_batch_test,
+                          InterpolatorFixture<IntpMatrixUniformCubicSpline>) {
+    Vector_t ref_points = Vector_t::LinSpaced(nb_ref_points, x1, x2);
+
+    std::function<Matrix_t(double)> func = [&](double x) {
+      return this->radial_contr.compute_neighbour_contribution(x, 0.5);
+    };
+    Matrix_t tmp_mat = func(x1);
+    int cols = tmp_mat.cols();
+    int rows = tmp_mat.rows();
+    auto intp{std::make_shared<IntpMatrixUniformCubicSpline>(
+        func, x1, x2, error_bound, cols, rows)};
+
+    int matrix_size = rows * cols;
+    // write in the middle of a larger matrix to check that the other rows
+    // are left untouched
+    Matrix_t intp_batch = Matrix_t::Zero(ref_points.size() + 2, matrix_size);
+    Matrix_t intp_derivative_batch =
+        Matrix_t::Zero(ref_points.size() + 2, matrix_size);
+    intp->interpolate_to_matrix(
+        ref_points, intp_batch.middleRows(1, ref_points.size()));
+    intp->interpolate_to_matrix_derivative(
+        ref_points, intp_derivative_batch.middleRows(1, ref_points.size()));
+    BOOST_CHECK_EQUAL(intp_batch.row(0).norm(), 0.);
+    BOOST_CHECK_EQUAL(intp_batch.bottomRows(1).norm(), 0.);
+    BOOST_CHECK_EQUAL(intp_derivative_batch.row(0).norm(), 0.);
+    BOOST_CHECK_EQUAL(intp_derivative_batch.bottomRows(1).norm(), 0.);
+    for (int i{0}; i < ref_points.size(); i++) {
+      Vector_t intp_val{intp->interpolate_to_vector(ref_points(i))};
+      Vector_t intp_derivative_val{
+          intp->interpolate_to_vector_derivative(ref_points(i))};
+      BOOST_CHECK_EQUAL((intp_batch.row(i + 1) - intp_val).norm(), 0.);
+      BOOST_CHECK_EQUAL(
+          (intp_derivative_batch.row(i + 1) - intp_derivative_val).norm(), 0.);
+    }
+  }
+
+  /**
+   * The interval-major polynomial table of the matrix interpolator gives the
+   * same values and derivatives as the cubic spline of each output taken
+   * separately, and its single precision copy agrees up to rounding
+   */
+  BOOST_FIXTURE_TEST_CASE(matrix_interpolator_table_test,
+                          InterpolatorFixture<IntpMatrixUniformCubicSpline>) {
+    Vector_t ref_points = Vector_t::LinSpaced(nb_ref_points, x1, x2);
+
+    std::function<Matrix_t(double)> func = [&](double x) {
+      return this->radial_contr.compute_neighbour_contribution(x, 0.5);
+    };
+    Matrix_t tmp_mat = func(x1);
+    int cols = tmp_mat.cols();
+    int rows = tmp_mat.rows();
+    auto intp{std::make_shared<IntpMatrixUniformCubicSpline>(
+        func, x1, x2, error_bound, cols, rows)};
+    BOOST_CHECK(not intp->is_single_precision_table());
+
+    int matrix_size = rows * cols;
+    Matrix_t intp_val(ref_points.size(), matrix_size);
+    Matrix_t intp_derivative_val(ref_points.size(), matrix_size);
+    intp->interpolate_to_matrix(ref_points, intp_val);
+    intp->interpolate_to_matrix_derivative(ref_points, intp_derivative_val);
+    const Vector_t grid{intp->get_grid_ref()};
+    const Matrix_t evaluated_grid{intp->get_evaluated_grid_ref()};
+    for (int k{0}; k < matrix_size; k++) {
+      IntpScalarUniformCubicSpline intp_scalar{grid, evaluated_grid.col(k)};
+      const double scale{evaluated_grid.col(k).array().abs().maxCoeff()};
+      for (int i{0}; i < ref_points.size(); i++) {
+        BOOST_CHECK_SMALL(
+            intp_val(i, k) - intp_scalar.interpolate(ref_points(i)),
+            1e-13 * scale);
+        BOOST_CHECK_SMALL(intp_derivative_val(i, k) -
+                              intp_scalar.interpolate_derivative(ref_points(i)),
+                          1e-11 * scale);
+      }
+    }
+
+    intp->set_single_precision_table(true);
+    BOOST_CHECK(intp->is_single_precision_table());
+    Matrix_t intp_single_val(ref_points.size(), matrix_size);
+    intp->interpolate_to_matrix(ref_points, intp_single_val);
+    const double scale{intp_val.array().abs().maxCoeff()};
+    BOOST_CHECK_GT((intp_single_val - intp_val).array().abs().maxCoeff(), 0.);
+    BOOST_CHECK_LE((intp_single_val - intp_val).array().abs().maxCoeff(),
+                   1e-6 * scale);
+    intp->set_single_precision_table(false);
+    intp->interpolate_to_matrix(ref_points, intp_single_val);
+    BOOST_CHECK_EQUAL((intp_single_val - intp_val).norm(), 0.);
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 }  // namespace rascal
@@ -215,6 +215,70 @@ namespace rascal {
   }
   */
 
+  /**
+   * Test that the batched evaluation of the spherical harmonics and their
+   * derivatives matches the evaluation one direction at a time, including
+   * directions along the z-axis and close to the poles and the equator.
+   */
+  BOOST_FIXTURE_TEST_CASE(math_spherical_harmonics_batch_test,
+                          SphericalHarmonicsClassRefFixture) {
+    size_t max_angular_l = this->ref_data[0]["max_angular_l"];
+    std::vector<Eigen::Vector3d> unit_vectors{};
+    for (auto & data : this->ref_data) {
+      std::vector<double> unit_vector_tmp = data["unit_vector"];
+      unit_vectors.emplace_back(unit_vector_tmp.data());
+    }
+    unit_vectors.emplace_back(0., 0., 1.);
+    unit_vectors.emplace_back(0., 0., -1.);
+    unit_vectors.emplace_back(1., 0., 0.);
+    unit_vectors.emplace_back(Eigen::Vector3d(0.05, -0.03, 1.).normalized());
+    unit_vectors.emplace_back(Eigen::Vector3d(0.3, -0.7, 1e-3).normalized());
+
+    math::MatrixX3_t directions(unit_vectors.size(), 3);
+    for (size_t i_direction{0}; i_direction < unit_vectors.size();
+         ++i_direction) {
+      directions.row(i_direction) = unit_vectors[i_direction].transpose();
+    }
+
+    math::SphericalHarmonics harmonics_calculator{true};
+    harmonics_calculator.precompute(max_angular_l);
+    math::SphericalHarmonics harmonics_batch_calculator{true};
+    harmonics_batch_calculator.precompute(max_angular_l);
+
+    const size_t n_harmonics{(max_angular_l + 1) * (max_angular_l + 1)};
+    for (bool conjugate : {false, true}) {
+      // a smaller batch first to check that the storage is grown properly
+      harmonics_batch_calculator.calc_batch(directions.topRows(2), true,
+                                            conjugate);
+      harmonics_batch_calculator.calc_batch(directions, true, conjugate);
+      auto harmonics_batch = harmonics_batch_calculator.get_harmonics_batch();
+      auto derivatives_batch =
+          harmonics_batch_calculator.get_harmonics_derivatives_batch();
+      BOOST_REQUIRE_EQUAL(harmonics_batch.rows(), directions.rows());
+      BOOST_REQUIRE_EQUAL(harmonics_batch.cols(), n_harmonics);
+      BOOST_REQUIRE_EQUAL(derivatives_batch.cols(), 3 * n_harmonics);
+      for (size_t i_direction{0}; i_direction < unit_vectors.size();
+           ++i_direction) {
+        harmonics_calculator.calc(unit_vectors[i_direction], true, conjugate);
+        auto harmonics = harmonics_calculator.get_harmonics();
+        auto derivatives = harmonics_calculator.get_harmonics_derivatives();
+        double error{(harmonics_batch.row(i_direction) - harmonics)
+                         .cwiseAbs()
+                         .maxCoeff()};
+        BOOST_CHECK_LE(error, 10 * math::DBL_FTOL);
+        for (int cartesian_idx{0}; cartesian_idx < 3; ++cartesian_idx) {
+          double error_derivatives{
+              (derivatives_batch.row(i_direction)
+                   .segment(cartesian_idx * n_harmonics, n_harmonics) -
+               derivatives.row(cartesian_idx))
+                  .cwiseAbs()
+                  .maxCoeff()};
+          BOOST_CHECK_LE(error_derivatives, 100 * math::DBL_FTOL);
+        }
+      }
+    }
+  }
+
   BOOST_AUTO_TEST_CASE(spherical_harmonics_gradient_test) {
     // (max) what?! how does this even remain numerically stable?
     // it's total overkill in any case, 10 or even 3 would suffice
@@ -0,0 +1,239 @@
+/**
+ * @file   test_optimal_radial_basis.cc
+ *
+ * @author agent <agent@local>
+ *
+ * @date   17 October 2026
+ *
+ * @brief  Test the estimation of the optimal radial basis
+ *
+ * Copyright  2026 agent, COSMO (EPFL), LAMMM (EPFL)
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "rascal/representations/calculator_spherical_expansion.hh"
+#include "rascal/representations/optimal_radial_basis.hh"
+#include "rascal/structure_managers/adaptor_center_contribution.hh"
+#include "rascal/structure_managers/adaptor_neighbour_list.hh"
+#include "rascal/structure_managers/adaptor_strict.hh"
+#include "rascal/structure_managers/structure_manager_centers.hh"
+#include "rascal/structure_managers/structure_manager_collection.hh"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+
+namespace rascal {
+
+  BOOST_AUTO_TEST_SUITE(optimal_radial_basis_test);
+
+  struct OptimalRadialBasisFixture {
+    using ManagerCollection_t =
+        ManagerCollection<StructureManagerCenters, AdaptorNeighbourList,
+                          AdaptorCenterContribution, AdaptorStrict>;
+    using Manager_t = typename ManagerCollection_t::Manager_t;
+    using Prop_t = typename CalculatorSphericalExpansion::template Property_t<
+        Manager_t>;
+
+    OptimalRadialBasisFixture() {
+      json fc_hypers{{"type", "ShiftedCosine"},
+                     {"cutoff", {{"value", cutoff}, {"unit", "AA"}}},
+                     {"smooth_width", {{"value", 0.5}, {"unit", "AA"}}}};
+      json sigma_hypers{{"type", "Constant"},
+                        {"gaussian_sigma", {{"value", 0.4}, {"unit", "AA"}}}};
+      hypers["cutoff_function"] = fc_hypers;
+      hypers["gaussian_density"] = sigma_hypers;
+      hypers["radial_contribution"] = {{"type", "GTO"}};
+
+      json ad1a{{"name", "AdaptorNeighbourList"},
+                {"initialization_arguments", {{"cutoff", cutoff}}}};
+      json ad1b{{"name", "AdaptorCenterContribution"},
+                {"initialization_arguments", {}}};
+      json ad2{{"name", "AdaptorStrict"},
+               {"initialization_arguments", {{"cutoff", cutoff}}}};
+      adaptors.emplace_back(ad1a);
+      adaptors.emplace_back(ad1b);
+      adaptors.emplace_back(ad2);
+    }
+
+    std::string filename{"reference_data/inputs/small_molecules-20.json"};
+    double cutoff{3.};
+    size_t max_radial{3};
+    size_t max_angular{3};
+    size_t expanded_max_radial{8};
+    json hypers{{"max_radial", max_radial},
+                {"max_angular", max_angular},
+                {"compute_gradients", false}};
+    json adaptors{};
+  };
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * The covariance accumulated over chunks of structures matches the
+   * covariance computed directly from the expansion coefficients of all
+   * the structures.
+   */
+  BOOST_FIXTURE_TEST_CASE(covariance_test, OptimalRadialBasisFixture) {
+    json expansion_hypers = hypers;
+    expansion_hypers["max_radial"] = expanded_max_radial;
+    CalculatorSphericalExpansion expansion{expansion_hypers};
+
+    RadialBasisCovariance covariance{expanded_max_radial, max_angular};
+    ManagerCollection_t managers_a{adaptors};
+    managers_a.add_structures(filename, 0, 5);
+    covariance.accumulate(expansion, managers_a);
+    ManagerCollection_t managers_b{adaptors};
+    managers_b.add_structures(filename, 5, 5);
+    covariance.accumulate(expansion, managers_b);
+
+    ManagerCollection_t managers{adaptors};
+    managers.add_structures(filename, 0, 10);
+    expansion.compute(managers);
+    RadialBasisCovariance::Matrices_t covariances_ref{};
+    size_t n_environments{0};
+    for (auto & manager : managers) {
+      auto && coefficients{
+          *manager->template get_property<Prop_t>(expansion.get_name(), true)};
+      for (auto center : manager) {
+        auto && coefficients_by_center{coefficients[center]};
+        for (const auto & key : coefficients_by_center.get_keys()) {
+          auto & covariances_by_sp{covariances_ref[key[0]]};
+          covariances_by_sp.resize(
+              max_angular + 1,
+              math::Matrix_t::Zero(expanded_max_radial, expanded_max_radial));
+          auto block{coefficients_by_center[key]};
+          for (size_t l{0}; l < max_angular + 1; ++l) {
+            for (size_t m{l * l}; m < (l + 1) * (l + 1); ++m) {
+              for (size_t n1{0}; n1 < expanded_max_radial; ++n1) {
+                for (size_t n2{0}; n2 < expanded_max_radial; ++n2) {
+                  covariances_by_sp[l](n1, n2) += block(n1, m) * block(n2, m);
+                }
+              }
+            }
+          }
+        }
+        ++n_environments;
+      }
+    }
+
+    BOOST_CHECK_EQUAL(covariance.get_n_environments(), n_environments);
+    auto covariances{covariance.get_covariances()};
+    BOOST_CHECK_EQUAL(covariances.size(), covariances_ref.size());
+    for (auto & sp_covariances_ref : covariances_ref) {
+      const auto & covariances_by_sp{covariances.at(sp_covariances_ref.first)};
+      for (size_t l{0}; l < max_angular + 1; ++l) {
+        math::Matrix_t covariance_ref{sp_covariances_ref.second[l] /
+                                      static_cast<double>(n_environments)};
+        const double error{
+            (covariances_by_sp[l] - covariance_ref).array().abs().maxCoeff()};
+        BOOST_CHECK_SMALL(error,
+                          1e-13 * covariance_ref.array().abs().maxCoeff());
+      }
+    }
+
+    // the projections are orthonormal and sorted by decreasing variance
+    for (const auto & sp_projections :
+         covariance.get_projection_matrices(max_radial)) {
+      for (size_t l{0}; l < max_angular + 1; ++l) {
+        const auto & projection{sp_projections.second[l]};
+        BOOST_CHECK_EQUAL(projection.rows(), max_radial);
+        BOOST_CHECK_EQUAL(projection.cols(), expanded_max_radial);
+        const auto & covariance_l{covariances.at(sp_projections.first)[l]};
+        math::Matrix_t variances{projection * covariance_l *
+                                 projection.transpose()};
+        BOOST_CHECK_SMALL((projection * projection.transpose() -
+                           math::Matrix_t::Identity(max_radial, max_radial))
+                              .array()
+                              .abs()
+                              .maxCoeff(),
+                          1e-12);
+        for (size_t i_comp{1}; i_comp < max_radial; ++i_comp) {
+          BOOST_CHECK_LE(variances(i_comp, i_comp),
+                         variances(i_comp - 1, i_comp - 1) * (1 + 1e-12));
+        }
+      }
+    }
+    BOOST_CHECK_THROW(
+        covariance.get_projection_matrices(expanded_max_radial + 1),
+        std::logic_error);
+  }
+
+  /* ---------------------------------------------------------------------- */
+  /**
+   * The spherical expansion on the optimal radial basis is the projection
+   * of the expansion on the expanded radial basis.
+   */
+  BOOST_FIXTURE_TEST_CASE(optimal_expansion_test, OptimalRadialBasisFixture) {
+    ManagerCollection_t managers{adaptors};
+    managers.add_structures(filename, 0, 10);
+    json optimal_hypers = get_optimal_radial_basis_hypers(
+        hypers, managers, static_cast<int>(expanded_max_radial));
+    auto && optimization{
+        optimal_hypers.at("radial_contribution").at("optimization")};
+    BOOST_TEST(optimization.count("Spline"));
+    BOOST_TEST(optimization.count("RadialDimReduction"));
+
+    json expansion_hypers = hypers;
+    expansion_hypers["max_radial"] = expanded_max_radial;
+    CalculatorSphericalExpansion expansion{expansion_hypers};
+    CalculatorSphericalExpansion optimal_expansion{optimal_hypers};
+    expansion.compute(managers);
+    optimal_expansion.compute(managers);
+
+    RadialBasisCovariance covariance{expanded_max_radial, max_angular};
+    for (auto & manager : managers) {
+      covariance.accumulate_structure(expansion, manager);
+    }
+    const auto projections{covariance.get_projection_matrices(max_radial)};
+
+    double max_error{0.};
+    double max_value{0.};
+    for (auto & manager : managers) {
+      auto && coefficients{
+          *manager->template get_property<Prop_t>(expansion.get_name(), true)};
+      auto && optimal_coefficients{*manager->template get_property<Prop_t>(
+          optimal_expansion.get_name(), true)};
+      BOOST_CHECK_EQUAL(optimal_coefficients.get_nb_row(), max_radial);
+      for (auto center : manager) {
+        auto && coefficients_by_center{coefficients[center]};
+        auto && optimal_coefficients_by_center{optimal_coefficients[center]};
+        for (const auto & key : coefficients_by_center.get_keys()) {
+          auto block{coefficients_by_center[key]};
+          auto optimal_block{optimal_coefficients_by_center[key]};
+          for (size_t l{0}; l < max_angular + 1; ++l) {
+            math::Matrix_t projected{
+                projections.at(key[0])[l] *
+                block.middleCols(l * l, 2 * l + 1)};
+            // the covariance is the same so are the principal components
+            const double error{
+                (optimal_block.middleCols(l * l, 2 * l + 1) - projected)
+                    .array()
+                    .abs()
+                    .maxCoeff()};
+            max_error = std::max(max_error, error);
+            max_value =
+                std::max(max_value, projected.array().abs().maxCoeff());
+          }
+        }
+      }
+    }
+    BOOST_TEST(max_value > 0.);
+    BOOST_CHECK_SMALL(max_error, 1e-6 * max_value);
+  }
+
+  BOOST_AUTO_TEST_SUITE_END();
+
+}  // namespace rascal
@@ -944,6 +944,67 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  /**
+   * checks that the blocks accessed through the key ids are the same as the
+   * ones accessed with the keys, and that the ids are shared by the entries
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(key_id_access_test, Fix, Fixtures, Fix) {
+    using SortedKey_t = typename Fix::BlockSparseProperty_t::SortedKey_t;
+    auto & managers = Fix::managers;
+    auto & keys_list = Fix::keys_list;
+    auto & sparse_features = Fix::sparse_features;
+    auto & test_datas = Fix::test_datas;
+
+    auto i_manager{0};
+    for (auto & manager : managers) {
+      auto & sparse_feature{sparse_features[i_manager]};
+      auto & keys{keys_list[i_manager]};
+      sparse_feature.set_shape(Fix::n_row, Fix::n_col);
+      sparse_feature.resize(keys);
+      sparse_feature.setZero();
+      auto i_center{0};
+      for (auto center : manager) {
+        auto && sparse_feature_center{sparse_feature[center]};
+        for (auto & key : keys[i_center]) {
+          int key_id{sparse_feature.find_key_id(SortedKey_t{key})};
+          BOOST_REQUIRE(sparse_feature_center.has_key_id(key_id));
+          BOOST_CHECK_EQUAL(key_id,
+                            sparse_feature.find_key_id_by_element(key[0]));
+          sparse_feature_center.block_by_id(key_id) =
+              test_datas[i_manager][i_center][key];
+        }
+        i_center++;
+      }
+
+      i_center = 0;
+      for (auto center : manager) {
+        auto && sparse_feature_center{sparse_feature[center]};
+        auto center_keys{sparse_feature_center.get_keys()};
+        auto center_key_ids{sparse_feature_center.get_key_ids()};
+        BOOST_REQUIRE_EQUAL(center_keys.size(), center_key_ids.size());
+        for (size_t i_key{0}; i_key < center_keys.size(); ++i_key) {
+          auto & key{center_keys[i_key]};
+          BOOST_CHECK_EQUAL(center_key_ids[i_key],
+                            sparse_feature.find_key_id(SortedKey_t{key}));
+          auto error{(sparse_feature_center[key] -
+                      test_datas[i_manager][i_center][key])
+                         .norm()};
+          BOOST_CHECK_LE(error, TOLERANCE);
+        }
+        // a key that is not in this entry
+        typename Fix::Key_t missing_key{-1};
+        BOOST_CHECK_EQUAL(sparse_feature_center.count(missing_key), 0);
+        BOOST_CHECK(not sparse_feature_center.has_key_id(
+            sparse_feature.find_key_id(SortedKey_t{missing_key})));
+        BOOST_CHECK_THROW(sparse_feature_center.at(missing_key),
+                          std::out_of_range);
+        i_center++;
+      }
+      i_manager++;
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   /**
    * test, if metadata can be assigned to properties
@@ -44,7 +44,7 @@ namespace rascal {
                         AdaptorCenterContribution, AdaptorStrict>;
 
   template <class Representation, class ManagerCollection,
-            template <class> class SparsePoints>
+            template <class...> class SparsePoints>
   struct SparsePointsFixture {
     using Representation_t = Representation;
     using ManagerCollection_t = ManagerCollection;
@@ -93,6 +93,66 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that the kernels computed by batches of centers match the kernels
+   * computed center by center with the sparse points.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(batched_kernel_test, Fix, multiple_fixtures,
+                                   Fix) {
+    using Calculator_t = typename Fix::Calculator_t;
+    using Prop_t = typename Fix::Property_t;
+    auto & representations = Fix::representations;
+    auto & collections = Fix::collections;
+    const double delta{1e-12};
+
+    for (auto & collection : collections) {
+      for (auto & representation : representations) {
+        // use every other center as sparse point
+        std::vector<std::vector<int>> selected_ids{};
+        for (auto & manager : collection) {
+          selected_ids.emplace_back();
+          for (int i_center{0}; i_center < static_cast<int>(manager->size());
+               i_center += 2) {
+            selected_ids.back().push_back(i_center);
+          }
+        }
+        SparsePointsBlockSparse<Calculator_t> sparse_points{};
+        sparse_points.push_back(representation, collection, selected_ids);
+
+        for (const size_t zeta : {1, 2, 3}) {
+          for (const std::string target_type : {"Structure", "Atom"}) {
+            json kernel_hypers{
+                {"zeta", zeta}, {"target_type", target_type}, {"name", "GAP"}};
+            SparseKernel kernel{kernel_hypers};
+            auto KNM{kernel.compute(representation, collection, sparse_points)};
+
+            math::Matrix_t KNM_ref{KNM.rows(), KNM.cols()};
+            KNM_ref.setZero();
+            int i_row{0};
+            for (auto & manager : collection) {
+              auto && prop{*manager->template get_property<Prop_t>(
+                  representation.get_name(), true)};
+              for (auto center : manager) {
+                math::Matrix_t k_row{internal::pow_zeta(
+                    sparse_points.dot(center.get_atom_type(), prop[center]),
+                    zeta)};
+                KNM_ref.row(i_row) += k_row.transpose();
+                if (target_type == "Atom") {
+                  ++i_row;
+                }
+              }
+              if (target_type == "Structure") {
+                ++i_row;
+              }
+            }
+            double diff{(KNM - KNM_ref).array().abs().maxCoeff()};
+            BOOST_TEST(diff < delta * KNM_ref.array().abs().maxCoeff());
+          }
+        }
+      }
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   /**
    * Utility fixture used to compare representations with sparsification
@@ -216,6 +276,60 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that the numerical kernel gradients computed in parallel with only
+   * the centers around the displaced atom match the ones computed by
+   * recomputing the whole structure, for both target types.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(local_numerical_grad_test, Fix,
+                                   sparse_grad_fixtures, Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Representation_t = typename Fix::Representation_t;
+    using Kernel_t = typename Fix::Kernel_t;
+    using SparsePoints_t = typename Fix::SparsePoints_t;
+    json inputs{};
+    inputs =
+        json_io::load("reference_data/tests_only/sparse_kernel_inputs.json");
+
+    // relative to the kernel since the finite differences amplify its
+    // rounding errors by 1 / h_disp
+    const double delta{1e-10};
+
+    for (const auto & input : inputs) {
+      std::string filename{input.at("filename").template get<std::string>()};
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json calculator_input = input.at("calculator").template get<json>();
+      json kernel_input = input.at("kernel").template get<json>();
+      auto selected_ids = input.at("selected_ids")
+                              .template get<std::vector<std::vector<int>>>();
+      const double h_disp{input.at("h").template get<double>()};
+      ManagerCollection_t managers{adaptors_input};
+      managers.add_structures(filename, 0,
+                              input.at("n_structures").template get<int>());
+      SparsePoints_t sparse_points{};
+      calculator_input["compute_gradients"] = false;
+      Representation_t representation{calculator_input};
+      representation.compute(managers);
+      sparse_points.push_back(representation, managers, selected_ids);
+      representation.set_n_threads(2);
+
+      for (const std::string target_type : {"Structure", "Atom"}) {
+        kernel_input["target_type"] = target_type;
+        Kernel_t kernel{kernel_input};
+        math::Matrix_t KNM_num_der{compute_numerical_kernel_gradients(
+            kernel, representation, managers, sparse_points, h_disp)};
+        math::Matrix_t KNM_num_der_local{compute_numerical_kernel_gradients(
+            kernel, representation, managers, sparse_points, h_disp, false,
+            true)};
+        math::Matrix_t KNM{
+            kernel.compute(representation, managers, sparse_points)};
+        const double scale{KNM.array().abs().maxCoeff() / h_disp};
+        BOOST_TEST((KNM_num_der_local - KNM_num_der).array().abs().maxCoeff() <
+                   delta * scale);
+      }
+    }
+  }
+
   /**
    * Test the analytical kernel stress against numerical kernel stress.
    */
@@ -321,6 +435,394 @@ namespace rascal {
     }
   }
 
+  /**
+   * Test that the fused predictions of SparseGPRPredictor match the
+   * predictions made with the kernel and the dedicated gradient routines.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(sparse_gpr_predictor_test, Fix,
+                                   sparse_grad_fixtures, Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Manager_t = typename ManagerCollection_t::Manager_t;
+    using Representation_t = typename Fix::Representation_t;
+    using Kernel_t = typename Fix::Kernel_t;
+    using SparsePoints_t = typename Fix::SparsePoints_t;
+
+    json inputs{};
+    inputs =
+        json_io::load("reference_data/tests_only/sparse_kernel_inputs.json");
+
+    const double delta{1e-10};
+    const double epsilon{1e-14};
+
+    for (const auto & input : inputs) {
+      std::string filename{input.at("filename").template get<std::string>()};
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json calculator_input = input.at("calculator").template get<json>();
+      json kernel_input = input.at("kernel").template get<json>();
+      auto selected_ids = input.at("selected_ids")
+                              .template get<std::vector<std::vector<int>>>();
+      Kernel_t kernel{kernel_input};
+      ManagerCollection_t managers{adaptors_input};
+      SparsePoints_t sparse_points{};
+      Representation_t representation{calculator_input};
+      managers.add_structures(filename, 0,
+                              input.at("n_structures").template get<int>());
+      representation.compute(managers);
+      sparse_points.push_back(representation, managers, selected_ids);
+
+      math::Vector_t weights{math::Vector_t::Random(sparse_points.size())};
+      std::map<int, double> self_contributions{};
+      for (const int & sp : sparse_points.species()) {
+        self_contributions[sp] = -0.5 * sp;
+      }
+
+      math::Matrix_t energies_k =
+          kernel.compute(representation, managers, sparse_points) *
+          weights.transpose();
+      std::string force_name = compute_sparse_kernel_gradients(
+          representation, kernel, managers, sparse_points, weights);
+      std::string neg_stress_name = compute_sparse_kernel_neg_stress(
+          representation, kernel, managers, sparse_points, weights);
+
+      SparseGPRPredictor<Representation_t> predictor{
+          calculator_input, sparse_points, weights,
+          kernel_input.at("zeta").template get<size_t>(), self_contributions};
+      size_t i_manager{0};
+      for (auto manager : managers) {
+        auto prediction{predictor.predict(manager)};
+
+        double energy_ref{energies_k(i_manager, 0)};
+        for (auto center : manager) {
+          energy_ref += self_contributions.at(center.get_atom_type());
+        }
+        BOOST_TEST(std::abs(prediction.energy - energy_ref) <
+                   delta * std::abs(energy_ref));
+
+        auto && gradients{*manager->template get_property<
+            Property<double, 1, Manager_t, 1, ThreeD>>(force_name, true)};
+        math::Matrix_t forces_ref = -gradients.view();
+        math::Matrix_t forces_diff = math::relative_error(
+            prediction.forces, forces_ref, delta, epsilon);
+        BOOST_TEST(forces_diff.maxCoeff() < delta);
+
+        auto manager_root = extract_underlying_manager<0>(manager);
+        if (manager_root->get_atomic_structure().pbc.any()) {
+          auto && neg_stress{*manager->template get_property<
+              Property<double, 0, Manager_t, 6>>(neg_stress_name, true)};
+          math::Matrix_t stress_ref = -Eigen::Map<const math::Matrix_t>(
+              neg_stress.view().data(), 6, 1);
+          math::Matrix_t stress = prediction.stress;
+          math::Matrix_t stress_diff =
+              math::relative_error(stress, stress_ref, delta, epsilon);
+          BOOST_TEST(stress_diff.maxCoeff() < delta);
+        }
+        ++i_manager;
+      }
+    }
+  }
+
+  /**
+   * Test that storing the representation and the sparse points in single
+   * precision keeps the kernel, the energies and the forces close to the
+   * double precision ones.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(single_precision_test, Fix,
+                                   sparse_grad_fixtures, Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Manager_t = typename ManagerCollection_t::Manager_t;
+    using Representation_t = typename Fix::Representation_t;
+    using PropertySingle_t =
+        typename Representation_t::template Property_t<Manager_t, float>;
+    using Kernel_t = typename Fix::Kernel_t;
+    using SparsePoints_t = typename Fix::SparsePoints_t;
+    using SparsePointsSingle_t =
+        SparsePointsBlockSparse<Representation_t, float>;
+
+    json inputs{};
+    inputs =
+        json_io::load("reference_data/tests_only/sparse_kernel_inputs.json");
+
+    // relative to the largest element of the reference
+    const double delta_kernel{1e-5};
+    const double delta_energy{1e-5};
+    const double delta_forces{1e-4};
+
+    for (const auto & input : inputs) {
+      std::string filename{input.at("filename").template get<std::string>()};
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json calculator_input = input.at("calculator").template get<json>();
+      json kernel_input = input.at("kernel").template get<json>();
+      auto selected_ids = input.at("selected_ids")
+                              .template get<std::vector<std::vector<int>>>();
+      Kernel_t kernel{kernel_input};
+      ManagerCollection_t managers{adaptors_input};
+      managers.add_structures(filename, 0,
+                              input.at("n_structures").template get<int>());
+      Representation_t representation{calculator_input};
+      json calculator_single_input = calculator_input;
+      calculator_single_input["single_precision"] = true;
+      Representation_t representation_single{calculator_single_input};
+      BOOST_TEST(not representation.is_single_precision());
+      BOOST_TEST(representation_single.is_single_precision());
+      representation.compute(managers);
+      representation_single.compute(managers);
+      // the invariants are only kept in single precision and are not
+      // converted again until the structure changes
+      for (auto manager : managers) {
+        auto && soap_vectors_single{
+            *manager->template get_property<PropertySingle_t>(
+                representation_single.get_name())};
+        BOOST_TEST(soap_vectors_single.is_updated());
+      }
+
+      SparsePoints_t sparse_points{};
+      sparse_points.push_back(representation, managers, selected_ids);
+      SparsePointsSingle_t sparse_points_single{};
+      sparse_points_single.push_back(representation_single, managers,
+                                     selected_ids);
+      SparsePointsSingle_t sparse_points_converted{sparse_points};
+      BOOST_TEST((sparse_points_single == sparse_points_converted));
+
+      math::Matrix_t KNM{
+          kernel.compute(representation, managers, sparse_points)};
+      math::Matrix_t KNM_single{kernel.compute(representation_single,
+                                               managers, sparse_points_single)};
+      BOOST_TEST((KNM - KNM_single).array().abs().maxCoeff() <
+                 delta_kernel * KNM.array().abs().maxCoeff());
+
+      math::Vector_t weights{math::Vector_t::Random(sparse_points.size())};
+      const size_t zeta{kernel_input.at("zeta").template get<size_t>()};
+      SparseGPRPredictor<Representation_t> predictor{
+          calculator_input, sparse_points, weights, zeta};
+      SparseGPRPredictor<Representation_t, float> predictor_single{
+          calculator_input, sparse_points_single, weights, zeta};
+      for (auto manager : managers) {
+        auto prediction{predictor.predict(manager)};
+        auto prediction_single{predictor_single.predict(manager)};
+        BOOST_TEST(std::abs(prediction.energy - prediction_single.energy) <
+                   delta_energy * std::abs(prediction.energy));
+        const double force_scale{prediction.forces.array().abs().maxCoeff()};
+        BOOST_TEST((prediction.forces - prediction_single.forces)
+                       .array()
+                       .abs()
+                       .maxCoeff() < delta_forces * force_scale);
+      }
+    }
+  }
+
+  /**
+   * Test that the predictions obtained by back-propagating dE/dX through
+   * the representation match the ones obtained with the gradients of the
+   * representation, for both kinds of PowerSpectrum products, both radial
+   * bases and with or without the spline of the radial integral. The
+   * radial integral of the GTO is evaluated differently below l_max = 3 so
+   * both cases are tested.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(adjoint_gradients_test, Fix,
+                                   sparse_grad_fixtures, Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Representation_t = typename Fix::Representation_t;
+    using SparsePoints_t = typename Fix::SparsePoints_t;
+    using Predictor_t = SparseGPRPredictor<Representation_t>;
+
+    json inputs{};
+    inputs =
+        json_io::load("reference_data/tests_only/sparse_kernel_inputs.json");
+
+    const double delta{1e-10};
+    const double epsilon{1e-14};
+
+    for (const auto & input : inputs) {
+      std::string filename{input.at("filename").template get<std::string>()};
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json kernel_input = input.at("kernel").template get<json>();
+      auto selected_ids = input.at("selected_ids")
+                              .template get<std::vector<std::vector<int>>>();
+      const size_t zeta{kernel_input.at("zeta").template get<size_t>()};
+      for (const std::string product : {"GEMM", "Loop"}) {
+        for (const bool use_spline : {false, true}) {
+          for (const std::string radial_basis : {"GTO", "DVR"}) {
+            for (const int max_angular : {2, 3}) {
+              json calculator_input =
+                  input.at("calculator").template get<json>();
+              calculator_input["powerspectrum_product"] = product;
+              calculator_input["max_angular"] = max_angular;
+              calculator_input["radial_contribution"]["type"] = radial_basis;
+              // the Bessel functions of the DVR basis are computed with one
+              // more order in the recursion when their gradients are needed
+              // so the two predictors differ slightly
+              const double delta_gradients{radial_basis == "DVR" ? 1e-8
+                                                                 : delta};
+              if (use_spline) {
+                calculator_input["radial_contribution"]["optimization"] = {
+                    {"Spline", {{"accuracy", 1e-8}}}};
+              }
+              ManagerCollection_t managers{adaptors_input};
+              managers.add_structures(
+                  filename, 0, input.at("n_structures").template get<int>());
+              Representation_t representation{calculator_input};
+              representation.compute(managers);
+              SparsePoints_t sparse_points{};
+              sparse_points.push_back(representation, managers, selected_ids);
+
+              math::Vector_t weights{
+                  math::Vector_t::Random(sparse_points.size())};
+              Predictor_t predictor{calculator_input, sparse_points, weights,
+                                    zeta};
+              Predictor_t predictor_adjoint{
+                  calculator_input, sparse_points,
+                  weights,          zeta,
+                  {},               Predictor_t::GradientMode::Adjoint};
+              for (auto manager : managers) {
+                auto prediction{predictor.predict(manager)};
+                auto prediction_adjoint{predictor_adjoint.predict(manager)};
+                BOOST_TEST(std::abs(prediction.energy -
+                                    prediction_adjoint.energy) <
+                           delta * std::abs(prediction.energy));
+                math::Matrix_t forces_diff =
+                    math::relative_error(prediction_adjoint.forces,
+                                         prediction.forces, delta, epsilon);
+                BOOST_TEST(forces_diff.maxCoeff() < delta_gradients);
+                // relative to the largest element since some of them vanish
+                const double virial_scale{
+                    prediction.virial.array().abs().maxCoeff()};
+                BOOST_TEST((prediction_adjoint.virial - prediction.virial)
+                               .array()
+                               .abs()
+                               .maxCoeff() < delta_gradients * virial_scale);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Test the predictions of SparseGPRPredictor on the full neighbour list of
+   * lammps, whose neighbours are ghost atoms for the periodic structures,
+   * against the predictions on the structure. The forces on the ghost atoms
+   * are summed on the atoms they are images of, as the reverse
+   * communication of lammps does, and the virial is accumulated like the
+   * pair style does.
+   */
+  BOOST_FIXTURE_TEST_CASE_TEMPLATE(lammps_predictor_test, Fix,
+                                   sparse_grad_fixtures, Fix) {
+    using ManagerCollection_t = typename Fix::ManagerCollection_t;
+    using Representation_t = typename Fix::Representation_t;
+    using SparsePoints_t = typename Fix::SparsePoints_t;
+    using Predictor_t = SparseGPRPredictor<Representation_t>;
+
+    json inputs{};
+    inputs =
+        json_io::load("reference_data/tests_only/sparse_kernel_inputs.json");
+
+    const double delta{1e-10};
+
+    for (const auto & input : inputs) {
+      std::string filename{input.at("filename").template get<std::string>()};
+      json adaptors_input = input.at("adaptors").template get<json>();
+      json calculator_input = input.at("calculator").template get<json>();
+      json kernel_input = input.at("kernel").template get<json>();
+      auto selected_ids = input.at("selected_ids")
+                              .template get<std::vector<std::vector<int>>>();
+      const double cutoff{calculator_input.at("cutoff_function")
+                              .at("cutoff")
+                              .at("value")
+                              .template get<double>()};
+
+      ManagerCollection_t managers{adaptors_input};
+      managers.add_structures(filename, 0,
+                              input.at("n_structures").template get<int>());
+      Representation_t representation{calculator_input};
+      representation.compute(managers);
+      SparsePoints_t sparse_points{};
+      sparse_points.push_back(representation, managers, selected_ids);
+      math::Vector_t weights{math::Vector_t::Random(sparse_points.size())};
+      json model{{"representation", calculator_input},
+                 {"sparse_points", sparse_points},
+                 {"weights", std::vector<double>(weights.data(),
+                                                 weights.data() +
+                                                     weights.size())},
+                 {"zeta", kernel_input.at("zeta")},
+                 {"self_contributions", {{"1", -0.5}, {"6", -1.}}}};
+
+      for (const auto gradient_mode : {Predictor_t::GradientMode::Forward,
+                                       Predictor_t::GradientMode::Adjoint}) {
+        auto predictor{Predictor_t::from_json(model, gradient_mode)};
+        for (auto manager : managers) {
+          auto prediction{predictor.predict(manager)};
+
+          auto manager_root = extract_underlying_manager<0>(manager);
+          LammpsFullNeighbourList neighbour_list{
+              manager_root->get_atomic_structure(), cutoff};
+          auto manager_root_lammps{
+              make_structure_manager<StructureManagerLammpsFull>()};
+          auto manager_center_lammps{
+              make_adapted_manager<AdaptorCenterContribution>(
+                  manager_root_lammps)};
+          auto manager_lammps{make_adapted_manager<AdaptorStrict>(
+              manager_center_lammps, cutoff)};
+          neighbour_list.update(manager_lammps);
+
+          double energy{0.};
+          math::Matrix_t forces{
+              math::Matrix_t::Zero(neighbour_list.nall, ThreeD)};
+          SparseGPRPrediction::Voigt_t virial{
+              SparseGPRPrediction::Voigt_t::Zero()};
+          predictor.predict_contributions(
+              manager_lammps,
+              [&energy](auto & /*center*/, double energy_i) {
+                energy += energy_i;
+              },
+              [&forces, &virial](auto & center, const auto & pair_gradients) {
+                Eigen::Vector3d r_i = center.get_position();
+                int i_neigh{0};
+                for (auto neigh : center.pairs_with_self_pair()) {
+                  const auto j_tag{neigh.get_atom_j().get_atom_tag()};
+                  Eigen::RowVector3d g_ij = pair_gradients.row(i_neigh);
+                  forces.row(j_tag) -= g_ij;
+                  Eigen::Vector3d r_ji = r_i - neigh.get_position();
+                  Eigen::Matrix3d w_ij = -r_ji * g_ij;
+                  virial.head<3>() += w_ij.diagonal();
+                  virial(3) += w_ij(1, 2);
+                  virial(4) += w_ij(0, 2);
+                  virial(5) += w_ij(0, 1);
+                  ++i_neigh;
+                }
+              });
+          // reverse communication of the forces on the ghost atoms
+          math::Matrix_t forces_local{
+              math::Matrix_t::Zero(neighbour_list.nlocal, ThreeD)};
+          for (int i_atom{0}; i_atom < neighbour_list.nall; ++i_atom) {
+            forces_local.row(neighbour_list.owner[i_atom]) +=
+                forces.row(i_atom);
+          }
+
+          BOOST_TEST(std::abs(energy - prediction.energy) <
+                     delta * std::abs(prediction.energy));
+          // relative to the largest element since the forces of the
+          // distorted diamond nearly vanish, and with a looser threshold
+          // since its centers are neighbours of their own periodic images,
+          // whose contributions only cancel exactly when they are distinct
+          // atoms as the ghosts of lammps
+          const double forces_scale{
+              prediction.forces.array().abs().maxCoeff()};
+          BOOST_TEST((forces_local - prediction.forces)
+                         .array()
+                         .abs()
+                         .maxCoeff() < 1e-5 * forces_scale);
+          BOOST_TEST(forces_local.colwise().sum().norm() <
+                     delta * forces_scale);
+          const double virial_scale{
+              prediction.virial.array().abs().maxCoeff()};
+          BOOST_TEST((virial - prediction.virial).array().abs().maxCoeff() <
+                     delta * virial_scale);
+        }
+      }
+    }
+  }
+
   BOOST_AUTO_TEST_SUITE_END();
 
 }  // namespace rascal
@@ -123,6 +123,113 @@ namespace rascal {
     bool verbose{false};
   };
 
+  /**
+   * Emulates the full neighbour list that lammps gives to a pair style on
+   * one process: all the atoms of the structure are local and the periodic
+   * images within the cutoff of a local atom are ghost atoms, i.e. x, type
+   * and the neighbour list are given for nlocal + nghost atoms.
+   */
+  struct LammpsFullNeighbourList {
+    LammpsFullNeighbourList(AtomicStructure<3> structure,
+                            const double cutoff) {
+      this->nlocal = static_cast<int>(structure.positions.cols());
+      // number of images needed in each direction of the cell
+      Eigen::Vector3i n_images{Eigen::Vector3i::Zero()};
+      if (structure.pbc.any()) {
+        Eigen::Matrix3d reciprocal{structure.cell.inverse()};
+        for (int i_dim{0}; i_dim < ThreeD; ++i_dim) {
+          if (structure.pbc(i_dim)) {
+            n_images(i_dim) = static_cast<int>(
+                std::ceil(cutoff * reciprocal.row(i_dim).norm()) + 1);
+          }
+        }
+      }
+      std::vector<Eigen::Vector3d> positions{};
+      for (int i_atom{0}; i_atom < this->nlocal; ++i_atom) {
+        positions.push_back(structure.positions.col(i_atom));
+        this->type.push_back(structure.atom_types(i_atom));
+        this->owner.push_back(i_atom);
+      }
+      for (int i_x{-n_images(0)}; i_x <= n_images(0); ++i_x) {
+        for (int i_y{-n_images(1)}; i_y <= n_images(1); ++i_y) {
+          for (int i_z{-n_images(2)}; i_z <= n_images(2); ++i_z) {
+            if (i_x == 0 and i_y == 0 and i_z == 0) {
+              continue;
+            }
+            Eigen::Vector3d shift{structure.cell *
+                                  Eigen::Vector3d(i_x, i_y, i_z)};
+            for (int i_atom{0}; i_atom < this->nlocal; ++i_atom) {
+              Eigen::Vector3d position{structure.positions.col(i_atom) +
+                                       shift};
+              auto distances{(structure.positions.colwise() - position)
+                                 .colwise()
+                                 .norm()};
+              if (distances.minCoeff() < cutoff) {
+                positions.push_back(position);
+                this->type.push_back(structure.atom_types(i_atom));
+                this->owner.push_back(i_atom);
+              }
+            }
+          }
+        }
+      }
+      this->nall = static_cast<int>(positions.size());
+
+      this->x_data.resize(ThreeD * this->nall);
+      this->f_data.assign(ThreeD * this->nall, 0.);
+      for (int i_atom{0}; i_atom < this->nall; ++i_atom) {
+        Eigen::Map<Eigen::Vector3d>(&this->x_data[ThreeD * i_atom]) =
+            positions[i_atom];
+        this->x.push_back(&this->x_data[ThreeD * i_atom]);
+        this->f.push_back(&this->f_data[ThreeD * i_atom]);
+      }
+      this->neighbours.resize(this->nlocal);
+      for (int i_atom{0}; i_atom < this->nlocal; ++i_atom) {
+        this->ilist.push_back(i_atom);
+        for (int j_atom{0}; j_atom < this->nall; ++j_atom) {
+          if (j_atom != i_atom and
+              (positions[j_atom] - positions[i_atom]).norm() < cutoff) {
+            this->neighbours[i_atom].push_back(j_atom);
+          }
+        }
+        this->numneigh.push_back(
+            static_cast<int>(this->neighbours[i_atom].size()));
+        this->firstneigh.push_back(this->neighbours[i_atom].data());
+      }
+      this->eatom.assign(this->nall, 0.);
+      this->vatom_data.assign(6 * this->nall, 0.);
+      for (int i_atom{0}; i_atom < this->nall; ++i_atom) {
+        this->vatom.push_back(&this->vatom_data[6 * i_atom]);
+      }
+    }
+
+    //! update a lammps manager with the neighbour list
+    template <class Manager>
+    void update(Manager & manager) {
+      manager->update(this->nlocal, this->nall, this->ilist.data(),
+                      this->numneigh.data(), this->firstneigh.data(),
+                      this->x.data(), this->f.data(), this->type.data(),
+                      this->eatom.data(), this->vatom.data());
+    }
+
+    int nlocal{0};
+    int nall{0};
+    //! local atom of which the atom is an image
+    std::vector<int> owner{};
+    std::vector<int> ilist{};
+    std::vector<int> numneigh{};
+    std::vector<std::vector<int>> neighbours{};
+    std::vector<int *> firstneigh{};
+    std::vector<int> type{};
+    std::vector<double> x_data{};
+    std::vector<double *> x{};
+    std::vector<double> f_data{};
+    std::vector<double *> f{};
+    std::vector<double> eatom{};
+    std::vector<double> vatom_data{};
+    std::vector<double *> vatom{};
+  };
+
 }  // namespace rascal
 
 #endif  // TESTS_TEST_SPARSE_KERNELS_HH_
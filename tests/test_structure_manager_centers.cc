@@ -173,6 +173,42 @@ namespace rascal {
     }
   }
 
+  /* ---------------------------------------------------------------------- */
+  // checking that the atoms changed by an update are marked
+  BOOST_FIXTURE_TEST_CASE(manager_changed_atoms_test,
+                          ManagerFixture<StructureManagerCenters>) {
+    int i_manager{0};
+    for (auto & manager : this->managers) {
+      auto structure = this->structures[i_manager];
+      const size_t n_update{manager->get_n_update()};
+      const size_t n_atoms{structure.get_number_of_atoms()};
+      const auto & update_indices{manager->get_atom_update_indices()};
+      BOOST_REQUIRE_EQUAL(update_indices.size(), n_atoms);
+
+      manager->update(structure);
+      BOOST_CHECK_EQUAL(manager->get_n_update(), n_update + 1);
+      for (const auto & update_index : update_indices) {
+        BOOST_CHECK_LE(update_index, n_update);
+      }
+
+      structure.displace_position(1, Eigen::Vector3d{1e-3, 0., 0.});
+      structure.atom_types(2) += 1;
+      manager->update(structure);
+      for (size_t i_atom{0}; i_atom < n_atoms; ++i_atom) {
+        const bool has_changed{i_atom == 1 or i_atom == 2};
+        BOOST_CHECK_EQUAL(update_indices[i_atom] == n_update + 2,
+                          has_changed);
+      }
+
+      structure.cell(0, 0) += 1.;
+      manager->update(structure);
+      for (const auto & update_index : update_indices) {
+        BOOST_CHECK_EQUAL(update_index, n_update + 3);
+      }
+      ++i_manager;
+    }
+  }
+
   /* ---------------------------------------------------------------------- */
   BOOST_AUTO_TEST_SUITE_END();
 }  // namespace rascal